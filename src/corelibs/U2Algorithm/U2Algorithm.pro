@@ -1,15 +1,19 @@
 include (U2Algorithm.pri)
 
 # Input
-HEADERS += src/misc/BinaryFindOpenCL.h \
+HEADERS += src/misc/BinaryFind.h \
+           src/misc/BinaryFindOpenCL.h \
            src/misc/BitsTable.h \
+           src/misc/ByteRegExp.h \
            src/misc/CDSearchTaskFactory.h \
            src/misc/DnaAssemblyMultiTask.h \
            src/misc/DynTable.h \
            src/misc/EnzymeModel.h \
            src/misc/FindAlgorithm.h \
            src/misc/FindAlgorithmTask.h \
+           src/misc/FindEnzymesAlgorithm.h \
            src/misc/GenomeAssemblyMultiTask.h \
+           src/misc/PrimerSeedIndex.h \
            src/misc/RepeatFinderSettings.h \
            src/misc/RepeatFinderTaskFactory.h \
            src/misc/RollingArray.h \
@@ -108,17 +112,22 @@ HEADERS += src/misc/BinaryFindOpenCL.h \
            src/util_weight_matrix/PWMConversionAlgorithmMCH.h \
            src/util_weight_matrix/PWMConversionAlgorithmNLG.h \
            src/util_weight_matrix/PWMConversionAlgorithmRegistry.h \
+           src/util_weight_matrix/WeightMatrixAlgorithm.h \
            src/util_gpu/opencl/OpenCLHelper.h \
            src/util_gpu/opencl/OpenCLUtils.h \
     src/util_msaedit/MsaUtilTasks.h
 
-SOURCES += src/misc/BinaryFindOpenCL.cpp \
+SOURCES += src/misc/BinaryFind.cpp \
+           src/misc/BinaryFindOpenCL.cpp \
            src/misc/BitsTable.cpp \
+           src/misc/ByteRegExp.cpp \
            src/misc/DnaAssemblyMultiTask.cpp \
            src/misc/EnzymeModel.cpp \
            src/misc/FindAlgorithm.cpp \
            src/misc/FindAlgorithmTask.cpp \
+           src/misc/FindEnzymesAlgorithm.cpp \
            src/misc/GenomeAssemblyMultiTask.cpp \
+           src/misc/PrimerSeedIndex.cpp \
            src/misc/SequenceContentFilterTask.cpp \
            src/molecular_geometry/GeomUtils.cpp \
            src/molecular_geometry/MolecularSurface.cpp \
@@ -207,6 +216,7 @@ SOURCES += src/misc/BinaryFindOpenCL.cpp \
            src/util_weight_matrix/PWMConversionAlgorithmMCH.cpp \
            src/util_weight_matrix/PWMConversionAlgorithmNLG.cpp \
            src/util_weight_matrix/PWMConversionAlgorithmRegistry.cpp \
+           src/util_weight_matrix/WeightMatrixAlgorithm.cpp \
            src/util_gpu/opencl/OpenCLHelper.cpp \
            src/util_gpu/opencl/OpenCLUtils.cpp \
     src/util_msaedit/MsaUtilTasks.cpp
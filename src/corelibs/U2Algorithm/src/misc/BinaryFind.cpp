@@ -0,0 +1,103 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include <U2Core/U2SafePoints.h>
+
+#include "BinaryFind.h"
+
+#if defined(__GNUC__)
+#define BINARY_FIND_PREFETCH(address) __builtin_prefetch(address)
+#elif defined(_MSC_VER)
+#include <xmmintrin.h>
+#define BINARY_FIND_PREFETCH(address) _mm_prefetch((const char *)(address), _MM_HINT_T0)
+#else
+#define BINARY_FIND_PREFETCH(address)
+#endif
+
+namespace U2 {
+
+qint64 BinaryFind::find(const quint64 *haystack, qint64 haystackSize, quint64 needle, quint64 filter) {
+    qint64 low = 0;
+    qint64 high = haystackSize - 1;
+    qint64 rc = 0;
+    while (low <= high) {
+        qint64 mid = (low + high) / 2;
+        rc = (haystack[mid]&filter) - (needle&filter);
+        if (rc < 0) {
+            low = mid + 1;
+        } else if (rc > 0) {
+            high = mid - 1;
+        } else {
+            for(high=mid-1;high >= 0 && (haystack[high]&filter)==(needle&filter); high--){};
+            high++;
+            break;
+        }
+    }
+    if (0==rc) {
+        return high;
+    }
+    return -1;
+}
+
+void BinaryFind::find(const quint64 *haystack, qint64 haystackSize, const quint64 *needles, const quint64 *filters, int needlesSize, qint64 *results) {
+    // a lower bound search gives the same first equal element as the single needle search
+    static const int GROUP_SIZE = 16;
+    qint64 low[GROUP_SIZE];
+    qint64 count[GROUP_SIZE];
+
+    for (int groupStart = 0; groupStart < needlesSize; groupStart += GROUP_SIZE) {
+        const int groupSize = qMin(GROUP_SIZE, needlesSize - groupStart);
+        const quint64 *values = needles + groupStart;
+        const quint64 *groupFilters = filters + groupStart;
+        for (int q = 0; q < groupSize; q++) {
+            low[q] = 0;
+            count[q] = haystackSize;
+            BINARY_FIND_PREFETCH(haystack + haystackSize / 2);
+        }
+
+        bool searching = haystackSize > 0;
+        while (searching) {
+            searching = false;
+            for (int q = 0; q < groupSize; q++) {
+                CHECK_CONTINUE(count[q] > 0);
+                const qint64 step = count[q] / 2;
+                const qint64 mid = low[q] + step;
+                if ((haystack[mid] & groupFilters[q]) < (values[q] & groupFilters[q])) {
+                    low[q] = mid + 1;
+                    count[q] -= step + 1;
+                } else {
+                    count[q] = step;
+                }
+                if (count[q] > 0) {
+                    BINARY_FIND_PREFETCH(haystack + low[q] + count[q] / 2);
+                    searching = true;
+                }
+            }
+        }
+
+        for (int q = 0; q < groupSize; q++) {
+            const bool found = low[q] < haystackSize && (haystack[low[q]] & groupFilters[q]) == (values[q] & groupFilters[q]);
+            results[groupStart + q] = found ? low[q] : -1;
+        }
+    }
+}
+
+} // U2
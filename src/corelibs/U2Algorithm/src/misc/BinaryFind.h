@@ -19,41 +19,25 @@
  * MA 02110-1301, USA.
  */
 
-#ifndef _U2_WEIGHT_MATRIX_ALGORITHM_H_
-#define _U2_WEIGHT_MATRIX_ALGORITHM_H_
+#ifndef _U2_BINARY_FIND_H_
+#define _U2_BINARY_FIND_H_
 
-#include <U2Algorithm/PWMConversionAlgorithm.h>
-
-#include <U2Core/DNATranslation.h>
+#include <U2Core/global.h>
 
 namespace U2 {
 
-enum MatrixBuldTarget {
-    FREQUENCY_MATRIX,
-    WEIGHT_MATRIX
-};
-
-enum MatrixBuildType {
-    PM_MONONUCLEOTIDE,
-    PM_DINUCLEOTIDE
-};
-
-class PMBuildSettings {
-public:
-    PMBuildSettings(): type(PM_MONONUCLEOTIDE), target(FREQUENCY_MATRIX) {
-
-    }
-    QString                     algo;
-    MatrixBuildType             type;
-    MatrixBuldTarget            target;
-};
-
-class WeightMatrixAlgorithm : public QObject {
-    Q_OBJECT
+/**
+ * Binary search of bit masks in a sorted array, the CPU counterpart of BinaryFindOpenCL.
+ * The masks are compared under a filter, so a mask equals the needle if the filtered prefixes are equal.
+ */
+class U2ALGORITHM_EXPORT BinaryFind {
 public:
-    static float getScore(const char* seq, int len, const PWMatrix& m, DNATranslation* complMap);
+    // returns the index of the first element equal to the needle or -1
+    static qint64 find(const quint64 *haystack, qint64 haystackSize, quint64 needle, quint64 filter);
+    // the same search for a batch of needles: the probes of several searches are interleaved and prefetched
+    static void find(const quint64 *haystack, qint64 haystackSize, const quint64 *needles, const quint64 *filters, int needlesSize, qint64 *results);
 };
 
-} //namespace
+} // U2
 
-#endif
+#endif // _U2_BINARY_FIND_H_
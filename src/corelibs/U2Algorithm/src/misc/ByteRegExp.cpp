@@ -0,0 +1,536 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include <cctype>
+
+#include <QObject>
+
+#include <U2Core/U2SafePoints.h>
+
+#include "ByteRegExp.h"
+
+namespace U2 {
+
+const int ByteRegExp::DEAD_STATE = 0;
+
+/************************************************************************/
+/* ByteSet */
+/************************************************************************/
+ByteRegExp::ByteSet::ByteSet() {
+    bits[0] = bits[1] = bits[2] = bits[3] = 0;
+}
+
+void ByteRegExp::ByteSet::add(uchar c) {
+    bits[c >> 6] |= quint64(1) << (c & 63);
+}
+
+void ByteRegExp::ByteSet::addRange(uchar first, uchar last) {
+    for (int c = first; c <= last; c++) {
+        add(uchar(c));
+    }
+}
+
+void ByteRegExp::ByteSet::unite(const ByteSet &other) {
+    for (int i = 0; i < 4; i++) {
+        bits[i] |= other.bits[i];
+    }
+}
+
+void ByteRegExp::ByteSet::invert() {
+    for (int i = 0; i < 4; i++) {
+        bits[i] = ~bits[i];
+    }
+}
+
+bool ByteRegExp::ByteSet::contains(uchar c) const {
+    return (bits[c >> 6] >> (c & 63)) & 1;
+}
+
+int ByteRegExp::ByteSet::getSingle() const {
+    int result = -1;
+    for (int c = 0; c < ALPHABET_SIZE; c++) {
+        if (contains(uchar(c))) {
+            CHECK(-1 == result, -1);
+            result = c;
+        }
+    }
+    return result;
+}
+
+/************************************************************************/
+/* ByteRegExp */
+/************************************************************************/
+ByteRegExp::ByteRegExp(const QByteArray &_pattern)
+    : pattern(_pattern), pos(0), anchoredAtStart(false), anchoredAtEnd(false), nfaStartState(-1), nfaMatchState(-1), dfaStartState(DEAD_STATE)
+{
+    if (pattern.startsWith('^')) {
+        anchoredAtStart = true;
+        pos = 1;
+    }
+    int length = pattern.length();
+    if (length > pos && pattern.endsWith('$')) {
+        int backslashes = 0;
+        for (int i = length - 2; i >= pos && '\\' == pattern.at(i); i--) {
+            backslashes++;
+        }
+        if (0 == backslashes % 2) {
+            anchoredAtEnd = true;
+            pattern.chop(1);
+        }
+    }
+
+    int root = parseAlternation();
+    CHECK(error.isEmpty(), );
+    CHECK_EXT(pos == pattern.length(), setError(QObject::tr("Unexpected ')' at position %1").arg(pos + 1)), );
+
+    nfaStartState = addNfaState();
+    nfaMatchState = compile(root, nfaStartState);
+    CHECK_EXT(nfa.size() <= MAX_NFA_STATES, setError(QObject::tr("The regular expression is too complex")), );
+    nodes.clear();
+
+    resetDfa();
+}
+
+bool ByteRegExp::isValid() const {
+    return error.isEmpty();
+}
+
+const QString & ByteRegExp::getError() const {
+    return error;
+}
+
+bool ByteRegExp::isAnchoredAtStart() const {
+    return anchoredAtStart;
+}
+
+bool ByteRegExp::isAnchoredAtEnd() const {
+    return anchoredAtEnd;
+}
+
+int ByteRegExp::getStartState() const {
+    return dfaStartState;
+}
+
+int ByteRegExp::next(int state, char c) {
+    const int idx = state * ALPHABET_SIZE + uchar(c);
+    int result = dfaTransitions[idx];
+    if (UNKNOWN_STATE == result) {
+        QVector<int> targets;
+        foreach (int nfaState, dfaStates[state]) {
+            const NfaState &s = nfa[nfaState];
+            if (s.hasSet && s.set.contains(uchar(c))) {
+                targets << s.next;
+            }
+        }
+        if (dfaStates.size() >= MAX_DFA_STATES) {
+            // 'state' is dropped, so the transition is not cached
+            resetDfa();
+            return getDfaState(targets);
+        }
+        result = getDfaState(targets);
+        dfaTransitions[idx] = result;
+    }
+    return result;
+}
+
+bool ByteRegExp::isDead(int state) {
+    return DEAD_STATE == state;
+}
+
+bool ByteRegExp::isAccepting(int state) const {
+    return dfaAccepting[state];
+}
+
+int ByteRegExp::parseAlternation() {
+    Node alternation(Node::Alternation);
+    alternation.children << parseConcatenation();
+    CHECK(error.isEmpty(), -1);
+    while (pos < pattern.length() && '|' == pattern.at(pos)) {
+        pos++;
+        alternation.children << parseConcatenation();
+        CHECK(error.isEmpty(), -1);
+    }
+    if (1 == alternation.children.size()) {
+        return alternation.children.first();
+    }
+    return addNode(alternation);
+}
+
+int ByteRegExp::parseConcatenation() {
+    Node concatenation(Node::Concat);
+    while (pos < pattern.length() && '|' != pattern.at(pos) && ')' != pattern.at(pos)) {
+        concatenation.children << parseRepeat();
+        CHECK(error.isEmpty(), -1);
+    }
+    return addNode(concatenation);
+}
+
+int ByteRegExp::parseRepeat() {
+    int atom = parseAtom();
+    CHECK(error.isEmpty(), -1);
+    int min = 0;
+    int max = 0;
+    while (parseQuantifier(min, max)) {
+        Node repeat(Node::Repeat);
+        repeat.children << atom;
+        repeat.min = min;
+        repeat.max = max;
+        atom = addNode(repeat);
+    }
+    CHECK(error.isEmpty(), -1);
+    return atom;
+}
+
+bool ByteRegExp::parseQuantifier(int &min, int &max) {
+    CHECK(pos < pattern.length(), false);
+    const char c = pattern.at(pos);
+    if ('*' == c || '+' == c || '?' == c) {
+        pos++;
+        min = ('+' == c) ? 1 : 0;
+        max = ('?' == c) ? 1 : -1;
+        return true;
+    }
+    CHECK('{' == c, false);
+
+    const int braceEnd = pattern.indexOf('}', pos);
+    CHECK_EXT(-1 != braceEnd, setError(QObject::tr("Missing '}' at position %1").arg(pos + 1)), false);
+    const QByteArray body = pattern.mid(pos + 1, braceEnd - pos - 1);
+    const int comma = body.indexOf(',');
+    bool minOk = true;
+    bool maxOk = true;
+    if (-1 == comma) {
+        min = max = body.toInt(&minOk);
+    } else {
+        const QByteArray minStr = body.left(comma).trimmed();
+        const QByteArray maxStr = body.mid(comma + 1).trimmed();
+        min = minStr.isEmpty() ? 0 : minStr.toInt(&minOk);
+        max = maxStr.isEmpty() ? -1 : maxStr.toInt(&maxOk);
+    }
+    CHECK_EXT(minOk && maxOk && min >= 0 && (-1 == max || min <= max),
+              setError(QObject::tr("Invalid quantifier at position %1").arg(pos + 1)), false);
+    pos = braceEnd + 1;
+    return true;
+}
+
+int ByteRegExp::parseAtom() {
+    const char c = pattern.at(pos);
+    switch (c) {
+    case '(': {
+        pos++;
+        if (pattern.mid(pos, 2) == "?:") {
+            pos += 2;
+        } else if (pattern.mid(pos, 2) == "?=" || pattern.mid(pos, 2) == "?!") {
+            return setError(QObject::tr("Lookahead assertions are not supported"));
+        }
+        int group = parseAlternation();
+        CHECK(error.isEmpty(), -1);
+        CHECK_EXT(pos < pattern.length() && ')' == pattern.at(pos), setError(QObject::tr("Missing ')'")), -1);
+        pos++;
+        return group;
+    }
+    case '[': {
+        pos++;
+        Node node(Node::Set);
+        CHECK(parseClass(node.set), -1);
+        return addNode(node);
+    }
+    case '.': {
+        pos++;
+        Node node(Node::Set);
+        node.set.invert();
+        return addNode(node);
+    }
+    case '\\': {
+        pos++;
+        Node node(Node::Set);
+        CHECK(parseEscape(node.set, false), -1);
+        return addNode(node);
+    }
+    case '*':
+    case '+':
+    case '?':
+    case '{':
+        return setError(QObject::tr("Nothing to repeat at position %1").arg(pos + 1));
+    case '^':
+    case '$':
+        return setError(QObject::tr("'%1' is supported only at the pattern boundaries").arg(c));
+    default: {
+        pos++;
+        Node node(Node::Set);
+        node.set.add(uchar(c));
+        return addNode(node);
+    }
+    }
+}
+
+bool ByteRegExp::parseClass(ByteSet &set) {
+    bool negated = false;
+    if (pos < pattern.length() && '^' == pattern.at(pos)) {
+        negated = true;
+        pos++;
+    }
+    bool first = true;
+    while (pos < pattern.length() && (first || ']' != pattern.at(pos))) {
+        first = false;
+        ByteSet item;
+        int rangeFirst = uchar(pattern.at(pos));
+        if ('\\' == pattern.at(pos)) {
+            pos++;
+            CHECK(parseEscape(item, true), false);
+            rangeFirst = item.getSingle();
+        } else {
+            item.add(uchar(rangeFirst));
+            pos++;
+        }
+
+        if (-1 != rangeFirst && pos + 1 < pattern.length() && '-' == pattern.at(pos) && ']' != pattern.at(pos + 1)) {
+            pos++;
+            int rangeLast = uchar(pattern.at(pos));
+            if ('\\' == pattern.at(pos)) {
+                pos++;
+                ByteSet last;
+                CHECK(parseEscape(last, true), false);
+                rangeLast = last.getSingle();
+            } else {
+                pos++;
+            }
+            CHECK_EXT(-1 != rangeLast && rangeFirst <= rangeLast, setError(QObject::tr("Invalid range in the character class")), false);
+            item.addRange(uchar(rangeFirst), uchar(rangeLast));
+        }
+        set.unite(item);
+    }
+    CHECK_EXT(pos < pattern.length(), setError(QObject::tr("Missing ']'")), false);
+    pos++;
+    if (negated) {
+        set.invert();
+    }
+    return true;
+}
+
+bool ByteRegExp::parseEscape(ByteSet &set, bool inClass) {
+    CHECK_EXT(pos < pattern.length(), setError(QObject::tr("Trailing '\\'")), false);
+    const char c = pattern.at(pos++);
+    switch (c) {
+    case 'd':
+    case 'D':
+        set.addRange('0', '9');
+        break;
+    case 's':
+    case 'S':
+        set.add(' ');
+        set.addRange('\t', '\r');
+        break;
+    case 'w':
+    case 'W':
+        set.addRange('0', '9');
+        set.addRange('A', 'Z');
+        set.addRange('a', 'z');
+        set.add('_');
+        break;
+    case 'n':
+        set.add('\n');
+        break;
+    case 't':
+        set.add('\t');
+        break;
+    case 'r':
+        set.add('\r');
+        break;
+    case 'f':
+        set.add('\f');
+        break;
+    case 'v':
+        set.add('\v');
+        break;
+    case 'a':
+        set.add('\a');
+        break;
+    case 'x': {
+        int digits = 0;
+        while (digits < 2 && pos + digits < pattern.length() && isxdigit(uchar(pattern.at(pos + digits)))) {
+            digits++;
+        }
+        CHECK_EXT(digits > 0, setError(QObject::tr("Invalid hexadecimal escape")), false);
+        set.add(uchar(pattern.mid(pos, digits).toInt(NULL, 16)));
+        pos += digits;
+        break;
+    }
+    case 'b':
+    case 'B':
+    case '<':
+    case '>':
+        CHECK_EXT(inClass, setError(QObject::tr("Word boundary assertions are not supported")), false);
+        set.add('b' == c ? '\b' : uchar(c));
+        break;
+    default:
+        CHECK_EXT(!(c >= '1' && c <= '9'), setError(QObject::tr("Back references are not supported")), false);
+        set.add(uchar(c));
+        break;
+    }
+    if ('D' == c || 'S' == c || 'W' == c) {
+        set.invert();
+    }
+    return true;
+}
+
+int ByteRegExp::addNode(const Node &node) {
+    nodes << node;
+    return nodes.size() - 1;
+}
+
+int ByteRegExp::setError(const QString &message) {
+    if (error.isEmpty()) {
+        error = message;
+    }
+    return -1;
+}
+
+int ByteRegExp::compile(int nodeId, int in) {
+    CHECK(nfa.size() <= MAX_NFA_STATES, in);
+    const Node &node = nodes[nodeId];
+    switch (node.type) {
+    case Node::Set: {
+        int out = addNfaState();
+        addSetTransition(in, node.set, out);
+        return out;
+    }
+    case Node::Concat: {
+        int current = in;
+        foreach (int child, node.children) {
+            current = compile(child, current);
+        }
+        return current;
+    }
+    case Node::Alternation: {
+        int out = addNfaState();
+        foreach (int child, node.children) {
+            int childIn = addNfaState();
+            nfa[in].epsilons << childIn;
+            int childOut = compile(child, childIn);
+            nfa[childOut].epsilons << out;
+        }
+        return out;
+    }
+    case Node::Repeat: {
+        const int child = node.children.first();
+        const int min = node.min;
+        const int max = node.max;
+        int current = in;
+        for (int i = 0; i < min; i++) {
+            current = compile(child, current);
+            CHECK(nfa.size() <= MAX_NFA_STATES, current);
+        }
+        if (-1 == max) {
+            int loop = addNfaState();
+            nfa[current].epsilons << loop;
+            int childOut = compile(child, loop);
+            nfa[childOut].epsilons << loop;
+            return loop;
+        }
+        int out = addNfaState();
+        for (int i = min; i < max; i++) {
+            nfa[current].epsilons << out;
+            current = compile(child, current);
+            CHECK(nfa.size() <= MAX_NFA_STATES, current);
+        }
+        nfa[current].epsilons << out;
+        return out;
+    }
+    default:
+        FAIL("Unexpected regular expression node", in);
+    }
+}
+
+int ByteRegExp::addNfaState() {
+    nfa << NfaState();
+    return nfa.size() - 1;
+}
+
+void ByteRegExp::addSetTransition(int from, const ByteSet &set, int to) {
+    if (nfa[from].hasSet) {
+        int intermediate = addNfaState();
+        nfa[from].epsilons << intermediate;
+        from = intermediate;
+    }
+    NfaState &state = nfa[from];
+    state.hasSet = true;
+    state.set = set;
+    state.next = to;
+}
+
+int ByteRegExp::getDfaState(const QVector<int> &nfaStates) {
+    QVector<bool> visited(nfa.size(), false);
+    foreach (int nfaState, nfaStates) {
+        addClosure(nfaState, visited);
+    }
+    // only the states with transitions and the match state define the DFA state
+    QVector<int> key;
+    for (int i = 0; i < nfa.size(); i++) {
+        if (visited[i] && (nfa[i].hasSet || i == nfaMatchState)) {
+            key << i;
+        }
+    }
+    const QByteArray keyBytes(reinterpret_cast<const char *>(key.constData()), key.size() * int(sizeof(int)));
+    QHash<QByteArray, int>::const_iterator found = dfaStateIds.constFind(keyBytes);
+    if (found != dfaStateIds.constEnd()) {
+        return found.value();
+    }
+
+    const int id = dfaStates.size();
+    dfaStateIds.insert(keyBytes, id);
+    dfaStates << key;
+    dfaAccepting << key.contains(nfaMatchState);
+    dfaTransitions.resize(dfaTransitions.size() + ALPHABET_SIZE);
+    int *transitions = dfaTransitions.data() + id * ALPHABET_SIZE;
+    for (int c = 0; c < ALPHABET_SIZE; c++) {
+        transitions[c] = (DEAD_STATE == id) ? DEAD_STATE : UNKNOWN_STATE;
+    }
+    return id;
+}
+
+void ByteRegExp::resetDfa() {
+    dfaStateIds.clear();
+    dfaStates.clear();
+    dfaAccepting.clear();
+    dfaTransitions.clear();
+
+    // the dead state is the empty set of the NFA states
+    getDfaState(QVector<int>());
+    QVector<int> startStates;
+    startStates << nfaStartState;
+    dfaStartState = getDfaState(startStates);
+}
+
+void ByteRegExp::addClosure(int nfaState, QVector<bool> &visited) const {
+    QVector<int> stack;
+    stack << nfaState;
+    while (!stack.isEmpty()) {
+        const int state = stack.last();
+        stack.removeLast();
+        CHECK_CONTINUE(!visited[state]);
+        visited[state] = true;
+        foreach (int target, nfa[state].epsilons) {
+            stack << target;
+        }
+    }
+}
+
+} // namespace U2
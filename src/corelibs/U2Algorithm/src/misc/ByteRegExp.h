@@ -0,0 +1,152 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef _U2_BYTE_REG_EXP_H_
+#define _U2_BYTE_REG_EXP_H_
+
+#include <QByteArray>
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+namespace U2 {
+
+/**
+ * A regular expression compiled to a DFA over the byte alphabet.
+ * The DFA states are built lazily while the text is scanned, so the text can be passed character by character
+ * from any source (e.g. a complemented or translated view of a sequence) without making a copy of it.
+ *
+ * The supported syntax is a subset of QRegExp: literals, '.', character classes with ranges and negation,
+ * the \d \D \s \S \w \W escapes, groups, alternation and the *, +, ?, {n}, {n,}, {n,m} quantifiers.
+ * '^' and '$' are supported only at the beginning and at the end of the whole pattern.
+ * Back references, assertions and lookaheads can't be expressed with a DFA and are reported as errors.
+ */
+class U2ALGORITHM_EXPORT ByteRegExp {
+public:
+    ByteRegExp(const QByteArray &pattern);
+
+    bool isValid() const;
+    const QString & getError() const;
+
+    bool isAnchoredAtStart() const;
+    bool isAnchoredAtEnd() const;
+
+    // the state before the first character of a match
+    int getStartState() const;
+    // the state after reading the character 'c' in the state 'state'.
+    // When the DFA grows too large it is rebuilt from scratch: only the dead state, the start state
+    // and the returned state are valid after the call
+    int next(int state, char c);
+    // true if no match can be continued from the state
+    static bool isDead(int state);
+    // true if the characters read so far form a match
+    bool isAccepting(int state) const;
+
+    static const int DEAD_STATE;
+
+private:
+    struct ByteSet {
+        ByteSet();
+        void add(uchar c);
+        void addRange(uchar first, uchar last);
+        void unite(const ByteSet &other);
+        void invert();
+        bool contains(uchar c) const;
+        // returns the only byte of the set or -1 if the set has another size
+        int getSingle() const;
+
+        quint64 bits[4];
+    };
+
+    struct Node {
+        enum Type {
+            Set,
+            Concat,
+            Alternation,
+            Repeat
+        };
+        Node(Type type = Concat) : type(type), min(0), max(0) {}
+
+        Type type;
+        ByteSet set;
+        QVector<int> children;
+        int min;
+        int max; // -1 is "unlimited"
+    };
+
+    struct NfaState {
+        NfaState() : hasSet(false), next(-1) {}
+
+        bool hasSet;
+        ByteSet set;
+        int next;
+        QVector<int> epsilons;
+    };
+
+    // parsing into the tree of nodes
+    int parseAlternation();
+    int parseConcatenation();
+    int parseRepeat();
+    int parseAtom();
+    bool parseQuantifier(int &min, int &max);
+    bool parseClass(ByteSet &set);
+    bool parseEscape(ByteSet &set, bool inClass);
+    int addNode(const Node &node);
+    int setError(const QString &message);
+
+    // Thompson's construction of the NFA
+    int compile(int node, int in);
+    int addNfaState();
+    void addSetTransition(int from, const ByteSet &set, int to);
+
+    // subset construction of the DFA
+    int getDfaState(const QVector<int> &nfaStates);
+    // drops all DFA states except the dead and the start ones
+    void resetDfa();
+    void addClosure(int nfaState, QVector<bool> &visited) const;
+
+    QByteArray pattern;
+    int pos;
+    QString error;
+    bool anchoredAtStart;
+    bool anchoredAtEnd;
+
+    QVector<Node> nodes;
+    QVector<NfaState> nfa;
+    int nfaStartState;
+    int nfaMatchState;
+
+    QHash<QByteArray, int> dfaStateIds;
+    QVector<QVector<int> > dfaStates;
+    QVector<bool> dfaAccepting;
+    QVector<int> dfaTransitions;
+    int dfaStartState;
+
+    static const int ALPHABET_SIZE = 256;
+    static const int UNKNOWN_STATE = -1;
+    static const int MAX_NFA_STATES = 100000;
+    // the transitions table takes 'ALPHABET_SIZE * sizeof(int)' bytes per state: 4 Mb for this limit
+    static const int MAX_DFA_STATES = 4096;
+};
+
+} // namespace U2
+
+#endif // _U2_BYTE_REG_EXP_H_
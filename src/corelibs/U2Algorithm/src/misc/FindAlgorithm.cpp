@@ -19,7 +19,8 @@
  * MA 02110-1301, USA.
  */
 
-#include <QRegExp>
+#include <QtAlgorithms>
+#include <QVector>
 
 #include <U2Core/DNATranslation.h>
 #include <U2Core/DNAAlphabet.h>
@@ -27,6 +28,7 @@
 #include <U2Core/TextUtils.h>
 #include <U2Core/U2SafePoints.h>
 
+#include <U2Algorithm/ByteRegExp.h>
 #include <U2Algorithm/DynTable.h>
 #include <U2Algorithm/RollingArray.h>
 
@@ -78,28 +80,199 @@ bool FindAlgorithmResult::lessByRegionStartPos(const U2::FindAlgorithmResult &r1
     }
 }
 
+static const char* getAmbiguousBaseMap();
+
+/**
+ * Myers' bit-vector algorithm for the approximate pattern search with insertions and deletions.
+ * It computes the same values as the last row of DynTable in the InsDel mode, but a column costs
+ * O(patternLen / 64) word operations. The last 'width' columns are kept as vertical delta vectors,
+ * so the length of a found region is restored with the same traceback rules as DynTable::getLen().
+ */
+class BitParallelEditTable {
+public:
+    BitParallelEditTable() : height(0), width(0), words(0), lastRowMask(0), current(0), score(0) {}
+
+    BitParallelEditTable(const char *pattern, int patternLen, int _width, bool useAmbiguousBases)
+        : height(patternLen), width(_width), words((patternLen + WORD_SIZE - 1) / WORD_SIZE),
+          lastRowMask(quint64(1) << ((patternLen - 1) % WORD_SIZE)), current(0), score(patternLen)
+    {
+        peq.fill(0, ALPHABET_SIZE * words);
+        const char *ambiguousMap = useAmbiguousBases ? getAmbiguousBaseMap() : NULL;
+        for (int c = 1; c < ALPHABET_SIZE; c++) {
+            quint64 *eq = peq.data() + c * words;
+            for (int y = 0; y < patternLen; y++) {
+                const uchar p = uchar(pattern[y]);
+                const bool matched = NULL == ambiguousMap ? c == p
+                    : (c < 128 && p < 128 && (ambiguousMap[c] & ambiguousMap[p]) != 0);
+                if (matched) {
+                    eq[y / WORD_SIZE] |= quint64(1) << (y % WORD_SIZE);
+                }
+            }
+        }
+        // the initial columns are the same as in DynTable: the value of the row 'y' is 'y + 1'
+        pv.fill(~quint64(0), width * words);
+        mv.fill(0, width * words);
+        chars.fill(0, width);
+    }
+
+    // processes the next sequence character and returns the distance for the new column
+    int match(char c) {
+        const int prev = current;
+        current = (current + 1 == width) ? 0 : current + 1;
+        const quint64 *eqs = peq.constData() + uchar(c) * words;
+        const quint64 *prevPv = pv.constData() + prev * words;
+        const quint64 *prevMv = mv.constData() + prev * words;
+        quint64 *curPv = pv.data() + current * words;
+        quint64 *curMv = mv.data() + current * words;
+        chars[current] = c;
+
+        int hin = 0; // the first row has zero horizontal deltas: a match may start anywhere
+        for (int b = 0; b < words; b++) {
+            const quint64 pvb = prevPv[b];
+            const quint64 mvb = prevMv[b];
+            const quint64 hinIsNeg = hin < 0 ? 1 : 0;
+            quint64 eq = eqs[b];
+            const quint64 xv = eq | mvb;
+            eq |= hinIsNeg;
+            const quint64 xh = (((eq & pvb) + pvb) ^ pvb) | eq;
+            quint64 ph = mvb | ~(xh | pvb);
+            quint64 mh = pvb & xh;
+            if (b == words - 1) {
+                score += (ph & lastRowMask) != 0 ? 1 : 0;
+                score -= (mh & lastRowMask) != 0 ? 1 : 0;
+            }
+            const int hout = int(ph >> (WORD_SIZE - 1)) - int(mh >> (WORD_SIZE - 1));
+            ph = (ph << 1) | (hin > 0 ? 1 : 0);
+            mh = (mh << 1) | hinIsNeg;
+            curPv[b] = mh | ~(xv | ph);
+            curMv[b] = ph & xv;
+            hin = hout;
+        }
+        return score;
+    }
+
+    int getLast() const {
+        return score;
+    }
+
+    int getLastLen() const {
+        int len = 0;
+        int x = width - 1;
+        int y = height - 1;
+        while (y >= 0 && x >= 0) {
+            const int v = getValue(x, y);
+            const int d = getValue(x - 1, y - 1);
+            const bool matched = isMatch(x, y);
+            if (matched && v == d) {
+                len++; x--; y--;
+            } else if (v == getValue(x, y - 1) + 1) { //prefer deletion in X sequence to minimize result len
+                y--;
+            } else if (!matched && v == d + 1) { // prefer mismatch instead of insertion into X sequence
+                len++; x--; y--;
+            } else { // this is insertion into X sequence
+                len++; x--;
+            }
+        }
+        return len;
+    }
+
+    static quint64 estimateTableSizeInBytes(const int width, const int height) {
+        const quint64 words = (height + WORD_SIZE - 1) / WORD_SIZE;
+        return (ALPHABET_SIZE + 2 * quint64(width)) * words * sizeof(quint64) + width;
+    }
+
+private:
+    // 'x' is a column of the window: 'width - 1' is the last processed one
+    int getSlot(int x) const {
+        const int slot = current - (width - 1 - x);
+        return slot < 0 ? slot + width : slot;
+    }
+
+    int getValue(int x, int y) const {
+        if (y < 0) {return 0;}
+        if (x < 0) {return y + 1;}
+        const int slot = getSlot(x);
+        const quint64 *pvs = pv.constData() + slot * words;
+        const quint64 *mvs = mv.constData() + slot * words;
+        int value = 0;
+        const int lastWord = y / WORD_SIZE;
+        for (int b = 0; b < lastWord; b++) {
+            value += qPopulationCount(pvs[b]) - qPopulationCount(mvs[b]);
+        }
+        const int bit = y % WORD_SIZE;
+        const quint64 mask = (bit == WORD_SIZE - 1) ? ~quint64(0) : (quint64(1) << (bit + 1)) - 1;
+        value += qPopulationCount(pvs[lastWord] & mask) - qPopulationCount(mvs[lastWord] & mask);
+        return value;
+    }
+
+    bool isMatch(int x, int y) const {
+        const uchar c = uchar(chars[getSlot(x)]);
+        return (peq[c * words + y / WORD_SIZE] >> (y % WORD_SIZE)) & 1;
+    }
+
+    static const int WORD_SIZE = 64;
+    static const int ALPHABET_SIZE = 256;
+
+    int height;
+    int width;
+    int words;
+    quint64 lastRowMask;
+    QVector<quint64> peq;
+    QVector<quint64> pv;
+    QVector<quint64> mv;
+    QByteArray chars;
+    int current;
+    int score;
+};
+
 class StrandContext {
 public:
-    StrandContext(int width, int height, bool insDel, const char* p)
-        : dynTable(width, height, insDel), pattern(p)
+    StrandContext(int width, int height, bool _insDel, const char* p, bool useAmbiguousBases = false)
+        : dynTable(_insDel ? 0 : width, _insDel ? 0 : height, false),
+          bitTable(_insDel ? BitParallelEditTable(p, height, width, useAmbiguousBases) : BitParallelEditTable()),
+          pattern(p), insDel(_insDel)
     {
     }
 
     StrandContext( const char * data, int arr_size, const char * p ) //using rolling array only in subst mode
-        : rollArr( data, arr_size ), pattern(p)
+        : rollArr( data, arr_size ), pattern(p), insDel(false)
     {
     }
 
-    StrandContext() : pattern(NULL) {}
+    StrandContext() : pattern(NULL), insDel(false) {}
 
-    static quint64 estimateRamUsageForOneContext(int width, int height)
+    static quint64 estimateRamUsageForOneContext(int width, int height, bool insDel)
     {
-        return DynTable::estimateTableSizeInBytes(width, height);
+        return insDel ? BitParallelEditTable::estimateTableSizeInBytes(width, height)
+            : DynTable::estimateTableSizeInBytes(width, height);
+    }
+
+    // fills the next column of the table and returns the number of errors in the last row
+    int match(char c, int patternLen) {
+        if (insDel) {
+            return bitTable.match(c);
+        }
+        for (int j = 0; j < patternLen; j++) {
+            dynTable.match(j, c == pattern[j]);
+        }
+        return dynTable.getLast();
+    }
+
+    int getLastLen() const {
+        return insDel ? bitTable.getLastLen() : dynTable.getLastLen();
+    }
+
+    void shiftColumn() {
+        if (!insDel) {
+            dynTable.shiftColumn();
+        }
     }
 
     DynTable dynTable;
+    BitParallelEditTable bitTable;
     RollingArray<char> rollArr;
     const char* pattern;
+    bool insDel;
     FindAlgorithmResult res;
 };
 
@@ -194,30 +367,24 @@ static void findInAmino(    FindAlgorithmResultsListener* rl,
     {
         for (int ci = conStart; ci < conEnd && !stopFlag; ci++) {
             StrandContext& ctx = context[3 * ci + translStrand];
-            DynTable& dt = ctx.dynTable;
-            const char* p = ctx.pattern;
             FindAlgorithmResult& res = ctx.res;
 
-            for (int j=0; j < patternLen && !stopFlag; j++) { //TODO: optimize -> specialize loops
-                int k = cycleIndex(seqLen, i);
-                char amino = ci == 0 ?
-                    aminoTT->translate3to1( seq[k],
-                                            seq[cycleIndex(seqLen, k + 1)],
-                                            seq[cycleIndex(seqLen, k + 2)]) :  //direct amino
-                    aminoTT->translate3to1(complMap.at( (quint8) seq[cycleIndex(seqLen, k + 2)]),
-                                           complMap.at((quint8) seq[cycleIndex(seqLen, k + 1)]),
-                                           complMap.at( (quint8)seq[k]) ); //compl amino
-
-                bool matched = (amino == p[j]);
-                dt.match(j, matched);
-            }
-            int err = dt.getLast();
+            int k = cycleIndex(seqLen, i);
+            char amino = ci == 0 ?
+                aminoTT->translate3to1( seq[k],
+                                        seq[cycleIndex(seqLen, k + 1)],
+                                        seq[cycleIndex(seqLen, k + 2)]) :  //direct amino
+                aminoTT->translate3to1(complMap.at( (quint8) seq[cycleIndex(seqLen, k + 2)]),
+                                       complMap.at((quint8) seq[cycleIndex(seqLen, k + 1)]),
+                                       complMap.at( (quint8)seq[k]) ); //compl amino
+
+            int err = ctx.match(amino, patternLen);
             if (!res.isEmpty() && (err > maxErr || (i - res.region.startPos) >= patternLenInNucl)) {
                 rl->onResult(res);
                 res.clear();
             }
             if (err <= maxErr) {
-                int newLen = dt.getLastLen();
+                int newLen = ctx.getLastLen();
                 newLen *= 3;
                 if (res.isEmpty() || res.err > err || (res.err == err && newLen < res.region.length)) {
                     SAFE_POINT( newLen + 3  * maxErr >= patternLenInNucl, "Internal algorithm error!", );
@@ -237,7 +404,7 @@ static void findInAmino(    FindAlgorithmResultsListener* rl,
                     }
                 }
             }
-            dt.shiftColumn();
+            ctx.shiftColumn();
             if (leftTillPercent == 0) {
                 percentsCompleted = qMin(percentsCompleted+1,100);
                 leftTillPercent = onePercentLen;
@@ -405,9 +572,14 @@ static char* createAmbiguousBaseMap() {
     return &map[0];
 }
 
+// the map is filled once: the searches in other threads read it
+static const char* getAmbiguousBaseMap() {
+    static const char* charMap = createAmbiguousBaseMap();
+    return charMap;
+}
 
 bool FindAlgorithm::cmpAmbiguous( char a, char b) {
-    static char* charMap = createAmbiguousBaseMap();
+    const char* charMap = getAmbiguousBaseMap();
 
     SAFE_POINT( a >= 0 && b >= 0, "Invalid characters supplied!", false );
 
@@ -441,15 +613,6 @@ inline bool match_pattern_ambiguous(const char* seq, const char* p, int start, i
     return match;
 }
 
-// reverses found result if it's located on the reverse complement strand
-inline void prepareResultPosition( int regionStart, int regionLength, int &foundStart,
-    int foundLength, U2Strand resultStrand )
-{
-    foundStart = resultStrand.isCompementary( )
-        ? regionStart + regionLength - foundStart - foundLength
-        : regionStart + foundStart;
-}
-
 static void sendResultToListener( int resultStartPos, int resultLength, U2Strand resultStrand,
     FindAlgorithmResultsListener *rl )
 {
@@ -464,74 +627,140 @@ static void sendResultToListener( int resultStartPos, int resultLength, U2Strand
     rl->onResult(res);
 }
 
-static void regExpSearch(   const QString &refSequence,
-                            const QRegExp &regExp,
-                            const U2Strand &searchStrand,
-                            const U2Region &sequenceRange,
+/**
+ * The views of a strand for the regular expression search.
+ * The characters are taken from the sequence on the fly, so neither the complement nor the translation are stored.
+ */
+class DirectRegExpText {
+public:
+    DirectRegExpText(const char *seq, int seqLen, qint64 start)
+        : seq(seq), seqLen(seqLen), start(start) {}
+
+    char at(int pos) const {
+        return seq[cycleIndex(seqLen, start + pos)];
+    }
+
+    qint64 getResultStart(int matchStart, int /*matchLen*/) const {
+        return start + matchStart;
+    }
+
+    static const int UNIT_LENGTH = 1;
+
+private:
+    const char *seq;
+    int seqLen;
+    qint64 start;
+};
+
+class ComplementRegExpText {
+public:
+    ComplementRegExpText(const char *seq, int seqLen, qint64 start, int textLen, const char *complMap)
+        : seq(seq), seqLen(seqLen), end(start + textLen), complMap(complMap) {}
+
+    char at(int pos) const {
+        return complMap[uchar(seq[cycleIndex(seqLen, end - pos - 1)])];
+    }
+
+    qint64 getResultStart(int matchStart, int matchLen) const {
+        return end - matchStart - matchLen;
+    }
+
+    static const int UNIT_LENGTH = 1;
+
+private:
+    const char *seq;
+    int seqLen;
+    qint64 end;
+    const char *complMap;
+};
+
+class DirectAminoRegExpText {
+public:
+    DirectAminoRegExpText(const char *seq, int seqLen, qint64 start, DNATranslation *aminoTT)
+        : seq(seq), seqLen(seqLen), start(start), aminoTT(aminoTT) {}
+
+    char at(int pos) const {
+        const qint64 k = start + 3 * pos;
+        return aminoTT->translate3to1(seq[cycleIndex(seqLen, k)],
+                                      seq[cycleIndex(seqLen, k + 1)],
+                                      seq[cycleIndex(seqLen, k + 2)]);
+    }
+
+    qint64 getResultStart(int matchStart, int /*matchLen*/) const {
+        return start + 3 * matchStart;
+    }
+
+    static const int UNIT_LENGTH = 3;
+
+private:
+    const char *seq;
+    int seqLen;
+    qint64 start;
+    DNATranslation *aminoTT;
+};
+
+class ComplementAminoRegExpText {
+public:
+    // 'end' is the end of the last full codon on the direct strand
+    ComplementAminoRegExpText(const char *seq, int seqLen, qint64 end, DNATranslation *aminoTT, const char *complMap)
+        : seq(seq), seqLen(seqLen), end(end), aminoTT(aminoTT), complMap(complMap) {}
+
+    char at(int pos) const {
+        const qint64 k = end - 3 * pos - 3;
+        return aminoTT->translate3to1(complMap[uchar(seq[cycleIndex(seqLen, k + 2)])],
+                                      complMap[uchar(seq[cycleIndex(seqLen, k + 1)])],
+                                      complMap[uchar(seq[cycleIndex(seqLen, k)])]);
+    }
+
+    qint64 getResultStart(int matchStart, int matchLen) const {
+        return end - 3 * (matchStart + matchLen);
+    }
+
+    static const int UNIT_LENGTH = 3;
+
+private:
+    const char *seq;
+    int seqLen;
+    qint64 end;
+    DNATranslation *aminoTT;
+    const char *complMap;
+};
+
+// reports all matches that start before 'startLimit' and are not longer than 'maxResultLen' text characters
+template <class Text>
+static void regExpSearch(   ByteRegExp &regExp,
+                            const Text &text,
+                            int textLen,
+                            int startLimit,
                             int maxResultLen,
-                            int currentStrand,
-                            int tailCutted, //only for translation on complementary strand, it is size of the tail that can not form amino acid
-                            int totalStrandCount,
-                            bool refSeqIsAminoTranslation,
-                            int aminoFrameNumber,
+                            const U2Strand &searchStrand,
+                            int passNumber,
+                            int passCount,
                             int &percentsCompleted,
                             int &stopFlag,
-                            FindAlgorithmResultsListener *rl,
-                            int cyclePoint = -1) // in cyclePoint position copy of the sequence beginning starts (for circular search)
+                            FindAlgorithmResultsListener *rl)
 {
-    if (cyclePoint == -1) {
-        cyclePoint = sequenceRange.endPos();
-    }
-
-    int foundStartPos = 0;
-    while ( 0 == stopFlag
-        && -1 != ( foundStartPos = regExp.indexIn( refSequence, foundStartPos ) ) )
-    {
-        // remember that there are a few iterations, so a single one yields
-        // 1 / @conEnd of total progress
-        percentsCompleted = ( 100 * foundStartPos * ( currentStrand + 1 ) )
-            / ( sequenceRange.length * totalStrandCount );
-
-        const int foundLength = regExp.matchedLength( );
-        if ( maxResultLen >= foundLength ) {
-            int resultStartPos = refSeqIsAminoTranslation ? foundStartPos * 3 : foundStartPos;
-            if (resultStartPos < cyclePoint || sequenceRange.startPos != 0) {
-                const int resultLen = refSeqIsAminoTranslation ? foundLength * 3 : foundLength;
-                prepareResultPosition( sequenceRange.startPos + (refSeqIsAminoTranslation * aminoFrameNumber),
-                                       sequenceRange.length - (refSeqIsAminoTranslation * aminoFrameNumber),
-                                       resultStartPos,
-                                       resultLen,
-                                       searchStrand );
-                resultStartPos -= (searchStrand.isCompementary() && refSeqIsAminoTranslation ? tailCutted : 0);
-
-                sendResultToListener( resultStartPos, resultLen, searchStrand, rl );
+    QVector<int> matchLengths;
+    const int end = qMin(startLimit, textLen);
+    for (int startPos = 0; startPos < end && 0 == stopFlag; startPos++) {
+        CHECK_BREAK(!regExp.isAnchoredAtStart() || 0 == startPos);
+        percentsCompleted = int((100 * (qint64(passNumber) * textLen + startPos)) / (qint64(passCount) * textLen));
+
+        matchLengths.clear();
+        int state = regExp.getStartState();
+        for (int pos = startPos; pos < textLen && pos - startPos < maxResultLen; pos++) {
+            state = regExp.next(state, text.at(pos));
+            CHECK_BREAK(!ByteRegExp::isDead(state));
+            if (regExp.isAccepting(state) && (!regExp.isAnchoredAtEnd() || pos + 1 == textLen)) {
+                matchLengths << pos - startPos + 1;
             }
         }
 
-        // try to find smaller substrings starting from the same position
-        int substrLength = qMin(foundLength - 1, maxResultLen);
-        while ( 0 == stopFlag && 0 < substrLength
-            && foundStartPos == ( regExp.indexIn( refSequence.left( foundStartPos + substrLength ), foundStartPos ) ) )
-        {
-            const int foundSubstrLength = regExp.matchedLength( );
-            if ( maxResultLen >= foundSubstrLength ) {
-                int resultStartPos = refSeqIsAminoTranslation ? foundStartPos * 3 : foundStartPos;
-                if (resultStartPos < cyclePoint || sequenceRange.startPos != 0) {
-                    const int resultLen = refSeqIsAminoTranslation ? foundSubstrLength * 3 : foundSubstrLength;
-                    prepareResultPosition( sequenceRange.startPos + (refSeqIsAminoTranslation * aminoFrameNumber),
-                                           sequenceRange.length - (refSeqIsAminoTranslation * aminoFrameNumber),
-                                           resultStartPos,
-                                           resultLen,
-                                           searchStrand );
-                    resultStartPos -= (searchStrand.isCompementary() && refSeqIsAminoTranslation ? tailCutted : 0);
-
-                    sendResultToListener( resultStartPos, resultLen, searchStrand, rl );
-                }
-            }
-            substrLength = foundSubstrLength - 1;
+        // all matches from the same position are reported starting from the longest one
+        for (int i = matchLengths.size() - 1; i >= 0; i--) {
+            const int matchLen = matchLengths[i];
+            sendResultToListener(text.getResultStart(startPos, matchLen), Text::UNIT_LENGTH * matchLen, searchStrand, rl);
         }
-
-        ++foundStartPos;
     }
 }
 
@@ -542,7 +771,7 @@ static void findInAmino_regExp( FindAlgorithmResultsListener *rl,
                                 const char *seq,
                                 const U2Region &range,
                                 bool searchIsCircular,
-                                const char *pattern,
+                                ByteRegExp &regExp,
                                 int maxRegExpResult,
                                 int &stopFlag,
                                 int &percentsCompleted )
@@ -552,66 +781,35 @@ static void findInAmino_regExp( FindAlgorithmResultsListener *rl,
     int conStart = isDirect( strand )? 0 : 1;
     int conEnd =  isComplement( strand ) ? 2 : 1;
 
-    QRegExp regExp( pattern );
-    SAFE_POINT( regExp.isValid( ), "Invalid regular expression supplied!", );
-
-    int maxAminoResult = maxRegExpResult * 3;
     int seqLen = QByteArray(seq).size();
-
+    int maxAminoResult = searchIsCircular ? maxRegExpResult : maxRegExpResult * 3;
     int bufferSize = 0;
-    const char *sequence = NULL;
-    QByteArray temp;
     if (searchIsCircular) {
         bufferSize = getCircularOverlap(seq, range, (seqLen > maxRegExpResult) ? maxRegExpResult - 1 : seqLen - 1);
-        temp = QByteArray(seq) + QByteArray(seq, bufferSize);
-        sequence = temp.data();
-    } else {
-        sequence = seq;
     }
+    const QByteArray complMap = (NULL == complTT) ? QByteArray() : complTT->getOne2OneMapper();
 
     for ( int ci = conStart; ci < conEnd && !stopFlag; ++ci ) {
-
         for (int aminoFrameNumber = 0; aminoFrameNumber < 3 && !stopFlag; aminoFrameNumber++) {
-            int len = seqLen - aminoFrameNumber - range.startPos;
-            if (range.startPos < seqLen && range.endPos() < seqLen) {
-                len = range.length - aminoFrameNumber;
-            }
-
-            QString translation;
-            QByteArray rawTranslation(len + bufferSize + 1, 0);
-            U2Strand resultStrand;
-            const int translationLen = (len + bufferSize) / 3;
+            const qint64 frameStart = range.startPos + aminoFrameNumber;
+            const int len = qMin(range.endPos(), qint64(seqLen)) - frameStart;
+            const int nuclLen = len + bufferSize;
+            CHECK_CONTINUE(nuclLen >= 3);
+            const int translationLen = nuclLen / 3;
+            // a result is reported once even if the circular overlap contains it again
+            const int startLimit = (searchIsCircular && 0 == range.startPos) ? (len + 2) / 3 : translationLen;
+            const int passNumber = 3 * (ci - conStart) + aminoFrameNumber;
+            const int passCount = 3 * (conEnd - conStart);
 
             if ( ci == 1 ) { // complementary
-                TextUtils::translate( complTT->getOne2OneMapper( ), sequence + range.startPos + aminoFrameNumber,
-                                      len + bufferSize,
-                                      rawTranslation.data() );
-                TextUtils::reverse( rawTranslation.data(), len + bufferSize - (len + bufferSize) % 3);
-                aminoTT->translate( rawTranslation.data(), len + bufferSize);
-
-                resultStrand = U2Strand::Complementary;
+                ComplementAminoRegExpText text(seq, seqLen, frameStart + 3 * translationLen, aminoTT, complMap.constData());
+                regExpSearch(regExp, text, translationLen, startLimit, maxAminoResult, U2Strand::Complementary,
+                             passNumber, passCount, percentsCompleted, stopFlag, rl);
             } else { // direct
-                qstrcpy(rawTranslation.data(), QByteArray(sequence + range.startPos + aminoFrameNumber, len + bufferSize).data());
-                aminoTT->translate( rawTranslation.data(), len + bufferSize);
-
-                resultStrand = U2Strand::Direct;
-            }
-            translation = QString( QByteArray( rawTranslation.data(), translationLen ) );
-
-
-            if (searchIsCircular) {
-                U2Region cirRange = range;
-                cirRange.length += (seqLen == range.length && range.startPos == 0) ? bufferSize : 0;
-
-                regExpSearch( translation, regExp, resultStrand, cirRange, maxRegExpResult, ci,
-                              (len + bufferSize) % 3, conEnd, true, aminoFrameNumber,
-                              percentsCompleted, stopFlag, rl, len);
-            } else {
-                regExpSearch( translation, regExp, resultStrand, range, maxAminoResult, ci,
-                              (len + bufferSize) % 3, conEnd, true, aminoFrameNumber,
-                              percentsCompleted, stopFlag, rl );
+                DirectAminoRegExpText text(seq, seqLen, frameStart, aminoTT);
+                regExpSearch(regExp, text, translationLen, startLimit, maxAminoResult, U2Strand::Direct,
+                             passNumber, passCount, percentsCompleted, stopFlag, rl);
             }
-
         }
     }
 }
@@ -628,8 +826,11 @@ static void findRegExp( FindAlgorithmResultsListener *rl,
                         int &stopFlag,
                         int &percentsCompleted )
 {
+    ByteRegExp regExp( pattern );
+    SAFE_POINT( regExp.isValid( ), "Invalid regular expression supplied!", );
+
     if ( NULL != aminoTT ) {
-        findInAmino_regExp( rl, aminoTT, complTT, strand, seq, range, searchIsCircular, pattern,
+        findInAmino_regExp( rl, aminoTT, complTT, strand, seq, range, searchIsCircular, regExp,
             maxRegExpResult, stopFlag, percentsCompleted );
         return;
     }
@@ -640,54 +841,25 @@ static void findRegExp( FindAlgorithmResultsListener *rl,
     const int conStart = isDirect( strand ) ? 0 : 1;
     const int conEnd =  isComplement( strand ) ? 2 : 1;
 
-    QRegExp regExp( pattern );
-    SAFE_POINT( regExp.isValid( ), "Invalid regular expression supplied!", );
+    int textLen = qMin(range.endPos(), qint64(seqLen)) - range.startPos;
+    int startLimit = textLen;
+    if (searchIsCircular) {
+        textLen += getCircularOverlap(seq, range, (range.length > maxRegExpResult) ? maxRegExpResult - 1 : range.length);
+        // a result is reported once even if the circular overlap contains it again
+        startLimit = (0 == range.startPos) ? seqLen : textLen;
+    }
+    CHECK(textLen > 0, );
+    const QByteArray complMap = (NULL == complTT) ? QByteArray() : complTT->getOne2OneMapper();
 
     for ( int ci = conStart; ci < conEnd && !stopFlag; ++ci ) {
-        QString substr;
-        QByteArray tmp( range.length + 1, 0 );
-        char *complSeq = NULL;
-        U2Strand resultStrand;
-
         if ( ci == 1 ) { // complementary
-            complSeq = tmp.data( );
-            TextUtils::translate( complTT->getOne2OneMapper( ), seq + range.startPos,
-                                  qMin(range.length, seqLen - range.startPos),
-                                  complSeq );
-            TextUtils::reverse( complSeq, qMin(range.length, seqLen - range.startPos) );
-            substr = QString( QByteArray( complSeq, qMin(range.length, seqLen - range.startPos) ) );
-            if (searchIsCircular) {
-                int bufferSize = getCircularOverlap(seq, range,
-                                                 (range.length > maxRegExpResult) ? maxRegExpResult - 1 : range.length);
-                QByteArray buffer( bufferSize, 0);
-                char *complBuffer = buffer.data();
-                TextUtils::translate( complTT->getOne2OneMapper( ), seq, bufferSize, complBuffer);
-                TextUtils::reverse( complBuffer, bufferSize);
-                substr.prepend(buffer);
-            }
-
-            resultStrand = U2Strand::Complementary;
+            ComplementRegExpText text(seq, seqLen, range.startPos, textLen, complMap.constData());
+            regExpSearch(regExp, text, textLen, startLimit, maxRegExpResult, U2Strand::Complementary,
+                         ci - conStart, conEnd - conStart, percentsCompleted, stopFlag, rl);
         } else { // direct
-            substr = QString( QByteArray( seq + range.startPos,
-                                          qMin(range.length, seqLen - range.startPos ) ));
-            if (searchIsCircular) {
-                int bufferSize = getCircularOverlap(seq, range,
-                                                 (range.length > maxRegExpResult) ? maxRegExpResult - 1 : range.length);
-                substr += QString( QByteArray( seq, bufferSize));
-            }
-            resultStrand = U2Strand::Direct;
-        }
-
-        if (searchIsCircular) {
-            U2Region cirRange = range;
-            if (range.length == seqLen && range.startPos == 0) {
-                cirRange.length += (range.length > maxRegExpResult) ? maxRegExpResult - 1 : range.length;
-            }
-            regExpSearch( substr, regExp, resultStrand, cirRange, maxRegExpResult, ci, 0, conEnd, false, 0,
-                percentsCompleted, stopFlag, rl, seqLen);
-        } else {
-            regExpSearch( substr, regExp, resultStrand, range, maxRegExpResult, ci, 0, conEnd, false, 0,
-                          percentsCompleted, stopFlag, rl );
+            DirectRegExpText text(seq, seqLen, range.startPos);
+            regExpSearch(regExp, text, textLen, startLimit, maxRegExpResult, U2Strand::Direct,
+                         ci - conStart, conEnd - conStart, percentsCompleted, stopFlag, rl);
         }
     }
 }
@@ -847,7 +1019,7 @@ void FindAlgorithm::find(
     int width =  patternLen + maxErr;
     int height = patternLen;
 
-    if ( width > INT_MAX / height ) {
+    if ( !insDel && width > INT_MAX / height ) {
         const FindAlgorithmResult result(FindAlgorithmResult::NOT_ENOUGH_MEMORY_ERROR);
         rl->onResult( result );
         return;
@@ -855,8 +1027,8 @@ void FindAlgorithm::find(
 
     try {
         StrandContext context[] = {
-            StrandContext(width, height, insDel, pattern),
-            StrandContext(width, height, insDel, complPattern)
+            StrandContext(width, height, insDel, pattern, useAmbiguousBases),
+            StrandContext(width, height, insDel, complPattern, useAmbiguousBases)
         };
 
         int onePercentLen = range.length/100;
@@ -872,16 +1044,9 @@ void FindAlgorithm::find(
         for (int i=range.startPos; i < end && !stopFlag; i++, leftTillPercent--) {
             for (int ci = conStart; ci < conEnd && !stopFlag; ci++) {
                 StrandContext& ctx = context[ci];
-                DynTable& dt = ctx.dynTable;
-                const char* p = ctx.pattern;
                 FindAlgorithmResult& res = ctx.res;
 
-                for (int j=0; j<patternLen && !stopFlag; j++) {
-                    bool matched = seq[ cycleIndex( seqLen, i) ] == p[j];
-                    dt.match(j, matched);
-                }
-
-                int err = dt.getLast();
+                int err = ctx.match(seq[ cycleIndex( seqLen, i) ], patternLen);
 
                 if (!res.isEmpty() && (err > maxErr || (i-res.region.startPos) >= patternLen)) {
                     rl->onResult(res);
@@ -889,7 +1054,7 @@ void FindAlgorithm::find(
                 }
 
                 if (err <= maxErr) {
-                    int newLen = dt.getLastLen();
+                    int newLen = ctx.getLastLen();
                     if (res.isEmpty() || res.err > err || (res.err == err && newLen < res.region.length)) {
                         int newStart = i-newLen+1;
                         bool boundaryCheck = (range.contains(newStart) && range.contains(newStart + newLen - 1));
@@ -908,7 +1073,7 @@ void FindAlgorithm::find(
                     }
                 }
 
-                dt.shiftColumn();
+                ctx.shiftColumn();
                 if (leftTillPercent == 0) {
                     percentsCompleted = qMin(percentsCompleted+1,100);
                     leftTillPercent = onePercentLen;
@@ -940,9 +1105,9 @@ int FindAlgorithm::estimateRamUsageInMbytes(const FindAlgorithmPatternSettings p
 
     if(FindAlgorithmPatternSettings_InsDel == patternSettings) {
         ramUsage = 2 * StrandContext::estimateRamUsageForOneContext(patternLength + maxError,
-                                                                        patternLength);
+                                                                        patternLength, true);
         if(searchInAminoTT) {
-            ramUsage *= 4;
+            ramUsage *= 3;
         }
     } else if(FindAlgorithmPatternSettings_Subst == patternSettings && searchInAminoTT)
         ramUsage = 7 * patternLength * sizeof(char);
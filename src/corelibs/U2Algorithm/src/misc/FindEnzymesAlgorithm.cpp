@@ -0,0 +1,136 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include <U2Core/U2AlphabetUtils.h>
+
+#include "FindEnzymesAlgorithm.h"
+
+namespace U2 {
+
+FindMultipleEnzymesAlgorithm::FindMultipleEnzymesAlgorithm(const QList<SEnzymeData>& enzymes, const DNAAlphabet* _seqAlphabet)
+    : seqAlphabet(_seqAlphabet), maxSiteLength(0)
+{
+    SAFE_POINT(seqAlphabet != NULL, "No sequence alphabet", );
+    foreach (const SEnzymeData& enzyme, enzymes) {
+        // the enzymes with empty sites or non-nucleic alphabets are filtered by the caller
+        CHECK_CONTINUE(!enzyme->seq.isEmpty() && enzyme->alphabet != NULL && enzyme->alphabet->isNucleic());
+        if (enzyme->seq.length() > MAX_SITE_LENGTH) {
+            unsupportedEnzymes << enzyme;
+            continue;
+        }
+        if (useExtendedComparator(enzyme->alphabet, seqAlphabet)) {
+            addEnzyme<ExtendedDNAlphabetComparator>(enzyme);
+        } else {
+            addEnzyme<ExactDNAAlphabetComparatorN1M_N2M>(enzyme);
+        }
+        maxSiteLength = qMax(maxSiteLength, enzyme->seq.length());
+    }
+
+    // the masks were collected word by word, store the masks of all words for a symbol together
+    const int nWords = startMasks.size();
+    QVector<quint64> wordTables = symbolTable;
+    for (int w = 0; w < nWords; w++) {
+        for (int c = 0; c < 256; c++) {
+            symbolTable[c * nWords + w] = wordTables[w * 256 + c];
+        }
+    }
+}
+
+bool FindMultipleEnzymesAlgorithm::useExtendedComparator(const DNAAlphabet* enzymeAlphabet, const DNAAlphabet* seqAlphabet) {
+    return enzymeAlphabet->getId() == BaseDNAAlphabetIds::NUCL_DNA_EXTENDED()
+        || seqAlphabet->getId() == BaseDNAAlphabetIds::NUCL_DNA_EXTENDED()
+        || seqAlphabet->getId() == BaseDNAAlphabetIds::NUCL_RNA_DEFAULT()
+        || seqAlphabet->getId() == BaseDNAAlphabetIds::NUCL_RNA_EXTENDED();
+}
+
+void FindMultipleEnzymesAlgorithm::addPattern(const SEnzymeData& enzyme, const U2Strand& strand, int length, const QVector<quint64>& symbolMasks) {
+    SAFE_POINT(length > 0 && length <= MAX_SITE_LENGTH, "Unexpected site length", );
+
+    // a pattern never crosses a word boundary, so the words are shifted independently
+    int usedBits = wordPatterns.isEmpty() ? 64 : patterns[wordPatterns.last().last()].endBit + 1;
+    if (usedBits + length > 64) {
+        wordPatterns.append(QVector<int>());
+        startMasks.append(0);
+        endMasks.append(0);
+        symbolTable.resize(symbolTable.size() + 256);
+        usedBits = 0;
+    }
+
+    SitePattern pattern;
+    pattern.enzyme = enzyme;
+    pattern.strand = strand;
+    pattern.length = length;
+    pattern.word = wordPatterns.size() - 1;
+    pattern.endBit = usedBits + length - 1;
+
+    startMasks.last() |= quint64(1) << usedBits;
+    endMasks.last() |= quint64(1) << pattern.endBit;
+    wordPatterns.last().append(patterns.size());
+    patterns.append(pattern);
+
+    quint64* wordTable = symbolTable.data() + pattern.word * 256;
+    for (int c = 0; c < 256; c++) {
+        wordTable[c] |= symbolMasks[c] << usedBits;
+    }
+}
+
+void FindMultipleEnzymesAlgorithm::run(const char* seq, int seqLen, int reportLimit, FindEnzymesAlgListener* l, TaskStateInfo& ti, int resultPosShift) const {
+    CHECK(!patterns.isEmpty(), );
+    const int nWords = startMasks.size();
+    const quint64* starts = startMasks.constData();
+    const quint64* ends = endMasks.constData();
+    const quint64* table = symbolTable.constData();
+
+    // the bit of a pattern symbol is set if the pattern prefix ending with the symbol matches the sequence
+    QVector<quint64> stateData(nWords, 0);
+    quint64* state = stateData.data();
+    for (int i = 0; i < seqLen && !ti.cancelFlag; i++) {
+        const quint64* masks = table + uchar(seq[i]) * nWords;
+        quint64 hits = 0;
+        for (int w = 0; w < nWords; w++) {
+            state[w] = ((state[w] << 1) | starts[w]) & masks[w];
+            hits |= state[w] & ends[w];
+        }
+        if (hits != 0) {
+            reportHits(state, i, reportLimit, l, resultPosShift);
+        }
+    }
+}
+
+void FindMultipleEnzymesAlgorithm::reportHits(const quint64* state, int pos, int reportLimit, FindEnzymesAlgListener* l, int resultPosShift) const {
+    for (int w = 0, nWords = wordPatterns.size(); w < nWords; w++) {
+        if ((state[w] & endMasks[w]) == 0) {
+            continue;
+        }
+        foreach (int patternIdx, wordPatterns[w]) {
+            const SitePattern& pattern = patterns[patternIdx];
+            if ((state[w] & (quint64(1) << pattern.endBit)) == 0) {
+                continue;
+            }
+            int startPos = pos - pattern.length + 1;
+            if (startPos < reportLimit) {
+                l->onResult(resultPosShift + startPos, pattern.enzyme, pattern.strand);
+            }
+        }
+    }
+}
+
+} // namespace U2
@@ -36,6 +36,7 @@
 
 #include <QObject>
 #include <QList>
+#include <QVector>
 
 namespace U2 {
 
@@ -46,6 +47,102 @@ public:
 };
 
 
+/**
+ * Finds sites of all given enzymes on both strands in a single pass over a sequence.
+ * Site patterns are matched with the bit-parallel Shift-And algorithm: the patterns are packed
+ * into 64-bit words, and every sequence symbol updates the states of all patterns
+ * with one table lookup per word. IUPAC codes are resolved when the per-symbol masks are built.
+ */
+class U2ALGORITHM_EXPORT FindMultipleEnzymesAlgorithm {
+public:
+    FindMultipleEnzymesAlgorithm(const QList<SEnzymeData>& enzymes, const DNAAlphabet* seqAlphabet);
+
+    // enzymes with sites longer than MAX_SITE_LENGTH, they must be searched with FindEnzymesAlgorithm
+    const QList<SEnzymeData>& getUnsupportedEnzymes() const {return unsupportedEnzymes;}
+
+    bool isEmpty() const {return patterns.isEmpty();}
+
+    int getMaxSiteLength() const {return maxSiteLength;}
+
+    // reports the sites that are found in the seq[0, seqLen) and start before the reportLimit
+    void run(const char* seq, int seqLen, int reportLimit, FindEnzymesAlgListener* l, TaskStateInfo& ti, int resultPosShift = 0) const;
+
+    static bool useExtendedComparator(const DNAAlphabet* enzymeAlphabet, const DNAAlphabet* seqAlphabet);
+
+    static const int MAX_SITE_LENGTH = 64;
+
+private:
+    struct SitePattern {
+        SitePattern() : length(0), word(0), endBit(0) {}
+        SEnzymeData     enzyme;
+        U2Strand        strand;
+        int             length;
+        int             word;
+        int             endBit;
+    };
+
+    template <typename CompareFN>
+    void addEnzyme(const SEnzymeData& enzyme);
+    // symbolMasks[c] has the bit i set if the symbol c matches the i-th symbol of the pattern
+    void addPattern(const SEnzymeData& enzyme, const U2Strand& strand, int length, const QVector<quint64>& symbolMasks);
+    void reportHits(const quint64* state, int pos, int reportLimit, FindEnzymesAlgListener* l, int resultPosShift) const;
+
+    const DNAAlphabet*      seqAlphabet;
+    QList<SEnzymeData>      unsupportedEnzymes;
+    QVector<SitePattern>    patterns;
+    // patterns indexes grouped by the word the pattern is packed to
+    QVector<QVector<int> >  wordPatterns;
+    QVector<quint64>        startMasks;
+    QVector<quint64>        endMasks;
+    // 256 symbols x words, the masks of all words for a symbol are stored together
+    // (while the patterns are being added the table is stored word by word)
+    QVector<quint64>        symbolTable;
+    int                     maxSiteLength;
+};
+
+template <typename CompareFN>
+void FindMultipleEnzymesAlgorithm::addEnzyme(const SEnzymeData& enzyme) {
+    CompareFN fn(seqAlphabet, enzyme->alphabet);
+    const int plen = enzyme->seq.length();
+
+    // the symbols of the sequence alphabet are compared with the comparator,
+    // the other symbols can match only themselves, the unknown symbol never matches
+    QByteArray symbols = seqAlphabet->getAlphabetChars();
+    char unknownChar = seqAlphabet->getDefaultSymbol();
+
+    QList<QByteArray> strandPatterns;
+    QList<U2Strand> strands;
+    strandPatterns << enzyme->seq;
+    strands << U2Strand::Direct;
+
+    DNATranslation* tt = AppContext::getDNATranslationRegistry()->lookupComplementTranslation(enzyme->alphabet);
+    if (tt != NULL) {
+        QByteArray revCompl = enzyme->seq;
+        tt->translate(revCompl.data(), revCompl.size());
+        TextUtils::reverse(revCompl.data(), revCompl.size());
+        if (revCompl != enzyme->seq) {
+            strandPatterns << revCompl;
+            strands << U2Strand::Complementary;
+        }
+    }
+
+    for (int i = 0; i < strandPatterns.size(); i++) {
+        const QByteArray& pattern = strandPatterns[i];
+        QVector<quint64> symbolMasks(256, 0);
+        for (int p = 0; p < plen; p++) {
+            const quint64 bit = quint64(1) << p;
+            symbolMasks[uchar(pattern[p])] |= bit;
+            foreach (char c, symbols) {
+                if (c != pattern[p] && fn.equals(pattern[p], c)) {
+                    symbolMasks[uchar(c)] |= bit;
+                }
+            }
+        }
+        symbolMasks[uchar(unknownChar)] = 0;
+        addPattern(enzyme, strands[i], plen, symbolMasks);
+    }
+}
+
 template <typename CompareFN>
 class FindEnzymesAlgorithm {
 public:
@@ -0,0 +1,265 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include <algorithm>
+
+#include <QObject>
+
+#include <U2Core/DNATranslation.h>
+#include <U2Core/Log.h>
+#include <U2Core/TextUtils.h>
+#include <U2Core/U2OpStatus.h>
+#include <U2Core/U2SafePoints.h>
+
+#include "PrimerSeedIndex.h"
+
+namespace U2 {
+
+const qint64 PrimerSeedIndex::MAX_SEQUENCE_LENGTH = 128 * 1024 * 1024;
+const int PrimerSeedIndex::MIN_SEED_LENGTH = 6;
+const int PrimerSeedIndex::MAX_SEED_LENGTH = 11;
+const int PrimerSeedIndex::MAX_SEED_VARIANTS = 256;
+
+namespace {
+
+const char BASES[] = "ACGT";
+const char AMBIGUOUS_CODE = 4;
+const char MISMATCH_CODE = 5;
+
+/* The code of a character as FindAlgorithm::cmpAmbiguous treats it: the base index if the character matches
+   the only base, AMBIGUOUS_CODE if it matches several bases and MISMATCH_CODE if it matches nothing */
+char getCode(uchar c) {
+    CHECK(c < 128, MISMATCH_CODE);
+    char code = MISMATCH_CODE;
+    for (int i = 0; i < 4; i++) {
+        if (FindAlgorithm::cmpAmbiguous(char(c), BASES[i])) {
+            CHECK(code == MISMATCH_CODE, AMBIGUOUS_CODE);
+            code = char(i);
+        }
+    }
+    return code;
+}
+
+}
+
+PrimerSeedIndex::PrimerSeedIndex(const QByteArray &_sequence, bool isCircular, int maxPatternLength, int seedLength)
+: prepared(false), indexed(false), memoryLocker(0), sequence(_sequence), sequenceLength(_sequence.length()), circular(isCircular), seedLength(seedLength)
+{
+    if (circular) {
+        sequence += _sequence.left(maxPatternLength - 1);
+    }
+}
+
+void PrimerSeedIndex::prepare(U2OpStatus &os) {
+    QMutexLocker locker(&lock);
+    CHECK(!prepared, );
+    SAFE_POINT_EXT(seedLength >= MIN_SEED_LENGTH && seedLength <= MAX_SEED_LENGTH, os.setError("Invalid seed length"), );
+
+    const qint64 bucketsBytes = ((qint64(1) << (2 * seedLength)) + 1) * qint64(sizeof(int));
+    if (!memoryLocker.tryAcquire(bucketsBytes)) {
+        dropIndex();
+        prepared = true;
+        return;
+    }
+
+    char codes[256];
+    for (int c = 0; c < 256; c++) {
+        codes[c] = getCode(uchar(c));
+    }
+
+    const char *seq = sequence.constData();
+    const int len = sequence.length();
+    const quint32 mask = (1u << (2 * seedLength)) - 1;
+    bucketStarts.fill(0, (1 << (2 * seedLength)) + 1);
+
+    // the first pass counts k-mers, the second one places their positions
+    for (int pass = 0; pass < 2; pass++) {
+        quint32 kmer = 0;
+        int validLength = 0;
+        for (int i = 0; i < len; i++) {
+            char code = codes[uchar(seq[i])];
+            if (code >= AMBIGUOUS_CODE) {
+                if (pass == 0 && code == AMBIGUOUS_CODE) {
+                    ambiguousPositions << i;
+                }
+                validLength = 0;
+                continue;
+            }
+            kmer = ((kmer << 2) | quint32(code)) & mask;
+            if (++validLength < seedLength) {
+                continue;
+            }
+            if (pass == 0) {
+                bucketStarts[kmer + 1]++;
+            } else {
+                positions[bucketStarts[kmer]++] = i - seedLength + 1;
+            }
+        }
+        if (pass == 0) {
+            for (int i = 1; i < bucketStarts.size(); i++) {
+                bucketStarts[i] += bucketStarts[i - 1];
+            }
+            CHECK_EXT(!os.isCoR(), dropIndex(), );
+            if (!memoryLocker.tryAcquire((qint64(bucketStarts.last()) + ambiguousPositions.size()) * qint64(sizeof(int)))) {
+                dropIndex();
+                prepared = true;
+                return;
+            }
+            positions.resize(bucketStarts.last());
+        } else {
+            // the buckets are filled, so every start is shifted to the start of the next bucket
+            for (int i = bucketStarts.size() - 1; i > 0; i--) {
+                bucketStarts[i] = bucketStarts[i - 1];
+            }
+            bucketStarts[0] = 0;
+        }
+    }
+    indexed = true;
+    prepared = true;
+}
+
+void PrimerSeedIndex::dropIndex() {
+    if (memoryLocker.hasError()) {
+        algoLog.details(QObject::tr("Not enough memory for the primer index, the whole sequence is scanned"));
+    }
+    bucketStarts = QVector<int>();
+    positions = QVector<int>();
+    ambiguousPositions = QVector<int>();
+    memoryLocker.release();
+    indexed = false;
+}
+
+const QByteArray & PrimerSeedIndex::getSequence() const {
+    return sequence;
+}
+
+bool PrimerSeedIndex::isCircular() const {
+    return circular;
+}
+
+int PrimerSeedIndex::getSeedLength(int patternLength, int maxErr) {
+    int result = qMin(patternLength / (maxErr + 1), MAX_SEED_LENGTH);
+    return result >= MIN_SEED_LENGTH ? result : 0;
+}
+
+QList<FindAlgorithmResult> PrimerSeedIndex::find(const QByteArray &pattern, int maxErr, DNATranslation *complTT, U2OpStatus &os) const {
+    QList<FindAlgorithmResult> result;
+    SAFE_POINT_EXT(prepared, os.setError("The primer index is not prepared"), result);
+    SAFE_POINT_EXT(NULL != complTT && complTT->isOne2One(), os.setError("Invalid translation supplied!"), result);
+    SAFE_POINT_EXT(pattern.length() > maxErr, os.setError("Invalid maximum error count supplied!"), result);
+    SAFE_POINT_EXT(!circular || pattern.length() <= sequence.length() - sequenceLength + 1, os.setError("The pattern is longer than the indexed circular overlap"), result);
+    CHECK(sequenceLength >= pattern.length(), result);
+
+    QByteArray complPattern(pattern.length(), 0);
+    TextUtils::translate(complTT->getOne2OneMapper(), pattern.constData(), pattern.length(), complPattern.data());
+    TextUtils::reverse(complPattern.data(), complPattern.length());
+
+    QList<FindAlgorithmResult> direct;
+    QList<FindAlgorithmResult> complement;
+    findInStrand(pattern.constData(), pattern.length(), maxErr, U2Strand::Direct, direct);
+    findInStrand(complPattern.constData(), complPattern.length(), maxErr, U2Strand::Complementary, complement);
+
+    // FindAlgorithm reports the direct strand site first if both strands have a site at the same position
+    int d = 0;
+    int c = 0;
+    while (d < direct.size() || c < complement.size()) {
+        if (c == complement.size() || (d < direct.size() && direct[d].region.startPos <= complement[c].region.startPos)) {
+            result << direct[d++];
+        } else {
+            result << complement[c++];
+        }
+    }
+    return result;
+}
+
+void PrimerSeedIndex::findInStrand(const char *pattern, int patternLength, int maxErr, U2Strand strand, QList<FindAlgorithmResult> &results) const {
+    // circular sites start at any position of the sequence and continue at its beginning
+    const int lastStart = circular ? sequenceLength - 1 : sequenceLength - patternLength;
+    QVector<int> candidates;
+
+    bool seedsApplicable = indexed && seedLength * (maxErr + 1) <= patternLength;
+    for (int i = 0; i <= maxErr && seedsApplicable; i++) {
+        seedsApplicable = addSeedCandidates(pattern + i * seedLength, i * seedLength, lastStart, candidates);
+    }
+    if (seedsApplicable) {
+        addAmbiguousCandidates(patternLength, lastStart, candidates);
+        std::sort(candidates.begin(), candidates.end());
+        candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+    } else {
+        candidates.resize(lastStart + 1);
+        for (int i = 0; i <= lastStart; i++) {
+            candidates[i] = i;
+        }
+    }
+
+    const char *seq = sequence.constData();
+    foreach (int start, candidates) {
+        int err = 0;
+        for (int j = 0; j < patternLength && err <= maxErr; j++) {
+            if (!FindAlgorithm::cmpAmbiguous(seq[start + j], pattern[j])) {
+                err++;
+            }
+        }
+        CHECK_CONTINUE(err <= maxErr);
+        results << FindAlgorithmResult(U2Region(start, patternLength), false, strand, err);
+    }
+}
+
+bool PrimerSeedIndex::addSeedCandidates(const char *seed, int offset, int lastStart, QVector<int> &candidates) const {
+    // an ambiguous primer base is expanded to all the bases it matches
+    QVector<quint32> kmers(1, 0);
+    for (int i = 0; i < seedLength; i++) {
+        QVector<quint32> extended;
+        for (int b = 0; b < 4; b++) {
+            CHECK_CONTINUE(FindAlgorithm::cmpAmbiguous(seed[i], BASES[b]));
+            foreach (quint32 kmer, kmers) {
+                extended << ((kmer << 2) | quint32(b));
+            }
+        }
+        CHECK(extended.size() <= MAX_SEED_VARIANTS, false);
+        kmers = extended;
+    }
+
+    foreach (quint32 kmer, kmers) {
+        for (int i = bucketStarts[kmer], n = bucketStarts[kmer + 1]; i < n; i++) {
+            int start = positions[i] - offset;
+            if (start >= 0 && start <= lastStart) {
+                candidates << start;
+            }
+        }
+    }
+    return true;
+}
+
+void PrimerSeedIndex::addAmbiguousCandidates(int patternLength, int lastStart, QVector<int> &candidates) const {
+    // ambiguous sequence characters are not indexed, so every site that covers them is verified
+    int nextStart = 0;
+    foreach (int pos, ambiguousPositions) {
+        int first = qMax(pos - patternLength + 1, nextStart);
+        int last = qMin(pos, lastStart);
+        for (int start = first; start <= last; start++) {
+            candidates << start;
+        }
+        nextStart = qMax(nextStart, last + 1);
+    }
+}
+
+} // U2
@@ -0,0 +1,89 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef _U2_PRIMER_SEED_INDEX_H_
+#define _U2_PRIMER_SEED_INDEX_H_
+
+#include <QMutex>
+#include <QVector>
+
+#include <U2Algorithm/FindAlgorithm.h>
+
+#include <U2Core/AppResources.h>
+
+namespace U2 {
+
+class DNATranslation;
+class U2OpStatus;
+
+/**
+ * K-mer index of a sequence that is searched for many primers.
+ * A site with at most N substitutions contains an exact match of one of N + 1 disjoint primer parts,
+ * so only the positions of these parts are verified. The found sites are the same as the ones of
+ * FindAlgorithm with substitutions and ambiguous bases, and they are reported in the same order.
+ * The index memory is reserved in the application memory resource: if it can not be reserved,
+ * all positions of the sequence are verified.
+ */
+class U2ALGORITHM_EXPORT PrimerSeedIndex {
+public:
+    PrimerSeedIndex(const QByteArray &sequence, bool isCircular, int maxPatternLength, int seedLength);
+
+    // builds the index on the first call, can be called from several threads.
+    // The index stays not prepared if the operation is canceled
+    void prepare(U2OpStatus &os);
+
+    const QByteArray & getSequence() const;
+    bool isCircular() const;
+
+    // finds the sites of the pattern on both strands, the index must be prepared
+    QList<FindAlgorithmResult> find(const QByteArray &pattern, int maxErr, DNATranslation *complTT, U2OpStatus &os) const;
+
+    // the longest seed that is applicable for the pattern, 0 if the pattern can not be searched with a seed index
+    static int getSeedLength(int patternLength, int maxErr);
+
+    static const qint64 MAX_SEQUENCE_LENGTH;
+
+private:
+    void findInStrand(const char *pattern, int patternLength, int maxErr, U2Strand strand, QList<FindAlgorithmResult> &results) const;
+    bool addSeedCandidates(const char *seed, int offset, int lastStart, QVector<int> &candidates) const;
+    void addAmbiguousCandidates(int patternLength, int lastStart, QVector<int> &candidates) const;
+    void dropIndex();
+
+    static const int MIN_SEED_LENGTH;
+    static const int MAX_SEED_LENGTH;
+    static const int MAX_SEED_VARIANTS;
+
+    QMutex          lock;
+    bool            prepared;
+    bool            indexed;            // false if there is no memory for the index
+    MemoryLocker    memoryLocker;
+    QByteArray      sequence;           // the sequence with its beginning appended if it is circular
+    int             sequenceLength;
+    bool            circular;
+    int             seedLength;
+    QVector<int>    bucketStarts;       // positions of the k-mer 'i' are positions[bucketStarts[i]..bucketStarts[i + 1])
+    QVector<int>    positions;
+    QVector<int>    ambiguousPositions; // positions of the sequence characters that match several bases
+};
+
+} // U2
+
+#endif // _U2_PRIMER_SEED_INDEX_H_
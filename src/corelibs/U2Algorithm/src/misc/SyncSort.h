@@ -22,6 +22,10 @@
 #ifndef _U2_SYNC_SORT_H_
 #define _U2_SYNC_SORT_H_
 
+#include <QRunnable>
+#include <QThreadPool>
+#include <QVector>
+
 #include <U2Core/global.h>
 
 namespace U2 {
@@ -32,8 +36,29 @@ public:
     SyncSort(QVector<T> &arr, QVector<S> &ind);
     SyncSort(T *arr, S *ind, int first, int length);
     void sort();
+    // gives the same result as sort(): the ranges left after a partition are sorted by different threads
+    void sort(int threadCount);
 private:
+    class SortRangeRunnable : public QRunnable {
+    public:
+        SortRangeRunnable(SyncSort *sorter, QThreadPool *threadPool, int off, int len)
+            : sorter(sorter), threadPool(threadPool), off(off), len(len) {}
+
+        void run() {
+            sorter->sortParallel(threadPool, off, len);
+        }
+
+    private:
+        SyncSort *sorter;
+        QThreadPool *threadPool;
+        int off;
+        int len;
+    };
+
     void sort(T *x, int off, int len);
+    void sortParallel(QThreadPool *threadPool, int off, int len);
+    // returns false if the range is sorted by the insertion sort, otherwise the ranges to be sorted are returned
+    bool partition(T *x, int off, int len, int &leftLen, int &rightOff, int &rightLen);
     qint64 compare(const T *x1, const T *x2) const;
     void swap(T *x1, T *x2) const;
     quint32 med3(T *x, quint32 a, quint32 b, quint32 c);
@@ -42,10 +67,50 @@ private:
     int len;
     T* start;
     S* indexes;
+
+    // smaller ranges are not worth passing to another thread
+    static const int MIN_PARALLEL_RANGE = 65536;
 };
 
 template<class T, class S>
 void SyncSort<T,S>::sort(T *x, int off, int len) {
+    int leftLen = 0;
+    int rightOff = 0;
+    int rightLen = 0;
+    if (!partition(x, off, len, leftLen, rightOff, rightLen)) {
+        return;
+    }
+
+    // Recursively sort non-partition-elements
+    if (leftLen > 1) {
+        sort(x, off, leftLen);
+    }
+    if (rightLen > 1) {
+        sort(x, rightOff, rightLen);
+    }
+}
+
+template<class T, class S>
+void SyncSort<T,S>::sortParallel(QThreadPool *threadPool, int off, int len) {
+    while (len >= MIN_PARALLEL_RANGE) {
+        int leftLen = 0;
+        int rightOff = 0;
+        int rightLen = 0;
+        if (!partition(start, off, len, leftLen, rightOff, rightLen)) {
+            return;
+        }
+        if (rightLen > 1) {
+            threadPool->start(new SortRangeRunnable(this, threadPool, rightOff, rightLen));
+        }
+        len = leftLen;
+    }
+    if (len > 1) {
+        sort(start, off, len);
+    }
+}
+
+template<class T, class S>
+bool SyncSort<T,S>::partition(T *x, int off, int len, int &leftLen, int &rightOff, int &rightLen) {
     // Insertion sort on smallest arrays
     if (len < 7) {
         for (int i=off; i<len+off; i++){
@@ -53,7 +118,7 @@ void SyncSort<T,S>::sort(T *x, int off, int len) {
                 swap(x+j, x+j-1);
             }
         }
-        return;
+        return false;
     }
 
     // Choose a partition element, v
@@ -100,13 +165,10 @@ void SyncSort<T,S>::sort(T *x, int off, int len) {
     s = qMin(a-off, b-a  ); vecswap(x+off, x+b-s, s);
     s = qMin(d-c,   n-d-1); vecswap(x+b,   x+n-s, s);
 
-    // Recursively sort non-partition-elements
-    if ((s = b-a) > 1) {
-        sort(x, off, s);
-    }
-    if ((s = d-c) > 1) {
-        sort(x, n-s, s);
-    }
+    leftLen = b-a;
+    rightLen = d-c;
+    rightOff = n-rightLen;
+    return true;
 }
 
 template<class T, class S>
@@ -161,6 +223,21 @@ void SyncSort<T,S>::sort() {
     sort(start, 0, len);
 }
 
+template<class T, class S>
+void SyncSort<T,S>::sort(int threadCount) {
+    if (len <= 0 || !start || !indexes) {
+        return;
+    }
+    if (threadCount < 2 || len < MIN_PARALLEL_RANGE) {
+        sort(start, 0, len);
+        return;
+    }
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(threadCount);
+    sortParallel(&threadPool, 0, len);
+    threadPool.waitForDone();
+}
+
 
 
 } //namespace
@@ -23,6 +23,7 @@
 #include "MSAConsensusUtils.h"
 
 #include <U2Core/DNAAlphabet.h>
+#include <U2Core/MaColumnSnapshot.h>
 #include <U2Core/MultipleSequenceAlignment.h>
 #include <U2Core/U2OpStatusUtils.h>
 
@@ -52,6 +53,8 @@ ConsensusAlgorithmFlags MSAConsensusAlgorithmFactory::getAphabetFlags(const DNAA
 // Algorithm
 
 char MSAConsensusAlgorithm::INVALID_CONS_CHAR = '\0';
+const int MSAConsensusAlgorithm::SNAPSHOT_CHUNK_SIZE = 4 * 1024 * 1024;
+
 MSAConsensusAlgorithm::MSAConsensusAlgorithm(MSAConsensusAlgorithmFactory* _factory, bool ignoreTrailingLeadingGaps, QObject* p)
     : QObject(p), factory(_factory),
       threshold(0),
@@ -61,17 +64,84 @@ MSAConsensusAlgorithm::MSAConsensusAlgorithm(MSAConsensusAlgorithmFactory* _fact
 
 char MSAConsensusAlgorithm::getConsensusCharAndScore(const MultipleAlignment& ma, int column, int& score,
                                                      QVector<int> seqIdx) const {
-    char consensusChar = getConsensusChar(ma, column, seqIdx);
+    score = 0;
+    CHECK(filterIdx(seqIdx, ma, column), INVALID_CONS_CHAR);
+
+    const QByteArray columnChars = getColumnChars(ma, column, seqIdx);
+    return getColumnConsensusCharAndScore(ma, columnChars.constData(), columnChars.size(), score);
+}
+
+char MSAConsensusAlgorithm::getConsensusChar(const MultipleAlignment& ma, int column, QVector<int> seqIdx) const {
+    CHECK(filterIdx(seqIdx, ma, column), INVALID_CONS_CHAR);
+
+    const QByteArray columnChars = getColumnChars(ma, column, seqIdx);
+    return getColumnConsensusChar(ma, columnChars.constData(), columnChars.size());
+}
+
+void MSAConsensusAlgorithm::getConsensusCharsAndScores(const MultipleAlignment& ma, const U2Region& region, QByteArray& chars,
+                                                       QVector<int>& scores, const QVector<int>& seqIdx) const {
+    chars.resize(int(region.length));
+    scores.resize(int(region.length));
+    const int nSeq = seqIdx.isEmpty() ? ma->getNumRows() : seqIdx.size();
+    if (nSeq == 0) {
+        chars.fill(INVALID_CONS_CHAR);
+        scores.fill(0);
+        return;
+    }
+
+    // the snapshot is built by chunks to limit the memory consumption for big alignments
+    const qint64 chunkLength = qMax(qint64(1), qint64(SNAPSHOT_CHUNK_SIZE / nSeq));
+    QByteArray filteredColumn;
+    for (qint64 chunkStart = region.startPos; chunkStart < region.endPos(); chunkStart += chunkLength) {
+        const U2Region chunk(chunkStart, qMin(chunkLength, region.endPos() - chunkStart));
+        const MaColumnSnapshot snapshot(ma, chunk, seqIdx, ignoreTrailingAndLeadingGaps);
+        for (qint64 column = chunk.startPos; column < chunk.endPos(); column++) {
+            const int resultIndex = int(column - region.startPos);
+            const char* columnChars = snapshot.getColumn(column);
+            int columnSize = nSeq;
+            if (ignoreTrailingAndLeadingGaps) {
+                filteredColumn.clear();
+                for (int i = 0; i < nSeq; i++) {
+                    if (columnChars[i] != MaColumnSnapshot::LEADING_OR_TRAILING_GAP_CHAR) {
+                        filteredColumn.append(columnChars[i]);
+                    }
+                }
+                if (filteredColumn.isEmpty()) {
+                    chars[resultIndex] = INVALID_CONS_CHAR;
+                    scores[resultIndex] = 0;
+                    continue;
+                }
+                columnChars = filteredColumn.constData();
+                columnSize = filteredColumn.size();
+            }
+            int score = 0;
+            chars[resultIndex] = getColumnConsensusCharAndScore(ma, columnChars, columnSize, score);
+            scores[resultIndex] = score;
+        }
+    }
+}
+
+char MSAConsensusAlgorithm::getColumnConsensusCharAndScore(const MultipleAlignment& ma, const char* column, int nSeq, int& score) const {
+    const char consensusChar = getColumnConsensusChar(ma, column, nSeq);
 
     //now compute score using most freq character
     int nonGaps = 0;
     QVector<int> freqsByChar(256);
-    uchar topChar = MSAConsensusUtils::getColumnFreqs(ma, column, freqsByChar, nonGaps, seqIdx);
+    const uchar topChar = MSAConsensusUtils::getColumnFreqs(column, nSeq, freqsByChar, nonGaps);
     score = freqsByChar[topChar];
 
     return consensusChar;
 }
 
+QByteArray MSAConsensusAlgorithm::getColumnChars(const MultipleAlignment& ma, int column, const QVector<int>& seqIdx) {
+    const int nSeq = seqIdx.isEmpty() ? ma->getNumRows() : seqIdx.size();
+    QByteArray columnChars(nSeq, U2Msa::GAP_CHAR);
+    for (int seq = 0; seq < nSeq; seq++) {
+        columnChars[seq] = ma->charAt(seqIdx.isEmpty() ? seq : seqIdx[seq], column);
+    }
+    return columnChars;
+}
+
 void MSAConsensusAlgorithm::setThreshold(int val) {
     int newThreshold = qBound(getMinThreshold(), val, getMaxThreshold());
     if (newThreshold == threshold) {
@@ -90,7 +90,15 @@ public:
     */
     virtual char getConsensusCharAndScore(const MultipleAlignment& ma, int column, int& score, QVector<int> seqIdx = QVector<int>()) const;
 
-    virtual char getConsensusChar(const MultipleAlignment& ma, int column, QVector<int> seqIdx = QVector<int>()) const = 0;
+    virtual char getConsensusChar(const MultipleAlignment& ma, int column, QVector<int> seqIdx = QVector<int>()) const;
+
+    /**
+        Computes consensus chars and scores for all columns of the region at once.
+        The alignment is copied to a column-major snapshot chunk by chunk, so the columns are processed without
+        per-character row lookups. The result is the same as calling getConsensusCharAndScore() for every column.
+    */
+    void getConsensusCharsAndScores(const MultipleAlignment& ma, const U2Region& region, QByteArray& chars, QVector<int>& scores,
+                                    const QVector<int>& seqIdx = QVector<int>()) const;
 
     virtual QString getDescription() const {return factory->getDescription();}
 
@@ -123,7 +131,18 @@ protected:
     // returns true if there are meaningful symbols on @pos, depending on @ignoreTrailingleadingGaps flag
     bool filterIdx(QVector<int> &seqIdx, const MultipleAlignment& ma, const int pos) const;
 
+    // returns the consensus char for the @nSeq characters of the column, the column contains only meaningful symbols
+    virtual char getColumnConsensusChar(const MultipleAlignment& ma, const char* column, int nSeq) const = 0;
+
+    // the default score is the frequency of the most frequent non-gap character
+    virtual char getColumnConsensusCharAndScore(const MultipleAlignment& ma, const char* column, int nSeq, int& score) const;
+
 private:
+    static QByteArray getColumnChars(const MultipleAlignment& ma, int column, const QVector<int>& seqIdx);
+
+    // max size of the column snapshot in getConsensusCharsAndScores(), in bytes
+    static const int SNAPSHOT_CHUNK_SIZE;
+
     MSAConsensusAlgorithmFactory* factory;
     int     threshold;
     bool    ignoreTrailingAndLeadingGaps;
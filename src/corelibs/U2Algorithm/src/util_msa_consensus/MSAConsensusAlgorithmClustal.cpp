@@ -42,19 +42,16 @@ MSAConsensusAlgorithm* MSAConsensusAlgorithmFactoryClustal::createAlgorithm(cons
 //////////////////////////////////////////////////////////////////////////
 //Algorithm
 
-char MSAConsensusAlgorithmClustal::getConsensusChar(const MultipleAlignment& ma, int pos, QVector<int> seqIdx) const {
-    CHECK(filterIdx(seqIdx, ma, pos), INVALID_CONS_CHAR);
-
+char MSAConsensusAlgorithmClustal::getColumnConsensusChar(const MultipleAlignment& ma, const char* column, int nSeq) const {
     if (!ma->getAlphabet()->isAmino()) {
         // for nucleic alphabet work as strict algorithm but use ' ' as default
         char  defChar = ' ';
-        char pc = ( seqIdx.isEmpty() ? ma->getRows().first() : ma->getRows()[ seqIdx[0] ] )->charAt(pos);
+        char pc = column[0];
         if (pc == U2Msa::GAP_CHAR) {
             pc = defChar;
         }
-        int nSeq =( seqIdx.isEmpty() ? ma->getNumRows() : seqIdx.size());
         for (int s = 1; s < nSeq; s++) {
-            char c = ma->getRow(seqIdx.isEmpty() ? s : seqIdx[s])->charAt(pos);
+            char c = column[s];
             if (c != pc) {
                 pc = defChar;
                 break;
@@ -76,9 +73,8 @@ char MSAConsensusAlgorithmClustal::getConsensusChar(const MultipleAlignment& ma,
         static int maxWeakGroupLen = 6;
 
         QByteArray currentGroup; //TODO: optimize 'currentGroup' related code!
-        int nSeq =( seqIdx.isEmpty() ? ma->getNumRows() : seqIdx.size());
         for (int s = 0; s < nSeq; s++) {
-            char c = ma->getRow(seqIdx.isEmpty() ? s : seqIdx[s])->charAt(pos);
+            char c = column[s];
             if (!currentGroup.contains(c)) {
                 currentGroup.append(c);
             }
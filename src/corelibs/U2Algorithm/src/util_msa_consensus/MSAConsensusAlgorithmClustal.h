@@ -54,7 +54,8 @@ public:
     MSAConsensusAlgorithmClustal(MSAConsensusAlgorithmFactoryClustal* f, bool ignoreTrailingLeadingGaps, QObject* p = NULL)
         : MSAConsensusAlgorithm(f, ignoreTrailingLeadingGaps, p) {}
 
-    virtual char getConsensusChar(const MultipleAlignment& ma, int column, QVector<int> seqIdx = QVector<int>()) const;
+protected:
+    virtual char getColumnConsensusChar(const MultipleAlignment& ma, const char* column, int nSeq) const;
 };
 
 }//namespace
@@ -21,6 +21,7 @@
 
 #include "MSAConsensusAlgorithmDefault.h"
 
+#include <U2Core/MaColumnSnapshot.h>
 #include <U2Core/MultipleSequenceAlignment.h>
 #include <QVector>
 
@@ -49,22 +50,16 @@ MSAConsensusAlgorithm* MSAConsensusAlgorithmFactoryDefault::createAlgorithm(cons
 //////////////////////////////////////////////////////////////////////////
 // Algorithm
 
-char MSAConsensusAlgorithmDefault::getConsensusCharAndScore(const MultipleAlignment& msa, int pos, int& cnt, QVector<int> seqIdx) const {
-    CHECK(filterIdx(seqIdx, msa, pos), INVALID_CONS_CHAR);
+char MSAConsensusAlgorithmDefault::getColumnConsensusCharAndScore(const MultipleAlignment&, const char* column, int nSeq, int& cnt) const {
+    int charFreqs[256] = {0};
+    MaColumnSnapshot::countChars(column, nSeq, charFreqs);
 
-    //TODO: use var-length array!
     QVector<QPair<int, char> > freqs(32);
     int ch = U2Msa::GAP_CHAR;
-    int nSeq = seqIdx.isEmpty() ? msa->getNumRows() : seqIdx.size();
-    for (int seq = 0; seq < nSeq; seq++) {
-        uchar c = (uchar)msa->charAt( seqIdx.isEmpty() ? seq : seqIdx[ seq ],
-                                     pos);
-        if (c >= 'A' && c <= 'Z') {
-            int idx = c - 'A';
-            assert(idx >=0 && idx <= freqs.size());
-            freqs[idx].first++;
-            freqs[idx].second = c;
-        }
+    for (int c = 'A'; c <= 'Z'; c++) {
+        int idx = c - 'A';
+        freqs[idx].first = charFreqs[c];
+        freqs[idx].second = charFreqs[c] == 0 ? 0 : c;
     }
     qSort(freqs);
     int p1 = freqs[freqs.size()-1].first;
@@ -57,12 +57,13 @@ public:
     MSAConsensusAlgorithmDefault(MSAConsensusAlgorithmFactoryDefault* f, bool ignoreTrailingLeadingGaps, QObject* p = NULL)
         : MSAConsensusAlgorithm(f, ignoreTrailingLeadingGaps, p) {}
 
-    virtual char getConsensusChar(const MultipleAlignment& ma, int column, QVector<int> seqIdx = QVector<int>()) const {
+protected:
+    virtual char getColumnConsensusChar(const MultipleAlignment& ma, const char* column, int nSeq) const {
         int countStub = 0;
-        return getConsensusCharAndScore(ma, column, countStub, seqIdx);
+        return getColumnConsensusCharAndScore(ma, column, nSeq, countStub);
     }
 
-    virtual char getConsensusCharAndScore(const MultipleAlignment& ma, int column, int& score, QVector<int> seqIdx = QVector<int>()) const;
+    virtual char getColumnConsensusCharAndScore(const MultipleAlignment& ma, const char* column, int nSeq, int& score) const;
 };
 
 }//namespace
@@ -126,25 +126,22 @@ MSAConsensusAlgorithmLevitsky::MSAConsensusAlgorithmLevitsky(MSAConsensusAlgorit
     int* freqsData = globalFreqs.data();
     int len = ma->getLength();
     foreach (const MultipleAlignmentRow& row, ma->getRows()) {
+        MsaRowColumnIterator columnIterator = row->getColumnIterator(0);
         for (int i = 0; i < len; i++) {
-            char c = row->charAt(i);
+            char c = columnIterator.next();
             registerHit(freqsData, c);
         }
     }
 }
 
-char MSAConsensusAlgorithmLevitsky::getConsensusChar(const MultipleAlignment& ma, int column, QVector<int> seqIdx) const {
-    CHECK(filterIdx(seqIdx, ma, column), INVALID_CONS_CHAR);
-
+char MSAConsensusAlgorithmLevitsky::getColumnConsensusChar(const MultipleAlignment& ma, const char* column, int nSeq) const {
     // count local freqs first
     QVarLengthArray<int> localFreqs(256);
     memset(localFreqs.data(), 0, localFreqs.size() * 4);
 
     int* freqsData = localFreqs.data();
-    int nSeq =( seqIdx.isEmpty() ? ma->getNumRows() : seqIdx.size());
     for (int seq = 0; seq < nSeq; seq++) {
-        char c = ma->charAt( seqIdx.isEmpty() ? seq : seqIdx [seq] , column);
-        registerHit(freqsData, c);
+        registerHit(freqsData, column[seq]);
     }
 
     //find all symbols with freq > threshold, select one with the lowest global freq
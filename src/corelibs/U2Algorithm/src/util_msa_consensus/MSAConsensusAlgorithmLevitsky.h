@@ -60,7 +60,8 @@ class U2ALGORITHM_EXPORT MSAConsensusAlgorithmLevitsky: public MSAConsensusAlgor
 public:
     MSAConsensusAlgorithmLevitsky(MSAConsensusAlgorithmFactoryLevitsky* f, const MultipleAlignment& ma, bool ignoreTrailingLeadingGaps, QObject* p = NULL);
 
-    virtual char getConsensusChar(const MultipleAlignment& ma, int column, QVector<int> seqIdx = QVector<int>()) const;
+protected:
+    virtual char getColumnConsensusChar(const MultipleAlignment& ma, const char* column, int nSeq) const;
 
 private:
     QVarLengthArray<int> globalFreqs;
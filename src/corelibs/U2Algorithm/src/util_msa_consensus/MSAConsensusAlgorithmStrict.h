@@ -56,7 +56,8 @@ public:
     MSAConsensusAlgorithmStrict(MSAConsensusAlgorithmFactoryStrict* f, bool ignoreTrailingLeadingGaps, QObject* p = NULL)
         : MSAConsensusAlgorithm(f, ignoreTrailingLeadingGaps, p) {}
 
-    virtual char getConsensusChar(const MultipleAlignment& ma, int column, QVector<int> seqIdx = QVector<int>()) const;
+protected:
+    virtual char getColumnConsensusChar(const MultipleAlignment& ma, const char* column, int nSeq) const;
 };
 
 
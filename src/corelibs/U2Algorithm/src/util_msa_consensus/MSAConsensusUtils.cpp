@@ -148,6 +148,27 @@ uchar MSAConsensusUtils::getColumnFreqs(const MultipleAlignment& ma, int pos, QV
     return maxC;
 }
 
+uchar MSAConsensusUtils::getColumnFreqs(const char* column, int nSeq, QVector<int>& freqsByChar, int& nonGapChars) {
+    assert(freqsByChar.size() == 256);
+    freqsByChar.fill(0);
+    nonGapChars = 0;
+    uchar maxC = 0;
+    int  maxCFreq = 0;
+    int* freqs = freqsByChar.data();
+    for (int seq = 0; seq < nSeq; seq++) {
+        uchar c = (uchar)column[seq];
+        freqs[c]++;
+        if (c!=U2Msa::GAP_CHAR && freqs[c] > maxCFreq) {
+            maxCFreq = freqs[c];
+            maxC = c;
+        }
+        if (c!=U2Msa::GAP_CHAR) {
+            nonGapChars++;
+        }
+    }
+    return maxC;
+}
+
 quint32 MSAConsensusUtils::packConsensusCharsToInt(const MultipleAlignment& ma, int pos, const int* mask4, bool gapsAffectPercents) {
     QVector<QPair<int, char> > freqs(32);
     int numNoGaps = 0;
@@ -60,6 +60,9 @@ public:
     static uchar getColumnFreqs(const MultipleAlignment& ma, int pos, QVector<int>& freqsByChar,
                                 int &nonGapChars, const QVector<int> &seqIdx = QVector<int>());
 
+    // the same as above for @nSeq characters of a column
+    static uchar getColumnFreqs(const char* column, int nSeq, QVector<int>& freqsByChar, int &nonGapChars);
+
 };
 
 }//namespace
@@ -21,7 +21,13 @@
 
 #include "MSADistanceAlgorithm.h"
 
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define U2_MSA_DISTANCE_USE_SSE2
+#endif
+
 #include <U2Core/DNAAlphabet.h>
+#include <U2Core/U2SafePoints.h>
 
 namespace U2 {
 
@@ -90,6 +96,74 @@ void MSADistanceAlgorithm::setDistanceValue(int row1, int row2, int distance) {
     }
 }
 
+QVector<QByteArray> MSADistanceAlgorithm::getRowsData(U2OpStatus& os) const {
+    QVector<QByteArray> rows;
+    const qint64 length = ma->getLength();
+    for (int i = 0, n = ma->getNumRows(); i < n; i++) {
+        rows << ma->getMsaRow(i)->toByteArray(os, length);
+        CHECK_OP(os, QVector<QByteArray>());
+    }
+    return rows;
+}
+
+namespace {
+
+int countBits(int mask) {
+    int count = 0;
+    for (; mask != 0; count++) {
+        mask &= mask - 1;
+    }
+    return count;
+}
+
+}
+
+int MSADistanceAlgorithm::countMatches(const char* row1, const char* row2, int length, bool excludeGaps) {
+    int count = 0;
+    int k = 0;
+#ifdef U2_MSA_DISTANCE_USE_SSE2
+    const __m128i gaps = _mm_set1_epi8(U2Msa::GAP_CHAR);
+    for (; k + 16 <= length; k += 16) {
+        const __m128i chars1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + k));
+        const __m128i chars2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row2 + k));
+        __m128i matches = _mm_cmpeq_epi8(chars1, chars2);
+        if (excludeGaps) {
+            matches = _mm_andnot_si128(_mm_cmpeq_epi8(chars1, gaps), matches);
+        }
+        count += countBits(_mm_movemask_epi8(matches));
+    }
+#endif
+    for (; k < length; k++) {
+        if (row1[k] == row2[k] && (!excludeGaps || row1[k] != U2Msa::GAP_CHAR)) {
+            count++;
+        }
+    }
+    return count;
+}
+
+int MSADistanceAlgorithm::countMismatches(const char* row1, const char* row2, int length, bool excludeGaps) {
+    int count = 0;
+    int k = 0;
+#ifdef U2_MSA_DISTANCE_USE_SSE2
+    const __m128i gaps = _mm_set1_epi8(U2Msa::GAP_CHAR);
+    for (; k + 16 <= length; k += 16) {
+        const __m128i chars1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + k));
+        const __m128i chars2 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row2 + k));
+        __m128i skipped = _mm_cmpeq_epi8(chars1, chars2);
+        if (excludeGaps) {
+            skipped = _mm_or_si128(skipped, _mm_or_si128(_mm_cmpeq_epi8(chars1, gaps), _mm_cmpeq_epi8(chars2, gaps)));
+        }
+        count += 16 - countBits(_mm_movemask_epi8(skipped));
+    }
+#endif
+    for (; k < length; k++) {
+        if (row1[k] != row2[k] && (!excludeGaps || (row1[k] != U2Msa::GAP_CHAR && row2[k] != U2Msa::GAP_CHAR))) {
+            count++;
+        }
+    }
+    return count;
+}
+
 void MSADistanceAlgorithm::fillTable() {
     int nSeq = ma->getNumRows();
     for (int i = 0; i < nSeq; i++) {
@@ -131,6 +131,16 @@ private:
 protected:
     virtual void fillTable();
     virtual int calculateSimilarity(int , int ){return 0;}
+
+    // returns all rows of the alignment as byte arrays of the alignment length
+    QVector<QByteArray> getRowsData(U2OpStatus& os) const;
+
+    // counts positions with equal characters, gap-gap positions are not counted if @excludeGaps is true
+    static int countMatches(const char* row1, const char* row2, int length, bool excludeGaps);
+
+    // counts positions with different characters, positions with a gap are not counted if @excludeGaps is true
+    static int countMismatches(const char* row1, const char* row2, int length, bool excludeGaps);
+
     MultipleSequenceAlignment                   ma;
     mutable QMutex                              lock;
     bool                                        excludeGaps;
@@ -22,6 +22,8 @@
 #include "MSADistanceAlgorithmHamming.h"
 
 #include <U2Core/MultipleSequenceAlignment.h>
+#include <U2Core/U2OpStatusUtils.h>
+#include <U2Core/U2SafePoints.h>
 
 namespace U2 {
 
@@ -56,21 +58,17 @@ MSADistanceAlgorithm* MSADistanceAlgorithmFactoryHamming::createAlgorithm(const
 
 void MSADistanceAlgorithmHamming::run() {
     int nSeq = ma->getNumRows();
+    const int length = ma->getLength();
+    U2OpStatus2Log os;
+    const QVector<QByteArray> rows = getRowsData(os);
+    CHECK_OP_EXT(os, setError(tr("An unexpected error has occurred during running the Hamming algorithm.")), );
+
     for (int i = 0; i < nSeq; i++) {
         for (int j = i; j < nSeq; j++) {
-            int sim = 0;
-            for (int k = 0; k < ma->getLength(); k++) {
-                if (isCanceled()) {
-                    return;
-                }
-                bool dissimilar = (ma->charAt(i, k) != ma->charAt(j, k));
-
-                if(!excludeGaps){
-                    if (dissimilar) sim++;
-                }else{
-                    if (dissimilar && (ma->charAt(i, k)!=U2Msa::GAP_CHAR && ma->charAt(j, k)!=U2Msa::GAP_CHAR)) sim++;
-                }
+            if (isCanceled()) {
+                return;
             }
+            int sim = countMismatches(rows[i].constData(), rows[j].constData(), length, excludeGaps);
             lock.lock();
             setDistanceValue(i, j, sim);
             lock.unlock();
@@ -61,34 +61,27 @@ void MSADistanceAlgorithmHammingRevCompl::run() {
 
     DNATranslation* trans = compTT ;
     int nSeq = ma->getNumRows();
-    MultipleSequenceAlignment revtransl;
-    revtransl->setAlphabet(ma->getAlphabet());
     U2OpStatus2Log os;
-    for (int i = 0; i < nSeq; i++) {
+    const QVector<QByteArray> rows = getRowsData(os);
+    CHECK_OP_EXT(os, setError(tr("An unexpected error has occurred during running"
+                                  " the Hamming reverse-complement algorithm.")),);
+
+    QVector<QByteArray> revRows;
+    foreach (QByteArray arr, rows) {
         if (isCanceled()) {
             return;
         }
-        QByteArray arr = ma->getMsaRow(i)->toByteArray(os, ma->getLength());
         trans->translate(arr.data(), arr.length());
         TextUtils::reverse(arr.data(), arr.length());
-
-        revtransl->addRow(ma->getMsaRow(i)->getName(), arr);
-
-        CHECK_OP_EXT(os, setError(tr("An unexpected error has occurred during running"
-                                      " the Hamming reverse-complement algorithm.")),);
+        revRows << arr;
     }
 
     for (int i = 0; i < nSeq; i++) {
         for (int j = i; j < nSeq; j++) {
-            int sim = 0;
-            for (int k = 0; k < ma->getLength(); k++) {
-                if (isCanceled()) {
-                    return;
-                }
-                if (ma->charAt(i, k) == revtransl->charAt(j, k)) {
-                    sim++;
-                }
+            if (isCanceled()) {
+                return;
             }
+            int sim = countMatches(rows[i].constData(), revRows[j].constData(), ma->getLength(), false);
             lock.lock();
             setDistanceValue(i, j, sim);
             lock.unlock();
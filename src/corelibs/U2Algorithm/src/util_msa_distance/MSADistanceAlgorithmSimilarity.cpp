@@ -22,6 +22,8 @@
 #include "MSADistanceAlgorithmSimilarity.h"
 
 #include <U2Core/MultipleSequenceAlignment.h>
+#include <U2Core/U2OpStatusUtils.h>
+#include <U2Core/U2SafePoints.h>
 
 namespace U2 {
 
@@ -56,22 +58,17 @@ MSADistanceAlgorithm* MSADistanceAlgorithmFactorySimilarity::createAlgorithm(con
 
 void MSADistanceAlgorithmSimilarity::run() {
     int nSeq = ma->getNumRows();
+    const int length = ma->getLength();
+    U2OpStatus2Log os;
+    const QVector<QByteArray> rows = getRowsData(os);
+    CHECK_OP_EXT(os, setError(tr("An unexpected error has occurred during running the similarity algorithm.")), );
+
     for (int i = 0; i < nSeq; i++) {
         for (int j = i; j < nSeq; j++) {
-            int sim = 0;
-            for (int k = 0; k < ma->getLength(); k++) {
-                if (isCanceled()) {
-                    return;
-                }
-                bool similar = (ma->charAt(i, k) == ma->charAt(j, k));
-
-                if(!excludeGaps){
-                    if (similar) sim++;
-                }else{
-                    if (similar && ma->charAt(i, k)!=U2Msa::GAP_CHAR) sim++;
-                }
-
+            if (isCanceled()) {
+                return;
             }
+            int sim = countMatches(rows[i].constData(), rows[j].constData(), length, excludeGaps);
             lock.lock();
             setDistanceValue(i, j, sim);
             lock.unlock();
@@ -24,6 +24,7 @@
 #include <U2Algorithm/DynTable.h>
 #include <U2Algorithm/RollingArray.h>
 
+#include <U2Core/AppResources.h>
 #include <U2Core/DNATranslation.h>
 #include <U2Core/DNAAlphabet.h>
 #include <U2Core/DNATranslationImpl.h>
@@ -32,7 +33,11 @@
 #include <U2Core/TextUtils.h>
 #include <U2Core/U2SafePoints.h>
 
+#include <QSemaphore>
+#include <QThreadPool>
+
 #include <assert.h>
+#include <string.h>
 
 namespace U2 {
 
@@ -49,6 +54,122 @@ static bool isComplement(ORFAlgorithmStrand s) {
     return s == ORFAlgorithmStrand_Both || s == ORFAlgorithmStrand_Complement;
 }
 
+static const DNATranslationRole CODON_ROLES[] = {DNATranslationRole_Stop, DNATranslationRole_Start, DNATranslationRole_Start_Alternative};
+static const int CODON_ROLES_COUNT = sizeof(CODON_ROLES) / sizeof(CODON_ROLES[0]);
+
+ORFCodonClassifier::ORFCodonClassifier(const DNATranslation3to1Impl* aTT) : nCodes(1) {
+    static const char FLAGS[CODON_ROLES_COUNT] = {STOP, START, ALT_START};
+    memset(charCodes, 0, sizeof(charCodes));
+    const QMap<DNATranslationRole, QList<Triplet> > roles = aTT->getCodons();
+    for (int r = 0; r < CODON_ROLES_COUNT; r++) {
+        foreach (const Triplet& t, roles.value(CODON_ROLES[r])) {
+            for (int i = 0; i < 3; i++) {
+                uchar c = (uchar)t.c[i];
+                if (charCodes[c] == 0) {
+                    charCodes[c] = nCodes++;
+                }
+            }
+        }
+    }
+    classes.fill(0, nCodes * nCodes * nCodes);
+    for (int r = 0; r < CODON_ROLES_COUNT; r++) {
+        foreach (const Triplet& t, roles.value(CODON_ROLES[r])) {
+            classes[index(t.c)] |= FLAGS[r];
+        }
+    }
+}
+
+namespace {
+
+/**
+ * Searches ORFs on the complement strand and keeps the results until the direct strand is processed,
+ * so the listener gets them in the sequential order.
+ */
+class ComplementStrandSearch : public ORFFindResultsListener {
+public:
+    ComplementStrandSearch(const ORFAlgorithmSettings& cfg, const U2EntityRef& entityRef, int& stopFlag)
+        : cfg(cfg), entityRef(entityRef), stopFlag(stopFlag), percentsCompleted(0) {}
+
+    void run() {
+        ORFFindAlgorithm::find(this, cfg, entityRef, stopFlag, percentsCompleted);
+        finished.release();
+    }
+
+    void onResult(const ORFFindResult& r, U2OpStatus& os) {
+        if (cfg.isResultsLimited && results.size() >= cfg.maxResult2Search) {
+            os.setCanceled(true);
+            return;
+        }
+        results.append(r);
+    }
+
+    bool waitForFinished(int msecs) {
+        return finished.tryAcquire(1, msecs);
+    }
+
+    int getPercentsCompleted() const {
+        return percentsCompleted;
+    }
+
+    const QList<ORFFindResult>& getResults() const {
+        return results;
+    }
+
+private:
+    ORFAlgorithmSettings cfg;
+    U2EntityRef entityRef;
+    int& stopFlag;
+    int percentsCompleted;
+    QList<ORFFindResult> results;
+    QSemaphore finished;
+};
+
+/** Is deleted by the pool, the search itself belongs to the thread that waits for it */
+class ComplementStrandRunnable : public QRunnable {
+public:
+    ComplementStrandRunnable(ComplementStrandSearch* search) : search(search) {}
+
+    void run() {
+        search->run();
+    }
+
+private:
+    ComplementStrandSearch* search;
+};
+
+}
+
+void ORFFindAlgorithm::findInBothStrandsParallel(ORFFindResultsListener* rl,
+                                                 const ORFAlgorithmSettings& cfg,
+                                                 U2EntityRef& entityRef,
+                                                 int& stopFlag,
+                                                 int& percentsCompleted)
+{
+    static const int PROGRESS_UPDATE_INTERVAL = 100;
+
+    ORFAlgorithmSettings directCfg = cfg;
+    directCfg.strand = ORFAlgorithmStrand_Direct;
+    ORFAlgorithmSettings complementCfg = cfg;
+    complementCfg.strand = ORFAlgorithmStrand_Complement;
+
+    ComplementStrandSearch complementSearch(complementCfg, entityRef, stopFlag);
+    QThreadPool::globalInstance()->start(new ComplementStrandRunnable(&complementSearch));
+    findInStrands(rl, directCfg, entityRef, stopFlag, percentsCompleted, 50);
+
+    // the direct strand gives the first half of the progress, the complement one the second half
+    const int directPercents = percentsCompleted;
+    while (!complementSearch.waitForFinished(PROGRESS_UPDATE_INTERVAL)) {
+        percentsCompleted = directPercents + complementSearch.getPercentsCompleted() / 2;
+    }
+    percentsCompleted = directPercents + complementSearch.getPercentsCompleted() / 2;
+
+    TaskStateInfo os;
+    foreach (const ORFFindResult& r, complementSearch.getResults()) {
+        CHECK(!stopFlag && !os.isCoR(), );
+        rl->onResult(r, os);
+    }
+}
+
 void ORFFindAlgorithm::find(
                             ORFFindResultsListener* rl,
                             const ORFAlgorithmSettings& cfg,
@@ -59,6 +180,20 @@ void ORFFindAlgorithm::find(
     SAFE_POINT(cfg.maxResult2Search >= 0, "Invalid max results count!", );
     SAFE_POINT(cfg.proteinTT && cfg.proteinTT->isThree2One(), "Amino translation is not 3to1 translation!", );
 
+    if (cfg.strand == ORFAlgorithmStrand_Both && AppResourcePool::instance()->getIdealThreadCount() > 1) {
+        findInBothStrandsParallel(rl, cfg, entityRef, stopFlag, percentsCompleted);
+        return;
+    }
+    findInStrands(rl, cfg, entityRef, stopFlag, percentsCompleted, cfg.strand == ORFAlgorithmStrand_Both ? 50 : 100);
+}
+
+void ORFFindAlgorithm::findInStrands(ORFFindResultsListener* rl,
+                                     const ORFAlgorithmSettings& cfg,
+                                     U2EntityRef& entityRef,
+                                     int& stopFlag,
+                                     int& percentsCompleted,
+                                     int percentsPerStrand)
+{
     TaskStateInfo os;
     U2SequenceObject dnaSeq("sequence",entityRef);
 
@@ -68,6 +203,7 @@ void ORFFindAlgorithm::find(
 
     DNATranslation3to1Impl* aTT = dynamic_cast<DNATranslation3to1Impl*>(cfg.proteinTT);
     SAFE_POINT(aTT != NULL, "Cannot convert DNATranslation to DNATranslation3to1Impl!", );
+    const ORFCodonClassifier codonClassifier(aTT);
     bool mustFit = cfg.mustFit;
     bool mustInit = cfg.mustInit;
     bool allowAltStart = cfg.allowAltStart;
@@ -76,8 +212,7 @@ void ORFFindAlgorithm::find(
     int minLen = qMax(cfg.minLen, 3);
     CHECK(cfg.searchRegion.length >= minLen, );
 
-    int onePercentLen = cfg.searchRegion.length/100;
-    if (cfg.strand == ORFAlgorithmStrand_Both) onePercentLen /=2;
+    int onePercentLen = cfg.searchRegion.length / percentsPerStrand;
     int leftTillPercent = onePercentLen;
     percentsCompleted = 0;
 
@@ -100,7 +235,7 @@ void ORFFindAlgorithm::find(
             }
             int frame = i % 3;
             QList<int>* initiators = start + frame;
-            if (!initiators->isEmpty() && aTT->isStopCodon(sequence.data() + seqPointer)) {
+            if (!initiators->isEmpty() && codonClassifier.isStop(sequence.data() + seqPointer)) {
                 foreach(int initiator, *initiators) {
                     qint64 len = i - initiator;
                     if (cfg.includeStopCodon) {
@@ -115,9 +250,7 @@ void ORFFindAlgorithm::find(
                     initiators->append(i+3);
                 }
             } else if (initiators->isEmpty() || allowOverlap) {
-                if (aTT->isStartCodon(sequence.data() + seqPointer)
-                    || (allowAltStart && aTT->isCodon(DNATranslationRole_Start_Alternative, sequence.data() + seqPointer))
-                   ) {
+                if (codonClassifier.isStart(sequence.data() + seqPointer, allowAltStart)) {
                     if (initiators->isEmpty() || initiators->last() != i) {
                         initiators->append(i);
                     }
@@ -162,7 +295,7 @@ void ORFFindAlgorithm::find(
                 // NOTE: frames of the start and the end of circular region are not equal!
                 int startFrame = (dnaSeq.getSequenceLength() - (3- frame) % 3) % 3;
                 QList<int>* initiators = start + startFrame;
-                if (!initiators->isEmpty() && aTT->isStopCodon(sequence.data() + seqPointer)) {
+                if (!initiators->isEmpty() && codonClassifier.isStop(sequence.data() + seqPointer)) {
                     foreach(int initiator, *initiators) {
                         int len = regLen + i - initiator;
                         if (len>=minLen && !os.isCoR()){
@@ -223,7 +356,7 @@ void ORFFindAlgorithm::find(
             }
             int frame = (i + 1) % 3;
             QList<int>* initiators = start + frame;
-            if (!initiators->isEmpty() && aTT->isStopCodon(sequence.data()+seqPointer)) {
+            if (!initiators->isEmpty() && codonClassifier.isStop(sequence.data()+seqPointer)) {
                 foreach(int initiator, *initiators) {
                     int len = initiator - i;
                     int ind = i;
@@ -240,9 +373,7 @@ void ORFFindAlgorithm::find(
                     initiators->append(i-3);
                 }
             } else if (initiators->isEmpty() || allowOverlap) {
-                if (aTT->isStartCodon(sequence.data()+seqPointer)
-                    || (allowAltStart && aTT->isCodon(DNATranslationRole_Start_Alternative, sequence.data()+seqPointer))
-                   ) {
+                if (codonClassifier.isStart(sequence.data()+seqPointer, allowAltStart)) {
                     if (initiators->isEmpty() || initiators->last() != i) {
                         initiators->append(i);
                     }
@@ -289,7 +420,7 @@ void ORFFindAlgorithm::find(
                 // NOTE: frames of the start and the end of circular region are not equal!
                 int startFrame =  (3 - ((dnaSeq.getSequenceLength() - frame) % 3)) % 3;
                 QList<int>* initiators = start + startFrame;
-                if (!initiators->isEmpty() && aTT->isStopCodon(sequence.data()+seqPointer)) {
+                if (!initiators->isEmpty() && codonClassifier.isStop(sequence.data()+seqPointer)) {
                     foreach(int initiator, *initiators) {
                         int len = regLen + initiator - i ;
                         if (len >= minLen && !os.isCoR()){
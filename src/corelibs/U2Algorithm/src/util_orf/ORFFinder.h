@@ -27,10 +27,12 @@
 #include <U2Core/DNASequenceObject.h>
 
 #include <QList>
+#include <QVector>
 
 namespace U2 {
 
 class DNATranslation;
+class DNATranslation3to1Impl;
 class TaskStateInfo;
 
 class U2ALGORITHM_EXPORT ORFFindResult {
@@ -133,6 +135,39 @@ public:
 };
 
 
+/**
+ * Classifies a codon with a single table lookup instead of scanning the codon lists of the translation.
+ * Every character used by the start, alternative start or stop codons gets its own code, all other characters
+ * share the code 0, so the result is exactly the same as the one of DNATranslation3to1Impl::isCodon.
+ */
+class U2ALGORITHM_EXPORT ORFCodonClassifier {
+public:
+    ORFCodonClassifier(const DNATranslation3to1Impl* aTT);
+
+    bool isStop(const char* s) const {
+        return (classes.at(index(s)) & STOP) != 0;
+    }
+
+    bool isStart(const char* s, bool allowAltStart) const {
+        return (classes.at(index(s)) & (allowAltStart ? START | ALT_START : START)) != 0;
+    }
+
+private:
+    int index(const char* s) const {
+        return (charCodes[(uchar)s[0]] * nCodes + charCodes[(uchar)s[1]]) * nCodes + charCodes[(uchar)s[2]];
+    }
+
+    enum {
+        STOP = 1,
+        START = 2,
+        ALT_START = 4
+    };
+
+    int nCodes;
+    uchar charCodes[256];
+    QVector<char> classes;
+};
+
 class U2ALGORITHM_EXPORT ORFFindAlgorithm {
 public:
     static void find(
@@ -141,7 +176,22 @@ public:
         U2EntityRef& entityRef,
         int& stopFlag,
         int& percentsCompleted);
+
+    // searches the direct strand in the current thread and the complement one in the global thread pool,
+    // the listener gets the results in the same order as from the sequential search of both strands
+    static void findInBothStrandsParallel(ORFFindResultsListener* rl,
+                                          const ORFAlgorithmSettings& cfg,
+                                          U2EntityRef& entityRef,
+                                          int& stopFlag,
+                                          int& percentsCompleted);
 private:
+    // searches the strands of the settings sequentially, each strand adds 'percentsPerStrand' to the progress
+    static void findInStrands(ORFFindResultsListener* rl,
+                              const ORFAlgorithmSettings& cfg,
+                              U2EntityRef& entityRef,
+                              int& stopFlag,
+                              int& percentsCompleted,
+                              int percentsPerStrand);
     static void addStartCodonsFromJunction(const U2SequenceObject &seq,
                                            const ORFAlgorithmSettings &cfg,
                                            ORFAlgorithmStrand strand,
@@ -0,0 +1,147 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include "WeightMatrixAlgorithm.h"
+
+#include <U2Core/DIProperties.h>
+#include <U2Core/U2SafePoints.h>
+
+namespace U2 {
+
+float WeightMatrixAlgorithm::getScore(const char* seq, int len, const PWMatrix& m, DNATranslation* complMap) {
+    int l = m.getLength();
+
+    float lower = m.getMinSum(), upper = m.getMaxSum();
+    QByteArray complMapper = (complMap != NULL) ? complMap->getOne2OneMapper() : QByteArray();
+    assert ((upper - lower) > 1e-9);
+    float curr = 0;
+    if (m.getType() == PWM_MONONUCLEOTIDE) {
+        for (int i = 0; i < len && i < l; i++) {
+            char c = (complMap != NULL) ? complMapper[uchar(seq[len - i])] : seq[i];
+            curr += m.getValue(DiProperty::index(c), i);
+        }
+    } else {
+        for (int i = 0; i < len && i < l; i++) {
+            char c1 = (complMap != NULL) ? complMapper[uchar(seq[len - i])] : seq[i];
+            char c2 = (complMap != NULL) ? complMapper[uchar(seq[len - (i+1)])] : seq[i+1];
+            curr += m.getValue(DiProperty::index(c1, c2), i);
+        }
+    }
+    assert (curr >= lower);
+    assert (curr <= upper);
+    return (curr - lower) / (upper - lower);
+}
+
+WeightMatrixSequenceCodes::WeightMatrixSequenceCodes(const QByteArray& seq, DNATranslation* complMap)
+    : prepared(false), seq(seq), complMap(complMap)
+{
+}
+
+void WeightMatrixSequenceCodes::prepare() {
+    QMutexLocker locker(&lock);
+    CHECK(!prepared, );
+    prepared = true;
+
+    const char* data = seq.constData();
+    const int len = seq.length();
+    uchar directTable[256];
+    for (int c = 0; c < 256; c++) {
+        directTable[c] = DiProperty::index(char(c));
+    }
+    directCodes.resize(len + 1);
+    uchar* direct = (uchar*)directCodes.data();
+    for (int i = 0; i < len; i++) {
+        direct[i] = directTable[uchar(data[i])];
+    }
+    direct[len] = directTable[0];
+
+    CHECK(complMap != NULL, );
+    QByteArray complMapper = complMap->getOne2OneMapper();
+    uchar complementTable[256];
+    for (int c = 0; c < 256; c++) {
+        complementTable[c] = DiProperty::index(complMapper[c]);
+    }
+    complementCodes.resize(len + 1);
+    uchar* complement = (uchar*)complementCodes.data();
+    for (int i = 0; i < len; i++) {
+        complement[i] = complementTable[uchar(data[i])];
+    }
+    complement[len] = complementTable[0];
+}
+
+WeightMatrixScanner::WeightMatrixScanner(const PWMatrix& m)
+    : length(m.getLength()), dinucleotide(m.getType() == PWM_DINUCLEOTIDE), lower(m.getMinSum()), upper(m.getMaxSum())
+{
+    const int rows = dinucleotide ? 16 : 4;
+    values.resize(length * rows);
+    maxSuffixSums.fill(0, length + 1);
+    for (int i = length - 1; i >= 0; i--) {
+        float max = m.getValue(0, i);
+        for (int j = 0; j < rows; j++) {
+            values[i * rows + j] = m.getValue(j, i);
+            max = qMax(max, values[i * rows + j]);
+        }
+        maxSuffixSums[i] = maxSuffixSums[i + 1] + max;
+    }
+}
+
+bool WeightMatrixScanner::getScore(const WeightMatrixSequenceCodes& codes, int pos, bool complement, float minScore, float& score) const {
+    // the slack keeps rounding errors of the bounds from dropping positions that exactly reach the minimum
+    static const float PRUNING_SLACK = 1e-4f;
+    const float minSum = lower + (minScore - PRUNING_SLACK) * (upper - lower);
+    const float* v = values.constData();
+    const float* bounds = maxSuffixSums.constData();
+
+    float curr = 0;
+    if (!dinucleotide) {
+        if (!complement) {
+            const uchar* c = codes.getDirectCodes() + pos;
+            for (int i = 0; i < length; i++, v += 4) {
+                curr += v[c[i]];
+                CHECK(curr + bounds[i + 1] >= minSum, false);
+            }
+        } else {
+            const uchar* c = codes.getComplementCodes() + pos + length;
+            for (int i = 0; i < length; i++, v += 4) {
+                curr += v[*(c - i)];
+                CHECK(curr + bounds[i + 1] >= minSum, false);
+            }
+        }
+    } else {
+        if (!complement) {
+            const uchar* c = codes.getDirectCodes() + pos;
+            for (int i = 0; i < length; i++, v += 16) {
+                curr += v[(c[i] << 2) + c[i + 1]];
+                CHECK(curr + bounds[i + 1] >= minSum, false);
+            }
+        } else {
+            const uchar* c = codes.getComplementCodes() + pos + length;
+            for (int i = 0; i < length; i++, v += 16) {
+                curr += v[(*(c - i) << 2) + *(c - i - 1)];
+                CHECK(curr + bounds[i + 1] >= minSum, false);
+            }
+        }
+    }
+    score = (curr - lower) / (upper - lower);
+    return true;
+}
+
+} //namespace
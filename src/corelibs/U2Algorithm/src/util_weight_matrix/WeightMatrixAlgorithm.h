@@ -0,0 +1,112 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef _U2_WEIGHT_MATRIX_ALGORITHM_H_
+#define _U2_WEIGHT_MATRIX_ALGORITHM_H_
+
+#include <U2Algorithm/PWMConversionAlgorithm.h>
+
+#include <U2Core/DNATranslation.h>
+
+#include <QMutex>
+#include <QVector>
+
+namespace U2 {
+
+enum MatrixBuldTarget {
+    FREQUENCY_MATRIX,
+    WEIGHT_MATRIX
+};
+
+enum MatrixBuildType {
+    PM_MONONUCLEOTIDE,
+    PM_DINUCLEOTIDE
+};
+
+class PMBuildSettings {
+public:
+    PMBuildSettings(): type(PM_MONONUCLEOTIDE), target(FREQUENCY_MATRIX) {
+
+    }
+    QString                     algo;
+    MatrixBuildType             type;
+    MatrixBuldTarget            target;
+};
+
+class U2ALGORITHM_EXPORT WeightMatrixAlgorithm : public QObject {
+    Q_OBJECT
+public:
+    static float getScore(const char* seq, int len, const PWMatrix& m, DNATranslation* complMap);
+};
+
+/**
+ * Nucleotide indexes of the direct and the complementary strand of a sequence.
+ * The sequence is encoded once and then scanned by any number of matrices.
+ */
+class U2ALGORITHM_EXPORT WeightMatrixSequenceCodes {
+public:
+    WeightMatrixSequenceCodes(const QByteArray& seq, DNATranslation* complMap);
+
+    // encodes the sequence on the first call, can be called from several threads
+    void prepare();
+
+    const QByteArray& getSequence() const { return seq; }
+    DNATranslation* getComplementTranslation() const { return complMap; }
+
+    // both arrays have one extra code after the end of the sequence: matrices read it at the last position
+    const uchar* getDirectCodes() const { return (const uchar*)directCodes.constData(); }
+    const uchar* getComplementCodes() const { return (const uchar*)complementCodes.constData(); }
+
+private:
+    QMutex          lock;
+    bool            prepared;
+    QByteArray      seq;
+    DNATranslation* complMap;
+    QByteArray      directCodes;
+    QByteArray      complementCodes;
+};
+
+/**
+ * Scores positions of an encoded sequence with a single matrix.
+ * The scores are equal to WeightMatrixAlgorithm::getScore, but a position is abandoned
+ * as soon as the best possible rest of the matrix can not reach the requested minimum.
+ */
+class U2ALGORITHM_EXPORT WeightMatrixScanner {
+public:
+    WeightMatrixScanner(const PWMatrix& m);
+
+    int getLength() const { return length; }
+
+    // returns false if the normalized score at 'pos' is less than 'minScore', 'score' is undefined then
+    bool getScore(const WeightMatrixSequenceCodes& codes, int pos, bool complement, float minScore, float& score) const;
+
+private:
+    int             length;
+    bool            dinucleotide;
+    float           lower;
+    float           upper;
+    QVector<float>  values;         // matrix values grouped by columns
+    QVector<float>  maxSuffixSums;  // maxSuffixSums[i] is the sum of maximum values of columns [i, length)
+};
+
+} //namespace
+
+#endif
@@ -145,6 +145,7 @@ HEADERS += src/cmdline/CMDLineCoreOptions.h \
            src/io/InputStream.h \
            src/io/IOAdapter.h \
            src/io/LocalFileAdapter.h \
+           src/io/MappedFileAdapter.h \
            src/io/OutputStream.h \
            src/io/RingBuffer.h \
            src/io/StringAdapter.h \
@@ -226,11 +227,13 @@ HEADERS += src/cmdline/CMDLineCoreOptions.h \
            src/util/GUrlUtils.h \
            src/util/ImportToDatabaseOptions.h \
            src/util/IOAdapterUtils.h \
+           src/util/MaColumnSnapshot.h \
            src/util/MaIterator.h \
            src/util/MaModificationInfo.h \
            src/util/McaDbiUtils.h \
            src/util/MsaDbiUtils.h \
            src/util/McaRowInnerData.h \
+           src/util/MsaRowGapIndex.h \
            src/util/MsaRowUtils.h \
            src/util/MSAUtils.h \
            src/util/MultipleChromatogramAlignmentExporter.h \
@@ -248,6 +251,7 @@ HEADERS += src/cmdline/CMDLineCoreOptions.h \
            src/util/TaskWatchdog.h \
            src/util/U1AnnotationUtils.h \
            src/util/U2AlphabetUtils.h \
+           src/util/U2AssemblyBinnedCoverage.h \
            src/util/U2AssemblyReadIterator.h \
            src/util/U2AssemblyUtils.h \
            src/util/U2AttributeUtils.h \
@@ -373,6 +377,7 @@ SOURCES += src/cmdline/CMDLineCoreOptions.cpp \
            src/io/HttpFileAdapter.cpp \
            src/io/IOAdapter.cpp \
            src/io/LocalFileAdapter.cpp \
+           src/io/MappedFileAdapter.cpp \
            src/io/StringAdapter.cpp \
            src/io/VFSAdapter.cpp \
            src/io/VirtualFileSystem.cpp \
@@ -449,11 +454,13 @@ SOURCES += src/cmdline/CMDLineCoreOptions.cpp \
            src/util/GUrlUtils.cpp \
            src/util/ImportToDatabaseOptions.cpp \
            src/util/IOAdapterUtils.cpp \
+           src/util/MaColumnSnapshot.cpp \
            src/util/MaIterator.cpp \
            src/util/MaModificationInfo.cpp \
            src/util/McaDbiUtils.cpp \
            src/util/McaRowInnerData.cpp \
            src/util/MsaDbiUtils.cpp \
+           src/util/MsaRowGapIndex.cpp \
            src/util/MsaRowUtils.cpp \
            src/util/MSAUtils.cpp \
            src/util/MultipleChromatogramAlignmentExporter.cpp \
@@ -469,6 +476,7 @@ SOURCES += src/cmdline/CMDLineCoreOptions.cpp \
            src/util/TaskWatchdog.cpp \
            src/util/U1AnnotationUtils.cpp \
            src/util/U2AlphabetUtils.cpp \
+           src/util/U2AssemblyBinnedCoverage.cpp \
            src/util/U2AssemblyReadIterator.cpp \
            src/util/U2AssemblyUtils.cpp \
            src/util/U2AttributeUtils.cpp \
@@ -35,11 +35,13 @@ const QString U2BaseAttributeName::reference_species("reference_species_attribut
 const QString U2BaseAttributeName::max_prow("max_prow_attribute");
 const QString U2BaseAttributeName::count_reads("count_reads_attribute");
 const QString U2BaseAttributeName::coverage_statistics("coverageStat");
+const QString U2BaseAttributeName::binned_coverage("binnedCoverage");
 
 const QStringList U2BaseAttributeName::getReadsRelatedAttributes() {
     QStringList result;
     result.append(count_reads);
     result.append(coverage_statistics);
+    result.append(binned_coverage);
     result.append(max_prow);
     return result;
 }
@@ -83,6 +83,9 @@ public:
     /** Coverage statistics */
     static const QString coverage_statistics;
 
+    /** Binned read start and end counts for the coverage, see U2AssemblyBinnedCoverage */
+    static const QString binned_coverage;
+
     static const QStringList getReadsRelatedAttributes();
 
 };
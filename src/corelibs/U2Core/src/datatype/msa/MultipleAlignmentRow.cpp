@@ -78,6 +78,10 @@ bool MultipleAlignmentRowData::isTrailingOrLeadingGap(qint64 position) const {
     return false;
 }
 
+MsaRowColumnIterator MultipleAlignmentRowData::getColumnIterator(qint64 position) const {
+    return MsaRowColumnIterator(sequence.seq, gaps, position);
+}
+
 MultipleAlignmentRowData::~MultipleAlignmentRowData() {
 
 }
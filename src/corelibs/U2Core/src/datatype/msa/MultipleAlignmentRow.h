@@ -25,6 +25,7 @@
 #include <QSharedPointer>
 
 #include <U2Core/DNASequence.h>
+#include <U2Core/MsaRowGapIndex.h>
 #include <U2Core/MsaRowUtils.h>
 #include <U2Core/U2Msa.h>
 #include <U2Core/U2OpStatus.h>
@@ -97,6 +98,9 @@ public:
 
     bool isTrailingOrLeadingGap(qint64 position) const;
 
+    /** Returns an iterator over the row characters starting from 'position', use it to read the row column by column */
+    MsaRowColumnIterator getColumnIterator(qint64 position = 0) const;
+
     virtual ~MultipleAlignmentRowData();
 
     /** Returns the list of gaps for the row */
@@ -137,6 +137,7 @@ MultipleSequenceAlignmentRowData::MultipleSequenceAlignmentRowData(const Multipl
       initialRowInDb(row->initialRowInDb)
 {
     SAFE_POINT(alignment != NULL, "Parent MultipleSequenceAlignmentData is NULL", );
+    updateGapIndex();
 }
 
 MultipleSequenceAlignmentRowData::~MultipleSequenceAlignmentRowData() {
@@ -284,6 +285,7 @@ void MultipleSequenceAlignmentRowData::setRowContent(const QByteArray &bytes, in
 
 void MultipleSequenceAlignmentRowData::insertGaps(int pos, int count, U2OpStatus &os) {
     MsaRowUtils::insertGaps(os, gaps, getRowLengthWithoutTrailing(), pos, count);
+    updateGapIndex();
 }
 
 void MultipleSequenceAlignmentRowData::removeChars(int pos, int count, U2OpStatus &os) {
@@ -318,10 +320,18 @@ void MultipleSequenceAlignmentRowData::removeChars(int pos, int count, U2OpStatu
 }
 
 char MultipleSequenceAlignmentRowData::charAt(qint64 position) const {
+    const MsaRowGapIndex *gapIndex = gapIndexCache.getIndex(gaps);
+    if (NULL != gapIndex) {
+        return gapIndex->charAt(sequence.seq, position);
+    }
     return MsaRowUtils::charAt(sequence.seq, gaps, position);
 }
 
 bool MultipleSequenceAlignmentRowData::isGap(qint64 pos) const {
+    const MsaRowGapIndex *gapIndex = gapIndexCache.getIndex(gaps);
+    if (NULL != gapIndex) {
+        return gapIndex->isGap(sequence.length(), pos);
+    }
     return MsaRowUtils::isGap(sequence.length(), gaps, pos);
 }
 
@@ -442,8 +452,10 @@ void MultipleSequenceAlignmentRowData::replaceChars(char origChar, char resultCh
     if (U2Msa::GAP_CHAR == resultChar) {
         // Get indexes of all 'origChar' characters in the row sequence
         QList<int> gapsIndexes;
-        for (int i = 0; i < getRowLength(); i++) {
-            if (origChar == charAt(i)) {
+        MsaRowColumnIterator columnIterator = getColumnIterator();
+        const int rowLength = getRowLength();
+        for (int i = 0; i < rowLength; i++) {
+            if (origChar == columnIterator.next()) {
                 gapsIndexes.append(i);
             }
         }
@@ -541,17 +553,19 @@ QByteArray MultipleSequenceAlignmentRowData::joinCharsAndGaps(bool keepOffset, b
 
 void MultipleSequenceAlignmentRowData::mergeConsecutiveGaps() {
     MsaRowUtils::mergeConsecutiveGaps(gaps);
+    updateGapIndex();
 }
 
 void MultipleSequenceAlignmentRowData::removeTrailingGaps() {
-    if (gaps.isEmpty()) {
-        return;
-    }
-
     // If the last char in the row is gap, remove the last gap
-    if (U2Msa::GAP_CHAR == charAt(MsaRowUtils::getRowLength(sequence.constData(), gaps) - 1)) {
+    if (!gaps.isEmpty() && U2Msa::GAP_CHAR == charAt(MsaRowUtils::getRowLength(sequence.constData(), gaps) - 1)) {
         gaps.removeLast();
     }
+    updateGapIndex();
+}
+
+void MultipleSequenceAlignmentRowData::updateGapIndex() {
+    gapIndexCache.update(gaps);
 }
 
 void MultipleSequenceAlignmentRowData::getStartAndEndSequencePositions(int pos, int count, int &startPosInSeq, int &endPosInSeq) {
@@ -23,6 +23,7 @@
 #define _U2_MULTIPLE_SEQUENCE_ALIGNMENT_ROW_H_
 
 #include <U2Core/DNASequence.h>
+#include <U2Core/MsaRowGapIndex.h>
 #include <U2Core/MsaRowUtils.h>
 #include <U2Core/U2Msa.h>
 
@@ -243,6 +244,9 @@ private:
     /** The row must not contain trailing gaps, this method is used to assure it after the row modification */
     void removeTrailingGaps();
 
+    /** Must be called after each modification of the gap model */
+    void updateGapIndex();
+
     /**
      * Calculates start and end position in the sequence,
      * depending on the start position in the row and the 'count' character from it
@@ -259,6 +263,9 @@ private:
 
     /** The row in the database */
     U2MsaRow initialRowInDb;
+
+    /** Speeds up charAt() and isGap() for rows with many gaps */
+    MsaRowGapIndexCache gapIndexCache;
 };
 
 inline const U2MsaRowGapModel & MultipleSequenceAlignmentRowData::getGapModel() const {
@@ -280,6 +287,7 @@ inline int MultipleSequenceAlignmentRowData::getCoreEnd() const {
 inline bool MultipleSequenceAlignmentRowData::simplify() {
     if (gaps.count() > 0) {
         gaps.clear();
+        updateGapIndex();
         return true;
     }
     return false;
@@ -36,8 +36,13 @@ class U2DbiPool;
 #define SQLITE_DBI_ID "SQLiteDbi"
 #define MYSQL_DBI_ID "MysqlDbi"
 #define BAM_DBI_ID "SamtoolsBasedDbi"
+#define MEMORY_DBI_ID "MemoryDbi"
+#define INDEXED_FASTA_DBI_ID "IndexedFastaDbi"
 #define DEFAULT_DBI_ID SQLITE_DBI_ID
 #define WORKFLOW_SESSION_TMP_DBI_ALIAS "workflow_session"
+#define WORKFLOW_SESSION_MEMORY_DBI_ALIAS "workflow_session_memory"
+// read-only property of the memory DBI: an approximate size of the stored data in bytes
+#define MEMORY_DBI_USED_MEMORY_PROPERTY "used-memory"
 
 
 /**
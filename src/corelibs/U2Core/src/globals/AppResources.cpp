@@ -44,6 +44,11 @@
 #include <Winbase.h> //for IsProcessorFeaturePresent
 #endif
 
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <immintrin.h> //for _xgetbv
+#include <intrin.h> //for __cpuid
+#endif
+
 namespace U2 {
 
 #define SETTINGS_ROOT QString("app_resource/")
@@ -234,6 +239,29 @@ bool AppResourcePool::isSSE2Enabled() {
     return answer;
 }
 
+bool AppResourcePool::isAVX2Enabled() {
+    bool answer = false;
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    //cpuid leaf 1: ecx bit 27 is OSXSAVE, bit 28 is AVX
+    //xgetbv: the OS saves both XMM and YMM registers
+    //cpuid leaf 7: ebx bit 5 is AVX2
+    int info[4] = {0};
+    __cpuid(info, 0);
+    if (info[0] >= 7) {
+        __cpuid(info, 1);
+        const bool avxSupported = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0;
+        if (avxSupported && (_xgetbv(0) & 0x6) == 0x6) {
+            __cpuidex(info, 7, 0);
+            answer = (info[1] & (1 << 5)) != 0;
+        }
+    }
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    __builtin_cpu_init();
+    answer = __builtin_cpu_supports("avx2") != 0;
+#endif
+    return answer;
+}
+
 void AppResourcePool::registerResource(AppResource* r) {
     SAFE_POINT(NULL != r,"",);
     SAFE_POINT(!resources.contains(r->getResourceId()), QString("Duplicate resource: ").arg(r->getResourceId()),);
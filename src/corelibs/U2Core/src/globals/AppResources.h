@@ -274,6 +274,9 @@ public:
 
     static bool isSSE2Enabled();
 
+    // checks that both the processor and the OS support AVX2 instructions
+    static bool isAVX2Enabled();
+
     void registerResource(AppResource* r);
     AppResource* getResource(int id) const;
 
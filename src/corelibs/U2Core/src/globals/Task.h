@@ -132,6 +132,8 @@ enum TaskFlag {
 
     TaskFlag_RunInMainThread = 1 << 5, // for tasks that need access to GUI, they will be run in main thread
 
+    TaskFlag_RunInWorkerPool = 1 << 6, // for short leaf subtasks that never wait for other tasks: run by a worker of the fixed-size pool instead of a new thread
+
     // Behavior based on subtasks
     TaskFlag_FailOnSubtaskError = 1 << 10, //subtask error is propagated automatically
 
@@ -248,6 +248,7 @@ void MultipleAlignmentObject::enlargeLength(U2OpStatus &os, qint64 newLength) {
     MaModificationInfo modificationInfo;
     modificationInfo.rowContentChanged = false;
     modificationInfo.rowListChanged = false;
+    modificationInfo.modifiedColumns << U2Region(length, newLength - length);
     updateCachedMultipleAlignment(modificationInfo);
 }
 
@@ -354,6 +355,8 @@ void MultipleAlignmentObject::insertGap(const U2Region &rows, int pos, int nGaps
     MaModificationInfo mi;
     mi.rowListChanged = false;
     mi.modifiedRowIds = rowIdsToInsert;
+    // the rows are shifted starting from the position, the alignment can become longer by nGaps at most
+    mi.modifiedColumns << U2Region(pos, ma->getLength() + nGaps - pos);
     updateCachedMultipleAlignment(mi);
 }
 
@@ -434,6 +437,9 @@ void MultipleAlignmentObject::removeRegion(int startPos, int startRow, int nBase
     if (track || !removedRows.isEmpty()) {
         MaModificationInfo mi;
         mi.modifiedRowIds = modifiedRowIds;
+        if (removedRows.isEmpty()) {
+            mi.modifiedColumns << U2Region(startPos, ma->getLength() - startPos);
+        }
         updateCachedMultipleAlignment(mi, removedRows);
     }
 
@@ -475,6 +481,7 @@ int MultipleAlignmentObject::deleteGap(U2OpStatus &os, const U2Region &rows, int
     MaModificationInfo mi;
     mi.rowListChanged = false;
     mi.modifiedRowIds = modifiedRowIds;
+    mi.modifiedColumns << U2Region(pos, msa->getLength() + removingGapColumnCount - pos);
     updateCachedMultipleAlignment(mi);
     return removingGapColumnCount;
 }
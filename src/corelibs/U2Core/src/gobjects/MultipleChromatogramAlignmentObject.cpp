@@ -152,6 +152,7 @@ void MultipleChromatogramAlignmentObject::replaceCharacter(int startPos, int row
     mi.rowListChanged = false;
     mi.alignmentLengthChanged = false;
     mi.modifiedRowIds << modifiedRowId;
+    mi.modifiedColumns << U2Region(startPos, 1);
 
     if (newChar != ' ' && !msa->getAlphabet()->contains(newChar)) {
         const DNAAlphabet *alp = U2AlphabetUtils::findBestAlphabet(QByteArray(1, newChar));
@@ -176,6 +176,7 @@ void MultipleSequenceAlignmentObject::replaceCharacter(int startPos, int rowInde
     mi.rowListChanged = false;
     mi.alignmentLengthChanged = false;
     mi.modifiedRowIds << modifiedRowId;
+    mi.modifiedColumns << U2Region(startPos, 1);
 
     if (newChar != ' ' && !msa->getAlphabet()->contains(newChar)) {
         const DNAAlphabet *alp = U2AlphabetUtils::findBestAlphabet(QByteArray(1, newChar));
@@ -26,6 +26,7 @@
 namespace U2 {
 
 const IOAdapterId BaseIOAdapters::LOCAL_FILE("local_file");
+const IOAdapterId BaseIOAdapters::MAPPED_LOCAL_FILE("local_file_mapped");
 const IOAdapterId BaseIOAdapters::GZIPPED_LOCAL_FILE("local_file_gzip");
 const IOAdapterId BaseIOAdapters::HTTP_FILE( "http_file" );
 const IOAdapterId BaseIOAdapters::GZIPPED_HTTP_FILE( "http_file_gzip" );
@@ -139,6 +139,7 @@ public:
 class U2CORE_EXPORT BaseIOAdapters {
 public:
     static const IOAdapterId LOCAL_FILE;
+    static const IOAdapterId MAPPED_LOCAL_FILE;
     static const IOAdapterId GZIPPED_LOCAL_FILE;
     static const IOAdapterId HTTP_FILE;
     static const IOAdapterId GZIPPED_HTTP_FILE;
@@ -0,0 +1,214 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+
+#include <QFileInfo>
+
+#ifdef Q_OS_UNIX
+#include <sys/mman.h>
+#endif
+
+#include <U2Core/TextUtils.h>
+#include <U2Core/U2SafePoints.h>
+
+#include "MappedFileAdapter.h"
+
+namespace U2 {
+
+const qint64 MappedFileAdapterFactory::MAPPING_THRESHOLD = 64 * 1024 * 1024;
+
+MappedFileAdapterFactory::MappedFileAdapterFactory(QObject* o)
+    : LocalFileAdapterFactory(o)
+{
+    name = tr("Memory-mapped local file");
+}
+
+IOAdapter* MappedFileAdapterFactory::createIOAdapter() {
+    return new MappedFileAdapter(this);
+}
+
+bool MappedFileAdapterFactory::isMappingPreferable(IOAdapterFactory* iof, const GUrl& url) {
+    CHECK(iof != NULL && url.isLocalFile(), false);
+    CHECK(iof->getAdapterId() == BaseIOAdapters::LOCAL_FILE || iof->getAdapterId() == BaseIOAdapters::MAPPED_LOCAL_FILE, false);
+    if (sizeof(void*) < 8) {
+        // there is not enough address space to map multi-gigabyte files
+        return false;
+    }
+    return QFileInfo(url.getURLString()).size() >= MAPPING_THRESHOLD;
+}
+
+MappedFileAdapter::MappedFileAdapter(IOAdapterFactory* factory, QObject* o)
+    : IOAdapter(factory, o), f(NULL), data(NULL), size(0), pos(0)
+{
+}
+
+bool MappedFileAdapter::open(const GUrl& url, IOAdapterMode m) {
+    SAFE_POINT(!isOpen(), "Adapter is already opened!", false);
+    CHECK(m == IOAdapterMode_Read, false);
+    CHECK(!url.isEmpty(), false);
+
+    f = new QFile(url.getURLString());
+    if (!f->open(QIODevice::ReadOnly)) {
+        delete f;
+        f = NULL;
+        return false;
+    }
+    size = f->size();
+    pos = 0;
+    if (size > 0) {
+        data = reinterpret_cast<const char*>(f->map(0, size));
+        if (data == NULL) {
+            f->close();
+            delete f;
+            f = NULL;
+            size = 0;
+            return false;
+        }
+#ifdef Q_OS_UNIX
+        madvise(const_cast<char*>(data), size, MADV_SEQUENTIAL);
+#endif
+    }
+    return true;
+}
+
+void MappedFileAdapter::close() {
+    SAFE_POINT(isOpen(), "Adapter is not opened!",);
+    if (data != NULL) {
+        f->unmap(reinterpret_cast<uchar*>(const_cast<char*>(data)));
+        data = NULL;
+    }
+    f->close();
+    delete f;
+    f = NULL;
+    size = 0;
+    pos = 0;
+}
+
+qint64 MappedFileAdapter::readUntilView(const char** view, qint64 maxSize, const QBitArray& readTerminators,
+                                        TerminatorHandling th, bool* terminatorFound)
+{
+    SAFE_POINT(isOpen(), "Adapter is not opened!", -1);
+    const char* start = data + pos;
+    const char* end = start + qMin(maxSize, size - pos);
+    const char* p = start;
+    while (p < end && !readTerminators.testBit((uchar)*p)) {
+        p++;
+    }
+    qint64 len = p - start;
+    bool found = p < end;
+    if (found && th != Term_Exclude) {
+        while (p < end && readTerminators.testBit((uchar)*p)) {
+            p++;
+        }
+        if (th == Term_Include) {
+            len = p - start;
+        }
+    }
+    pos += p - start;
+
+    *view = start;
+    if (terminatorFound != NULL) {
+        *terminatorFound = found;
+    }
+    return len;
+}
+
+qint64 MappedFileAdapter::readLineView(const char** view, qint64 maxSize, bool* terminatorFound) {
+    bool b = false;
+    if (terminatorFound == NULL) {
+        terminatorFound = &b;
+    }
+    qint64 len = readUntilView(view, maxSize, TextUtils::LINE_BREAKS, Term_Exclude, terminatorFound);
+    if (*terminatorFound) {
+        // skip one EOL: '\n', '\r' or Windows '\r\n'
+        if (data[pos] == '\r' && pos + 1 < size && data[pos + 1] == '\n') {
+            pos++;
+        }
+        pos++;
+    }
+    return len;
+}
+
+qint64 MappedFileAdapter::readUntil(char* buff, qint64 maxSize, const QBitArray& readTerminators,
+                                    TerminatorHandling th, bool* terminatorFound)
+{
+    const char* view = NULL;
+    qint64 startPos = pos;
+    qint64 len = readUntilView(&view, maxSize, readTerminators, th, terminatorFound);
+    CHECK(len >= 0, len);
+    // the terminators are copied for Term_Skip mode too, like the base implementation does
+    memcpy(buff, view, pos - startPos);
+    return len;
+}
+
+bool MappedFileAdapter::getChar(char* buff) {
+    SAFE_POINT(isOpen(), "Adapter is not opened!", false);
+    CHECK(pos < size, false);
+    *buff = data[pos++];
+    return true;
+}
+
+qint64 MappedFileAdapter::readBlock(char* buff, qint64 maxSize) {
+    SAFE_POINT(isOpen(), "Adapter is not opened!", -1);
+    qint64 len = qMin(maxSize, size - pos);
+    memcpy(buff, data + pos, len);
+    pos += len;
+    return len;
+}
+
+qint64 MappedFileAdapter::writeBlock(const char*, qint64) {
+    FAIL("Mapped file adapter is read-only!", -1);
+}
+
+bool MappedFileAdapter::skip(qint64 nBytes) {
+    SAFE_POINT(isOpen(), "Adapter is not opened!", false);
+    qint64 newPos = pos + nBytes;
+    CHECK(newPos >= 0 && newPos <= size, false);
+    pos = newPos;
+    return true;
+}
+
+qint64 MappedFileAdapter::left() const {
+    SAFE_POINT(isOpen(), "Adapter is not opened!", -1);
+    return size - pos;
+}
+
+int MappedFileAdapter::getProgress() const {
+    SAFE_POINT(isOpen(), "Adapter is not opened!", -1);
+    CHECK(size > 0, 100);
+    return int(100 * float(pos) / size);
+}
+
+qint64 MappedFileAdapter::bytesRead() const {
+    return pos;
+}
+
+GUrl MappedFileAdapter::getURL() const {
+    SAFE_POINT(isOpen(), "Adapter is not opened!", GUrl());
+    return GUrl(f->fileName(), GUrl_File);
+}
+
+QString MappedFileAdapter::errorString() const {
+    SAFE_POINT(isOpen(), "Adapter is not opened!", QString());
+    return f->errorString();
+}
+
+}//namespace
@@ -0,0 +1,115 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+
+#ifndef _U2_MAPPED_FILE_ADAPTER_H_
+#define _U2_MAPPED_FILE_ADAPTER_H_
+
+#include <U2Core/LocalFileAdapter.h>
+
+namespace U2 {
+
+/**
+ * Creates read-only adapters that map the whole local file into memory.
+ */
+class U2CORE_EXPORT MappedFileAdapterFactory : public LocalFileAdapterFactory {
+    Q_OBJECT
+public:
+    MappedFileAdapterFactory(QObject* p = NULL);
+
+    virtual IOAdapter* createIOAdapter();
+
+    virtual IOAdapterId getAdapterId() const {return BaseIOAdapters::MAPPED_LOCAL_FILE;}
+
+    virtual bool isIOModeSupported(IOAdapterMode m) const {return m == IOAdapterMode_Read;}
+
+    /**
+     * Returns true if the file should be read with MappedFileAdapter instead of the adapter created by 'iof':
+     * the file is a large local file that is not compressed.
+     */
+    static bool isMappingPreferable(IOAdapterFactory* iof, const GUrl& url);
+
+    /** Files larger than this size are mapped into memory automatically when a document is loaded */
+    static const qint64 MAPPING_THRESHOLD;
+};
+
+/**
+ * Read-only adapter over a memory-mapped local file.
+ * Besides the regular IOAdapter interface it gives direct access to the mapped data:
+ * the 'view' methods return pointers into the mapped pages without copying the data.
+ * The pointers are valid until the adapter is closed.
+ */
+class U2CORE_EXPORT MappedFileAdapter : public IOAdapter {
+    Q_OBJECT
+public:
+    /** 'f' is a factory reported by the adapter: it can be the factory of a regular local file adapter */
+    MappedFileAdapter(IOAdapterFactory* f, QObject* o = NULL);
+    ~MappedFileAdapter() {if (isOpen()) close();}
+
+    virtual bool open(const GUrl& url, IOAdapterMode m);
+
+    virtual bool isOpen() const {return f != NULL;}
+
+    virtual void close();
+
+    virtual qint64 readUntil(char* buff, qint64 maxSize, const QBitArray& readTerminators,
+        TerminatorHandling th, bool* terminatorFound = 0);
+
+    virtual bool getChar(char* buff);
+
+    virtual qint64 readBlock(char* data, qint64 maxSize);
+
+    virtual qint64 writeBlock(const char* data, qint64 size);
+
+    virtual bool skip(qint64 nBytes);
+
+    virtual qint64 left() const;
+
+    virtual int getProgress() const;
+
+    virtual qint64 bytesRead() const;
+
+    virtual GUrl getURL() const;
+
+    virtual QString errorString() const;
+
+    /** Returns the mapped file content, NULL for empty files */
+    const char* getData() const {return data;}
+
+    qint64 getSize() const {return size;}
+
+    /** The same as 'readUntil', but sets 'view' to the read data in the mapped pages instead of copying it */
+    qint64 readUntilView(const char** view, qint64 maxSize, const QBitArray& readTerminators,
+        TerminatorHandling th, bool* terminatorFound = 0);
+
+    /** The same as 'readLine', but sets 'view' to the line in the mapped pages instead of copying it */
+    qint64 readLineView(const char** view, qint64 maxSize, bool* terminatorFound = 0);
+
+private:
+    QFile* f;
+    const char* data;
+    qint64 size;
+    qint64 pos;
+};
+
+}//namespace
+
+#endif
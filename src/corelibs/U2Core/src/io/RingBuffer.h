@@ -10,6 +10,7 @@ namespace U2 {
 		inline void append(const char* src, int n);
 		int length() const {return len;}
 		char* rawData() const {return data;}
+		void clear() {len = 0; start = 0;}
 	private:
 		char* data; // buffer area
 		int size; // buffer size
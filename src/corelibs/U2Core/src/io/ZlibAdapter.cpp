@@ -20,6 +20,12 @@
  */
 
 #include <qendian.h>
+#include <QDataStream>
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+
+#include <U2Core/U2SafePoints.h>
 
 #include "LocalFileAdapter.h"
 
@@ -54,10 +60,21 @@ void addAccessPoint( GZipIndex& index, int bits, qint64 in, qint64 out, quint32
     if (left < quint32(GZipIndex::WINSIZE)) {
         window.append( QByteArray( wnd, GZipIndex::WINSIZE - left ) );
     }
-    next.window = qCompress( window ).toBase64();
+    next.window = qCompress( window );
+    index.points.append( next );
+}
+// used in GZipIndex building: the next gzip member can be inflated without a dictionary
+void addMemberAccessPoint( GZipIndex& index, qint64 in, qint64 out ) {
+    GZipIndexAccessPoint next;
+    next.bits = 0;
+    next.in = in;
+    next.out = out;
     index.points.append( next );
 }
 
+const quint32 GZIP_INDEX_MAGIC = 0x55475a49; // "UGZI"
+const qint32 GZIP_INDEX_VERSION = 1;
+
 } // anonymous namespace
 
 namespace U2 {
@@ -72,15 +89,20 @@ public:
     qint64 getPos() const;
     bool skip( const GZipIndexAccessPoint& index, qint64 offset );
 private:
+    // prepares the stream to inflate the next gzip member
+    bool restartStream();
+
     static const int CHUNK = 16384;
+    static const int GZIP_TRAILER_SIZE = 8;
     z_stream strm;
     char buf[CHUNK];
     IOAdapter* io;
     bool doCompression;
+    bool rawDeflate; // inflating from an access point inside of a gzip member, without the header
     qint64 curPos; // position of uncompressed file
 };
 
-GzipUtil::GzipUtil(IOAdapter* io, bool doCompression) : io(io), doCompression(doCompression), curPos( 0 )
+GzipUtil::GzipUtil(IOAdapter* io, bool doCompression) : io(io), doCompression(doCompression), rawDeflate( false ), curPos( 0 )
 {
 //#ifdef _DEBUG
     memset(buf, 0xDD, CHUNK);
@@ -127,13 +149,14 @@ qint64 GzipUtil::uncompress(char* outBuff, qint64 outSize)
         /* run inflate() on input until output buffer is full */
         if (strm.avail_in == 0) {
             // need more input
-            strm.avail_in = io->readBlock(buf, CHUNK);
+            qint64 l = io->readBlock(buf, CHUNK);
+            if (l == -1) {
+                // TODO log error
+                return -1;
+            }
+            strm.avail_in = l;
             strm.next_in = (Bytef*)buf;
         }
-        if (strm.avail_in == quint32(-1)) {
-            // TODO log error
-            return -1;
-        }
         if (strm.avail_in == 0)
             break;
 
@@ -145,14 +168,11 @@ qint64 GzipUtil::uncompress(char* outBuff, qint64 outSize)
             case Z_MEM_ERROR:
                 return -1;
             case Z_STREAM_END:
-            {
-                qint64 readBytes = 0;
-                readBytes = outSize - strm.avail_out;
-                inflateReset(&strm);
-                inflateInit2(&strm, 32 + 15);
-
-                return readBytes;
-            }
+                // concatenated gzip members ( e.g. BGZF blocks ) are read as one stream
+                if (!restartStream()) {
+                    return -1;
+                }
+                continue;
             case Z_BUF_ERROR:
             case Z_FINISH:
                 curPos += outSize - strm.avail_out;
@@ -168,6 +188,27 @@ qint64 GzipUtil::uncompress(char* outBuff, qint64 outSize)
     return outSize - strm.avail_out;
 }
 
+bool GzipUtil::restartStream() {
+    if (!rawDeflate) {
+        return Z_OK == inflateReset(&strm);
+    }
+    // raw inflation does not consume the trailer of the member
+    for (int i = 0; i < GZIP_TRAILER_SIZE; i++) {
+        if (strm.avail_in == 0) {
+            qint64 l = io->readBlock(buf, CHUNK);
+            CHECK(l > 0, false);
+            strm.avail_in = l;
+            strm.next_in = (Bytef*)buf;
+        }
+        strm.avail_in--;
+        strm.next_in++;
+    }
+    // zlib 1.2.3 can not switch the header processing by inflateReset
+    inflateEnd(&strm);
+    rawDeflate = false;
+    return Z_OK == inflateInit2(&strm, 32 + 15);
+}
+
 qint64 GzipUtil::compress(const char* inBuff, qint64 inSize, bool finish)
 {
     int ret; Q_UNUSED(ret);
@@ -204,7 +245,6 @@ bool GzipUtil::skip( const GZipIndexAccessPoint& here, qint64 offset ) {
     if( here.out > offset || 0 > offset ) {
         return false;
     }
-    int ret = 0;
     bool ok = false;
     char discard[GZipIndex::WINSIZE];
 
@@ -212,21 +252,35 @@ bool GzipUtil::skip( const GZipIndexAccessPoint& here, qint64 offset ) {
     if( NULL == localIO ) {
         return false;
     }
-    ok = localIO->skip( here.in - ( here.bits ? 1 : 0 ) );
+    // LocalFileAdapter::skip is relative to the current position
+    ok = localIO->skip( here.in - ( here.bits ? 1 : 0 ) - localIO->bytesRead() );
     if ( !ok ) {
         return false;
     }
-    inflateInit2( &strm, -15 );
+    strm.avail_in = 0;
+    strm.next_in = Z_NULL;
+    inflateEnd( &strm );
+    rawDeflate = !here.window.isEmpty();
+    if ( Z_OK != inflateInit2( &strm, rawDeflate ? -15 : 32 + 15 ) ) {
+        return false;
+    }
     if ( here.bits ) {
         char chr = 0;
         ok = io->getChar( &chr );
         if( !ok ) {
             return false;
         }
-        ret = chr;
+        int ret = uchar( chr );
         inflatePrime( &strm, here.bits, ret >> ( 8 - here.bits ) );
     }
-    inflateSetDictionary( &strm, ( const Bytef* )here.window.data(), GZipIndex::WINSIZE );
+    if ( rawDeflate ) {
+        QByteArray window = qUncompress( here.window );
+        if ( GZipIndex::WINSIZE != window.size() ) {
+            return false;
+        }
+        inflateSetDictionary( &strm, ( const Bytef* )window.constData(), GZipIndex::WINSIZE );
+    }
+    curPos = here.out;
 
     /* skip uncompressed bytes until offset reached, then satisfy request */
     offset -= here.out;
@@ -252,7 +306,7 @@ bool GzipUtil::skip( const GZipIndexAccessPoint& here, qint64 offset ) {
 }
 
 ZlibAdapter::ZlibAdapter(IOAdapter* io)
-: IOAdapter(io->getFactory()), io(io), z(NULL), buf(NULL), rewinded(0) {}
+: IOAdapter(io->getFactory()), io(io), z(NULL), buf(NULL), rewinded(0), index(NULL), storedIndexChecked(false), indexFailed(false) {}
 
 ZlibAdapter::~ZlibAdapter() {
     close();
@@ -267,6 +321,11 @@ void ZlibAdapter::close() {
         delete buf;
         buf = NULL;
     }
+    delete index;
+    index = NULL;
+    storedIndexChecked = false;
+    indexFailed = false;
+    rewinded = 0;
     if (io->isOpen()) io->close();
 }
 
@@ -333,23 +392,99 @@ bool ZlibAdapter::skip(qint64 nBytes) {
             rewinded = -nBytes;
             return true;
         }
-        return false;
+        return seek(z->getPos() + nBytes);
     }
     rewinded = 0;
-    char* tmp = new char[nBytes];
-    qint64 skipped = readBlock(tmp, nBytes);
-    delete[] tmp;
+    if (nBytes > GZipIndex::SPAN && loadStoredIndex()) {
+        qint64 pos = z->getPos() + nBytes;
+        int point = index->findAccessPoint(pos);
+        if (point >= 0 && index->points[point].out > z->getPos()) {
+            return seek(pos);
+        }
+    }
+    return readThrough(nBytes);
+}
 
-    return skipped == nBytes;
+bool ZlibAdapter::readThrough(qint64 nBytes) {
+    QByteArray tmp(int(qMin(nBytes, qint64(BUFLEN))), 0);
+    while (nBytes > 0) {
+        qint64 l = readBlock(tmp.data(), qMin(nBytes, qint64(tmp.size())));
+        CHECK(l > 0, false);
+        nBytes -= l;
+    }
+    return true;
+}
+
+bool ZlibAdapter::seek(qint64 pos) {
+    CHECK(pos >= 0, false);
+    CHECK(prepareIndex(), false);
+    CHECK(index->uncompressedSize < 0 || pos <= index->uncompressedSize, false);
+    int point = index->findAccessPoint(pos);
+    CHECK(point >= 0, false);
+    const GZipIndexAccessPoint& here = index->points[point];
+
+    // inflate the last bytes before the position through the seek buffer to let skipping back from there
+    qint64 bufferStart = qMax(here.out, pos - BUFLEN);
+    rewinded = 0;
+    buf->clear();
+    CHECK(z->skip(here, bufferStart), false);
+    return readThrough(pos - bufferStart);
+}
+
+bool ZlibAdapter::loadStoredIndex() const {
+    CHECK(NULL == index, true);
+    CHECK(!storedIndexChecked, false);
+    storedIndexChecked = true;
+    // only a file opened for reading can have a stored index
+    CHECK(NULL != buf && NULL != qobject_cast<LocalFileAdapter*>(io), false);
+
+    bool indexLoaded = false;
+    GZipIndex storedIndex = loadGzipIndex(io->getURL(), &indexLoaded);
+    CHECK(indexLoaded, false);
+    index = new GZipIndex(storedIndex);
+    return true;
+}
+
+bool ZlibAdapter::prepareIndex() {
+    CHECK(NULL == index, true);
+    CHECK(!indexFailed, false);
+    CHECK(!loadStoredIndex(), true);
+    indexFailed = true;
+
+    LocalFileAdapterFactory* factory = qobject_cast<LocalFileAdapterFactory*>(io->getFactory());
+    CHECK(NULL != factory && NULL != qobject_cast<LocalFileAdapter*>(io), false);
+    GUrl url = io->getURL();
+
+    LocalFileAdapter indexIO(factory);
+    CHECK(indexIO.open(url, IOAdapterMode_Read), false);
+    bool ok = false;
+    GZipIndex builtIndex = buildGzipIndex(&indexIO, GZipIndex::SPAN, &ok);
+    CHECK(ok, false);
+    // small files are inflated from the beginning fast enough
+    if (builtIndex.points.size() > 1) {
+        storeGzipIndex(builtIndex, url);
+    }
+    index = new GZipIndex(builtIndex);
+    indexFailed = false;
+    return true;
+}
+
+qint64 ZlibAdapter::left() const {
+    CHECK(loadStoredIndex() && index->uncompressedSize >= 0, -1);
+    return index->uncompressedSize - bytesRead();
 }
 
 bool ZlibAdapter::skip( const GZipIndexAccessPoint& point, qint64 offset ) {
     if( NULL == z ) {
         return false;
     }
-    if( !point.window.size() || 0 > offset ) {
+    if( 0 > offset ) {
         return false;
     }
+    rewinded = 0;
+    if( NULL != buf ) {
+        buf->clear();
+    }
     return z->skip( point, offset );
 }
 
@@ -418,7 +553,26 @@ GZipIndex ZlibAdapter::buildGzipIndex( IOAdapter* io, qint64 span, bool* ok ) {
                 return GZipIndex();
             }
             if (ret == Z_STREAM_END) {
-                break;
+                // concatenated gzip members ( e.g. BGZF blocks ) follow: they are started without a window
+                if (strm.avail_in == 0) {
+                    qint64 l = io->readBlock( input, GZipIndex::CHUNK );
+                    if ( -1 == l ) {
+                        setIfYouCan( false, ok );
+                        return GZipIndex();
+                    }
+                    strm.avail_in = l;
+                    strm.next_in = ( Bytef* )&input[0];
+                }
+                if (strm.avail_in == 0) {
+                    break;
+                }
+                if (totout - last > span) {
+                    addMemberAccessPoint(index, totin, totout);
+                    last = totout;
+                }
+                inflateReset(&strm);
+                ret = Z_OK;
+                continue;
             }
             /* if at end of block, consider adding an index entry (note that if
             data_type indicates an end-of-block, then all of the
@@ -437,10 +591,82 @@ GZipIndex ZlibAdapter::buildGzipIndex( IOAdapter* io, qint64 span, bool* ok ) {
     } while (ret != Z_STREAM_END);
 
     (void)inflateEnd(&strm);
+    index.uncompressedSize = totout;
     setIfYouCan( true, ok );
     return index;
 }
 
+int GZipIndex::findAccessPoint( qint64 offset ) const {
+    int low = 0;
+    int high = points.size() - 1;
+    int result = -1;
+    while (low <= high) {
+        int mid = (low + high) / 2;
+        if (points[mid].out <= offset) {
+            result = mid;
+            low = mid + 1;
+        } else {
+            high = mid - 1;
+        }
+    }
+    return result;
+}
+
+QString ZlibAdapter::getGzipIndexUrl( const GUrl& url ) {
+    return url.getURLString() + ".gzidx";
+}
+
+GZipIndex ZlibAdapter::loadGzipIndex( const GUrl& url, bool* ok ) {
+    setIfYouCan( false, ok );
+    QFileInfo fileInfo( url.getURLString() );
+    QFile indexFile( getGzipIndexUrl( url ) );
+    CHECK( fileInfo.exists() && indexFile.open( QIODevice::ReadOnly ), GZipIndex() );
+
+    QDataStream stream( &indexFile );
+    quint32 magic = 0;
+    qint32 version = 0;
+    qint64 fileSize = 0;
+    uint modified = 0;
+    stream >> magic >> version >> fileSize >> modified;
+    CHECK( GZIP_INDEX_MAGIC == magic && GZIP_INDEX_VERSION == version, GZipIndex() );
+    // the file was changed after the index had been built
+    CHECK( fileInfo.size() == fileSize && fileInfo.lastModified().toTime_t() == modified, GZipIndex() );
+
+    GZipIndex index;
+    qint32 pointsCount = 0;
+    stream >> index.uncompressedSize >> pointsCount;
+    CHECK( pointsCount > 0, GZipIndex() );
+    for (int i = 0; i < pointsCount && QDataStream::Ok == stream.status(); i++) {
+        GZipIndexAccessPoint point;
+        qint32 bits = 0;
+        stream >> point.out >> point.in >> bits >> point.window;
+        point.bits = bits;
+        index.points.append( point );
+    }
+    CHECK( QDataStream::Ok == stream.status(), GZipIndex() );
+    setIfYouCan( true, ok );
+    return index;
+}
+
+bool ZlibAdapter::storeGzipIndex( const GZipIndex& index, const GUrl& url ) {
+    QFileInfo fileInfo( url.getURLString() );
+    QFile indexFile( getGzipIndexUrl( url ) );
+    // the directory can be read-only, the index is built again on the next seek then
+    CHECK( fileInfo.exists() && indexFile.open( QIODevice::WriteOnly | QIODevice::Truncate ), false );
+
+    QDataStream stream( &indexFile );
+    stream << GZIP_INDEX_MAGIC << GZIP_INDEX_VERSION << qint64( fileInfo.size() ) << fileInfo.lastModified().toTime_t();
+    stream << index.uncompressedSize << qint32( index.points.size() );
+    foreach (const GZipIndexAccessPoint& point, index.points) {
+        stream << point.out << point.in << qint32( point.bits ) << point.window;
+    }
+    if ( QDataStream::Ok != stream.status() ) {
+        indexFile.remove();
+        return false;
+    }
+    return true;
+}
+
 qint64 ZlibAdapter::getUncompressedFileSizeInBytes(const GUrl &url) {
     QFile file(url.getURLString());
     if (!file.open(QIODevice::ReadOnly)) {
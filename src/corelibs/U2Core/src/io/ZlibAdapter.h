@@ -49,7 +49,11 @@ public:
 
     virtual bool skip(qint64 nBytes);
 
-    virtual qint64 left() const {return -1;}
+    /**
+     * Known only when the file has a stored access point index or the index is built by a backward seek,
+     * otherwise returns -1
+     */
+    virtual qint64 left() const;
 
     virtual int getProgress() const {return io->getProgress();}
 
@@ -65,9 +69,22 @@ public:
     /**
      * on error *ok set to false and GZipIndex() is returned
      * io - opened ioadapter, on the beginning of the file
+     * Concatenated gzip members ( e.g. BGZF blocks ) are indexed too
      */
     static GZipIndex buildGzipIndex( IOAdapter* io, qint64 span, bool* ok = NULL );
 
+    /**
+     * The access point index of a local gzipped file is stored next to the file
+     */
+    static QString getGzipIndexUrl( const GUrl& url );
+
+    /**
+     * on error or if the index is older than the file *ok set to false and GZipIndex() is returned
+     */
+    static GZipIndex loadGzipIndex( const GUrl& url, bool* ok = NULL );
+
+    static bool storeGzipIndex( const GZipIndex& index, const GUrl& url );
+
     /**
      * returns -1 if a file is failed to open
      */
@@ -76,26 +93,43 @@ public:
     virtual QString errorString() const;
 
 private:
+    // loads the stored index of the file on the first call, returns false if there is no valid stored index
+    bool loadStoredIndex() const;
+    // loads the stored index of the file or builds and stores it, returns false for non-local files
+    bool prepareIndex();
+    // seeks to any position of the uncompressed data using the access point index
+    bool seek(qint64 pos);
+    bool readThrough(qint64 nBytes);
+
     static const int BUFLEN = 32768;
     IOAdapter* io;
     GzipUtil* z;
     RingBuffer* buf; // seek buffer
     int rewinded; // how much should read from seek buffer
+    mutable GZipIndex* index; // random access points, NULL until it is needed
+    mutable bool storedIndexChecked;
+    bool indexFailed;
 };
 
 struct GZipIndexAccessPoint {
     qint64     out;    // corresponding offset in uncompressed data
     qint64     in;     // offset in input file of first full byte
     int        bits;   // number of bits (1-7) from byte at in - 1, or 0
-    QByteArray window; //preceding WINSIZE of uncompressed data
+    QByteArray window; // compressed preceding WINSIZE of uncompressed data, empty if the point is a gzip member start
 };
 
 struct U2CORE_EXPORT GZipIndex {
+    GZipIndex() : uncompressedSize(-1) {}
+
     static const int    WINSIZE = 32768;
     static const qint64 SPAN    = 1048576L;
     static const int    CHUNK   = 16384;
 
+    // returns the number of the last point before @offset or -1
+    int findAccessPoint( qint64 offset ) const;
+
     QList< GZipIndexAccessPoint > points;
+    qint64 uncompressedSize;
 }; // GZipIndex
 
 };//namespace
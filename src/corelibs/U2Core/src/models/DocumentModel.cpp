@@ -36,6 +36,7 @@
 #include <U2Core/IOAdapter.h>
 #include <U2Core/L10n.h>
 #include <U2Core/Log.h>
+#include <U2Core/MappedFileAdapter.h>
 #include <U2Core/Task.h>
 #include <U2Core/U2Dbi.h>
 #include <U2Core/U2DbiRegistry.h>
@@ -85,10 +86,21 @@ Document* DocumentFormat::createNewUnloadedDocument(IOAdapterFactory* iof, const
 }
 
 Document* DocumentFormat::loadDocument(IOAdapterFactory* iof, const GUrl& url, const QVariantMap& hints, U2OpStatus& os) {
-    QScopedPointer<IOAdapter> io(iof->createIOAdapter());
-    if (!io->open(url, IOAdapterMode_Read)) {
-        os.setError(L10N::errorOpeningFileRead(url));
-        return NULL;
+    QScopedPointer<IOAdapter> io;
+    if (MappedFileAdapterFactory::isMappingPreferable(iof, url)) {
+        // the adapter reports 'iof' as its factory: the loaded document is stored with the regular adapter
+        io.reset(new MappedFileAdapter(iof));
+        if (!io->open(url, IOAdapterMode_Read)) {
+            coreLog.trace(QString("Failed to map file into memory, it is read in the regular way: %1").arg(url.getURLString()));
+            io.reset();
+        }
+    }
+    if (io.isNull()) {
+        io.reset(iof->createIOAdapter());
+        if (!io->open(url, IOAdapterMode_Read)) {
+            os.setError(L10N::errorOpeningFileRead(url));
+            return NULL;
+        }
     }
 
     Document* res = NULL;
@@ -157,7 +157,7 @@ QVector<U2Region> SequenceWalkerTask::splitRange(const U2Region& range, int chun
 //////////////////////////////////////////////////////////////////////////
 // subtask
 SequenceWalkerSubtask::SequenceWalkerSubtask(SequenceWalkerTask* _t, const U2Region& glob, bool lo, bool ro, const char* _seq, int _len, bool _doCompl, bool _doAmino)
-: Task(tr("Sequence walker subtask"), TaskFlag_None),
+: Task(tr("Sequence walker subtask"), TaskFlag_RunInWorkerPool),
 t(_t), globalRegion(glob), localSeq(_seq), originalLocalSeq(_seq),
 localLen(_len), originalLocalLen(_len), doCompl(_doCompl), doAmino(_doAmino),
 leftOverlap(lo), rightOverlap(ro)
@@ -21,6 +21,9 @@
 
 #include <U2Core/L10n.h>
 #include <U2Core/U2AssemblyDbi.h>
+#include <U2Core/U2AttributeDbi.h>
+#include <U2Core/U2AttributeUtils.h>
+#include <U2Core/U2CoreAttributes.h>
 #include <U2Core/U2DbiUtils.h>
 #include <U2Core/U2OpStatusUtils.h>
 #include <U2Core/U2SafePoints.h>
@@ -29,9 +32,45 @@
 
 namespace U2 {
 
+namespace {
+
+/** Passes reads through and collects their coverage */
+class CoverageCollectingIterator : public U2DbiIterator<U2AssemblyRead> {
+public:
+    CoverageCollectingIterator(U2DbiIterator<U2AssemblyRead> *readsIterator, U2AssemblyBinnedCoverage &binnedCoverage) :
+        readsIterator(readsIterator),
+        binnedCoverage(binnedCoverage)
+    {
+
+    }
+
+    bool hasNext() {
+        return readsIterator->hasNext();
+    }
+
+    U2AssemblyRead next() {
+        U2AssemblyRead read = readsIterator->next();
+        if (NULL != read.constData()) {
+            binnedCoverage.addRead(read);
+        }
+        return read;
+    }
+
+    U2AssemblyRead peek() {
+        return readsIterator->peek();
+    }
+
+private:
+    U2DbiIterator<U2AssemblyRead> *readsIterator;
+    U2AssemblyBinnedCoverage &binnedCoverage;
+};
+
+}   // namespace
+
 AssemblyImporter::AssemblyImporter(U2OpStatus &os) :
     os(os),
-    objectExists(false)
+    objectExists(false),
+    binnedCoverageComplete(false)
 {
 
 }
@@ -40,7 +79,8 @@ AssemblyImporter::AssemblyImporter(const U2DbiRef &dbiRef, U2Assembly &assembly,
     dbiRef(dbiRef),
     assembly(assembly),
     os(os),
-    objectExists(true)
+    objectExists(true),
+    binnedCoverageComplete(false)
 {
 
 }
@@ -68,10 +108,16 @@ void AssemblyImporter::createAssembly(const U2DbiRef &dbiRef, const QString &fol
     U2AssemblyDbi *assemblyDbi = connection.dbi->getAssemblyDbi();
     SAFE_POINT(NULL != assemblyDbi, L10N::nullPointerError("assembly dbi"), );
 
-    assemblyDbi->createAssemblyObject(assembly, canonicalFolder, readsIterator, importInfo, os);
+    if (NULL != readsIterator) {
+        CoverageCollectingIterator coverageIterator(readsIterator, binnedCoverage);
+        assemblyDbi->createAssemblyObject(assembly, canonicalFolder, &coverageIterator, importInfo, os);
+    } else {
+        assemblyDbi->createAssemblyObject(assembly, canonicalFolder, NULL, importInfo, os);
+    }
 
     this->assembly = assembly;
     objectExists = true;
+    binnedCoverageComplete = true;
 }
 
 void AssemblyImporter::addReads(U2DbiIterator<U2AssemblyRead> *readsIterator) {
@@ -86,7 +132,11 @@ void AssemblyImporter::addReads(U2DbiIterator<U2AssemblyRead> *readsIterator) {
     U2AssemblyDbi *assemblyDbi = connection.dbi->getAssemblyDbi();
     SAFE_POINT(NULL != assemblyDbi, L10N::nullPointerError("assembly dbi"), );
 
-    assemblyDbi->addReads(assembly.id, readsIterator, os);
+    // the dbi removes the stored coverage when the reads are added
+    takeStoredBinnedCoverage(connection);
+
+    CoverageCollectingIterator coverageIterator(readsIterator, binnedCoverage);
+    assemblyDbi->addReads(assembly.id, &coverageIterator, os);
 }
 
 void AssemblyImporter::packReads(U2AssemblyReadsImportInfo &importInfo) {
@@ -129,9 +179,49 @@ void AssemblyImporter::finalizeAssembly() {
         Q_ASSERT(false);
     }
 
+    saveBinnedCoverage(connection);
+
     U2AssemblyDbi *assemblyDbi = connection.dbi->getAssemblyDbi();
     SAFE_POINT(NULL != assemblyDbi, L10N::nullPointerError("assembly dbi"), );
     assemblyDbi->finalizeAssemblyObject(assembly, os);
 }
 
+void AssemblyImporter::takeStoredBinnedCoverage(const DbiConnection &connection) {
+    // the coverage of the reads that were in the assembly before is unknown if it is not stored
+    CHECK(!binnedCoverageComplete, );
+    U2AttributeDbi *attributeDbi = connection.dbi->getAttributeDbi();
+    CHECK(NULL != attributeDbi, );
+
+    U2OpStatusImpl innerOs;
+    U2ByteArrayAttribute attribute = U2AttributeUtils::findByteArrayAttribute(attributeDbi, assembly.id, U2BaseAttributeName::binned_coverage, innerOs);
+    CHECK_OP_EXT(innerOs, coreLog.details(innerOs.getError()), );
+    CHECK(attribute.hasValidId(), );
+
+    const U2AssemblyBinnedCoverage storedCoverage = U2AssemblyBinnedCoverage::deserialize(attribute.value, innerOs);
+    CHECK_OP_EXT(innerOs, coreLog.details(innerOs.getError()), );
+    binnedCoverage.merge(storedCoverage);
+    binnedCoverageComplete = true;
+}
+
+void AssemblyImporter::saveBinnedCoverage(const DbiConnection &connection) {
+    CHECK(!os.isCoR(), );
+    CHECK(binnedCoverageComplete && !binnedCoverage.isEmpty(), );
+
+    U2AttributeDbi *attributeDbi = connection.dbi->getAttributeDbi();
+    CHECK(NULL != attributeDbi, );
+
+    U2OpStatusImpl innerOs;
+    U2AssemblyBinnedCoverage::removeStored(attributeDbi, assembly.id, innerOs);
+    CHECK_OP_EXT(innerOs, coreLog.details(innerOs.getError()), );
+
+    U2ByteArrayAttribute coverageAttribute;
+    U2AttributeUtils::init(coverageAttribute, assembly, U2BaseAttributeName::binned_coverage);
+    coverageAttribute.value = binnedCoverage.serialize();
+    attributeDbi->createByteArrayAttribute(coverageAttribute, innerOs);
+    CHECK_OP_EXT(innerOs, coreLog.details(innerOs.getError()), );
+
+    binnedCoverage = U2AssemblyBinnedCoverage();
+    binnedCoverageComplete = false;
+}
+
 }   // namespace U2
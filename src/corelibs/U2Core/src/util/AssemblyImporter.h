@@ -24,9 +24,11 @@
 
 #include <U2Core/AssemblyObject.h>
 #include <U2Core/U2Assembly.h>
+#include <U2Core/U2AssemblyBinnedCoverage.h>
 
 namespace U2 {
 
+class DbiConnection;
 class U2AssemblyReadsImportInfo;
 
 class U2CORE_EXPORT AssemblyImporter {
@@ -47,11 +49,19 @@ public:
 
 private:
     void finalizeAssembly();
+    // adds the stored coverage of the existing reads to the collected one
+    void takeStoredBinnedCoverage(const DbiConnection &connection);
+    void saveBinnedCoverage(const DbiConnection &connection);
 
     U2DbiRef dbiRef;
     U2Assembly assembly;
     U2OpStatus &os;
     bool objectExists;
+
+    // coverage of the reads imported by this importer
+    U2AssemblyBinnedCoverage binnedCoverage;
+    // true if all reads of the assembly were imported by this importer
+    bool binnedCoverageComplete;
 };
 
 }   // namespace U2
@@ -0,0 +1,100 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include <U2Core/MsaRowGapIndex.h>
+#include <U2Core/U2SafePoints.h>
+
+#include "MaColumnSnapshot.h"
+
+namespace U2 {
+
+const char MaColumnSnapshot::LEADING_OR_TRAILING_GAP_CHAR = '\0';
+const int MaColumnSnapshot::ROWS_BLOCK_SIZE = 64;
+
+MaColumnSnapshot::MaColumnSnapshot(const MultipleAlignment &ma, const U2Region &_region, const QVector<int> &rowIndexes, bool markLeadingAndTrailingGaps)
+    : region(_region),
+      rowsCount(rowIndexes.isEmpty() ? ma->getNumRows() : rowIndexes.size())
+{
+    CHECK(rowsCount > 0 && !region.isEmpty(), );
+    data.resize(int(region.length * rowsCount));
+    char *columns = data.data();
+
+    QList<MsaRowColumnIterator> iterators;
+    QVector<qint64> coreStarts;
+    QVector<qint64> coreEnds;
+    for (int blockStart = 0; blockStart < rowsCount; blockStart += ROWS_BLOCK_SIZE) {
+        const int blockSize = qMin(ROWS_BLOCK_SIZE, rowsCount - blockStart);
+        iterators.clear();
+        coreStarts.clear();
+        coreEnds.clear();
+        for (int i = 0; i < blockSize; i++) {
+            const MultipleAlignmentRow &row = ma->getRow(rowIndexes.isEmpty() ? blockStart + i : rowIndexes[blockStart + i]);
+            iterators << row->getColumnIterator(region.startPos);
+            coreStarts << (markLeadingAndTrailingGaps ? row->getCoreStart() : qint64(0));
+            coreEnds << (markLeadingAndTrailingGaps ? row->getCoreEnd() : region.endPos());
+        }
+
+        // every column of the block is written contiguously
+        for (qint64 column = region.startPos; column < region.endPos(); column++) {
+            char *columnData = columns + (column - region.startPos) * rowsCount + blockStart;
+            for (int i = 0; i < blockSize; i++) {
+                const char c = iterators[i].next();
+                columnData[i] = (column < coreStarts[i] || column >= coreEnds[i]) ? LEADING_OR_TRAILING_GAP_CHAR : c;
+            }
+        }
+    }
+}
+
+const U2Region & MaColumnSnapshot::getRegion() const {
+    return region;
+}
+
+int MaColumnSnapshot::getRowsCount() const {
+    return rowsCount;
+}
+
+const char * MaColumnSnapshot::getColumn(qint64 column) const {
+    SAFE_POINT(region.contains(column), "Column is out of the snapshot region", NULL);
+    return data.constData() + (column - region.startPos) * rowsCount;
+}
+
+void MaColumnSnapshot::countChars(const char *chars, int count, int *freqs) {
+    // four interleaved counters break the dependency between consecutive increments of the same counter
+    int freqs1[256] = {0};
+    int freqs2[256] = {0};
+    int freqs3[256] = {0};
+    const uchar *data = reinterpret_cast<const uchar *>(chars);
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        freqs[data[i]]++;
+        freqs1[data[i + 1]]++;
+        freqs2[data[i + 2]]++;
+        freqs3[data[i + 3]]++;
+    }
+    for (; i < count; i++) {
+        freqs[data[i]]++;
+    }
+    for (int c = 0; c < 256; c++) {
+        freqs[c] += freqs1[c] + freqs2[c] + freqs3[c];
+    }
+}
+
+}   // namespace U2
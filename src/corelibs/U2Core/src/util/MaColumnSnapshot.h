@@ -0,0 +1,68 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef _U2_MA_COLUMN_SNAPSHOT_H_
+#define _U2_MA_COLUMN_SNAPSHOT_H_
+
+#include <QVector>
+
+#include <U2Core/MultipleAlignment.h>
+#include <U2Core/U2Region.h>
+
+namespace U2 {
+
+/**
+ * An immutable copy of the alignment columns stored column by column:
+ * the characters of a column are contiguous, so column algorithms (e.g. consensus) read them without
+ * a per-character virtual call and a gap model lookup.
+ * The rows are read sequentially with MsaRowColumnIterator, in blocks, to keep the transposition cache friendly.
+ */
+class U2CORE_EXPORT MaColumnSnapshot {
+public:
+    /**
+     * Copies the 'region' columns of the rows with 'rowIndexes' (all rows if the list is empty).
+     * If 'markLeadingAndTrailingGaps' is true, leading and trailing gaps of the rows are stored as LEADING_OR_TRAILING_GAP_CHAR.
+     */
+    MaColumnSnapshot(const MultipleAlignment &ma, const U2Region &region, const QVector<int> &rowIndexes = QVector<int>(), bool markLeadingAndTrailingGaps = false);
+
+    const U2Region & getRegion() const;
+    int getRowsCount() const;
+
+    /** Returns getRowsCount() characters of the alignment column, 'column' is a position in the alignment */
+    const char * getColumn(qint64 column) const;
+
+    /** Adds the number of every character of 'chars' to 'freqs' that must have 256 elements */
+    static void countChars(const char *chars, int count, int *freqs);
+
+    static const char LEADING_OR_TRAILING_GAP_CHAR;
+
+    /** Rows are transposed by blocks of this size */
+    static const int ROWS_BLOCK_SIZE;
+
+private:
+    U2Region region;
+    int rowsCount;
+    QByteArray data;
+};
+
+}   // namespace U2
+
+#endif // _U2_MA_COLUMN_SNAPSHOT_H_
@@ -24,7 +24,7 @@
 
 #include <QVariantMap>
 
-#include <U2Core/global.h>
+#include <U2Core/U2Region.h>
 
 namespace U2 {
 
@@ -45,6 +45,9 @@ public:
     bool alphabetChanged;
     QVariantMap hints;
     QList<qint64> modifiedRowIds;
+    // Columns that could be changed by the modification, may exceed the alignment length.
+    // An empty list means that any column could be changed.
+    QList<U2Region> modifiedColumns;
     MaModificationType type;
 
 private:
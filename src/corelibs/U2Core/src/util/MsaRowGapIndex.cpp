@@ -0,0 +1,151 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include <algorithm>
+
+#include <U2Core/U2SafePoints.h>
+
+#include "MsaRowGapIndex.h"
+
+namespace U2 {
+
+//////////////////////////////////////////////////////////////////////////
+/// MsaRowGapIndex
+MsaRowGapIndex::MsaRowGapIndex(const U2MsaRowGapModel &gaps)
+    : gaps(gaps)
+{
+    gapStarts.reserve(gaps.size());
+    gapEnds.reserve(gaps.size());
+    gapsLengthBefore.reserve(gaps.size() + 1);
+
+    qint64 gapsLength = 0;
+    gapsLengthBefore << gapsLength;
+    foreach (const U2MsaGap &gap, gaps) {
+        gapStarts << gap.offset;
+        gapEnds << gap.offset + gap.gap;
+        gapsLength += gap.gap;
+        gapsLengthBefore << gapsLength;
+    }
+}
+
+int MsaRowGapIndex::getGapsLength() const {
+    return int(gapsLengthBefore.last());
+}
+
+bool MsaRowGapIndex::isBuiltFor(const U2MsaRowGapModel &gaps) const {
+    return this->gaps.constBegin() == gaps.constBegin() && this->gaps.size() == gaps.size();
+}
+
+bool MsaRowGapIndex::isGap(int dataLength, qint64 position) const {
+    const int gapsBefore = countGapsStartedBefore(position);
+    if (gapsBefore > 0 && position < gapEnds[gapsBefore - 1]) {
+        return true;
+    }
+    if (gapsBefore < gapStarts.size()) {
+        // there is a gap further in the row, so the position is not in the trailing gap
+        return false;
+    }
+    return dataLength + gapsLengthBefore.last() <= position;
+}
+
+char MsaRowGapIndex::charAt(const QByteArray &seq, qint64 position) const {
+    if (position < 0 || position >= seq.length() + gapsLengthBefore.last()) {
+        return U2Msa::GAP_CHAR;
+    }
+
+    const int gapsBefore = countGapsStartedBefore(position);
+    if (gapsBefore > 0 && position < gapEnds[gapsBefore - 1]) {
+        return U2Msa::GAP_CHAR;
+    }
+
+    const qint64 positionInSeq = position - gapsLengthBefore[gapsBefore];
+    if (positionInSeq >= seq.length()) {
+        return U2Msa::GAP_CHAR;
+    }
+    return seq[int(positionInSeq)];
+}
+
+int MsaRowGapIndex::countGapsStartedBefore(qint64 position) const {
+    return int(std::upper_bound(gapStarts.constBegin(), gapStarts.constEnd(), position) - gapStarts.constBegin());
+}
+
+//////////////////////////////////////////////////////////////////////////
+/// MsaRowGapIndexCache
+const int MsaRowGapIndexCache::MIN_GAPS_COUNT_TO_INDEX = 16;
+
+void MsaRowGapIndexCache::update(const U2MsaRowGapModel &gaps) {
+    if (gaps.size() < MIN_GAPS_COUNT_TO_INDEX) {
+        index.clear();
+        return;
+    }
+    CHECK(index.isNull() || !index->isBuiltFor(gaps), );
+    index = QSharedPointer<const MsaRowGapIndex>(new MsaRowGapIndex(gaps));
+}
+
+const MsaRowGapIndex * MsaRowGapIndexCache::getIndex(const U2MsaRowGapModel &gaps) const {
+    CHECK(!index.isNull() && index->isBuiltFor(gaps), NULL);
+    return index.data();
+}
+
+//////////////////////////////////////////////////////////////////////////
+/// MsaRowColumnIterator
+MsaRowColumnIterator::MsaRowColumnIterator(const QByteArray &seq, const U2MsaRowGapModel &gaps, qint64 startPosition)
+    : seq(seq),
+      gaps(gaps),
+      position(startPosition),
+      positionInSeq(qMax(qint64(0), startPosition)),
+      gapIndex(0)
+{
+    foreach (const U2MsaGap &gap, gaps) {
+        if (gap.offset + gap.gap <= position) {
+            positionInSeq -= gap.gap;
+            gapIndex++;
+            continue;
+        }
+        if (gap.offset <= position) {
+            // inside the gap: the next sequence character follows the gap
+            positionInSeq -= position - gap.offset;
+        }
+        break;
+    }
+}
+
+qint64 MsaRowColumnIterator::getPosition() const {
+    return position;
+}
+
+char MsaRowColumnIterator::next() {
+    char result = U2Msa::GAP_CHAR;
+    if (position >= 0) {
+        if (gapIndex < gaps.size() && position >= gaps[gapIndex].offset) {
+            if (position + 1 >= gaps[gapIndex].offset + gaps[gapIndex].gap) {
+                gapIndex++;
+            }
+        } else if (positionInSeq < seq.length()) {
+            result = seq[int(positionInSeq)];
+            positionInSeq++;
+        }
+    }
+    position++;
+    return result;
+}
+
+}   // namespace U2
@@ -0,0 +1,110 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef _U2_MSA_ROW_GAP_INDEX_H_
+#define _U2_MSA_ROW_GAP_INDEX_H_
+
+#include <QSharedPointer>
+#include <QVector>
+
+#include <U2Core/U2Msa.h>
+
+namespace U2 {
+
+/**
+ * Prefix sums of a row gap model: a position is looked up with a binary search instead of walking the gap list.
+ * The results are the same as the results of the corresponding MsaRowUtils methods.
+ */
+class U2CORE_EXPORT MsaRowGapIndex {
+public:
+    MsaRowGapIndex(const U2MsaRowGapModel &gaps);
+
+    int getGapsLength() const;
+
+    /**
+     * Returns true if the index was built for this gap model.
+     * The index holds a shallow copy of the gap model, so any modification of the model detaches it.
+     */
+    bool isBuiltFor(const U2MsaRowGapModel &gaps) const;
+
+    /** The same as MsaRowUtils::isGap() */
+    bool isGap(int dataLength, qint64 position) const;
+
+    /** The same as MsaRowUtils::charAt() */
+    char charAt(const QByteArray &seq, qint64 position) const;
+
+private:
+    /** Returns the number of gaps that start at 'position' or before it */
+    int countGapsStartedBefore(qint64 position) const;
+
+    U2MsaRowGapModel gaps;
+    QVector<qint64> gapStarts;
+    QVector<qint64> gapEnds;
+    // gapsLengthBefore[i] is the length of gaps [0, i)
+    QVector<qint64> gapsLengthBefore;
+};
+
+/**
+ * Keeps the index of a row gap model.
+ * The index is rebuilt by the row owner after each modification of the gap model,
+ * readers only check that the index is actual: getIndex() doesn't lock and doesn't modify the cache.
+ * Rows with a few gaps are not indexed: the linear search is fast enough for them.
+ */
+class U2CORE_EXPORT MsaRowGapIndexCache {
+public:
+    /** Rebuilds the index if it was built for another gap model */
+    void update(const U2MsaRowGapModel &gaps);
+
+    /** Returns NULL if the gap model is not indexed or the index was not updated after the model modification */
+    const MsaRowGapIndex * getIndex(const U2MsaRowGapModel &gaps) const;
+
+    static const int MIN_GAPS_COUNT_TO_INDEX;
+
+private:
+    // the index is immutable, so the row copies share it
+    QSharedPointer<const MsaRowGapIndex> index;
+};
+
+/**
+ * Sequential access to the row characters (including leading and trailing gaps):
+ * each call of next() takes constant time instead of a search in the gap model.
+ */
+class U2CORE_EXPORT MsaRowColumnIterator {
+public:
+    MsaRowColumnIterator(const QByteArray &seq, const U2MsaRowGapModel &gaps, qint64 startPosition = 0);
+
+    /** Returns the position of the character that will be returned by the next call of next() */
+    qint64 getPosition() const;
+
+    /** Returns the character at the current position and moves to the next position */
+    char next();
+
+private:
+    QByteArray seq;
+    U2MsaRowGapModel gaps;
+    qint64 position;
+    qint64 positionInSeq;
+    int gapIndex;
+};
+
+}   // namespace U2
+
+#endif // _U2_MSA_ROW_GAP_INDEX_H_
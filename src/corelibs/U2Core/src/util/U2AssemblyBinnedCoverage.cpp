@@ -0,0 +1,161 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include <QDataStream>
+
+#include <U2Core/U2AttributeDbi.h>
+#include <U2Core/U2CoreAttributes.h>
+#include <U2Core/U2SafePoints.h>
+
+#include "U2AssemblyBinnedCoverage.h"
+
+namespace U2 {
+
+const qint64 U2AssemblyBinnedCoverage::BIN_SIZE = 64;
+const qint64 U2AssemblyBinnedCoverage::MIN_POINT_LENGTH = 64 * BIN_SIZE;
+
+static const quint32 BINNED_COVERAGE_FORMAT_VERSION = 1;
+
+U2AssemblyBinnedCoverage::U2AssemblyBinnedCoverage()
+    : prefixSums(false)
+{
+}
+
+bool U2AssemblyBinnedCoverage::isEmpty() const {
+    return starts.isEmpty();
+}
+
+void U2AssemblyBinnedCoverage::addRead(const U2AssemblyRead &read) {
+    CHECK(read->leftmostPos >= 0 && read->effectiveLen > 0, );
+    toCounts();
+
+    const qint64 firstBin = read->leftmostPos / BIN_SIZE;
+    const qint64 lastBin = (read->leftmostPos + read->effectiveLen - 1) / BIN_SIZE;
+    ensureBins(lastBin + 1);
+    starts[int(firstBin)]++;
+    ends[int(lastBin)]++;
+}
+
+void U2AssemblyBinnedCoverage::merge(const U2AssemblyBinnedCoverage &other) {
+    U2AssemblyBinnedCoverage otherCounts = other;
+    otherCounts.toCounts();
+    toCounts();
+
+    ensureBins(otherCounts.starts.size());
+    for (int i = 0; i < otherCounts.starts.size(); i++) {
+        starts[i] += otherCounts.starts[i];
+        ends[i] += otherCounts.ends[i];
+    }
+}
+
+bool U2AssemblyBinnedCoverage::getCoverage(const U2Region &region, U2AssemblyCoverageStat &coverage) {
+    const int pointsCount = coverage.size();
+    CHECK(pointsCount > 0 && !region.isEmpty() && region.startPos >= 0, false);
+    CHECK(region.length / pointsCount >= MIN_POINT_LENGTH, false);
+    toPrefixSums();
+
+    // starts[i] is the number of reads that start before the bin i, ends[i] is the number of reads that end before it
+    const qint64 binsCount = starts.size();
+    for (int i = 0; i < pointsCount; i++) {
+        const qint64 pointStart = region.startPos + region.length * i / pointsCount;
+        const qint64 pointEnd = region.startPos + region.length * (i + 1) / pointsCount;
+        const qint64 firstBin = qMin(binsCount - 1, (pointStart + BIN_SIZE / 2) / BIN_SIZE);
+        const qint64 endBin = qMin(binsCount - 1, (pointEnd + BIN_SIZE / 2) / BIN_SIZE);
+        // the reads that start before the point end minus the reads that end before the point start
+        coverage[i] = qint32(starts[int(endBin)] - ends[int(firstBin)]);
+    }
+    return true;
+}
+
+QByteArray U2AssemblyBinnedCoverage::serialize() {
+    toCounts();
+
+    QByteArray data;
+    QDataStream stream(&data, QIODevice::WriteOnly);
+    stream << BINNED_COVERAGE_FORMAT_VERSION << BIN_SIZE << starts << ends;
+    return data;
+}
+
+U2AssemblyBinnedCoverage U2AssemblyBinnedCoverage::deserialize(const QByteArray &data, U2OpStatus &os) {
+    U2AssemblyBinnedCoverage result;
+    QDataStream stream(data);
+
+    quint32 version = 0;
+    stream >> version;
+    CHECK_EXT(QDataStream::Ok == stream.status(), os.setError("Invalid binned coverage data"), result);
+    CHECK_EXT(BINNED_COVERAGE_FORMAT_VERSION == version, os.setError("Unsupported binned coverage format"), result);
+
+    qint64 binSize = 0;
+    QVector<quint32> starts;
+    QVector<quint32> ends;
+    stream >> binSize >> starts >> ends;
+    CHECK_EXT(QDataStream::Ok == stream.status(), os.setError("Invalid binned coverage data"), result);
+    CHECK_EXT(BIN_SIZE == binSize && starts.size() == ends.size(), os.setError("Unsupported binned coverage format"), result);
+
+    result.starts = starts;
+    result.ends = ends;
+    return result;
+}
+
+void U2AssemblyBinnedCoverage::removeStored(U2AttributeDbi *attributeDbi, const U2DataId &assemblyId, U2OpStatus &os) {
+    CHECK(NULL != attributeDbi, );
+    const QList<U2DataId> attributeIds = attributeDbi->getObjectAttributes(assemblyId, U2BaseAttributeName::binned_coverage, os);
+    CHECK_OP(os, );
+    CHECK(!attributeIds.isEmpty(), );
+    attributeDbi->removeAttributes(attributeIds, os);
+}
+
+void U2AssemblyBinnedCoverage::ensureBins(qint64 binsCount) {
+    // one more bin keeps the total sums when the counts are converted to the prefix sums
+    CHECK(starts.size() < binsCount + 1, );
+    starts.resize(int(binsCount + 1));
+    ends.resize(int(binsCount + 1));
+}
+
+void U2AssemblyBinnedCoverage::toCounts() {
+    CHECK(prefixSums, );
+    for (int i = 0; i + 1 < starts.size(); i++) {
+        starts[i] = starts[i + 1] - starts[i];
+        ends[i] = ends[i + 1] - ends[i];
+    }
+    if (!starts.isEmpty()) {
+        starts.last() = 0;
+        ends.last() = 0;
+    }
+    prefixSums = false;
+}
+
+void U2AssemblyBinnedCoverage::toPrefixSums() {
+    CHECK(!prefixSums, );
+    quint32 startsSum = 0;
+    quint32 endsSum = 0;
+    for (int i = 0; i < starts.size(); i++) {
+        const quint32 startsCount = starts[i];
+        const quint32 endsCount = ends[i];
+        starts[i] = startsSum;
+        ends[i] = endsSum;
+        startsSum += startsCount;
+        endsSum += endsCount;
+    }
+    prefixSums = true;
+}
+
+}   // namespace U2
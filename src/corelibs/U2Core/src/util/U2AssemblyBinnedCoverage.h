@@ -0,0 +1,85 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef _U2_ASSEMBLY_BINNED_COVERAGE_H_
+#define _U2_ASSEMBLY_BINNED_COVERAGE_H_
+
+#include <U2Core/U2Assembly.h>
+#include <U2Core/U2OpStatus.h>
+#include <U2Core/U2Region.h>
+
+namespace U2 {
+
+class U2AttributeDbi;
+
+/**
+    Coverage summary of an assembly: for every bin of BIN_SIZE bases it stores
+    the number of reads that start in the bin and the number of reads that end in it.
+    The number of reads that intersect any range of bins is the difference of two prefix sums,
+    so the coverage of a large region is taken in the same "reads that intersect the point" terms
+    as U2AssemblyDbi::calculateCoverage() does, without scanning the reads.
+    The summary is computed once when reads are imported and is stored in the dbi as an attribute.
+    The assembly dbis remove the attribute when reads are added or removed later.
+*/
+class U2CORE_EXPORT U2AssemblyBinnedCoverage {
+public:
+    U2AssemblyBinnedCoverage();
+
+    bool isEmpty() const;
+
+    void addRead(const U2AssemblyRead &read);
+
+    /** Adds the reads collected by the other summary */
+    void merge(const U2AssemblyBinnedCoverage &other);
+
+    /**
+        Fills every point of the coverage vector with the number of reads that intersect the region part that the point represents.
+        The point borders are rounded to the nearest bin borders, so the reads that start or end
+        within BIN_SIZE / 2 bases of a border can be assigned to the neighbour point.
+        Returns false if a point is shorter than MIN_POINT_LENGTH: the rounding is noticeable there,
+        the coverage must be calculated from the reads.
+    */
+    bool getCoverage(const U2Region &region, U2AssemblyCoverageStat &coverage);
+
+    QByteArray serialize();
+    static U2AssemblyBinnedCoverage deserialize(const QByteArray &data, U2OpStatus &os);
+
+    /** Removes the stored coverage of the assembly: it is not valid when the reads are changed */
+    static void removeStored(U2AttributeDbi *attributeDbi, const U2DataId &assemblyId, U2OpStatus &os);
+
+    static const qint64 BIN_SIZE;
+    static const qint64 MIN_POINT_LENGTH;
+
+private:
+    void ensureBins(qint64 binsCount);
+    void toCounts();
+    void toPrefixSums();
+
+    // per-bin counts or, if 'prefixSums' is set, the number of reads that start (end) before the bin.
+    // The prefix sums are unsigned: their difference is correct even if a sum overflows
+    QVector<quint32> starts;
+    QVector<quint32> ends;
+    bool prefixSums;
+};
+
+}   // namespace U2
+
+#endif // _U2_ASSEMBLY_BINNED_COVERAGE_H_
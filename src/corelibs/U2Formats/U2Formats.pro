@@ -16,12 +16,15 @@ HEADERS += src/ABIFormat.h \
            src/EMBLGenbankAbstractDocument.h \
            src/EMBLPlainTextFormat.h \
            src/FastaFormat.h \
+           src/FastaIndex.h \
            src/FastqFormat.h \
+           src/FastqRecordReader.h \
            src/FpkmTrackingFormat.h \
            src/GenbankLocationParser.h \
            src/GenbankPlainTextFormat.h \
            src/GFFFormat.h \
            src/GTFFormat.h \
+           src/IndexedFastaDbi.h \
            src/IOLibUtils.h \
            src/MegaFormat.h \
            src/MSFFormat.h \
@@ -49,6 +52,12 @@ HEADERS += src/ABIFormat.h \
            src/ace/AceImporter.h \
            src/ace/CloneAssemblyWithReferenceToDbiTask.h \
            src/ace/ConvertAceToSqliteTask.h \
+           src/memory_dbi/MemoryAttributeDbi.h \
+           src/memory_dbi/MemoryDbi.h \
+           src/memory_dbi/MemoryFeatureDbi.h \
+           src/memory_dbi/MemoryMsaDbi.h \
+           src/memory_dbi/MemoryObjectDbi.h \
+           src/memory_dbi/MemorySequenceDbi.h \
            src/mysql_dbi/MysqlAssemblyDbi.h \
            src/mysql_dbi/MysqlAttributeDbi.h \
            src/mysql_dbi/MysqlBlobInputStream.h \
@@ -104,6 +113,7 @@ HEADERS += src/ABIFormat.h \
            src/util/AssemblyAdapter.h \
            src/util/AssemblyPackAlgorithm.h \
            src/util/PairedFastqComparator.h \
+           src/util/ParallelBgzfCompressor.h \
            src/util/SnpeffInfoParser.h
 
 SOURCES += src/ABIFormat.cpp \
@@ -121,12 +131,15 @@ SOURCES += src/ABIFormat.cpp \
            src/EMBLGenbankAbstractDocument.cpp \
            src/EMBLPlainTextFormat.cpp \
            src/FastaFormat.cpp \
+           src/FastaIndex.cpp \
            src/FastqFormat.cpp \
+           src/FastqRecordReader.cpp \
            src/FpkmTrackingFormat.cpp \
            src/GenbankLocationParser.cpp \
            src/GenbankPlainTextFormat.cpp \
            src/GFFFormat.cpp \
            src/GTFFormat.cpp \
+           src/IndexedFastaDbi.cpp \
            src/MegaFormat.cpp \
            src/MSFFormat.cpp \
            src/NewickFormat.cpp \
@@ -152,6 +165,12 @@ SOURCES += src/ABIFormat.cpp \
            src/ace/AceImportUtils.cpp \
            src/ace/CloneAssemblyWithReferenceToDbiTask.cpp \
            src/ace/ConvertAceToSqliteTask.cpp \
+           src/memory_dbi/MemoryAttributeDbi.cpp \
+           src/memory_dbi/MemoryDbi.cpp \
+           src/memory_dbi/MemoryFeatureDbi.cpp \
+           src/memory_dbi/MemoryMsaDbi.cpp \
+           src/memory_dbi/MemoryObjectDbi.cpp \
+           src/memory_dbi/MemorySequenceDbi.cpp \
            src/mysql_dbi/MysqlAssemblyDbi.cpp \
            src/mysql_dbi/MysqlAttributeDbi.cpp \
            src/mysql_dbi/MysqlBlobInputStream.cpp \
@@ -206,6 +225,7 @@ SOURCES += src/ABIFormat.cpp \
            src/tasks/MysqlUpgradeTask.cpp \
            src/util/AssemblyPackAlgorithm.cpp \
            src/util/PairedFastqComparator.cpp \
+           src/util/ParallelBgzfCompressor.cpp \
            src/util/SnpeffInfoParser.cpp
 
 RESOURCES += U2Formats.qrc
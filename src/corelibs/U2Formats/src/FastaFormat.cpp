@@ -19,6 +19,7 @@
  * MA 02110-1301, USA.
  */
 
+#include <QFileInfo>
 #include <QTextStream>
 
 #include <U2Core/AnnotationTableObject.h>
@@ -26,9 +27,11 @@
 #include <U2Core/AppResources.h>
 #include <U2Core/DNAAlphabet.h>
 #include <U2Core/DNASequenceObject.h>
+#include <U2Core/DbiConnection.h>
 #include <U2Core/GObjectTypes.h>
 #include <U2Core/IOAdapter.h>
 #include <U2Core/L10n.h>
+#include <U2Core/MappedFileAdapter.h>
 #include <U2Core/MultipleSequenceAlignmentObject.h>
 #include <U2Core/Task.h>
 #include <U2Core/TextUtils.h>
@@ -36,11 +39,14 @@
 #include <U2Core/U2AttributeDbi.h>
 #include <U2Core/U2DbiUtils.h>
 #include <U2Core/U2ObjectDbi.h>
+#include <U2Core/U2OpStatusUtils.h>
 #include <U2Core/U2SafePoints.h>
 #include <U2Core/U2SequenceUtils.h>
 
 #include "DocumentFormatUtils.h"
 #include "FastaFormat.h"
+#include "FastaIndex.h"
+#include "IndexedFastaDbi.h"
 
 namespace U2 {
 
@@ -165,6 +171,9 @@ static void load(IOAdapter* io, const U2DbiRef& dbiRef, const QVariantMap& fs, Q
 
     const int objectsCountLimit = fs.contains(DocumentReadingMode_MaxObjectsInDoc) ? fs[DocumentReadingMode_MaxObjectsInDoc].toInt() : -1;
     const bool settingsMakeUniqueName = !fs.value(DocumentReadingMode_DontMakeUniqueNames, false).toBool();
+
+    // sequence lines of memory-mapped files are passed to the importer directly from the mapped pages
+    MappedFileAdapter* mappedIo = qobject_cast<MappedFileAdapter*>(io);
     while (!os.isCoR()) {
         //skip start comments and read header
         if(!headerReaded){
@@ -206,22 +215,35 @@ static void load(IOAdapter* io, const U2DbiRef& dbiRef, const QVariantMap& fs, Q
         }
         int sequenceLen = 0;
         while (!os.isCoR()) {
+            const char* line = buff;
             do{
-                len = io->readLine(buff, DocumentFormat::READ_BUFF_SIZE);
+                if (mappedIo != NULL) {
+                    len = mappedIo->readLineView(&line, DocumentFormat::READ_BUFF_SIZE);
+                } else {
+                    len = io->readLine(buff, DocumentFormat::READ_BUFF_SIZE);
+                }
             }while(len <= 0 && !io->isEof());
 
             if (len <= 0 && io->isEof()) {
                 break;
             }
-            buff[len] = 0;
 
-            if(buff[0] != fastaCommentStartChar && buff[0] != FastaFormat::FASTA_HEADER_START_SYMBOL){
-                len = TextUtils::remove(buff, len, TextUtils::WHITES);
+            if(line[0] != fastaCommentStartChar && line[0] != FastaFormat::FASTA_HEADER_START_SYMBOL){
+                if (line != buff && TextUtils::contains(TextUtils::WHITES, line, len)) {
+                    len = TextUtils::remove(line, len, buff, TextUtils::WHITES);
+                    line = buff;
+                } else if (line == buff) {
+                    len = TextUtils::remove(buff, len, TextUtils::WHITES);
+                }
                 if(len > 0){
-                    seqImporter.addBlock(buff, len, os);
+                    seqImporter.addBlock(line, len, os);
                     sequenceLen += len;
                 }
-            }else if( buff[0] == FastaFormat::FASTA_HEADER_START_SYMBOL){
+            }else if( line[0] == FastaFormat::FASTA_HEADER_START_SYMBOL){
+                if (line != buff) {
+                    memcpy(buff, line, len);
+                }
+                buff[len] = 0;
                 headerReaded = true;
                 break;
             }
@@ -298,6 +320,96 @@ static void load(IOAdapter* io, const U2DbiRef& dbiRef, const QVariantMap& fs, Q
 }
 
 
+// files of this size are not imported: the sequences are read from the file on demand
+// (DocumentReadingMode_IndexedLoadingMinFileSize overrides the size)
+#define INDEXED_LOADING_MIN_FILE_SIZE (Q_INT64_C(256) * 1024 * 1024)
+// FASTA is usually compressed 3-4 times, the gzipped file size is compared when its data size is unknown
+#define INDEXED_LOADING_GZIP_RATIO 4
+
+static bool isIndexedLoadingApplicable(IOAdapter* io, const QVariantMap& fs, int gapSize) {
+    // merging, case annotations and the folder hint require the data to be in the destination database
+    CHECK(-1 == gapSize, false);
+    CHECK(NO_CASE_ANNS == fs.value(GObjectHint_CaseAnns, NO_CASE_ANNS).toInt(), false);
+    CHECK(!fs.contains(DocumentFormat::DBI_FOLDER_HINT), false);
+
+    const IOAdapterId adapterId = io->getFactory()->getAdapterId();
+    CHECK(BaseIOAdapters::LOCAL_FILE == adapterId || BaseIOAdapters::MAPPED_LOCAL_FILE == adapterId
+          || BaseIOAdapters::GZIPPED_LOCAL_FILE == adapterId, false);
+
+    const qint64 minSize = fs.value(DocumentReadingMode_IndexedLoadingMinFileSize, INDEXED_LOADING_MIN_FILE_SIZE).toLongLong();
+    const qint64 fileSize = QFileInfo(io->getURL().getURLString()).size();
+    CHECK(BaseIOAdapters::GZIPPED_LOCAL_FILE == adapterId, fileSize >= minSize);
+
+    // the stored index knows the uncompressed size
+    if (FastaIndex::hasValidIndex(io->getURL())) {
+        U2OpStatusImpl indexOs;
+        const FastaIndex index = FastaIndex::load(FastaIndex::getIndexUrl(io->getURL()), indexOs);
+        if (!indexOs.hasError()) {
+            return index.getDataSize() >= minSize;
+        }
+    }
+    return fileSize >= minSize / INDEXED_LOADING_GZIP_RATIO;
+}
+
+namespace {
+
+/** Reports the indexing progress to the load task and stops on its cancel, the error is kept to fall back to the import */
+class IndexingOpStatus : public U2OpStatusImpl {
+public:
+    IndexingOpStatus(U2OpStatus& parent) : parent(parent) {}
+
+    virtual bool isCanceled() const {
+        return parent.isCanceled() || U2OpStatusImpl::isCanceled();
+    }
+
+    virtual void setProgress(int v) {
+        parent.setProgress(v);
+        U2OpStatusImpl::setProgress(v);
+    }
+
+private:
+    U2OpStatus& parent;
+};
+
+/** A child of the sequence object: keeps the indexed dbi open, so the index is parsed once for the object lifetime */
+class IndexedFastaDbiConnectionHolder : public QObject {
+public:
+    IndexedFastaDbiConnectionHolder(const DbiConnection& con, QObject* parent) : QObject(parent), con(con) {}
+
+private:
+    DbiConnection con;
+};
+
+}
+
+Document* FastaFormat::loadIndexedDocument(IOAdapter* io, const U2DbiRef& dbiRef, const QVariantMap& fs, U2OpStatus& os) {
+    const U2DbiRef srcDbiRef(IndexedFastaDbiFactory::ID, io->getURL().getURLString());
+    DbiConnection con(srcDbiRef, true, os);
+    CHECK_OP(os, NULL);
+
+    const int objectsCountLimit = fs.contains(DocumentReadingMode_MaxObjectsInDoc) ? fs[DocumentReadingMode_MaxObjectsInDoc].toInt() : -1;
+    QHash<U2DataId, QString> names = con.dbi->getObjectDbi()->getObjectNames(0, U2DbiOptions::U2_DBI_NO_LIMIT, os);
+    CHECK_OP(os, NULL);
+    CHECK_EXT(!names.isEmpty(), os.setError(FastaFormat::tr("Sequence is empty")), NULL);
+    CHECK_EXT(objectsCountLimit <= 0 || names.size() <= objectsCountLimit,
+              os.setError(FastaFormat::tr("File \"%1\" contains too many sequences to be displayed. "
+                                          "However, you can process these data using instruments from the menu <i>Tools -> NGS data analysis</i> "
+                                          "or pipelines built with Workflow Designer.").arg(io->getURL().getURLString())), NULL);
+
+    QList<GObject*> objects;
+    foreach (const U2DataId& id, con.dbi->getObjectDbi()->getObjects(0, U2DbiOptions::U2_DBI_NO_LIMIT, os)) {
+        U2SequenceObject* object = new U2SequenceObject(names.value(id), U2EntityRef(srcDbiRef, id));
+        new IndexedFastaDbiConnectionHolder(con, object);
+        objects << object;
+    }
+    CHECK_OP_EXT(os, qDeleteAll(objects), NULL);
+
+    Document* doc = new Document(this, io->getFactory(), io->getURL(), dbiRef, objects, fs, tr("The sequences are read from the indexed file"));
+    doc->setDocumentOwnsDbiResources(false);
+    doc->setModificationTrack(false);
+    return doc;
+}
+
 Document* FastaFormat::loadDocument(IOAdapter* io, const U2DbiRef& dbiRef, const QVariantMap& fs, U2OpStatus& os) {
     CHECK_EXT(io!=NULL && io->isOpen(), os.setError(L10N::badArgument("IO adapter")), NULL);
 
@@ -305,6 +417,17 @@ Document* FastaFormat::loadDocument(IOAdapter* io, const U2DbiRef& dbiRef, const
 
     int gapSize = qBound(-1, DocumentFormatUtils::getMergeGap(fs), 1000 * 1000);
 
+    if (isIndexedLoadingApplicable(io, fs, gapSize)) {
+        IndexingOpStatus indexedOs(os);
+        Document* doc = loadIndexedDocument(io, dbiRef, fs, indexedOs);
+        CHECK_EXT(!os.isCoR(), delete doc, NULL);
+        if (!indexedOs.hasError()) {
+            return doc;
+        }
+        // e.g. the lines have different lengths: the file is imported as usual
+        ioLog.details(tr("The FASTA file is not indexed: %1").arg(indexedOs.getError()));
+    }
+
     QString lockReason;
     load(io, dbiRef, fs, objects, gapSize, lockReason, os);
     CHECK_OP_EXT(os, qDeleteAll(objects), NULL);
@@ -61,6 +61,8 @@ protected:
     virtual Document* loadDocument(IOAdapter* io, const U2DbiRef& dbiRef, const QVariantMap& fs, U2OpStatus& os);
 
 private:
+    // Creates the document over IndexedFastaDbi, the sequences are not imported to @dbiRef
+    Document* loadIndexedDocument(IOAdapter* io, const U2DbiRef& dbiRef, const QVariantMap& fs, U2OpStatus& os);
 
     QString formatName;
 };
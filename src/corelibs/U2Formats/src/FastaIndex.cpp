@@ -0,0 +1,267 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include <QFileInfo>
+#include <QScopedPointer>
+#include <QStringList>
+
+#include <U2Core/IOAdapter.h>
+#include <U2Core/IOAdapterUtils.h>
+#include <U2Core/Log.h>
+#include <U2Core/U2OpStatusUtils.h>
+#include <U2Core/U2SafePoints.h>
+
+#include "FastaIndex.h"
+
+namespace U2 {
+
+FastaIndexEntry::FastaIndexEntry()
+    : length(0), offset(0), lineBases(0), lineWidth(0)
+{
+
+}
+
+qint64 FastaIndexEntry::getOffset(qint64 pos) const {
+    CHECK(lineBases > 0, offset);
+    return offset + (pos / lineBases) * lineWidth + pos % lineBases;
+}
+
+namespace {
+
+const int READ_BUFFER_SIZE = 1024 * 1024;
+const int FAI_LINE_MAX_SIZE = 64 * 1024;
+const int FAI_COLUMNS_COUNT = 5;
+
+/** Collects the entries line by line */
+class FastaIndexBuilder {
+public:
+    FastaIndexBuilder(QList<FastaIndexEntry> &entries)
+        : entries(entries), lastLineIsShort(false), blankLineFound(false)
+    {
+
+    }
+
+    void addHeader(const QByteArray &header, qint64 sequenceOffset, U2OpStatus &os) {
+        QByteArray name = header.mid(1).trimmed();
+        int spacePos = name.indexOf(' ');
+        int tabPos = name.indexOf('\t');
+        if (-1 != tabPos && (-1 == spacePos || tabPos < spacePos)) {
+            spacePos = tabPos;
+        }
+        if (-1 != spacePos) {
+            name = name.left(spacePos);
+        }
+        CHECK_EXT(!name.isEmpty(), os.setError(QObject::tr("A FASTA sequence without a name at %1").arg(sequenceOffset)), );
+
+        FastaIndexEntry entry;
+        entry.name = QString::fromLatin1(name);
+        entry.offset = sequenceOffset;
+        entries << entry;
+        lastLineIsShort = false;
+        blankLineFound = false;
+    }
+
+    // @width includes the end of line, it is negative for the last line of the file without the end of line
+    void addSequenceLine(int bases, int width, U2OpStatus &os) {
+        if (0 == bases) {
+            blankLineFound = true;
+            return;
+        }
+        CHECK_EXT(!entries.isEmpty(), os.setError(QObject::tr("The FASTA file does not start with a header")), );
+        FastaIndexEntry &entry = entries.last();
+        if (width < 0) {
+            width = bases + (entry.lineWidth > 0 ? entry.lineWidth - entry.lineBases : 1);
+        }
+        // only the last line of a sequence can be shorter than the others: the offsets are computed from the line length
+        CHECK_EXT(!lastLineIsShort && !blankLineFound,
+            os.setError(QObject::tr("Different line lengths in the sequence \"%1\"").arg(entry.name)), );
+        if (0 == entry.lineBases) {
+            entry.lineBases = bases;
+            entry.lineWidth = width;
+        } else {
+            CHECK_EXT(bases <= entry.lineBases && width - bases == entry.lineWidth - entry.lineBases,
+                os.setError(QObject::tr("Different line lengths in the sequence \"%1\"").arg(entry.name)), );
+            lastLineIsShort = bases < entry.lineBases;
+        }
+        entry.length += bases;
+    }
+
+private:
+    QList<FastaIndexEntry> &entries;
+    bool lastLineIsShort;
+    bool blankLineFound;
+};
+
+}
+
+FastaIndex FastaIndex::build(IOAdapter *io, U2OpStatus &os) {
+    FastaIndex index;
+    FastaIndexBuilder builder(index.entries);
+    QByteArray buffer(READ_BUFFER_SIZE, 0);
+
+    qint64 pos = 0;
+    bool lineStart = true;
+    bool inHeader = false;
+    QByteArray header;
+    int lineBases = 0;
+    int lineWidth = 0;
+    while (!os.isCoR()) {
+        qint64 len = io->readBlock(buffer.data(), buffer.size());
+        CHECK_EXT(len >= 0, os.setError(QObject::tr("Read error: %1").arg(io->errorString())), FastaIndex());
+        if (0 == len) {
+            break;
+        }
+        os.setProgress(io->getProgress());
+        const char *data = buffer.constData();
+        for (int i = 0; i < len; i++, pos++) {
+            char c = data[i];
+            if (lineStart && '>' == c) {
+                inHeader = true;
+            }
+            lineStart = ('\n' == c);
+            if (inHeader) {
+                if (lineStart) {
+                    builder.addHeader(header, pos + 1, os);
+                    CHECK_OP(os, FastaIndex());
+                    header.clear();
+                    inHeader = false;
+                } else {
+                    header.append(c);
+                }
+                continue;
+            }
+            lineWidth++;
+            if (lineStart) {
+                builder.addSequenceLine(lineBases, lineWidth, os);
+                CHECK_OP(os, FastaIndex());
+                lineBases = 0;
+                lineWidth = 0;
+            } else if ('\r' != c) {
+                lineBases++;
+            }
+        }
+    }
+    CHECK_OP(os, FastaIndex());
+    if (inHeader) {
+        builder.addHeader(header, pos, os);
+    } else if (lineWidth > 0) {
+        builder.addSequenceLine(lineBases, -1, os);
+    }
+    CHECK_OP(os, FastaIndex());
+    return index;
+}
+
+FastaIndex FastaIndex::load(const GUrl &faiUrl, U2OpStatus &os) {
+    QScopedPointer<IOAdapter> io(IOAdapterUtils::open(faiUrl, os));
+    CHECK_OP(os, FastaIndex());
+
+    FastaIndex index;
+    QByteArray line(FAI_LINE_MAX_SIZE, 0);
+    while (!io->isEof()) {
+        qint64 len = io->readLine(line.data(), line.size());
+        CHECK_EXT(len >= 0, os.setError(QObject::tr("Read error: %1").arg(io->errorString())), FastaIndex());
+        if (0 == len) {
+            continue;
+        }
+        QStringList columns = QString::fromLatin1(line.constData(), len).split('\t');
+        CHECK_EXT(FAI_COLUMNS_COUNT == columns.size(), os.setError(QObject::tr("Invalid FASTA index file: %1").arg(faiUrl.getURLString())), FastaIndex());
+
+        FastaIndexEntry entry;
+        bool ok[FAI_COLUMNS_COUNT - 1];
+        entry.name = columns[0];
+        entry.length = columns[1].toLongLong(&ok[0]);
+        entry.offset = columns[2].toLongLong(&ok[1]);
+        entry.lineBases = columns[3].toInt(&ok[2]);
+        entry.lineWidth = columns[4].toInt(&ok[3]);
+        CHECK_EXT(ok[0] && ok[1] && ok[2] && ok[3] && entry.lineWidth >= entry.lineBases,
+            os.setError(QObject::tr("Invalid FASTA index file: %1").arg(faiUrl.getURLString())), FastaIndex());
+        index.entries << entry;
+    }
+    return index;
+}
+
+void FastaIndex::save(const GUrl &faiUrl, U2OpStatus &os) const {
+    QScopedPointer<IOAdapter> io(IOAdapterUtils::open(faiUrl, os, IOAdapterMode_Write));
+    CHECK_OP(os, );
+    foreach (const FastaIndexEntry &entry, entries) {
+        QString line = QString("%1\t%2\t%3\t%4\t%5\n").arg(entry.name).arg(entry.length).arg(entry.offset).arg(entry.lineBases).arg(entry.lineWidth);
+        QByteArray data = line.toLatin1();
+        CHECK_EXT(data.size() == io->writeBlock(data), os.setError(QObject::tr("Write error: %1").arg(io->errorString())), );
+    }
+}
+
+GUrl FastaIndex::getIndexUrl(const GUrl &fastaUrl) {
+    return GUrl(fastaUrl.getURLString() + ".fai");
+}
+
+bool FastaIndex::hasValidIndex(const GUrl &fastaUrl) {
+    QFileInfo indexInfo(getIndexUrl(fastaUrl).getURLString());
+    QFileInfo fastaInfo(fastaUrl.getURLString());
+    return indexInfo.exists() && indexInfo.lastModified() >= fastaInfo.lastModified();
+}
+
+FastaIndex FastaIndex::prepare(const GUrl &fastaUrl, U2OpStatus &os) {
+    const GUrl indexUrl = getIndexUrl(fastaUrl);
+    if (hasValidIndex(fastaUrl)) {
+        U2OpStatusImpl loadOs;
+        FastaIndex index = load(indexUrl, loadOs);
+        if (!loadOs.hasError()) {
+            return index;
+        }
+        ioLog.details(QObject::tr("The FASTA index is rebuilt: %1").arg(loadOs.getError()));
+    }
+
+    QScopedPointer<IOAdapter> io(IOAdapterUtils::open(fastaUrl, os));
+    CHECK_OP(os, FastaIndex());
+    FastaIndex index = build(io.data(), os);
+    CHECK_OP(os, FastaIndex());
+
+    // the index is still usable if the directory is read-only
+    U2OpStatusImpl saveOs;
+    index.save(indexUrl, saveOs);
+    if (saveOs.hasError()) {
+        ioLog.details(QObject::tr("Can not save the FASTA index: %1").arg(saveOs.getError()));
+    }
+    return index;
+}
+
+const QList<FastaIndexEntry> & FastaIndex::getEntries() const {
+    return entries;
+}
+
+int FastaIndex::indexOf(const QString &name) const {
+    for (int i = 0; i < entries.size(); i++) {
+        if (entries[i].name == name) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+qint64 FastaIndex::getDataSize() const {
+    qint64 result = 0;
+    foreach (const FastaIndexEntry &entry, entries) {
+        result = qMax(result, entry.getOffset(entry.length));
+    }
+    return result;
+}
+
+} // U2
@@ -0,0 +1,92 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef _U2_FASTA_INDEX_H_
+#define _U2_FASTA_INDEX_H_
+
+#include <QList>
+#include <QString>
+
+#include <U2Core/GUrl.h>
+#include <U2Core/global.h>
+
+namespace U2 {
+
+class IOAdapter;
+class U2OpStatus;
+
+/**
+ * One line of the SAMtools .fai index
+ */
+class U2FORMATS_EXPORT FastaIndexEntry {
+public:
+    FastaIndexEntry();
+
+    // Returns the offset of the sequence position in the uncompressed file
+    qint64 getOffset(qint64 pos) const;
+
+    QString name;
+    qint64 length;
+    // the offset of the first base in the uncompressed file
+    qint64 offset;
+    int lineBases;
+    // including the end of line
+    int lineWidth;
+};
+
+/**
+ * Sequence offsets of a FASTA file in the SAMtools .fai format.
+ * The index is built without SAMtools, so gzipped and BGZF files are indexed too:
+ * their offsets are positions in the uncompressed data,
+ * ZlibAdapter seeks to them with its access point index.
+ */
+class U2FORMATS_EXPORT FastaIndex {
+public:
+    // @io must be opened for reading on the beginning of the file
+    static FastaIndex build(IOAdapter *io, U2OpStatus &os);
+
+    static FastaIndex load(const GUrl &faiUrl, U2OpStatus &os);
+
+    void save(const GUrl &faiUrl, U2OpStatus &os) const;
+
+    static GUrl getIndexUrl(const GUrl &fastaUrl);
+
+    // The index is up-to-date if it is not older than the FASTA file
+    static bool hasValidIndex(const GUrl &fastaUrl);
+
+    // Loads the index of the file or builds it and tries to save it next to the file
+    static FastaIndex prepare(const GUrl &fastaUrl, U2OpStatus &os);
+
+    const QList<FastaIndexEntry> & getEntries() const;
+
+    // Returns -1 if there is no sequence with the name
+    int indexOf(const QString &name) const;
+
+    // Returns the end offset of the last sequence: the uncompressed data size without the trailing lines
+    qint64 getDataSize() const;
+
+private:
+    QList<FastaIndexEntry> entries;
+};
+
+} // U2
+
+#endif // _U2_FASTA_INDEX_H_
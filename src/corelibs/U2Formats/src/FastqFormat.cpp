@@ -40,6 +40,7 @@
 
 #include "DocumentFormatUtils.h"
 #include "FastqFormat.h"
+#include "FastqRecordReader.h"
 
 /* TRANSLATOR U2::FastqFormat */
 
@@ -515,6 +516,27 @@ void FastqFormat::writeEntry(const QString& sequenceName, const DNASequence& who
     writeSequence(os, io, qualityData, wholeSeq.length(), errorMessage, cutLines);
 }
 
+void FastqFormat::writeEntry(const FastqRecord &record, IOAdapter *io, const QString &errorMessage, U2OpStatus &os) {
+    CHECK_EXT(record.qualityLength == 0 || record.qualityLength == record.seqLength, os.setError(errorMessage), );
+
+    QByteArray buf;
+    const char *qualityData = record.quality;
+    if (record.qualityLength == 0) {
+        // record the highest possible quality
+        buf.fill('I', record.seqLength);
+        qualityData = buf.constData();
+    }
+
+    bool written = io->writeBlock("@", 1) == 1
+        && io->writeBlock(record.name, record.nameLength) == record.nameLength
+        && io->writeBlock("\n", 1) == 1
+        && io->writeBlock(record.seq, record.seqLength) == record.seqLength
+        && io->writeBlock("\n+\n", 3) == 3
+        && io->writeBlock(qualityData, record.seqLength) == record.seqLength
+        && io->writeBlock("\n", 1) == 1;
+    CHECK_EXT(written, os.setError(errorMessage), );
+}
+
 void FastqFormat::storeEntry(IOAdapter *io, const QMap< GObjectType, QList<GObject*> > &objectsMap, U2OpStatus &os) {
     SAFE_POINT(objectsMap.contains(GObjectTypes::SEQUENCE), "Fastq entry storing: no sequences", );
     const QList<GObject*> &seqs = objectsMap[GObjectTypes::SEQUENCE];
@@ -30,6 +30,7 @@ namespace U2 {
 
 class IOAdapter;
 class DNASequence;
+class FastqRecord;
 
 class U2FORMATS_EXPORT FastqFormat : public DocumentFormat {
     Q_OBJECT
@@ -52,6 +53,9 @@ public:
 
     static void writeEntry(const QString &seqName, const DNASequence &seq, IOAdapter *io, const QString &errorMessage, U2OpStatus &os, bool cutLines = true);
 
+    // writes the record without line cutting
+    static void writeEntry(const FastqRecord &record, IOAdapter *io, const QString &errorMessage, U2OpStatus &os);
+
 protected:
     virtual Document* loadDocument(IOAdapter* io, const U2DbiRef& dbiRef, const QVariantMap& fs, U2OpStatus& os);
 
@@ -0,0 +1,180 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include <string.h>
+
+#include <U2Core/IOAdapter.h>
+#include <U2Core/Log.h>
+#include <U2Core/TextUtils.h>
+#include <U2Core/U2OpStatus.h>
+#include <U2Core/U2SafePoints.h>
+
+#include "FastqFormat.h"
+#include "FastqRecordReader.h"
+
+namespace U2 {
+
+FastqRecord::FastqRecord()
+    : name(NULL), nameLength(0), seq(NULL), seqLength(0), quality(NULL), qualityLength(0)
+{
+
+}
+
+const int FastqRecordReader::BUFFER_SIZE = 4 * 1024 * 1024;
+
+FastqRecordReader::FastqRecordReader(IOAdapter *io)
+    : io(io), eof(false), buffer(BUFFER_SIZE, 0), bufferStart(0), bufferEnd(0), lastLineStart(0),
+      nameLength(0), seqLength(0), qualityLength(0)
+{
+
+}
+
+bool FastqRecordReader::fillBuffer(U2OpStatus &os) {
+    char *data = buffer.data();
+    if (bufferStart > 0) {
+        memmove(data, data + bufferStart, bufferEnd - bufferStart);
+        bufferEnd -= bufferStart;
+        bufferStart = 0;
+    }
+    if (bufferEnd == buffer.size()) {
+        // a line does not fit into the buffer
+        buffer.resize(2 * buffer.size());
+        data = buffer.data();
+    }
+
+    qint64 readCount = io->readBlock(data + bufferEnd, buffer.size() - bufferEnd);
+    CHECK_EXT(readCount >= 0, os.setError(FastqFormat::tr("Error while reading sequence")), false);
+    eof = (0 == readCount);
+    bufferEnd += readCount;
+    return true;
+}
+
+bool FastqRecordReader::readLine(char *&line, int &length, U2OpStatus &os) {
+    int lineEnd = -1;
+    int searchFrom = bufferStart;
+    while (-1 == lineEnd) {
+        const void *eoln = memchr(buffer.constData() + searchFrom, '\n', bufferEnd - searchFrom);
+        if (NULL != eoln) {
+            lineEnd = static_cast<const char *>(eoln) - buffer.constData();
+        } else if (eof) {
+            CHECK(bufferStart < bufferEnd, false);
+            lineEnd = bufferEnd;
+        } else {
+            int scanned = bufferEnd - bufferStart;
+            CHECK(fillBuffer(os), false);
+            searchFrom = bufferStart + scanned;
+        }
+    }
+
+    char *data = buffer.data();
+    int start = bufferStart;
+    int end = lineEnd;
+    lastLineStart = bufferStart;
+    bufferStart = qMin(lineEnd + 1, bufferEnd);
+
+    while (start < end && TextUtils::WHITES.testBit((uchar)data[start])) {
+        start++;
+    }
+    while (end > start && TextUtils::WHITES.testBit((uchar)data[end - 1])) {
+        end--;
+    }
+    line = data + start;
+    length = end - start;
+    return true;
+}
+
+void FastqRecordReader::append(QByteArray &storage, int &length, const char *data, int dataLength) {
+    if (length + dataLength > storage.size()) {
+        storage.resize(qMax(length + dataLength, 2 * storage.size()));
+    }
+    memcpy(storage.data() + length, data, dataLength);
+    length += dataLength;
+}
+
+bool FastqRecordReader::readNext(FastqRecord &record, U2OpStatus &os) {
+    static const QString nameError = FastqFormat::tr("Error while trying to find sequence name start");
+    static const QString sizeError = FastqFormat::tr("Bad quality scores: inconsistent size.");
+    static const QString qualityNameError = FastqFormat::tr("Sequence name differs from quality scores name: %1 and %2");
+
+    char *line = NULL;
+    int length = 0;
+    bool skipping = false;
+    forever {
+        do {
+            CHECK(readLine(line, length, os), false);
+        } while (0 == length);
+
+        if ('@' != line[0]) {
+            // report a broken block once and look for the next record
+            if (!skipping) {
+                coreLog.error(nameError);
+                skipping = true;
+            }
+            continue;
+        }
+        skipping = false;
+        nameLength = 0;
+        append(name, nameLength, line + 1, length - 1);
+
+        seqLength = 0;
+        bool separatorFound = false;
+        while (readLine(line, length, os)) {
+            if (length > 0 && '+' == line[0]) {
+                separatorFound = true;
+                break;
+            }
+            append(seq, seqLength, line, length);
+        }
+        CHECK_OP(os, false);
+        CHECK_EXT(separatorFound, coreLog.error(QString("%1: %2").arg(QString::fromLatin1(name.constData(), nameLength)).arg(sizeError)), false);
+
+        if (length > 1 && (length - 1 != nameLength || 0 != memcmp(line + 1, name.constData(), nameLength))) {
+            coreLog.error(qualityNameError.arg(QString::fromLatin1(name.constData(), nameLength))
+                                          .arg(QString::fromLatin1(line + 1, length - 1)));
+            continue;
+        }
+
+        qualityLength = 0;
+        while (qualityLength < seqLength && readLine(line, length, os)) {
+            if (qualityLength + length > seqLength) {
+                // the line may be the header of the next record
+                bufferStart = lastLineStart;
+                break;
+            }
+            append(quality, qualityLength, line, length);
+        }
+        CHECK_OP(os, false);
+        if (qualityLength != seqLength) {
+            coreLog.error(QString("%1: %2").arg(QString::fromLatin1(name.constData(), nameLength)).arg(sizeError));
+            continue;
+        }
+
+        record.name = name.data();
+        record.nameLength = nameLength;
+        record.seq = seq.data();
+        record.seqLength = seqLength;
+        record.quality = quality.data();
+        record.qualityLength = qualityLength;
+        return true;
+    }
+}
+
+} // U2
@@ -0,0 +1,96 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef _U2_FASTQ_RECORD_READER_H_
+#define _U2_FASTQ_RECORD_READER_H_
+
+#include <QByteArray>
+
+#include <U2Core/global.h>
+
+namespace U2 {
+
+class IOAdapter;
+class U2OpStatus;
+
+/**
+ * One FASTQ record. The fields point to the buffers of the reader
+ * that produced the record and stay valid until the next record is read.
+ * The data is not zero-terminated.
+ */
+class U2FORMATS_EXPORT FastqRecord {
+public:
+    FastqRecord();
+
+    // the whole header line without the leading '@'
+    char *name;
+    int nameLength;
+    char *seq;
+    int seqLength;
+    // empty if the record has no quality scores
+    char *quality;
+    int qualityLength;
+};
+
+/**
+ * Reads FASTQ records through a large reusable buffer.
+ * FastqFormat::loadSequence allocates line buffers and the resulting DNASequence
+ * for every read. This reader does not allocate anything per record:
+ * its buffers grow only when a record is longer than all the previous ones.
+ * Multiline sequences and qualities are supported.
+ * Malformed records are skipped with a message in the log.
+ */
+class U2FORMATS_EXPORT FastqRecordReader {
+public:
+    // @io must be opened for reading and must live longer than the reader
+    FastqRecordReader(IOAdapter *io);
+
+    // Returns false at the end of the file or if a reading error occurs (@os is set then)
+    bool readNext(FastqRecord &record, U2OpStatus &os);
+
+private:
+    // The line is trimmed and is valid until the next call
+    bool readLine(char *&line, int &length, U2OpStatus &os);
+    bool fillBuffer(U2OpStatus &os);
+    static void append(QByteArray &storage, int &length, const char *data, int dataLength);
+
+    IOAdapter *io;
+    bool eof;
+
+    QByteArray buffer;
+    int bufferStart;
+    int bufferEnd;
+    // the start of the last read line, lets to return the line back to the buffer
+    int lastLineStart;
+
+    QByteArray name;
+    int nameLength;
+    QByteArray seq;
+    int seqLength;
+    QByteArray quality;
+    int qualityLength;
+
+    static const int BUFFER_SIZE;
+};
+
+} // U2
+
+#endif // _U2_FASTQ_RECORD_READER_H_
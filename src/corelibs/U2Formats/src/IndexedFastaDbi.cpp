@@ -0,0 +1,378 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include <QFile>
+
+#include <U2Core/DNAAlphabet.h>
+#include <U2Core/IOAdapter.h>
+#include <U2Core/IOAdapterUtils.h>
+#include <U2Core/L10n.h>
+#include <U2Core/TextUtils.h>
+#include <U2Core/U2AlphabetUtils.h>
+#include <U2Core/U2SafePoints.h>
+#include <U2Core/U2SqlHelpers.h>
+
+#include "IndexedFastaDbi.h"
+
+namespace U2 {
+
+/************************************************************************/
+/* IndexedFastaDbi */
+/************************************************************************/
+const int IndexedFastaDbi::ALPHABET_SAMPLE_SIZE = 64 * 1024;
+
+IndexedFastaDbi::IndexedFastaDbi()
+    : U2AbstractDbi(IndexedFastaDbiFactory::ID)
+{
+
+}
+
+IndexedFastaDbi::~IndexedFastaDbi() {
+    cleanup();
+}
+
+void IndexedFastaDbi::init(const QHash<QString, QString> &properties, const QVariantMap &, U2OpStatus &os) {
+    QMutexLocker locker(&ioLock);
+    CHECK_EXT(U2DbiState_Void == state, os.setError(U2DbiL10n::tr("Illegal database state: %1").arg(state)), );
+    state = U2DbiState_Starting;
+
+    const QString urlString = properties.value(U2DbiOptions::U2_DBI_OPTION_URL);
+    CHECK_EXT(!urlString.isEmpty(), os.setError(U2DbiL10n::tr("URL is not specified")); cleanup(), );
+    url = GUrl(urlString);
+    CHECK_EXT(url.isLocalFile(), os.setError(U2DbiL10n::tr("Non-local files are not supported")); cleanup(), );
+
+    index = FastaIndex::prepare(url, os);
+    CHECK_OP_EXT(os, cleanup(), );
+
+    io.reset(IOAdapterUtils::open(url, os));
+    CHECK_OP_EXT(os, cleanup(), );
+
+    for (int i = 0; i < index.getEntries().size(); i++) {
+        alphabets << U2AlphabetId();
+    }
+    objectDbi.reset(new IndexedFastaObjectDbi(this));
+    sequenceDbi.reset(new IndexedFastaSequenceDbi(this));
+
+    initProperties = properties;
+    features.insert(U2DbiFeature_ReadSequence);
+    dbiId = urlString;
+    state = U2DbiState_Ready;
+}
+
+QVariantMap IndexedFastaDbi::shutdown(U2OpStatus &) {
+    QMutexLocker locker(&ioLock);
+    cleanup();
+    return QVariantMap();
+}
+
+void IndexedFastaDbi::cleanup() {
+    objectDbi.reset();
+    sequenceDbi.reset();
+    io.reset();
+    index = FastaIndex();
+    alphabets.clear();
+    state = U2DbiState_Void;
+}
+
+U2ObjectDbi* IndexedFastaDbi::getObjectDbi() {
+    CHECK(U2DbiState_Ready == state, NULL);
+    return objectDbi.data();
+}
+
+U2SequenceDbi* IndexedFastaDbi::getSequenceDbi() {
+    CHECK(U2DbiState_Ready == state, NULL);
+    return sequenceDbi.data();
+}
+
+U2DataType IndexedFastaDbi::getEntityTypeById(const U2DataId &id) const {
+    return U2DbiUtils::toType(id);
+}
+
+bool IndexedFastaDbi::isReadOnly() const {
+    return true;
+}
+
+const QList<FastaIndexEntry> & IndexedFastaDbi::getEntries() const {
+    return index.getEntries();
+}
+
+int IndexedFastaDbi::getEntryNumber(const U2DataId &id) const {
+    CHECK(U2Type::Sequence == U2DbiUtils::toType(id), -1);
+    const qint64 number = qint64(U2DbiUtils::toDbiId(id)) - 1;
+    CHECK(number >= 0 && number < index.getEntries().size(), -1);
+    return int(number);
+}
+
+U2DataId IndexedFastaDbi::getSequenceId(int entryNumber) {
+    return U2DbiUtils::toU2DataId(entryNumber + 1, U2Type::Sequence);
+}
+
+U2AlphabetId IndexedFastaDbi::getAlphabet(int entryNumber, U2OpStatus &os) {
+    QMutexLocker locker(&ioLock);
+    SAFE_POINT_EXT(entryNumber >= 0 && entryNumber < alphabets.size(), os.setError("Invalid sequence number"), U2AlphabetId());
+    CHECK(!alphabets[entryNumber].isValid(), alphabets[entryNumber]);
+
+    const QByteArray sample = readSequenceUnsafe(entryNumber, U2Region(0, ALPHABET_SAMPLE_SIZE), os);
+    CHECK_OP(os, U2AlphabetId());
+    const DNAAlphabet *alphabet = U2AlphabetUtils::findBestAlphabet(sample);
+    CHECK_EXT(NULL != alphabet, os.setError(U2DbiL10n::tr("Alphabet is unknown")), U2AlphabetId());
+
+    // the rest of the sequence is not checked: it may contain the ambiguous symbols
+    QString alphabetId = alphabet->getId();
+    if (BaseDNAAlphabetIds::NUCL_DNA_DEFAULT() == alphabetId) {
+        alphabetId = BaseDNAAlphabetIds::NUCL_DNA_EXTENDED();
+    } else if (BaseDNAAlphabetIds::NUCL_RNA_DEFAULT() == alphabetId) {
+        alphabetId = BaseDNAAlphabetIds::NUCL_RNA_EXTENDED();
+    } else if (BaseDNAAlphabetIds::AMINO_DEFAULT() == alphabetId) {
+        alphabetId = BaseDNAAlphabetIds::AMINO_EXTENDED();
+    }
+    alphabets[entryNumber] = U2AlphabetId(alphabetId);
+    return alphabets[entryNumber];
+}
+
+QByteArray IndexedFastaDbi::readSequence(int entryNumber, const U2Region &region, U2OpStatus &os) {
+    QMutexLocker locker(&ioLock);
+    return readSequenceUnsafe(entryNumber, region, os);
+}
+
+QByteArray IndexedFastaDbi::readSequenceUnsafe(int entryNumber, const U2Region &region, U2OpStatus &os) {
+    CHECK_EXT(U2DbiState_Ready == state, os.setError(U2DbiL10n::tr("Illegal database state: %1").arg(state)), QByteArray());
+    SAFE_POINT_EXT(entryNumber >= 0 && entryNumber < index.getEntries().size(), os.setError("Invalid sequence number"), QByteArray());
+
+    const FastaIndexEntry &entry = index.getEntries()[entryNumber];
+    const U2Region r = region.intersect(U2Region(0, entry.length));
+    CHECK(!r.isEmpty(), QByteArray());
+
+    const qint64 startOffset = entry.getOffset(r.startPos);
+    const qint64 endOffset = entry.getOffset(r.endPos() - 1) + 1;
+    CHECK_EXT(endOffset - startOffset <= INT_MAX, os.setError(U2DbiL10n::tr("The sequence region is too long: %1").arg(r.length)), QByteArray());
+
+    // the adapters skip backward too: ZlibAdapter restarts from the nearest access point
+    bool skipped = io->skip(startOffset - io->bytesRead());
+    CHECK_EXT(skipped, os.setError(L10N::errorReadingFile(url)), QByteArray());
+
+    QByteArray result(int(endOffset - startOffset), 0);
+    const qint64 readLength = io->readBlock(result.data(), result.size());
+    CHECK_EXT(readLength == result.size(), os.setError(L10N::errorReadingFile(url)), QByteArray());
+
+    const int length = TextUtils::remove(result.data(), result.size(), TextUtils::WHITES);
+    result.resize(length);
+    TextUtils::translate(TextUtils::UPPER_CASE_MAP, result.data(), result.size());
+    CHECK_EXT(result.size() == r.length, os.setError(U2DbiL10n::tr("The FASTA index does not match the file: %1").arg(url.getURLString())), QByteArray());
+    return result;
+}
+
+/************************************************************************/
+/* IndexedFastaObjectDbi */
+/************************************************************************/
+IndexedFastaObjectDbi::IndexedFastaObjectDbi(IndexedFastaDbi *dbi)
+    : U2SimpleObjectDbi(dbi), dbi(dbi)
+{
+
+}
+
+qint64 IndexedFastaObjectDbi::countObjects(U2OpStatus &os) {
+    return countObjects(U2Type::Sequence, os);
+}
+
+qint64 IndexedFastaObjectDbi::countObjects(U2DataType type, U2OpStatus &) {
+    CHECK(U2Type::Sequence == type || U2Type::Unknown == type, 0);
+    return dbi->getEntries().size();
+}
+
+qint64 IndexedFastaObjectDbi::countObjects(const QString &folder, U2OpStatus &os) {
+    CHECK_EXT(U2ObjectDbi::ROOT_FOLDER == folder, os.setError(U2DbiL10n::tr("No such folder: %1").arg(folder)), 0);
+    return countObjects(os);
+}
+
+void IndexedFastaObjectDbi::getObject(U2Object &object, const U2DataId &id, U2OpStatus &os) {
+    const int number = dbi->getEntryNumber(id);
+    CHECK_EXT(-1 != number, os.setError(U2DbiL10n::tr("Object not found")), );
+
+    object.id = id;
+    object.dbiId = dbi->getDbiId();
+    object.version = 0;
+    object.visualName = dbi->getEntries()[number].name;
+    object.trackModType = NoTrack;
+}
+
+QList<U2DataId> IndexedFastaObjectDbi::getObjects(qint64 offset, qint64 count, U2OpStatus &os) {
+    return getObjects(U2Type::Sequence, offset, count, os);
+}
+
+QList<U2DataId> IndexedFastaObjectDbi::getObjects(U2DataType type, qint64 offset, qint64 count, U2OpStatus &) {
+    QList<U2DataId> result;
+    CHECK(U2Type::Sequence == type || U2Type::Unknown == type, result);
+
+    const qint64 size = dbi->getEntries().size();
+    const qint64 end = (U2DbiOptions::U2_DBI_NO_LIMIT == count) ? size : qMin(size, offset + count);
+    for (qint64 i = qMax(qint64(0), offset); i < end; i++) {
+        result << IndexedFastaDbi::getSequenceId(int(i));
+    }
+    return result;
+}
+
+QList<U2DataId> IndexedFastaObjectDbi::getObjects(const QString &folder, qint64 offset, qint64 count, U2OpStatus &os) {
+    CHECK_EXT(U2ObjectDbi::ROOT_FOLDER == folder, os.setError(U2DbiL10n::tr("No such folder: %1").arg(folder)), QList<U2DataId>());
+    return getObjects(offset, count, os);
+}
+
+QHash<U2DataId, QString> IndexedFastaObjectDbi::getObjectNames(qint64 offset, qint64 count, U2OpStatus &os) {
+    QHash<U2DataId, QString> result;
+    foreach (const U2DataId &id, getObjects(offset, count, os)) {
+        result[id] = dbi->getEntries()[dbi->getEntryNumber(id)].name;
+    }
+    return result;
+}
+
+QList<U2DataId> IndexedFastaObjectDbi::getParents(const U2DataId &, U2OpStatus &) {
+    return QList<U2DataId>();
+}
+
+QStringList IndexedFastaObjectDbi::getFolders(U2OpStatus &) {
+    return QStringList(U2ObjectDbi::ROOT_FOLDER);
+}
+
+QHash<U2Object, QString> IndexedFastaObjectDbi::getObjectFolders(U2OpStatus &os) {
+    QHash<U2Object, QString> result;
+    foreach (const U2DataId &id, getObjects(0, U2DbiOptions::U2_DBI_NO_LIMIT, os)) {
+        U2Object object;
+        getObject(object, id, os);
+        CHECK_OP(os, result);
+        result[object] = U2ObjectDbi::ROOT_FOLDER;
+    }
+    return result;
+}
+
+QStringList IndexedFastaObjectDbi::getObjectFolders(const U2DataId &objectId, U2OpStatus &) {
+    CHECK(-1 != dbi->getEntryNumber(objectId), QStringList());
+    return QStringList(U2ObjectDbi::ROOT_FOLDER);
+}
+
+qint64 IndexedFastaObjectDbi::getObjectVersion(const U2DataId &, U2OpStatus &) {
+    return 0;
+}
+
+qint64 IndexedFastaObjectDbi::getFolderLocalVersion(const QString &folder, U2OpStatus &os) {
+    CHECK_EXT(U2ObjectDbi::ROOT_FOLDER == folder, os.setError(U2DbiL10n::tr("No such folder: %1").arg(folder)), 0);
+    return 0;
+}
+
+qint64 IndexedFastaObjectDbi::getFolderGlobalVersion(const QString &folder, U2OpStatus &os) {
+    CHECK_EXT(U2ObjectDbi::ROOT_FOLDER == folder, os.setError(U2DbiL10n::tr("No such folder: %1").arg(folder)), 0);
+    return 0;
+}
+
+U2DbiIterator<U2DataId>* IndexedFastaObjectDbi::getObjectsByVisualName(const QString &, U2DataType, U2OpStatus &) {
+    return NULL;
+}
+
+void IndexedFastaObjectDbi::renameObject(const U2DataId &, const QString &, U2OpStatus &os) {
+    os.setError("Operation not supported: IndexedFastaObjectDbi::renameObject");
+}
+
+void IndexedFastaObjectDbi::setObjectRank(const U2DataId &, U2DbiObjectRank, U2OpStatus &os) {
+    os.setError("Operation not supported: IndexedFastaObjectDbi::setObjectRank");
+}
+
+U2DbiObjectRank IndexedFastaObjectDbi::getObjectRank(const U2DataId &, U2OpStatus &) {
+    return U2DbiObjectRank_TopLevel;
+}
+
+void IndexedFastaObjectDbi::setParent(const U2DataId &, const U2DataId &, U2OpStatus &os) {
+    os.setError("Operation not supported: IndexedFastaObjectDbi::setParent");
+}
+
+/************************************************************************/
+/* IndexedFastaSequenceDbi */
+/************************************************************************/
+IndexedFastaSequenceDbi::IndexedFastaSequenceDbi(IndexedFastaDbi *dbi)
+    : U2SequenceDbi(dbi), dbi(dbi)
+{
+
+}
+
+U2Sequence IndexedFastaSequenceDbi::getSequenceObject(const U2DataId &sequenceId, U2OpStatus &os) {
+    const int number = dbi->getEntryNumber(sequenceId);
+    CHECK_EXT(-1 != number, os.setError(U2DbiL10n::tr("Sequence is not found")), U2Sequence());
+
+    U2Sequence sequence(sequenceId, dbi->getDbiId(), 0);
+    sequence.visualName = dbi->getEntries()[number].name;
+    sequence.length = dbi->getEntries()[number].length;
+    sequence.alphabet = dbi->getAlphabet(number, os);
+    CHECK_OP(os, U2Sequence());
+    return sequence;
+}
+
+QByteArray IndexedFastaSequenceDbi::getSequenceData(const U2DataId &sequenceId, const U2Region &region, U2OpStatus &os) {
+    const int number = dbi->getEntryNumber(sequenceId);
+    CHECK_EXT(-1 != number, os.setError(U2DbiL10n::tr("Sequence is not found")), QByteArray());
+    return dbi->readSequence(number, region, os);
+}
+
+void IndexedFastaSequenceDbi::createSequenceObject(U2Sequence &, const QString &, U2OpStatus &os, U2DbiObjectRank) {
+    os.setError("Operation not supported: IndexedFastaSequenceDbi::createSequenceObject");
+}
+
+void IndexedFastaSequenceDbi::updateSequenceObject(U2Sequence &, U2OpStatus &os) {
+    os.setError("Operation not supported: IndexedFastaSequenceDbi::updateSequenceObject");
+}
+
+void IndexedFastaSequenceDbi::updateSequenceData(const U2DataId &, const U2Region &, const QByteArray &, const QVariantMap &, U2OpStatus &os) {
+    os.setError("Operation not supported: IndexedFastaSequenceDbi::updateSequenceData");
+}
+
+void IndexedFastaSequenceDbi::updateSequenceData(const U2DataId &, const U2DataId &, const U2Region &, const QByteArray &, const QVariantMap &, U2OpStatus &os) {
+    os.setError("Operation not supported: IndexedFastaSequenceDbi::updateSequenceData");
+}
+
+/************************************************************************/
+/* IndexedFastaDbiFactory */
+/************************************************************************/
+const U2DbiFactoryId IndexedFastaDbiFactory::ID = INDEXED_FASTA_DBI_ID;
+
+IndexedFastaDbiFactory::IndexedFastaDbiFactory()
+    : U2DbiFactory()
+{
+
+}
+
+U2Dbi* IndexedFastaDbiFactory::createDbi() {
+    return new IndexedFastaDbi();
+}
+
+U2DbiFactoryId IndexedFastaDbiFactory::getId() const {
+    return ID;
+}
+
+FormatCheckResult IndexedFastaDbiFactory::isValidDbi(const QHash<QString, QString> &, const QByteArray &, U2OpStatus &) const {
+    return FormatDetection_NotMatched;
+}
+
+GUrl IndexedFastaDbiFactory::id2Url(const U2DbiId &id) const {
+    return GUrl(id, GUrl_File);
+}
+
+bool IndexedFastaDbiFactory::isDbiExists(const U2DbiId &id) const {
+    return QFile::exists(id);
+}
+
+} // U2
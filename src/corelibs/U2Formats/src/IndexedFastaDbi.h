@@ -0,0 +1,153 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef _U2_INDEXED_FASTA_DBI_H_
+#define _U2_INDEXED_FASTA_DBI_H_
+
+#include <QMutex>
+#include <QScopedPointer>
+
+#include <U2Core/GUrl.h>
+#include <U2Core/U2AbstractDbi.h>
+#include <U2Core/U2DbiRegistry.h>
+
+#include "FastaIndex.h"
+
+namespace U2 {
+
+class IOAdapter;
+class IndexedFastaDbi;
+
+class IndexedFastaObjectDbi : public U2SimpleObjectDbi {
+public:
+    IndexedFastaObjectDbi(IndexedFastaDbi *dbi);
+
+    virtual qint64 countObjects(U2OpStatus &os);
+    virtual qint64 countObjects(U2DataType type, U2OpStatus &os);
+    virtual qint64 countObjects(const QString &folder, U2OpStatus &os);
+    virtual void getObject(U2Object &object, const U2DataId &id, U2OpStatus &os);
+    virtual QList<U2DataId> getObjects(qint64 offset, qint64 count, U2OpStatus &os);
+    virtual QList<U2DataId> getObjects(U2DataType type, qint64 offset, qint64 count, U2OpStatus &os);
+    virtual QList<U2DataId> getObjects(const QString &folder, qint64 offset, qint64 count, U2OpStatus &os);
+    virtual QHash<U2DataId, QString> getObjectNames(qint64 offset, qint64 count, U2OpStatus &os);
+    virtual QList<U2DataId> getParents(const U2DataId &entityId, U2OpStatus &os);
+    virtual QStringList getFolders(U2OpStatus &os);
+    virtual QHash<U2Object, QString> getObjectFolders(U2OpStatus &os);
+    virtual QStringList getObjectFolders(const U2DataId &objectId, U2OpStatus &os);
+    virtual qint64 getObjectVersion(const U2DataId &objectId, U2OpStatus &os);
+    virtual qint64 getFolderLocalVersion(const QString &folder, U2OpStatus &os);
+    virtual qint64 getFolderGlobalVersion(const QString &folder, U2OpStatus &os);
+    virtual U2DbiIterator<U2DataId>* getObjectsByVisualName(const QString &visualName, U2DataType type, U2OpStatus &os);
+    virtual void renameObject(const U2DataId &id, const QString &newName, U2OpStatus &os);
+    virtual void setObjectRank(const U2DataId &objectId, U2DbiObjectRank newRank, U2OpStatus &os);
+    virtual U2DbiObjectRank getObjectRank(const U2DataId &objectId, U2OpStatus &os);
+    virtual void setParent(const U2DataId &parentId, const U2DataId &childId, U2OpStatus &os);
+
+private:
+    IndexedFastaDbi *dbi;
+}; // IndexedFastaObjectDbi
+
+class IndexedFastaSequenceDbi : public U2SequenceDbi {
+public:
+    IndexedFastaSequenceDbi(IndexedFastaDbi *dbi);
+
+    virtual U2Sequence getSequenceObject(const U2DataId &sequenceId, U2OpStatus &os);
+    virtual QByteArray getSequenceData(const U2DataId &sequenceId, const U2Region &region, U2OpStatus &os);
+
+    /**
+     * Unsupported methods: the file is never modified
+     */
+    virtual void createSequenceObject(U2Sequence &sequence, const QString &folder, U2OpStatus &os, U2DbiObjectRank rank = U2DbiObjectRank_TopLevel);
+    virtual void updateSequenceObject(U2Sequence &sequence, U2OpStatus &os);
+    virtual void updateSequenceData(const U2DataId &sequenceId, const U2Region &regionToReplace, const QByteArray &dataToInsert, const QVariantMap &hints, U2OpStatus &os);
+    virtual void updateSequenceData(const U2DataId &masterId, const U2DataId &sequenceId,
+                                    const U2Region &regionToReplace, const QByteArray &dataToInsert, const QVariantMap &hints, U2OpStatus &os);
+
+private:
+    IndexedFastaDbi *dbi;
+}; // IndexedFastaSequenceDbi
+
+/**
+ * Read-only DBI over a FASTA file with the SAMtools .fai index.
+ * The sequences are not imported: every requested region is read from the file,
+ * so opening a genome costs only the index building (once) and the memory is not spent on the data.
+ * Gzipped and BGZF files are supported, ZlibAdapter seeks in them with its access point index.
+ * The database URL is the FASTA file URL. All methods are thread-safe.
+ */
+class U2FORMATS_EXPORT IndexedFastaDbi : public U2AbstractDbi {
+public:
+    IndexedFastaDbi();
+    ~IndexedFastaDbi();
+
+    virtual void init(const QHash<QString, QString> &properties, const QVariantMap &persistentData, U2OpStatus &os);
+    virtual QVariantMap shutdown(U2OpStatus &os);
+    virtual U2ObjectDbi* getObjectDbi();
+    virtual U2SequenceDbi* getSequenceDbi();
+    virtual U2DataType getEntityTypeById(const U2DataId &id) const;
+    virtual bool isReadOnly() const;
+
+    const QList<FastaIndexEntry> & getEntries() const;
+
+    // Returns the entry number or -1 if the id is unknown
+    int getEntryNumber(const U2DataId &id) const;
+    static U2DataId getSequenceId(int entryNumber);
+
+    // The alphabet is guessed by the beginning of the sequence and cached
+    U2AlphabetId getAlphabet(int entryNumber, U2OpStatus &os);
+
+    // Reads the region of the sequence without line breaks and in upper case
+    QByteArray readSequence(int entryNumber, const U2Region &region, U2OpStatus &os);
+
+    // The sequence beginning length used to guess the alphabet
+    static const int ALPHABET_SAMPLE_SIZE;
+
+private:
+    QByteArray readSequenceUnsafe(int entryNumber, const U2Region &region, U2OpStatus &os);
+    void cleanup();
+
+    GUrl url;
+    FastaIndex index;
+    QList<U2AlphabetId> alphabets;
+    mutable QMutex ioLock;
+    QScopedPointer<IOAdapter> io;
+    QScopedPointer<IndexedFastaObjectDbi> objectDbi;
+    QScopedPointer<IndexedFastaSequenceDbi> sequenceDbi;
+}; // IndexedFastaDbi
+
+class U2FORMATS_EXPORT IndexedFastaDbiFactory : public U2DbiFactory {
+public:
+    IndexedFastaDbiFactory();
+
+    virtual U2Dbi* createDbi();
+    virtual U2DbiFactoryId getId() const;
+
+    /** FASTA files are opened with the document format, the DBI is never detected */
+    virtual FormatCheckResult isValidDbi(const QHash<QString, QString> &properties, const QByteArray &rawData, U2OpStatus &os) const;
+
+    virtual GUrl id2Url(const U2DbiId &id) const;
+    virtual bool isDbiExists(const U2DbiId &id) const;
+
+    static const U2DbiFactoryId ID;
+}; // IndexedFastaDbiFactory
+
+} // U2
+
+#endif // _U2_INDEXED_FASTA_DBI_H_
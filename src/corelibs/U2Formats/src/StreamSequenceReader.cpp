@@ -20,10 +20,15 @@
  */
 
 #include <U2Core/AppContext.h>
+#include <U2Core/BaseDocumentFormats.h>
 #include <U2Core/DocumentModel.h>
 #include <U2Core/DocumentUtils.h>
 #include <U2Core/IOAdapter.h>
+#include <U2Core/IOAdapterUtils.h>
+#include <U2Core/TextUtils.h>
 #include <U2Core/Timer.h>
+#include <U2Core/U2AlphabetUtils.h>
+#include <U2Core/U2SafePoints.h>
 
 #include "StreamSequenceReader.h"
 
@@ -31,6 +36,9 @@ namespace U2 {
 
 DNASequence* StreamSequenceReader::getNextSequenceObject() {
     if (hasNext()) {
+        if (currentSeq.isNull()) {
+            createSequenceFromRecord();
+        }
         DNASequence* result = currentSeq.data();
         lookupPerformed = false;
         return result;
@@ -38,6 +46,12 @@ DNASequence* StreamSequenceReader::getNextSequenceObject() {
     return NULL;
 }
 
+const FastqRecord* StreamSequenceReader::getNextRecord() {
+    CHECK(hasNext(), NULL);
+    lookupPerformed = false;
+    return &currentRecord;
+}
+
 StreamSequenceReader::StreamSequenceReader()
 : currentReaderIndex(-1), currentSeq(NULL), errorOccured(false), lookupPerformed(false)
 {
@@ -55,26 +69,52 @@ bool StreamSequenceReader::hasNext() {
         }
 
         while (currentReaderIndex < readers.count()) {
-            ReaderContext ctx = readers.at(currentReaderIndex);
-            DNASequence *newSeq = ctx.format->loadSequence(ctx.io, taskInfo);
-            currentSeq.reset(newSeq);
-            if (NULL == newSeq) {
-                ++currentReaderIndex;
-            } else {
+            if (readRecord(readers[currentReaderIndex])) {
                 lookupPerformed = true;
                 break;
             }
+            ++currentReaderIndex;
         }
 
     }
 
-    if (currentSeq.isNull()) {
-        return false;
+    return lookupPerformed;
+}
+
+bool StreamSequenceReader::readRecord(ReaderContext& ctx) {
+    currentSeq.reset();
+    if (NULL != ctx.fastqReader) {
+        CHECK(ctx.fastqReader->readNext(currentRecord, taskInfo), false);
+        // the same as FastqFormat::loadSequence does for the extended DNA alphabet
+        TextUtils::translate(TextUtils::UPPER_CASE_MAP, currentRecord.seq, currentRecord.seqLength);
+        return true;
     }
 
+    DNASequence *newSeq = ctx.format->loadSequence(ctx.io, taskInfo);
+    CHECK(NULL != newSeq, false);
+    currentSeq.reset(newSeq);
+
+    currentRecordName = newSeq->getName().toLatin1();
+    currentRecord.name = currentRecordName.data();
+    currentRecord.nameLength = currentRecordName.length();
+    currentRecord.seq = newSeq->seq.data();
+    currentRecord.seqLength = newSeq->seq.length();
+    currentRecord.quality = newSeq->quality.qualCodes.data();
+    currentRecord.qualityLength = newSeq->quality.qualCodes.length();
     return true;
 }
 
+void StreamSequenceReader::createSequenceFromRecord() {
+    const DNAAlphabet *alphabet = U2AlphabetUtils::getById(BaseDNAAlphabetIds::NUCL_DNA_EXTENDED());
+    SAFE_POINT(NULL != alphabet, "StreamSequenceReader: alphabet is NULL", );
+
+    DNASequence *seq = new DNASequence(QString::fromLatin1(currentRecord.name, currentRecord.nameLength),
+                                       QByteArray(currentRecord.seq, currentRecord.seqLength),
+                                       alphabet);
+    seq->quality = DNAQuality(QByteArray(currentRecord.quality, currentRecord.qualityLength));
+    currentSeq.reset(seq);
+}
+
 bool StreamSequenceReader::init( const QList<GUrl>& urls ) {
     foreach (const GUrl& url, urls) {
         QList<FormatDetectionResult> detectedFormats = DocumentUtils::detectFormat(url);
@@ -87,12 +127,16 @@ bool StreamSequenceReader::init( const QList<GUrl>& urls ) {
         if ( ctx.format->getFlags().testFlag(DocumentFormatFlag_SupportStreaming) == false  ) {
             break;
         }
-        IOAdapterFactory* factory = AppContext::getIOAdapterRegistry()->getIOAdapterFactoryById(BaseIOAdapters::LOCAL_FILE);
+        IOAdapterFactory* factory = AppContext::getIOAdapterRegistry()->getIOAdapterFactoryById(IOAdapterUtils::url2io(url));
         IOAdapter* io = factory->createIOAdapter();
         if (!io->open(url, IOAdapterMode_Read)) {
+            delete io;
             break;
         }
         ctx.io = io;
+        if (BaseDocumentFormats::FASTQ == ctx.format->getFormatId()) {
+            ctx.fastqReader = new FastqRecordReader(io);
+        }
         readers.append(ctx);
     }
 
@@ -127,6 +171,8 @@ int StreamSequenceReader::getProgress() {
 
 StreamSequenceReader::~StreamSequenceReader() {
     for(int i =0; i < readers.size(); ++i) {
+        delete readers[i].fastqReader;
+        readers[i].fastqReader = NULL;
         delete readers[i].io;
         readers[i].io = NULL;
     }
@@ -30,6 +30,8 @@
 #include <U2Core/DNASequenceObject.h>
 #include <U2Core/DNASequence.h>
 
+#include "FastqRecordReader.h"
+
 namespace U2 {
 
 class Document;
@@ -45,17 +47,23 @@ class IOAdapter;
 * to be read by StreamSequenceReader.
 * In case of multiple files, they will be read subsequently.
 *
+* FASTQ files are parsed by FastqRecordReader: getNextRecord() gives
+* the reads without creating a DNASequence object for each of them.
+*
 */
 
 class U2FORMATS_EXPORT StreamSequenceReader {
     struct ReaderContext {
-        ReaderContext() : io(NULL), format(NULL) {}
+        ReaderContext() : io(NULL), format(NULL), fastqReader(NULL) {}
         IOAdapter* io;
         DocumentFormat* format;
+        FastqRecordReader* fastqReader;
     };
     QList<ReaderContext> readers;
     int currentReaderIndex;
     QScopedPointer<DNASequence> currentSeq;
+    FastqRecord currentRecord;
+    QByteArray currentRecordName;
     bool errorOccured;
     bool lookupPerformed;
     QString errorMessage;
@@ -70,6 +78,13 @@ public:
     int getProgress();
     QString getErrorMessage();
     DNASequence* getNextSequenceObject();
+    // The record is valid until the next reading. For other formats than FASTQ
+    // it points to the data of the sequence object that was read
+    const FastqRecord* getNextRecord();
+
+private:
+    bool readRecord(ReaderContext& ctx);
+    void createSequenceFromRecord();
 };
 
 
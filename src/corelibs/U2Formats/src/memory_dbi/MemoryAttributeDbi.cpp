@@ -0,0 +1,190 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include <U2Core/U2DbiUtils.h>
+#include <U2Core/U2SafePoints.h>
+#include <U2Core/U2SqlHelpers.h>
+
+#include "MemoryAttributeDbi.h"
+
+namespace U2 {
+
+MemoryAttributeDbi::MemoryAttributeDbi(MemoryDbi* dbi)
+    : U2AttributeDbi(dbi),
+      MemoryChildDbiCommon(dbi)
+{
+
+}
+
+QStringList MemoryAttributeDbi::getAvailableAttributeNames(U2OpStatus&) {
+    QMutexLocker locker(dbi->getDbMutex());
+    QSet<QString> names;
+    foreach (const AttributeRecord& record, attributes) {
+        names.insert(record.header.name);
+    }
+    return names.toList();
+}
+
+QList<U2DataId> MemoryAttributeDbi::getObjectAttributes(const U2DataId& objectId, const QString& attributeName, U2OpStatus&) {
+    QMutexLocker locker(dbi->getDbMutex());
+    QList<U2DataId> result;
+    foreach (const U2DataId& id, attributesByObject.value(objectId)) {
+        if (attributeName.isEmpty() || attributes[id].header.name == attributeName) {
+            result << id;
+        }
+    }
+    return result;
+}
+
+QList<U2DataId> MemoryAttributeDbi::getObjectPairAttributes(const U2DataId& objectId, const U2DataId& childId, const QString& attributeName, U2OpStatus&) {
+    QMutexLocker locker(dbi->getDbMutex());
+    QList<U2DataId> result;
+    foreach (const U2DataId& id, attributesByObject.value(objectId)) {
+        const U2Attribute& header = attributes[id].header;
+        if (header.childId == childId && (attributeName.isEmpty() || header.name == attributeName)) {
+            result << id;
+        }
+    }
+    return result;
+}
+
+U2IntegerAttribute MemoryAttributeDbi::getIntegerAttribute(const U2DataId& attributeId, U2OpStatus& os) {
+    QMutexLocker locker(dbi->getDbMutex());
+    U2IntegerAttribute res;
+    const AttributeRecord* record = findAttribute(attributeId, U2Type::AttributeInteger, os);
+    CHECK_OP(os, res);
+    static_cast<U2Attribute&>(res) = record->header;
+    res.value = record->intValue;
+    return res;
+}
+
+U2RealAttribute MemoryAttributeDbi::getRealAttribute(const U2DataId& attributeId, U2OpStatus& os) {
+    QMutexLocker locker(dbi->getDbMutex());
+    U2RealAttribute res;
+    const AttributeRecord* record = findAttribute(attributeId, U2Type::AttributeReal, os);
+    CHECK_OP(os, res);
+    static_cast<U2Attribute&>(res) = record->header;
+    res.value = record->realValue;
+    return res;
+}
+
+U2StringAttribute MemoryAttributeDbi::getStringAttribute(const U2DataId& attributeId, U2OpStatus& os) {
+    QMutexLocker locker(dbi->getDbMutex());
+    U2StringAttribute res;
+    const AttributeRecord* record = findAttribute(attributeId, U2Type::AttributeString, os);
+    CHECK_OP(os, res);
+    static_cast<U2Attribute&>(res) = record->header;
+    res.value = record->stringValue;
+    return res;
+}
+
+U2ByteArrayAttribute MemoryAttributeDbi::getByteArrayAttribute(const U2DataId& attributeId, U2OpStatus& os) {
+    QMutexLocker locker(dbi->getDbMutex());
+    U2ByteArrayAttribute res;
+    const AttributeRecord* record = findAttribute(attributeId, U2Type::AttributeByteArray, os);
+    CHECK_OP(os, res);
+    static_cast<U2Attribute&>(res) = record->header;
+    res.value = record->byteArrayValue;
+    return res;
+}
+
+QList<U2DataId> MemoryAttributeDbi::sort(const U2DbiSortConfig&, qint64, qint64, U2OpStatus& os) {
+    U2DbiUtils::logNotSupported(U2DbiFeature_AttributeSorting, getRootDbi(), os);
+    return QList<U2DataId>();
+}
+
+void MemoryAttributeDbi::removeAttributes(const QList<U2DataId>& attributeIds, U2OpStatus&) {
+    QMutexLocker locker(dbi->getDbMutex());
+    foreach (const U2DataId& id, attributeIds) {
+        removeAttribute(id);
+    }
+}
+
+void MemoryAttributeDbi::removeObjectAttributes(const U2DataId& objectId, U2OpStatus&) {
+    QMutexLocker locker(dbi->getDbMutex());
+    foreach (const U2DataId& id, attributesByObject.value(objectId)) {
+        removeAttribute(id);
+    }
+}
+
+void MemoryAttributeDbi::createIntegerAttribute(U2IntegerAttribute& a, U2OpStatus& os) {
+    AttributeRecord record;
+    record.intValue = a.value;
+    createAttribute(a, U2Type::AttributeInteger, record, os);
+}
+
+void MemoryAttributeDbi::createRealAttribute(U2RealAttribute& a, U2OpStatus& os) {
+    AttributeRecord record;
+    record.realValue = a.value;
+    createAttribute(a, U2Type::AttributeReal, record, os);
+}
+
+void MemoryAttributeDbi::createStringAttribute(U2StringAttribute& a, U2OpStatus& os) {
+    AttributeRecord record;
+    record.stringValue = a.value;
+    createAttribute(a, U2Type::AttributeString, record, os);
+}
+
+void MemoryAttributeDbi::createByteArrayAttribute(U2ByteArrayAttribute& a, U2OpStatus& os) {
+    AttributeRecord record;
+    record.byteArrayValue = a.value;
+    createAttribute(a, U2Type::AttributeByteArray, record, os);
+}
+
+void MemoryAttributeDbi::createAttribute(U2Attribute& attribute, U2DataType type, const AttributeRecord& record, U2OpStatus&) {
+    QMutexLocker locker(dbi->getDbMutex());
+    attribute.id = dbi->createId(type);
+
+    AttributeRecord& stored = attributes[attribute.id];
+    stored = record;
+    stored.header = attribute;
+    attributesByObject[attribute.objectId] << attribute.id;
+    dbi->updateUsedMemory(getRecordSize(stored));
+}
+
+const MemoryAttributeDbi::AttributeRecord* MemoryAttributeDbi::findAttribute(const U2DataId& attributeId, U2DataType type, U2OpStatus& os) const {
+    DBI_TYPE_CHECK(attributeId, type, os, NULL);
+    QHash<U2DataId, AttributeRecord>::ConstIterator it = attributes.constFind(attributeId);
+    CHECK_EXT(it != attributes.constEnd(), os.setError(U2DbiL10n::tr("Attribute not found.")), NULL);
+    return &it.value();
+}
+
+void MemoryAttributeDbi::removeAttribute(const U2DataId& attributeId) {
+    QHash<U2DataId, AttributeRecord>::Iterator it = attributes.find(attributeId);
+    CHECK(it != attributes.end(), );
+
+    const U2DataId objectId = it->header.objectId;
+    dbi->updateUsedMemory(-getRecordSize(*it));
+    attributes.erase(it);
+
+    QHash<U2DataId, QList<U2DataId> >::Iterator objectIt = attributesByObject.find(objectId);
+    CHECK(objectIt != attributesByObject.end(), );
+    objectIt->removeAll(attributeId);
+    if (objectIt->isEmpty()) {
+        attributesByObject.erase(objectIt);
+    }
+}
+
+qint64 MemoryAttributeDbi::getRecordSize(const AttributeRecord& record) {
+    return sizeof(AttributeRecord) + (record.header.name.size() + record.stringValue.size()) * sizeof(QChar) + record.byteArrayValue.size();
+}
+
+}   // namespace U2
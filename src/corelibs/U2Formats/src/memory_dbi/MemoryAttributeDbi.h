@@ -0,0 +1,77 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef _U2_MEMORY_ATTRIBUTE_DBI_H_
+#define _U2_MEMORY_ATTRIBUTE_DBI_H_
+
+#include "MemoryDbi.h"
+
+namespace U2 {
+
+class MemoryAttributeDbi : public U2AttributeDbi, public MemoryChildDbiCommon {
+public:
+    MemoryAttributeDbi(MemoryDbi* dbi);
+
+    virtual QStringList getAvailableAttributeNames(U2OpStatus& os);
+    virtual QList<U2DataId> getObjectAttributes(const U2DataId& objectId, const QString& attributeName, U2OpStatus& os);
+    virtual QList<U2DataId> getObjectPairAttributes(const U2DataId& objectId, const U2DataId& childId, const QString& attributeName, U2OpStatus& os);
+
+    virtual U2IntegerAttribute getIntegerAttribute(const U2DataId& attributeId, U2OpStatus& os);
+    virtual U2RealAttribute getRealAttribute(const U2DataId& attributeId, U2OpStatus& os);
+    virtual U2StringAttribute getStringAttribute(const U2DataId& attributeId, U2OpStatus& os);
+    virtual U2ByteArrayAttribute getByteArrayAttribute(const U2DataId& attributeId, U2OpStatus& os);
+
+    /** Not supported */
+    virtual QList<U2DataId> sort(const U2DbiSortConfig& sc, qint64 offset, qint64 count, U2OpStatus& os);
+
+    virtual void removeAttributes(const QList<U2DataId>& attributeIds, U2OpStatus& os);
+    virtual void removeObjectAttributes(const U2DataId& objectId, U2OpStatus& os);
+
+    virtual void createIntegerAttribute(U2IntegerAttribute& a, U2OpStatus& os);
+    virtual void createRealAttribute(U2RealAttribute& a, U2OpStatus& os);
+    virtual void createStringAttribute(U2StringAttribute& a, U2OpStatus& os);
+    virtual void createByteArrayAttribute(U2ByteArrayAttribute& a, U2OpStatus& os);
+
+private:
+    struct AttributeRecord {
+        AttributeRecord() : intValue(0), realValue(0.0) {}
+
+        U2Attribute     header;
+        qint64          intValue;
+        double          realValue;
+        QString         stringValue;
+        QByteArray      byteArrayValue;
+    };
+
+    void createAttribute(U2Attribute& attribute, U2DataType type, const AttributeRecord& record, U2OpStatus& os);
+    const AttributeRecord* findAttribute(const U2DataId& attributeId, U2DataType type, U2OpStatus& os) const;
+    void removeAttribute(const U2DataId& attributeId);
+
+    static qint64 getRecordSize(const AttributeRecord& record);
+
+    QHash<U2DataId, AttributeRecord> attributes;
+    /** Attribute ids sorted by the creation order */
+    QHash<U2DataId, QList<U2DataId> > attributesByObject;
+};
+
+}   // namespace U2
+
+#endif // _U2_MEMORY_ATTRIBUTE_DBI_H_
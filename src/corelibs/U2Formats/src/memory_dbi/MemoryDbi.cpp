@@ -0,0 +1,254 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include <U2Core/U2SafePoints.h>
+#include <U2Core/U2SqlHelpers.h>
+
+#include "MemoryAttributeDbi.h"
+#include "MemoryDbi.h"
+#include "MemoryFeatureDbi.h"
+#include "MemoryMsaDbi.h"
+#include "MemoryObjectDbi.h"
+#include "MemorySequenceDbi.h"
+
+namespace U2 {
+
+MemoryDbi::MemoryDbi()
+    : U2AbstractDbi(MemoryDbiFactory::ID),
+      lock(QMutex::Recursive),
+      lastId(0),
+      usedMemory(0)
+{
+    objectDbi.reset(new MemoryObjectDbi(this));
+    objectRelationsDbi.reset(new MemoryObjectRelationsDbi(this));
+    sequenceDbi.reset(new MemorySequenceDbi(this));
+    msaDbi.reset(new MemoryMsaDbi(this));
+    featureDbi.reset(new MemoryFeatureDbi(this));
+    attributeDbi.reset(new MemoryAttributeDbi(this));
+    modDbi.reset(new MemoryModDbi(this));
+}
+
+MemoryDbi::~MemoryDbi() {
+
+}
+
+void MemoryDbi::init(const QHash<QString, QString>& props, const QVariantMap&, U2OpStatus& os) {
+    QMutexLocker locker(&lock);
+    if (state != U2DbiState_Void) {
+        os.setError(U2DbiL10n::tr("Illegal database state: %1").arg(state));
+        return;
+    }
+
+    const QString url = props.value(U2DbiOptions::U2_DBI_OPTION_URL);
+    CHECK_EXT(!url.isEmpty(), os.setError(U2DbiL10n::tr("URL is not specified")), );
+
+    dbiId = url;
+    initProperties = props;
+
+    features.insert(U2DbiFeature_ReadSequence);
+    features.insert(U2DbiFeature_WriteSequence);
+    features.insert(U2DbiFeature_ReadMsa);
+    features.insert(U2DbiFeature_WriteMsa);
+    features.insert(U2DbiFeature_ReadFeatures);
+    features.insert(U2DbiFeature_WriteFeatures);
+    features.insert(U2DbiFeature_ReadAttributes);
+    features.insert(U2DbiFeature_WriteAttributes);
+    features.insert(U2DbiFeature_ReadProperties);
+    features.insert(U2DbiFeature_WriteProperties);
+    features.insert(U2DbiFeature_ReadRelations);
+    features.insert(U2DbiFeature_WriteRelations);
+    features.insert(U2DbiFeature_RemoveObjects);
+
+    state = U2DbiState_Ready;
+}
+
+QVariantMap MemoryDbi::shutdown(U2OpStatus& os) {
+    QMutexLocker locker(&lock);
+    if (state != U2DbiState_Ready) {
+        os.setError(U2DbiL10n::tr("Illegal database state %1!").arg(state));
+        return QVariantMap();
+    }
+
+    state = U2DbiState_Stopping;
+    objectDbi.reset(new MemoryObjectDbi(this));
+    objectRelationsDbi.reset(new MemoryObjectRelationsDbi(this));
+    sequenceDbi.reset(new MemorySequenceDbi(this));
+    msaDbi.reset(new MemoryMsaDbi(this));
+    featureDbi.reset(new MemoryFeatureDbi(this));
+    attributeDbi.reset(new MemoryAttributeDbi(this));
+    properties.clear();
+    usedMemory = 0;
+    state = U2DbiState_Void;
+    return QVariantMap();
+}
+
+U2ObjectDbi* MemoryDbi::getObjectDbi() {
+    return objectDbi.data();
+}
+
+U2ObjectRelationsDbi* MemoryDbi::getObjectRelationsDbi() {
+    return objectRelationsDbi.data();
+}
+
+U2SequenceDbi* MemoryDbi::getSequenceDbi() {
+    return sequenceDbi.data();
+}
+
+U2MsaDbi* MemoryDbi::getMsaDbi() {
+    return msaDbi.data();
+}
+
+U2FeatureDbi* MemoryDbi::getFeatureDbi() {
+    return featureDbi.data();
+}
+
+U2AttributeDbi* MemoryDbi::getAttributeDbi() {
+    return attributeDbi.data();
+}
+
+U2ModDbi* MemoryDbi::getModDbi() {
+    return modDbi.data();
+}
+
+U2DataType MemoryDbi::getEntityTypeById(const U2DataId& id) const {
+    return U2DbiUtils::toType(id);
+}
+
+QString MemoryDbi::getProperty(const QString& name, const QString& defaultValue, U2OpStatus&) {
+    QMutexLocker locker(&lock);
+    if (MEMORY_DBI_USED_MEMORY_PROPERTY == name) {
+        return QString::number(usedMemory);
+    }
+    return properties.value(name, defaultValue);
+}
+
+void MemoryDbi::setProperty(const QString& name, const QString& value, U2OpStatus&) {
+    QMutexLocker locker(&lock);
+    properties[name] = value;
+}
+
+QMutex * MemoryDbi::getDbMutex() const {
+    return &lock;
+}
+
+bool MemoryDbi::isReadOnly() const {
+    return false;
+}
+
+MemoryObjectDbi* MemoryDbi::getMemoryObjectDbi() const {
+    return objectDbi.data();
+}
+
+MemoryObjectRelationsDbi* MemoryDbi::getMemoryObjectRelationsDbi() const {
+    return objectRelationsDbi.data();
+}
+
+MemorySequenceDbi* MemoryDbi::getMemorySequenceDbi() const {
+    return sequenceDbi.data();
+}
+
+MemoryMsaDbi* MemoryDbi::getMemoryMsaDbi() const {
+    return msaDbi.data();
+}
+
+MemoryFeatureDbi* MemoryDbi::getMemoryFeatureDbi() const {
+    return featureDbi.data();
+}
+
+MemoryAttributeDbi* MemoryDbi::getMemoryAttributeDbi() const {
+    return attributeDbi.data();
+}
+
+qint64 MemoryDbi::getUsedMemory() const {
+    QMutexLocker locker(&lock);
+    return usedMemory;
+}
+
+void MemoryDbi::updateUsedMemory(qint64 delta) {
+    usedMemory += delta;
+    SAFE_POINT(usedMemory >= 0, "Negative memory usage", );
+}
+
+U2DataId MemoryDbi::createId(U2DataType type) {
+    QMutexLocker locker(&lock);
+    return U2DbiUtils::toU2DataId(++lastId, type);
+}
+
+/************************************************************************/
+/* MemoryModDbi */
+/************************************************************************/
+MemoryModDbi::MemoryModDbi(MemoryDbi* dbi)
+    : U2ModDbi(dbi),
+      MemoryChildDbiCommon(dbi)
+{
+
+}
+
+U2SingleModStep MemoryModDbi::getModStep(const U2DataId&, qint64, U2OpStatus& os) {
+    U2DbiUtils::logNotSupported(U2DbiFeature_ReadModifications, dbi, os);
+    return U2SingleModStep();
+}
+
+void MemoryModDbi::removeObjectMods(const U2DataId&, U2OpStatus&) {
+    // modifications are not tracked
+}
+
+void MemoryModDbi::startCommonUserModStep(const U2DataId&, U2OpStatus&) {
+    // modifications are not tracked
+}
+
+void MemoryModDbi::endCommonUserModStep(const U2DataId&, U2OpStatus&) {
+    // modifications are not tracked
+}
+
+/************************************************************************/
+/* MemoryDbiFactory */
+/************************************************************************/
+const U2DbiFactoryId MemoryDbiFactory::ID = MEMORY_DBI_ID;
+
+MemoryDbiFactory::MemoryDbiFactory()
+    : U2DbiFactory()
+{
+
+}
+
+U2Dbi* MemoryDbiFactory::createDbi() {
+    return new MemoryDbi();
+}
+
+U2DbiFactoryId MemoryDbiFactory::getId() const {
+    return ID;
+}
+
+FormatCheckResult MemoryDbiFactory::isValidDbi(const QHash<QString, QString>&, const QByteArray&, U2OpStatus&) const {
+    return FormatDetection_NotMatched;
+}
+
+GUrl MemoryDbiFactory::id2Url(const U2DbiId& id) const {
+    return GUrl(id, GUrl_File);
+}
+
+bool MemoryDbiFactory::isDbiExists(const U2DbiId&) const {
+    // the database exists only while it is opened in the DBI pool
+    return false;
+}
+
+}   // namespace U2
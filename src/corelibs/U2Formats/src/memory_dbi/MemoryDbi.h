@@ -0,0 +1,161 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef _U2_MEMORY_DBI_H_
+#define _U2_MEMORY_DBI_H_
+
+#include <QMutex>
+
+#include <U2Core/U2AbstractDbi.h>
+#include <U2Core/U2DbiRegistry.h>
+
+namespace U2 {
+
+class MemoryAttributeDbi;
+class MemoryFeatureDbi;
+class MemoryModDbi;
+class MemoryMsaDbi;
+class MemoryObjectDbi;
+class MemoryObjectRelationsDbi;
+class MemorySequenceDbi;
+
+/**
+    RAM-resident DBI. Keeps sequences, alignments, annotation tables and attributes
+    in process memory and never touches the file system: the database URL is used as an identifier only.
+    The data lives until the last connection to the database is closed.
+
+    Intended for short-living temporary data like workflow messages.
+    All methods are thread-safe.
+*/
+class U2FORMATS_EXPORT MemoryDbi : public U2AbstractDbi {
+public:
+    MemoryDbi();
+    ~MemoryDbi();
+
+    virtual void init(const QHash<QString, QString>& properties, const QVariantMap& persistentData, U2OpStatus& os);
+
+    virtual QVariantMap shutdown(U2OpStatus& os);
+
+    virtual U2ObjectDbi* getObjectDbi();
+
+    virtual U2ObjectRelationsDbi* getObjectRelationsDbi();
+
+    virtual U2SequenceDbi* getSequenceDbi();
+
+    virtual U2MsaDbi* getMsaDbi();
+
+    virtual U2FeatureDbi* getFeatureDbi();
+
+    virtual U2AttributeDbi* getAttributeDbi();
+
+    virtual U2ModDbi* getModDbi();
+
+    virtual U2DataType getEntityTypeById(const U2DataId& id) const;
+
+    virtual QString getProperty(const QString& name, const QString& defaultValue, U2OpStatus& os);
+
+    virtual void setProperty(const QString& name, const QString& value, U2OpStatus& os);
+
+    virtual QMutex * getDbMutex() const;
+
+    virtual bool isReadOnly() const;
+
+    MemoryObjectDbi* getMemoryObjectDbi() const;
+
+    MemoryObjectRelationsDbi* getMemoryObjectRelationsDbi() const;
+
+    MemorySequenceDbi* getMemorySequenceDbi() const;
+
+    MemoryMsaDbi* getMemoryMsaDbi() const;
+
+    MemoryFeatureDbi* getMemoryFeatureDbi() const;
+
+    MemoryAttributeDbi* getMemoryAttributeDbi() const;
+
+    /** Returns an approximate size of the data stored in the database, in bytes */
+    qint64 getUsedMemory() const;
+
+    /** Changes the used memory counter. Must be called under the database lock */
+    void updateUsedMemory(qint64 delta);
+
+    /** Returns a new database-wide unique id for an entity of the @type */
+    U2DataId createId(U2DataType type);
+
+private:
+    mutable QMutex                          lock;
+    qint64                                  lastId;
+    qint64                                  usedMemory;
+    QHash<QString, QString>                 properties;
+
+    QScopedPointer<MemoryObjectDbi>         objectDbi;
+    QScopedPointer<MemoryObjectRelationsDbi> objectRelationsDbi;
+    QScopedPointer<MemorySequenceDbi>       sequenceDbi;
+    QScopedPointer<MemoryMsaDbi>            msaDbi;
+    QScopedPointer<MemoryFeatureDbi>        featureDbi;
+    QScopedPointer<MemoryAttributeDbi>      attributeDbi;
+    QScopedPointer<MemoryModDbi>            modDbi;
+};
+
+/** Common base for all MemoryDbi sub-DBIs */
+class MemoryChildDbiCommon {
+public:
+    MemoryChildDbiCommon(MemoryDbi* dbi) : dbi(dbi) {}
+    virtual ~MemoryChildDbiCommon() {}
+
+protected:
+    MemoryDbi* dbi;
+};
+
+/**
+    Modifications are not tracked in memory: undo/redo is not available for the stored objects,
+    user modification steps are accepted and ignored.
+*/
+class MemoryModDbi : public U2ModDbi, public MemoryChildDbiCommon {
+public:
+    MemoryModDbi(MemoryDbi* dbi);
+
+    virtual U2SingleModStep getModStep(const U2DataId& objectId, qint64 trackVersion, U2OpStatus& os);
+    virtual void removeObjectMods(const U2DataId& objectId, U2OpStatus& os);
+    virtual void startCommonUserModStep(const U2DataId& masterObjId, U2OpStatus& os);
+    virtual void endCommonUserModStep(const U2DataId& masterObjId, U2OpStatus& os);
+};
+
+class U2FORMATS_EXPORT MemoryDbiFactory : public U2DbiFactory {
+public:
+    MemoryDbiFactory();
+
+    virtual U2Dbi* createDbi();
+
+    virtual U2DbiFactoryId getId() const;
+
+    /** Memory databases can't be stored in files, so nothing matches */
+    virtual FormatCheckResult isValidDbi(const QHash<QString, QString>& properties, const QByteArray& rawData, U2OpStatus& os) const;
+
+    virtual GUrl id2Url(const U2DbiId& id) const;
+
+    virtual bool isDbiExists(const U2DbiId& id) const;
+
+    static const U2DbiFactoryId ID;
+};
+
+}   // namespace U2
+
+#endif // _U2_MEMORY_DBI_H_
@@ -0,0 +1,599 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include <U2Core/U2DbiUtils.h>
+#include <U2Core/U2SafePoints.h>
+#include <U2Core/U2SqlHelpers.h>
+
+#include "MemoryFeatureDbi.h"
+#include "MemoryObjectDbi.h"
+
+namespace U2 {
+
+namespace {
+
+template <class T>
+bool compareValues(const T& value, const T& pattern, ComparisonOp op) {
+    switch (op) {
+    case ComparisonOp_EQ:
+        return value == pattern;
+    case ComparisonOp_NEQ:
+        return value != pattern;
+    case ComparisonOp_GT:
+        return value > pattern;
+    case ComparisonOp_GET:
+        return value >= pattern;
+    case ComparisonOp_LT:
+        return value < pattern;
+    case ComparisonOp_LET:
+        return value <= pattern;
+    default:
+        return false;
+    }
+}
+
+bool startPosLessThan(const U2Feature& first, const U2Feature& second) {
+    return first.location.region.startPos < second.location.region.startPos;
+}
+
+bool startPosGreaterThan(const U2Feature& first, const U2Feature& second) {
+    return first.location.region.startPos > second.location.region.startPos;
+}
+
+bool featureTableLessThan(const U2Feature& first, const U2Feature& second) {
+    if (first.featureClass != second.featureClass) {
+        return first.featureClass > second.featureClass;
+    }
+    if (first.location.region.startPos != second.location.region.startPos) {
+        return first.location.region.startPos < second.location.region.startPos;
+    }
+    return first.location.region.length < second.location.region.length;
+}
+
+bool matchesNameAndSequence(const U2Feature& feature, const QString& name, const U2DataId& seqId) {
+    return (name.isEmpty() || feature.name == name) && (seqId.isEmpty() || seqId == feature.sequenceId);
+}
+
+bool matchesClass(const U2Feature& feature, const FeatureFlags& types) {
+    return types.testFlag(feature.featureClass);
+}
+
+}
+
+MemoryFeatureDbi::MemoryFeatureDbi(MemoryDbi* dbi)
+    : U2FeatureDbi(dbi),
+      MemoryChildDbiCommon(dbi)
+{
+
+}
+
+void MemoryFeatureDbi::createAnnotationTableObject(U2AnnotationTable& table, const QString& folder, U2OpStatus& os) {
+    QMutexLocker locker(dbi->getDbMutex());
+    dbi->getMemoryObjectDbi()->createObject(table, folder, U2DbiObjectRank_TopLevel, os);
+    CHECK_OP(os, );
+    annotationTables.insert(table.id, table.rootFeature);
+}
+
+U2AnnotationTable MemoryFeatureDbi::getAnnotationTableObject(const U2DataId& tableId, U2OpStatus& os) {
+    U2AnnotationTable result;
+    DBI_TYPE_CHECK(tableId, U2Type::AnnotationTable, os, result);
+
+    QMutexLocker locker(dbi->getDbMutex());
+    CHECK_EXT(annotationTables.contains(tableId), os.setError(U2DbiL10n::tr("Annotation table object not found.")), result);
+    dbi->getMemoryObjectDbi()->getObject(result, tableId, os);
+    CHECK_OP(os, result);
+    result.rootFeature = annotationTables.value(tableId);
+    return result;
+}
+
+void MemoryFeatureDbi::removeAnnotationTableData(const U2DataId& tableId, U2OpStatus& os) {
+    DBI_TYPE_CHECK(tableId, U2Type::AnnotationTable, os, );
+
+    QMutexLocker locker(dbi->getDbMutex());
+    CHECK(annotationTables.contains(tableId), );
+    const U2DataId rootId = annotationTables.take(tableId);
+    CHECK(!rootId.isEmpty(), );
+
+    foreach (quint64 id, featuresByRoot.value(rootId)) {
+        removeFeatureCore(id);
+    }
+    removeFeatureCore(U2DbiUtils::toDbiId(rootId));
+}
+
+U2Feature MemoryFeatureDbi::getFeature(const U2DataId& featureId, U2OpStatus& os) {
+    DBI_TYPE_CHECK(featureId, U2Type::Feature, os, U2Feature());
+
+    QMutexLocker locker(dbi->getDbMutex());
+    FeatureRecord* record = findFeature(featureId, os);
+    CHECK_OP(os, U2Feature());
+    return record->feature;
+}
+
+qint64 MemoryFeatureDbi::countFeatures(const FeatureQuery& q, U2OpStatus& os) {
+    QMutexLocker locker(dbi->getDbMutex());
+    const QList<U2Feature> result = selectFeatures(q, os);
+    CHECK_OP(os, -1);
+    return result.size();
+}
+
+U2DbiIterator<U2Feature>* MemoryFeatureDbi::getFeatures(const FeatureQuery& q, U2OpStatus& os) {
+    QMutexLocker locker(dbi->getDbMutex());
+    const QList<U2Feature> result = selectFeatures(q, os);
+    CHECK_OP(os, NULL);
+    return new BufferedDbiIterator<U2Feature>(result, U2Feature());
+}
+
+QList<U2FeatureKey> MemoryFeatureDbi::getFeatureKeys(const U2DataId& featureId, U2OpStatus& os) {
+    QMutexLocker locker(dbi->getDbMutex());
+    FeatureRecord* record = findFeature(featureId, os);
+    CHECK_OP(os, QList<U2FeatureKey>());
+    return record->keys;
+}
+
+QList<FeatureAndKey> MemoryFeatureDbi::getFeatureTable(const U2DataId& rootFeatureId, U2OpStatus&) {
+    QMutexLocker locker(dbi->getDbMutex());
+    QList<U2Feature> tableFeatures;
+    foreach (quint64 id, featuresByRoot.value(rootFeatureId)) {
+        tableFeatures << features[id].feature;
+    }
+    qStableSort(tableFeatures.begin(), tableFeatures.end(), featureTableLessThan);
+
+    QList<FeatureAndKey> result;
+    foreach (const U2Feature& feature, tableFeatures) {
+        const QList<U2FeatureKey>& keys = features[U2DbiUtils::toDbiId(feature.id)].keys;
+        FeatureAndKey fnk;
+        fnk.feature = feature;
+        if (keys.isEmpty()) {
+            result << fnk;
+        }
+        foreach (const U2FeatureKey& key, keys) {
+            fnk.key = key;
+            result << fnk;
+        }
+    }
+    return result;
+}
+
+void MemoryFeatureDbi::createFeature(U2Feature& feature, const QList<U2FeatureKey>& keys, U2OpStatus&) {
+    QMutexLocker locker(dbi->getDbMutex());
+    feature.id = dbi->createId(U2Type::Feature);
+
+    FeatureRecord record;
+    record.feature = feature;
+    record.keys = keys;
+    features.insert(U2DbiUtils::toDbiId(feature.id), record);
+    updateIndexes(U2Feature(), feature);
+    dbi->updateUsedMemory(getRecordSize(record));
+}
+
+void MemoryFeatureDbi::addKey(const U2DataId& featureId, const U2FeatureKey& key, U2OpStatus& os) {
+    DBI_TYPE_CHECK(featureId, U2Type::Feature, os, );
+
+    QMutexLocker locker(dbi->getDbMutex());
+    FeatureRecord* record = findFeature(featureId, os);
+    CHECK_OP(os, );
+
+    const qint64 oldSize = getRecordSize(*record);
+    record->keys << key;
+    dbi->updateUsedMemory(getRecordSize(*record) - oldSize);
+}
+
+void MemoryFeatureDbi::removeAllKeys(const U2DataId& featureId, const QString& keyName, U2OpStatus& os) {
+    DBI_TYPE_CHECK(featureId, U2Type::Feature, os, );
+
+    QMutexLocker locker(dbi->getDbMutex());
+    FeatureRecord* record = findFeature(featureId, os);
+    CHECK_OP(os, );
+
+    const qint64 oldSize = getRecordSize(*record);
+    for (int i = record->keys.size() - 1; i >= 0; i--) {
+        if (record->keys[i].name == keyName) {
+            record->keys.removeAt(i);
+        }
+    }
+    dbi->updateUsedMemory(getRecordSize(*record) - oldSize);
+}
+
+void MemoryFeatureDbi::removeKey(const U2DataId& featureId, const U2FeatureKey& key, U2OpStatus& os) {
+    DBI_TYPE_CHECK(featureId, U2Type::Feature, os, );
+
+    QMutexLocker locker(dbi->getDbMutex());
+    FeatureRecord* record = findFeature(featureId, os);
+    CHECK_OP(os, );
+
+    const qint64 oldSize = getRecordSize(*record);
+    record->keys.removeAll(key);
+    dbi->updateUsedMemory(getRecordSize(*record) - oldSize);
+}
+
+void MemoryFeatureDbi::updateKeyValue(const U2DataId& featureId, const U2FeatureKey& key, U2OpStatus& os) {
+    DBI_TYPE_CHECK(featureId, U2Type::Feature, os, );
+
+    QMutexLocker locker(dbi->getDbMutex());
+    FeatureRecord* record = findFeature(featureId, os);
+    CHECK_OP(os, );
+
+    const qint64 oldSize = getRecordSize(*record);
+    for (int i = 0; i < record->keys.size(); i++) {
+        if (record->keys[i].name == key.name) {
+            record->keys[i].value = key.value;
+        }
+    }
+    dbi->updateUsedMemory(getRecordSize(*record) - oldSize);
+}
+
+bool MemoryFeatureDbi::getKeyValue(const U2DataId& featureId, U2FeatureKey& key, U2OpStatus& os) {
+    DBI_TYPE_CHECK(featureId, U2Type::Feature, os, false);
+
+    QMutexLocker locker(dbi->getDbMutex());
+    FeatureRecord* record = findFeature(featureId, os);
+    CHECK_OP(os, false);
+
+    foreach (const U2FeatureKey& storedKey, record->keys) {
+        if (storedKey.name == key.name) {
+            key.value = storedKey.value;
+            return true;
+        }
+    }
+    return false;
+}
+
+void MemoryFeatureDbi::updateLocation(const U2DataId& featureId, const U2FeatureLocation& location, U2OpStatus& os) {
+    DBI_TYPE_CHECK(featureId, U2Type::Feature, os, );
+
+    QMutexLocker locker(dbi->getDbMutex());
+    FeatureRecord* record = findFeature(featureId, os);
+    CHECK_OP(os, );
+    record->feature.location = location;
+}
+
+void MemoryFeatureDbi::updateType(const U2DataId& featureId, U2FeatureType newType, U2OpStatus& os) {
+    DBI_TYPE_CHECK(featureId, U2Type::Feature, os, );
+
+    QMutexLocker locker(dbi->getDbMutex());
+    FeatureRecord* record = findFeature(featureId, os);
+    CHECK_OP(os, );
+    record->feature.featureType = newType;
+}
+
+void MemoryFeatureDbi::updateName(const U2DataId& featureId, const QString& newName, U2OpStatus& os) {
+    DBI_TYPE_CHECK(featureId, U2Type::Feature, os, );
+
+    QMutexLocker locker(dbi->getDbMutex());
+    FeatureRecord* record = findFeature(featureId, os);
+    CHECK_OP(os, );
+
+    const qint64 oldSize = getRecordSize(*record);
+    record->feature.name = newName;
+    dbi->updateUsedMemory(getRecordSize(*record) - oldSize);
+}
+
+void MemoryFeatureDbi::updateParentId(const U2DataId& featureId, const U2DataId& parentId, U2OpStatus& os) {
+    DBI_TYPE_CHECK(featureId, U2Type::Feature, os, );
+    DBI_TYPE_CHECK(parentId, U2Type::Feature, os, );
+
+    QMutexLocker locker(dbi->getDbMutex());
+    FeatureRecord* record = findFeature(featureId, os);
+    CHECK_OP(os, );
+
+    const U2Feature oldFeature = record->feature;
+    record->feature.parentFeatureId = parentId;
+    updateIndexes(oldFeature, record->feature);
+}
+
+void MemoryFeatureDbi::updateSequenceId(const U2DataId& featureId, const U2DataId& seqId, U2OpStatus& os) {
+    DBI_TYPE_CHECK(featureId, U2Type::Feature, os, );
+    DBI_TYPE_CHECK(seqId, U2Type::Sequence, os, );
+
+    QMutexLocker locker(dbi->getDbMutex());
+    FeatureRecord* record = findFeature(featureId, os);
+    CHECK_OP(os, );
+    record->feature.sequenceId = seqId;
+}
+
+void MemoryFeatureDbi::removeFeature(const U2DataId& featureId, U2OpStatus& os) {
+    DBI_TYPE_CHECK(featureId, U2Type::Feature, os, );
+
+    QMutexLocker locker(dbi->getDbMutex());
+    removeFeatureRecursive(U2DbiUtils::toDbiId(featureId));
+}
+
+void MemoryFeatureDbi::removeFeaturesByParent(const U2DataId& parentId, U2OpStatus& os, SubfeatureSelectionMode mode) {
+    DBI_TYPE_CHECK(parentId, U2Type::Feature, os, );
+
+    QMutexLocker locker(dbi->getDbMutex());
+    foreach (quint64 id, featuresByParent.value(parentId)) {
+        removeFeatureRecursive(id);
+    }
+    if (SelectParentFeature == mode) {
+        removeFeatureRecursive(U2DbiUtils::toDbiId(parentId));
+    }
+}
+
+void MemoryFeatureDbi::removeFeaturesByParents(const QList<U2DataId>& parentIds, U2OpStatus& os) {
+    QMutexLocker locker(dbi->getDbMutex());
+    foreach (const U2DataId& parentId, parentIds) {
+        removeFeaturesByParent(parentId, os, SelectParentFeature);
+        CHECK_OP(os, );
+    }
+}
+
+void MemoryFeatureDbi::removeFeaturesByRoot(const U2DataId& rootId, U2OpStatus& os, SubfeatureSelectionMode mode) {
+    DBI_TYPE_CHECK(rootId, U2Type::Feature, os, );
+
+    QMutexLocker locker(dbi->getDbMutex());
+    foreach (quint64 id, featuresByRoot.value(rootId)) {
+        removeFeatureCore(id);
+    }
+    if (SelectParentFeature == mode) {
+        removeFeatureCore(U2DbiUtils::toDbiId(rootId));
+    }
+}
+
+U2DbiIterator<U2Feature>* MemoryFeatureDbi::getFeaturesByRegion(const U2Region& reg, const U2DataId& rootId, const QString& featureName,
+                                                                  const U2DataId& seqId, U2OpStatus&, bool contains) {
+    QMutexLocker locker(dbi->getDbMutex());
+    QList<U2Feature> result;
+    foreach (quint64 id, getCandidates(rootId, U2DataId())) {
+        const U2Feature& feature = features[id].feature;
+        const U2Region& region = feature.location.region;
+        const bool matches = contains ? reg.contains(region) : (region.startPos < reg.endPos() && region.endPos() > reg.startPos);
+        if (matches && matchesNameAndSequence(feature, featureName, seqId)) {
+            result << feature;
+        }
+    }
+    return new BufferedDbiIterator<U2Feature>(result, U2Feature());
+}
+
+U2DbiIterator<U2Feature>* MemoryFeatureDbi::getFeaturesByParent(const U2DataId& parentId, const QString& featureName, const U2DataId& seqId,
+                                                                  U2OpStatus&, SubfeatureSelectionMode mode) {
+    QMutexLocker locker(dbi->getDbMutex());
+    QList<U2Feature> result;
+    foreach (quint64 id, featuresByParent.value(parentId)) {
+        const U2Feature& feature = features[id].feature;
+        if (matchesNameAndSequence(feature, featureName, seqId)) {
+            result << feature;
+        }
+    }
+    const quint64 parentDbiId = U2DbiUtils::toDbiId(parentId);
+    if (SelectParentFeature == mode && features.contains(parentDbiId)) {
+        const U2Feature& parent = features[parentDbiId].feature;
+        if (matchesNameAndSequence(parent, featureName, seqId)) {
+            result << parent;
+        }
+    }
+    sortByStart(result);
+    return new BufferedDbiIterator<U2Feature>(result, U2Feature());
+}
+
+U2DbiIterator<U2Feature>* MemoryFeatureDbi::getFeaturesByRoot(const U2DataId& rootId, const FeatureFlags& types, U2OpStatus&) {
+    QMutexLocker locker(dbi->getDbMutex());
+    QList<U2Feature> result;
+    foreach (quint64 id, featuresByRoot.value(rootId)) {
+        const U2Feature& feature = features[id].feature;
+        if (matchesClass(feature, types)) {
+            result << feature;
+        }
+    }
+    sortByStart(result);
+    return new BufferedDbiIterator<U2Feature>(result, U2Feature());
+}
+
+U2DbiIterator<U2Feature>* MemoryFeatureDbi::getFeaturesBySequence(const QString& featureName, const U2DataId& seqId, U2OpStatus&) {
+    QMutexLocker locker(dbi->getDbMutex());
+    QList<U2Feature> result;
+    foreach (const FeatureRecord& record, features) {
+        if (record.feature.sequenceId == seqId && record.feature.name == featureName) {
+            result << record.feature;
+        }
+    }
+    sortByStart(result);
+    return new BufferedDbiIterator<U2Feature>(result, U2Feature());
+}
+
+U2DbiIterator<U2Feature>* MemoryFeatureDbi::getFeaturesByName(const U2DataId& rootId, const QString& name, const FeatureFlags& types, U2OpStatus&) {
+    QMutexLocker locker(dbi->getDbMutex());
+    QList<U2Feature> result;
+    foreach (quint64 id, featuresByRoot.value(rootId)) {
+        const U2Feature& feature = features[id].feature;
+        if (feature.name == name && matchesClass(feature, types)) {
+            result << feature;
+        }
+    }
+    sortByStart(result);
+    return new BufferedDbiIterator<U2Feature>(result, U2Feature());
+}
+
+QMap<U2DataId, QStringList> MemoryFeatureDbi::getAnnotationTablesByFeatureKey(const QStringList& values, U2OpStatus&) {
+    QMutexLocker locker(dbi->getDbMutex());
+    QMap<U2DataId, QStringList> result;
+    CHECK(!values.isEmpty(), result);
+
+    for (QMap<U2DataId, U2DataId>::ConstIterator it = annotationTables.constBegin(); it != annotationTables.constEnd(); ++it) {
+        foreach (quint64 id, featuresByRoot.value(it.value())) {
+            const FeatureRecord& record = features[id];
+            foreach (const U2FeatureKey& key, record.keys) {
+                bool matches = true;
+                foreach (const QString& value, values) {
+                    CHECK_EXT_BREAK(key.value.contains(value, Qt::CaseInsensitive), matches = false);
+                }
+                if (matches && !result[it.key()].contains(record.feature.name)) {
+                    result[it.key()] << record.feature.name;
+                }
+            }
+        }
+    }
+    return result;
+}
+
+MemoryFeatureDbi::FeatureRecord* MemoryFeatureDbi::findFeature(const U2DataId& featureId, U2OpStatus& os) {
+    QMap<quint64, FeatureRecord>::Iterator it = features.find(U2DbiUtils::toDbiId(featureId));
+    CHECK_EXT(it != features.end(), os.setError(U2DbiL10n::tr("Feature not found.")), NULL);
+    return &it.value();
+}
+
+QList<U2Feature> MemoryFeatureDbi::selectFeatures(const FeatureQuery& q, U2OpStatus& os) {
+    QList<U2Feature> result;
+    if (!q.parentFeatureId.isEmpty()) {
+        DBI_TYPE_CHECK(q.parentFeatureId, U2Type::Feature, os, result);
+    }
+    if (!q.rootFeatureId.isEmpty()) {
+        DBI_TYPE_CHECK(q.rootFeatureId, U2Type::Feature, os, result);
+    }
+    if (!q.sequenceId.isEmpty()) {
+        DBI_TYPE_CHECK(q.sequenceId, U2Type::Sequence, os, result);
+    }
+
+    foreach (quint64 id, getCandidates(q.rootFeatureId, q.parentFeatureId)) {
+        const FeatureRecord& record = features[id];
+        if (matchesQuery(record, q)) {
+            result << record.feature;
+        }
+    }
+
+    const bool useRegion = 0 < q.intersectRegion.length;
+    if (useRegion && ComparisonOp_Invalid != q.closestFeature) {
+        // only one closest feature is returned
+        const bool descending = ComparisonOp_LT == q.closestFeature || ComparisonOp_LET == q.closestFeature;
+        qStableSort(result.begin(), result.end(), descending ? startPosGreaterThan : startPosLessThan);
+        result = result.mid(0, 1);
+    } else if (useRegion && OrderOp_None != q.startPosOrderOp) {
+        sortByStart(result);
+    }
+    return result;
+}
+
+QList<quint64> MemoryFeatureDbi::getCandidates(const U2DataId& rootId, const U2DataId& parentId) const {
+    if (!parentId.isEmpty()) {
+        return featuresByParent.value(parentId).toList();
+    }
+    if (!rootId.isEmpty()) {
+        return featuresByRoot.value(rootId).toList();
+    }
+    return features.keys();
+}
+
+void MemoryFeatureDbi::updateIndexes(const U2Feature& oldFeature, const U2Feature& newFeature) {
+    const quint64 id = U2DbiUtils::toDbiId(newFeature.id);
+    if (oldFeature.rootFeatureId != newFeature.rootFeatureId) {
+        if (!oldFeature.rootFeatureId.isEmpty()) {
+            featuresByRoot[oldFeature.rootFeatureId].remove(id);
+        }
+        if (!newFeature.rootFeatureId.isEmpty()) {
+            featuresByRoot[newFeature.rootFeatureId].insert(id);
+        }
+    }
+    if (oldFeature.parentFeatureId != newFeature.parentFeatureId) {
+        if (!oldFeature.parentFeatureId.isEmpty()) {
+            featuresByParent[oldFeature.parentFeatureId].remove(id);
+        }
+        if (!newFeature.parentFeatureId.isEmpty()) {
+            featuresByParent[newFeature.parentFeatureId].insert(id);
+        }
+    }
+}
+
+void MemoryFeatureDbi::removeFeatureCore(quint64 id) {
+    QMap<quint64, FeatureRecord>::Iterator it = features.find(id);
+    CHECK(it != features.end(), );
+
+    const U2Feature feature = it->feature;
+    dbi->updateUsedMemory(-getRecordSize(*it));
+    features.erase(it);
+
+    if (!feature.rootFeatureId.isEmpty()) {
+        QHash<U2DataId, QSet<quint64> >::Iterator rootIt = featuresByRoot.find(feature.rootFeatureId);
+        if (rootIt != featuresByRoot.end()) {
+            rootIt->remove(id);
+            if (rootIt->isEmpty()) {
+                featuresByRoot.erase(rootIt);
+            }
+        }
+    }
+    if (!feature.parentFeatureId.isEmpty()) {
+        QHash<U2DataId, QSet<quint64> >::Iterator parentIt = featuresByParent.find(feature.parentFeatureId);
+        if (parentIt != featuresByParent.end()) {
+            parentIt->remove(id);
+            if (parentIt->isEmpty()) {
+                featuresByParent.erase(parentIt);
+            }
+        }
+    }
+    featuresByRoot.remove(feature.id);
+    featuresByParent.remove(feature.id);
+}
+
+void MemoryFeatureDbi::removeFeatureRecursive(quint64 id) {
+    CHECK(features.contains(id), );
+    const U2DataId featureId = features[id].feature.id;
+    foreach (quint64 childId, featuresByParent.value(featureId)) {
+        removeFeatureRecursive(childId);
+    }
+    removeFeatureCore(id);
+}
+
+bool MemoryFeatureDbi::matchesQuery(const FeatureRecord& record, const FeatureQuery& q) {
+    const U2Feature& feature = record.feature;
+    if (q.parentFeatureId.isEmpty() && q.topLevelOnly) {
+        CHECK(feature.parentFeatureId.isEmpty(), false);
+    }
+    CHECK(U2Feature::Invalid == q.featureClass || q.featureClass == feature.featureClass, false);
+    CHECK(U2FeatureTypes::Invalid == q.featureType || q.featureType == feature.featureType, false);
+    CHECK(q.featureName.isEmpty() || q.featureName == feature.name, false);
+    CHECK(q.sequenceId.isEmpty() || q.sequenceId == feature.sequenceId, false);
+
+    if (0 < q.intersectRegion.length) {
+        const U2Region& region = feature.location.region;
+        if (ComparisonOp_Invalid == q.closestFeature) {
+            CHECK(region.startPos < q.intersectRegion.endPos() && region.endPos() > q.intersectRegion.startPos, false);
+        } else {
+            CHECK(compareValues(region.startPos, q.intersectRegion.startPos, q.closestFeature), false);
+        }
+    }
+
+    if (Strand_Direct == q.strandQuery) {
+        CHECK(feature.location.strand.isDirect(), false);
+    } else if (Strand_Compl == q.strandQuery) {
+        CHECK(feature.location.strand.isCompementary(), false);
+    }
+
+    CHECK(!q.keyName.isEmpty() || !q.keyValue.isEmpty(), true);
+    foreach (const U2FeatureKey& key, record.keys) {
+        CHECK_CONTINUE(q.keyName.isEmpty() || q.keyName == key.name);
+        CHECK_CONTINUE(q.keyValue.isEmpty() || compareValues(key.value, q.keyValue, q.keyValueCompareOp));
+        return true;
+    }
+    return false;
+}
+
+void MemoryFeatureDbi::sortByStart(QList<U2Feature>& features) {
+    qStableSort(features.begin(), features.end(), startPosLessThan);
+}
+
+qint64 MemoryFeatureDbi::getRecordSize(const FeatureRecord& record) {
+    qint64 stringsSize = record.feature.name.size();
+    foreach (const U2FeatureKey& key, record.keys) {
+        stringsSize += key.name.size() + key.value.size();
+    }
+    return sizeof(FeatureRecord) + stringsSize * sizeof(QChar);
+}
+
+}   // namespace U2
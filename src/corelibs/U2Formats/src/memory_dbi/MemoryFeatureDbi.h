@@ -0,0 +1,100 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef _U2_MEMORY_FEATURE_DBI_H_
+#define _U2_MEMORY_FEATURE_DBI_H_
+
+#include "MemoryDbi.h"
+
+namespace U2 {
+
+class MemoryFeatureDbi : public U2FeatureDbi, public MemoryChildDbiCommon {
+public:
+    MemoryFeatureDbi(MemoryDbi* dbi);
+
+    virtual void createAnnotationTableObject(U2AnnotationTable& table, const QString& folder, U2OpStatus& os);
+    virtual U2AnnotationTable getAnnotationTableObject(const U2DataId& tableId, U2OpStatus& os);
+    virtual void removeAnnotationTableData(const U2DataId& tableId, U2OpStatus& os);
+
+    virtual U2Feature getFeature(const U2DataId& featureId, U2OpStatus& os);
+    virtual qint64 countFeatures(const FeatureQuery& q, U2OpStatus& os);
+    virtual U2DbiIterator<U2Feature>* getFeatures(const FeatureQuery& q, U2OpStatus& os);
+    virtual QList<U2FeatureKey> getFeatureKeys(const U2DataId& featureId, U2OpStatus& os);
+    virtual QList<FeatureAndKey> getFeatureTable(const U2DataId& rootFeatureId, U2OpStatus& os);
+
+    virtual void createFeature(U2Feature& feature, const QList<U2FeatureKey>& keys, U2OpStatus& os);
+    virtual void addKey(const U2DataId& featureId, const U2FeatureKey& key, U2OpStatus& os);
+    virtual void removeAllKeys(const U2DataId& featureId, const QString& keyName, U2OpStatus& os);
+    virtual void removeKey(const U2DataId& featureId, const U2FeatureKey& key, U2OpStatus& os);
+    virtual void updateKeyValue(const U2DataId& featureId, const U2FeatureKey& key, U2OpStatus& os);
+    virtual bool getKeyValue(const U2DataId& featureId, U2FeatureKey& key, U2OpStatus& os);
+    virtual void updateLocation(const U2DataId& featureId, const U2FeatureLocation& location, U2OpStatus& os);
+    virtual void updateType(const U2DataId& featureId, U2FeatureType newType, U2OpStatus& os);
+    virtual void updateName(const U2DataId& featureId, const QString& newName, U2OpStatus& os);
+    virtual void updateParentId(const U2DataId& featureId, const U2DataId& parentId, U2OpStatus& os);
+    virtual void updateSequenceId(const U2DataId& featureId, const U2DataId& seqId, U2OpStatus& os);
+
+    virtual void removeFeature(const U2DataId& featureId, U2OpStatus& os);
+    virtual void removeFeaturesByParent(const U2DataId& parentId, U2OpStatus& os, SubfeatureSelectionMode mode);
+    virtual void removeFeaturesByParents(const QList<U2DataId>& parentIds, U2OpStatus& os);
+    virtual void removeFeaturesByRoot(const U2DataId& rootId, U2OpStatus& os, SubfeatureSelectionMode mode);
+
+    virtual U2DbiIterator<U2Feature>* getFeaturesByRegion(const U2Region& reg, const U2DataId& rootId, const QString& featureName,
+                                                          const U2DataId& seqId, U2OpStatus& os, bool contains);
+    virtual U2DbiIterator<U2Feature>* getFeaturesByParent(const U2DataId& parentId, const QString& featureName, const U2DataId& seqId,
+                                                          U2OpStatus& os, SubfeatureSelectionMode mode);
+    virtual U2DbiIterator<U2Feature>* getFeaturesByRoot(const U2DataId& rootId, const FeatureFlags& types, U2OpStatus& os);
+    virtual U2DbiIterator<U2Feature>* getFeaturesBySequence(const QString& featureName, const U2DataId& seqId, U2OpStatus& os);
+    virtual U2DbiIterator<U2Feature>* getFeaturesByName(const U2DataId& rootId, const QString& name, const FeatureFlags& types, U2OpStatus& os);
+
+    virtual QMap<U2DataId, QStringList> getAnnotationTablesByFeatureKey(const QStringList& values, U2OpStatus& os);
+
+private:
+    struct FeatureRecord {
+        U2Feature               feature;
+        QList<U2FeatureKey>     keys;
+    };
+
+    FeatureRecord* findFeature(const U2DataId& featureId, U2OpStatus& os);
+    QList<U2Feature> selectFeatures(const FeatureQuery& q, U2OpStatus& os);
+    QList<quint64> getCandidates(const U2DataId& rootId, const U2DataId& parentId) const;
+
+    void updateIndexes(const U2Feature& oldFeature, const U2Feature& newFeature);
+    void removeFeatureCore(quint64 id);
+    void removeFeatureRecursive(quint64 id);
+
+    static bool matchesQuery(const FeatureRecord& record, const FeatureQuery& q);
+    static void sortByStart(QList<U2Feature>& features);
+    static qint64 getRecordSize(const FeatureRecord& record);
+
+    /** Features sorted by the creation order */
+    QMap<quint64, FeatureRecord> features;
+    /** Feature ids by the root feature id */
+    QHash<U2DataId, QSet<quint64> > featuresByRoot;
+    /** Feature ids by the parent feature id */
+    QHash<U2DataId, QSet<quint64> > featuresByParent;
+    /** Root feature ids by the annotation table object id */
+    QMap<U2DataId, U2DataId> annotationTables;
+};
+
+}   // namespace U2
+
+#endif // _U2_MEMORY_FEATURE_DBI_H_
@@ -0,0 +1,347 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include <U2Core/U2Mca.h>
+#include <U2Core/U2SafePoints.h>
+#include <U2Core/U2SqlHelpers.h>
+
+#include "MemoryMsaDbi.h"
+#include "MemoryObjectDbi.h"
+#include "MemorySequenceDbi.h"
+
+namespace U2 {
+
+MemoryMsaDbi::MemoryMsaDbi(MemoryDbi* dbi)
+    : U2MsaDbi(dbi),
+      MemoryChildDbiCommon(dbi)
+{
+
+}
+
+U2Msa MemoryMsaDbi::getMsaObject(const U2DataId& msaId, U2OpStatus& os) {
+    QMutexLocker locker(dbi->getDbMutex());
+    U2Msa res;
+    dbi->getMemoryObjectDbi()->getObject(res, msaId, os);
+    CHECK_OP(os, res);
+
+    MsaRecord* msa = findMsa(msaId, os);
+    CHECK_OP(os, res);
+    res.length = msa->length;
+    res.alphabet = msa->alphabet;
+    return res;
+}
+
+qint64 MemoryMsaDbi::getNumOfRows(const U2DataId& msaId, U2OpStatus& os) {
+    QMutexLocker locker(dbi->getDbMutex());
+    MsaRecord* msa = findMsa(msaId, os);
+    CHECK_OP(os, 0);
+    return msa->order.size();
+}
+
+QList<U2MsaRow> MemoryMsaDbi::getRows(const U2DataId& msaId, U2OpStatus& os) {
+    QMutexLocker locker(dbi->getDbMutex());
+    QList<U2MsaRow> res;
+    MsaRecord* msa = findMsa(msaId, os);
+    CHECK_OP(os, res);
+
+    res.reserve(msa->order.size());
+    foreach (qint64 rowId, msa->order) {
+        res << msa->rows.value(rowId);
+    }
+    return res;
+}
+
+U2MsaRow MemoryMsaDbi::getRow(const U2DataId& msaId, qint64 rowId, U2OpStatus& os) {
+    QMutexLocker locker(dbi->getDbMutex());
+    MsaRecord* msa = findMsa(msaId, os);
+    CHECK_OP(os, U2MsaRow());
+    U2MsaRow* row = findRow(msa, rowId, os);
+    CHECK_OP(os, U2MsaRow());
+    return *row;
+}
+
+QList<qint64> MemoryMsaDbi::getRowsOrder(const U2DataId& msaId, U2OpStatus& os) {
+    QMutexLocker locker(dbi->getDbMutex());
+    MsaRecord* msa = findMsa(msaId, os);
+    CHECK_OP(os, QList<qint64>());
+    return msa->order;
+}
+
+U2AlphabetId MemoryMsaDbi::getMsaAlphabet(const U2DataId& msaId, U2OpStatus& os) {
+    QMutexLocker locker(dbi->getDbMutex());
+    MsaRecord* msa = findMsa(msaId, os);
+    CHECK_OP(os, U2AlphabetId());
+    return msa->alphabet;
+}
+
+qint64 MemoryMsaDbi::getMsaLength(const U2DataId& msaId, U2OpStatus& os) {
+    QMutexLocker locker(dbi->getDbMutex());
+    MsaRecord* msa = findMsa(msaId, os);
+    CHECK_OP(os, 0);
+    return msa->length;
+}
+
+U2DataId MemoryMsaDbi::createMcaObject(const QString& folder, const QString& name, const U2AlphabetId& alphabet, U2OpStatus& os) {
+    return createMcaObject(folder, name, alphabet, 0, os);
+}
+
+U2DataId MemoryMsaDbi::createMcaObject(const QString& folder, const QString& name, const U2AlphabetId& alphabet, int length, U2OpStatus& os) {
+    U2Mca mca;
+    mca.visualName = name;
+    mca.alphabet = alphabet;
+    mca.length = length;
+    return createObject(mca, folder, os);
+}
+
+U2DataId MemoryMsaDbi::createMsaObject(const QString& folder, const QString& name, const U2AlphabetId& alphabet, U2OpStatus& os) {
+    return createMsaObject(folder, name, alphabet, 0, os);
+}
+
+U2DataId MemoryMsaDbi::createMsaObject(const QString& folder, const QString& name, const U2AlphabetId& alphabet, int length, U2OpStatus& os) {
+    U2Msa msa;
+    msa.visualName = name;
+    msa.alphabet = alphabet;
+    msa.length = length;
+    return createObject(msa, folder, os);
+}
+
+void MemoryMsaDbi::updateMsaName(const U2DataId& msaId, const QString& name, U2OpStatus& os) {
+    dbi->getMemoryObjectDbi()->renameObject(msaId, name, os);
+}
+
+void MemoryMsaDbi::updateMsaAlphabet(const U2DataId& msaId, const U2AlphabetId& alphabet, U2OpStatus& os) {
+    QMutexLocker locker(dbi->getDbMutex());
+    MsaRecord* msa = findMsa(msaId, os);
+    CHECK_OP(os, );
+    msa->alphabet = alphabet;
+    dbi->getMemoryObjectDbi()->incrementVersion(msaId, os);
+}
+
+void MemoryMsaDbi::addRows(const U2DataId& msaId, QList<U2MsaRow>& rows, U2OpStatus& os) {
+    QMutexLocker locker(dbi->getDbMutex());
+    MsaRecord* msa = findMsa(msaId, os);
+    CHECK_OP(os, );
+
+    for (int i = 0; i < rows.size(); i++) {
+        insertRow(msaId, msa, -1, rows[i], os);
+        CHECK_OP(os, );
+    }
+    dbi->getMemoryObjectDbi()->incrementVersion(msaId, os);
+}
+
+void MemoryMsaDbi::addRow(const U2DataId& msaId, qint64 posInMsa, U2MsaRow& row, U2OpStatus& os) {
+    QMutexLocker locker(dbi->getDbMutex());
+    MsaRecord* msa = findMsa(msaId, os);
+    CHECK_OP(os, );
+
+    insertRow(msaId, msa, posInMsa, row, os);
+    CHECK_OP(os, );
+    dbi->getMemoryObjectDbi()->incrementVersion(msaId, os);
+}
+
+void MemoryMsaDbi::removeRows(const U2DataId& msaId, const QList<qint64>& rowIds, U2OpStatus& os) {
+    QMutexLocker locker(dbi->getDbMutex());
+    MsaRecord* msa = findMsa(msaId, os);
+    CHECK_OP(os, );
+    SAFE_POINT(msa->order.size() >= rowIds.size(), "Incorrect rows to remove!", );
+
+    foreach (qint64 rowId, rowIds) {
+        removeRowCore(msaId, msa, rowId, os);
+        CHECK_OP(os, );
+    }
+    if (msa->order.isEmpty()) {
+        msa->length = 0;
+    }
+    dbi->getMemoryObjectDbi()->incrementVersion(msaId, os);
+}
+
+void MemoryMsaDbi::removeRow(const U2DataId& msaId, qint64 rowId, U2OpStatus& os) {
+    QMutexLocker locker(dbi->getDbMutex());
+    MsaRecord* msa = findMsa(msaId, os);
+    CHECK_OP(os, );
+    SAFE_POINT(!msa->order.isEmpty(), "Empty MSA!", );
+
+    removeRowCore(msaId, msa, rowId, os);
+    CHECK_OP(os, );
+    dbi->getMemoryObjectDbi()->incrementVersion(msaId, os);
+}
+
+void MemoryMsaDbi::updateRowName(const U2DataId& msaId, qint64 rowId, const QString& newName, U2OpStatus& os) {
+    QMutexLocker locker(dbi->getDbMutex());
+    MsaRecord* msa = findMsa(msaId, os);
+    CHECK_OP(os, );
+    U2MsaRow* row = findRow(msa, rowId, os);
+    CHECK_OP(os, );
+
+    dbi->getMemoryObjectDbi()->renameObject(row->sequenceId, newName, os);
+    CHECK_OP(os, );
+    dbi->getMemoryObjectDbi()->incrementVersion(msaId, os);
+}
+
+void MemoryMsaDbi::updateRowContent(const U2DataId& msaId, qint64 rowId, const QByteArray& seqBytes, const QList<U2MsaGap>& gaps, U2OpStatus& os) {
+    QMutexLocker locker(dbi->getDbMutex());
+    MsaRecord* msa = findMsa(msaId, os);
+    CHECK_OP(os, );
+    U2MsaRow* row = findRow(msa, rowId, os);
+    CHECK_OP(os, );
+
+    dbi->getMemorySequenceDbi()->updateSequenceData(msaId, row->sequenceId, U2_REGION_MAX, seqBytes, QVariantMap(), os);
+    CHECK_OP(os, );
+
+    row->gstart = 0;
+    row->gend = seqBytes.length();
+    setGapModel(row, gaps);
+
+    qint64 length = row->gend - row->gstart;
+    foreach (const U2MsaGap& gap, gaps) {
+        length += gap.gap;
+    }
+    msa->length = qMax(msa->length, length);
+}
+
+void MemoryMsaDbi::updateGapModel(const U2DataId& msaId, qint64 msaRowId, const QList<U2MsaGap>& gapModel, U2OpStatus& os) {
+    QMutexLocker locker(dbi->getDbMutex());
+    MsaRecord* msa = findMsa(msaId, os);
+    CHECK_OP(os, );
+    U2MsaRow* row = findRow(msa, msaRowId, os);
+    CHECK_OP(os, );
+
+    setGapModel(row, gapModel);
+
+    qint64 length = row->gend - row->gstart;
+    foreach (const U2MsaGap& gap, gapModel) {
+        length += gap.gap;
+    }
+    msa->length = qMax(msa->length, length);
+    dbi->getMemoryObjectDbi()->incrementVersion(msaId, os);
+}
+
+void MemoryMsaDbi::setNewRowsOrder(const U2DataId& msaId, const QList<qint64>& rowIds, U2OpStatus& os) {
+    QMutexLocker locker(dbi->getDbMutex());
+    MsaRecord* msa = findMsa(msaId, os);
+    CHECK_OP(os, );
+    SAFE_POINT(msa->order.size() == rowIds.size(), "Incorrect number of row IDs!", );
+
+    msa->order = rowIds;
+    dbi->getMemoryObjectDbi()->incrementVersion(msaId, os);
+}
+
+void MemoryMsaDbi::updateMsaLength(const U2DataId& msaId, qint64 length, U2OpStatus& os) {
+    QMutexLocker locker(dbi->getDbMutex());
+    MsaRecord* msa = findMsa(msaId, os);
+    CHECK_OP(os, );
+    msa->length = length;
+    dbi->getMemoryObjectDbi()->incrementVersion(msaId, os);
+}
+
+void MemoryMsaDbi::removeMsaData(const U2DataId& msaId, U2OpStatus& os) {
+    QMutexLocker locker(dbi->getDbMutex());
+    MsaRecord* msa = findMsa(msaId, os);
+    CHECK_OP(os, );
+
+    const QList<qint64> rowIds = msa->order;
+    foreach (qint64 rowId, rowIds) {
+        removeRowCore(msaId, msa, rowId, os);
+        CHECK_OP(os, );
+    }
+    msas.remove(msaId);
+}
+
+U2DataId MemoryMsaDbi::createObject(U2Msa& msa, const QString& folder, U2OpStatus& os) {
+    QMutexLocker locker(dbi->getDbMutex());
+    dbi->getMemoryObjectDbi()->createObject(msa, folder, U2DbiObjectRank_TopLevel, os);
+    CHECK_OP(os, U2DataId());
+
+    MsaRecord record;
+    record.alphabet = msa.alphabet;
+    record.length = msa.length;
+    msas.insert(msa.id, record);
+    return msa.id;
+}
+
+MemoryMsaDbi::MsaRecord* MemoryMsaDbi::findMsa(const U2DataId& msaId, U2OpStatus& os) {
+    QHash<U2DataId, MsaRecord>::Iterator it = msas.find(msaId);
+    CHECK_EXT(it != msas.end(), os.setError(U2DbiL10n::tr("Msa object not found!")), NULL);
+    return &it.value();
+}
+
+U2MsaRow* MemoryMsaDbi::findRow(MsaRecord* msa, qint64 rowId, U2OpStatus& os) {
+    QHash<qint64, U2MsaRow>::Iterator it = msa->rows.find(rowId);
+    CHECK_EXT(it != msa->rows.end(), os.setError(U2DbiL10n::tr("Msa row not found!")), NULL);
+    return &it.value();
+}
+
+void MemoryMsaDbi::insertRow(const U2DataId& msaId, MsaRecord* msa, qint64 posInMsa, U2MsaRow& row, U2OpStatus& os) {
+    if (-1 == posInMsa) {
+        posInMsa = msa->order.size();
+    }
+    SAFE_POINT(posInMsa >= 0 && posInMsa <= msa->order.size(), "Incorrect input position!", );
+
+    row.rowId = ++msa->lastRowId;
+    row.length = calculateRowLength(row.gend - row.gstart, row.gaps);
+    dbi->getMemoryObjectDbi()->setParent(msaId, row.sequenceId, os);
+    CHECK_OP(os, );
+
+    U2MsaRow& stored = msa->rows[row.rowId];
+    stored = row;
+    qSort(stored.gaps.begin(), stored.gaps.end(), U2MsaGap::lessThan);
+    msa->order.insert(static_cast<int>(posInMsa), row.rowId);
+    dbi->updateUsedMemory(getRowSize(stored));
+
+    msa->length = qMax(msa->length, row.length);
+}
+
+void MemoryMsaDbi::removeRowCore(const U2DataId& msaId, MsaRecord* msa, qint64 rowId, U2OpStatus& os) {
+    U2MsaRow* row = findRow(msa, rowId, os);
+    CHECK_OP(os, );
+
+    const U2DataId sequenceId = row->sequenceId;
+    dbi->updateUsedMemory(-getRowSize(*row));
+    msa->rows.remove(rowId);
+    msa->order.removeAll(rowId);
+
+    // modifications are not tracked, so the row sequence is not needed anymore
+    dbi->getMemoryObjectDbi()->removeParent(msaId, sequenceId, true, os);
+}
+
+void MemoryMsaDbi::setGapModel(U2MsaRow* row, const QList<U2MsaGap>& gapModel) {
+    const qint64 oldSize = getRowSize(*row);
+    row->gaps = gapModel;
+    qSort(row->gaps.begin(), row->gaps.end(), U2MsaGap::lessThan);
+    row->length = calculateRowLength(row->gend - row->gstart, row->gaps);
+    dbi->updateUsedMemory(getRowSize(*row) - oldSize);
+}
+
+qint64 MemoryMsaDbi::calculateRowLength(qint64 seqLength, const QList<U2MsaGap>& gaps) {
+    qint64 res = seqLength;
+    foreach (const U2MsaGap& gap, gaps) {
+        if (gap.offset < res) { // ignore trailing gaps
+            res += gap.gap;
+        }
+    }
+    return res;
+}
+
+qint64 MemoryMsaDbi::getRowSize(const U2MsaRow& row) {
+    return sizeof(U2MsaRow) + row.gaps.size() * sizeof(U2MsaGap);
+}
+
+}   // namespace U2
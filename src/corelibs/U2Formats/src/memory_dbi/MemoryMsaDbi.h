@@ -0,0 +1,89 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef _U2_MEMORY_MSA_DBI_H_
+#define _U2_MEMORY_MSA_DBI_H_
+
+#include "MemoryDbi.h"
+
+namespace U2 {
+
+class MemoryMsaDbi : public U2MsaDbi, public MemoryChildDbiCommon {
+public:
+    MemoryMsaDbi(MemoryDbi* dbi);
+
+    virtual U2Msa getMsaObject(const U2DataId& id, U2OpStatus& os);
+    virtual qint64 getNumOfRows(const U2DataId& msaId, U2OpStatus& os);
+    virtual QList<U2MsaRow> getRows(const U2DataId& msaId, U2OpStatus& os);
+    virtual U2MsaRow getRow(const U2DataId& msaId, qint64 rowId, U2OpStatus& os);
+    virtual QList<qint64> getRowsOrder(const U2DataId& msaId, U2OpStatus& os);
+    virtual U2AlphabetId getMsaAlphabet(const U2DataId& msaId, U2OpStatus& os);
+    virtual qint64 getMsaLength(const U2DataId& msaId, U2OpStatus& os);
+
+    virtual U2DataId createMcaObject(const QString& folder, const QString& name, const U2AlphabetId& alphabet, U2OpStatus& os);
+    virtual U2DataId createMcaObject(const QString& folder, const QString& name, const U2AlphabetId& alphabet, int length, U2OpStatus& os);
+    virtual U2DataId createMsaObject(const QString& folder, const QString& name, const U2AlphabetId& alphabet, U2OpStatus& os);
+    virtual U2DataId createMsaObject(const QString& folder, const QString& name, const U2AlphabetId& alphabet, int length, U2OpStatus& os);
+
+    virtual void updateMsaName(const U2DataId& msaId, const QString& name, U2OpStatus& os);
+    virtual void updateMsaAlphabet(const U2DataId& msaId, const U2AlphabetId& alphabet, U2OpStatus& os);
+
+    virtual void addRows(const U2DataId& msaId, QList<U2MsaRow>& rows, U2OpStatus& os);
+    virtual void addRow(const U2DataId& msaId, qint64 posInMsa, U2MsaRow& row, U2OpStatus& os);
+    virtual void removeRows(const U2DataId& msaId, const QList<qint64>& rowIds, U2OpStatus& os);
+    virtual void removeRow(const U2DataId& msaId, qint64 rowId, U2OpStatus& os);
+
+    virtual void updateRowName(const U2DataId& msaId, qint64 rowId, const QString& newName, U2OpStatus& os);
+    virtual void updateRowContent(const U2DataId& msaId, qint64 rowId, const QByteArray& seqBytes, const QList<U2MsaGap>& gaps, U2OpStatus& os);
+    virtual void updateGapModel(const U2DataId& msaId, qint64 msaRowId, const QList<U2MsaGap>& gapModel, U2OpStatus& os);
+    virtual void setNewRowsOrder(const U2DataId& msaId, const QList<qint64>& rowIds, U2OpStatus& os);
+    virtual void updateMsaLength(const U2DataId& msaId, qint64 length, U2OpStatus& os);
+
+    /** Removes the rows and their sequences, the alignment object itself is removed by the object DBI */
+    void removeMsaData(const U2DataId& msaId, U2OpStatus& os);
+
+private:
+    struct MsaRecord {
+        MsaRecord() : length(0), lastRowId(0) {}
+
+        U2AlphabetId            alphabet;
+        qint64                  length;
+        qint64                  lastRowId;
+        QList<qint64>           order;
+        QHash<qint64, U2MsaRow> rows;
+    };
+
+    U2DataId createObject(U2Msa& msa, const QString& folder, U2OpStatus& os);
+    MsaRecord* findMsa(const U2DataId& msaId, U2OpStatus& os);
+    U2MsaRow* findRow(MsaRecord* msa, qint64 rowId, U2OpStatus& os);
+    void insertRow(const U2DataId& msaId, MsaRecord* msa, qint64 posInMsa, U2MsaRow& row, U2OpStatus& os);
+    void removeRowCore(const U2DataId& msaId, MsaRecord* msa, qint64 rowId, U2OpStatus& os);
+    void setGapModel(U2MsaRow* row, const QList<U2MsaGap>& gapModel);
+
+    static qint64 calculateRowLength(qint64 seqLength, const QList<U2MsaGap>& gaps);
+    static qint64 getRowSize(const U2MsaRow& row);
+
+    QHash<U2DataId, MsaRecord> msas;
+};
+
+}   // namespace U2
+
+#endif // _U2_MEMORY_MSA_DBI_H_
@@ -0,0 +1,432 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include <U2Core/U2ObjectTypeUtils.h>
+#include <U2Core/U2SafePoints.h>
+#include <U2Core/U2SqlHelpers.h>
+
+#include "MemoryAttributeDbi.h"
+#include "MemoryFeatureDbi.h"
+#include "MemoryMsaDbi.h"
+#include "MemoryObjectDbi.h"
+#include "MemorySequenceDbi.h"
+
+namespace U2 {
+
+MemoryObjectDbi::ObjectRecord::ObjectRecord()
+    : type(U2Type::Unknown),
+      rank(U2DbiObjectRank_TopLevel),
+      version(1),
+      trackModType(NoTrack)
+{
+
+}
+
+MemoryObjectDbi::MemoryObjectDbi(MemoryDbi* dbi)
+    : U2SimpleObjectDbi(dbi),
+      MemoryChildDbiCommon(dbi)
+{
+
+}
+
+qint64 MemoryObjectDbi::countObjects(U2OpStatus& os) {
+    return countObjects(U2Type::Unknown, os);
+}
+
+qint64 MemoryObjectDbi::countObjects(U2DataType type, U2OpStatus&) {
+    QMutexLocker locker(dbi->getDbMutex());
+    return selectTopLevelObjects(type, QString(), 0, U2DbiOptions::U2_DBI_NO_LIMIT).size();
+}
+
+qint64 MemoryObjectDbi::countObjects(const QString& folder, U2OpStatus&) {
+    QMutexLocker locker(dbi->getDbMutex());
+    return selectTopLevelObjects(U2Type::Unknown, U2DbiUtils::makeFolderCanonical(folder), 0, U2DbiOptions::U2_DBI_NO_LIMIT).size();
+}
+
+void MemoryObjectDbi::getObject(U2Object& object, const U2DataId& id, U2OpStatus& os) {
+    QMutexLocker locker(dbi->getDbMutex());
+    const ObjectRecord* record = findObject(id, os);
+    CHECK_OP(os, );
+
+    object.id = id;
+    object.dbiId = dbi->getDbiId();
+    object.visualName = record->name;
+    object.version = record->version;
+    object.trackModType = record->trackModType;
+}
+
+U2DataId MemoryObjectDbi::getObject(qint64 objectId, U2OpStatus& os) {
+    QMutexLocker locker(dbi->getDbMutex());
+    CHECK_EXT(objects.contains(objectId), os.setError(U2DbiL10n::tr("Object not found.")), U2DataId());
+    return U2DbiUtils::toU2DataId(objectId, objects[objectId].type);
+}
+
+QList<U2DataId> MemoryObjectDbi::getObjects(qint64 offset, qint64 count, U2OpStatus&) {
+    QMutexLocker locker(dbi->getDbMutex());
+    return selectTopLevelObjects(U2Type::Unknown, QString(), offset, count);
+}
+
+QList<U2DataId> MemoryObjectDbi::getObjects(U2DataType type, qint64 offset, qint64 count, U2OpStatus&) {
+    QMutexLocker locker(dbi->getDbMutex());
+    return selectTopLevelObjects(type, QString(), offset, count);
+}
+
+QList<U2DataId> MemoryObjectDbi::getObjects(const QString& folder, qint64 offset, qint64 count, U2OpStatus&) {
+    QMutexLocker locker(dbi->getDbMutex());
+    return selectTopLevelObjects(U2Type::Unknown, U2DbiUtils::makeFolderCanonical(folder), offset, count);
+}
+
+QHash<U2DataId, QString> MemoryObjectDbi::getObjectNames(qint64 offset, qint64 count, U2OpStatus& os) {
+    QMutexLocker locker(dbi->getDbMutex());
+    QHash<U2DataId, QString> result;
+    foreach (const U2DataId& id, getObjects(offset, count, os)) {
+        result.insert(id, objects[U2DbiUtils::toDbiId(id)].name);
+    }
+    return result;
+}
+
+U2DbiIterator<U2DataId>* MemoryObjectDbi::getObjectsByVisualName(const QString& visualName, U2DataType type, U2OpStatus&) {
+    QMutexLocker locker(dbi->getDbMutex());
+    QList<U2DataId> result;
+    foreach (const U2DataId& id, selectTopLevelObjects(type, QString(), 0, U2DbiOptions::U2_DBI_NO_LIMIT)) {
+        if (objects[U2DbiUtils::toDbiId(id)].name == visualName) {
+            result << id;
+        }
+    }
+    return new BufferedDbiIterator<U2DataId>(result);
+}
+
+QList<U2DataId> MemoryObjectDbi::getParents(const U2DataId& entityId, U2OpStatus& os) {
+    QMutexLocker locker(dbi->getDbMutex());
+    const ObjectRecord* record = findObject(entityId, os);
+    CHECK_OP(os, QList<U2DataId>());
+    return record->parents;
+}
+
+void MemoryObjectDbi::setParent(const U2DataId& parentId, const U2DataId& childId, U2OpStatus& os) {
+    QMutexLocker locker(dbi->getDbMutex());
+    CHECK_EXT(isObjectExists(parentId), os.setError(U2DbiL10n::tr("Object not found.")), );
+    ObjectRecord* child = findObject(childId, os);
+    CHECK_OP(os, );
+    if (!child->parents.contains(parentId)) {
+        child->parents << parentId;
+    }
+}
+
+QStringList MemoryObjectDbi::getFolders(U2OpStatus&) {
+    QMutexLocker locker(dbi->getDbMutex());
+    QStringList result = folders.toList();
+    if (!result.contains(U2ObjectDbi::ROOT_FOLDER)) {
+        result << U2ObjectDbi::ROOT_FOLDER;
+    }
+    result.sort();
+    return result;
+}
+
+QHash<U2Object, QString> MemoryObjectDbi::getObjectFolders(U2OpStatus&) {
+    QMutexLocker locker(dbi->getDbMutex());
+    QHash<U2Object, QString> result;
+    for (QMap<quint64, ObjectRecord>::ConstIterator it = objects.constBegin(); it != objects.constEnd(); ++it) {
+        CHECK_CONTINUE(U2DbiObjectRank_TopLevel == it->rank);
+        U2Object object(U2DbiUtils::toU2DataId(it.key(), it->type), dbi->getDbiId(), it->version);
+        object.visualName = it->name;
+        object.trackModType = it->trackModType;
+        result.insert(object, it->folder);
+    }
+    return result;
+}
+
+QStringList MemoryObjectDbi::getObjectFolders(const U2DataId& objectId, U2OpStatus& os) {
+    QMutexLocker locker(dbi->getDbMutex());
+    const ObjectRecord* record = findObject(objectId, os);
+    CHECK_OP(os, QStringList());
+    CHECK(U2DbiObjectRank_TopLevel == record->rank, QStringList());
+    return QStringList() << record->folder;
+}
+
+qint64 MemoryObjectDbi::getFolderLocalVersion(const QString&, U2OpStatus&) {
+    return 0;
+}
+
+qint64 MemoryObjectDbi::getFolderGlobalVersion(const QString&, U2OpStatus&) {
+    return 0;
+}
+
+void MemoryObjectDbi::createFolder(const QString& path, U2OpStatus&) {
+    QMutexLocker locker(dbi->getDbMutex());
+    folders.insert(U2DbiUtils::makeFolderCanonical(path));
+}
+
+qint64 MemoryObjectDbi::getObjectVersion(const U2DataId& objectId, U2OpStatus& os) {
+    QMutexLocker locker(dbi->getDbMutex());
+    const ObjectRecord* record = findObject(objectId, os);
+    CHECK_OP(os, -1);
+    return record->version;
+}
+
+void MemoryObjectDbi::setTrackModType(const U2DataId& objectId, U2TrackModType trackModType, U2OpStatus& os) {
+    QMutexLocker locker(dbi->getDbMutex());
+    ObjectRecord* record = findObject(objectId, os);
+    CHECK_OP(os, );
+    record->trackModType = trackModType;
+}
+
+U2TrackModType MemoryObjectDbi::getTrackModType(const U2DataId& objectId, U2OpStatus& os) {
+    QMutexLocker locker(dbi->getDbMutex());
+    const ObjectRecord* record = findObject(objectId, os);
+    CHECK_OP(os, NoTrack);
+    return record->trackModType;
+}
+
+void MemoryObjectDbi::setObjectRank(const U2DataId& objectId, U2DbiObjectRank newRank, U2OpStatus& os) {
+    QMutexLocker locker(dbi->getDbMutex());
+    ObjectRecord* record = findObject(objectId, os);
+    CHECK_OP(os, );
+    record->rank = newRank;
+}
+
+U2DbiObjectRank MemoryObjectDbi::getObjectRank(const U2DataId& objectId, U2OpStatus& os) {
+    QMutexLocker locker(dbi->getDbMutex());
+    const ObjectRecord* record = findObject(objectId, os);
+    CHECK_OP(os, U2DbiObjectRank_TopLevel);
+    return record->rank;
+}
+
+void MemoryObjectDbi::renameObject(const U2DataId& id, const QString& newName, U2OpStatus& os) {
+    QMutexLocker locker(dbi->getDbMutex());
+    ObjectRecord* record = findObject(id, os);
+    CHECK_OP(os, );
+
+    const qint64 oldSize = getRecordSize(*record);
+    record->name = newName;
+    record->version++;
+    dbi->updateUsedMemory(getRecordSize(*record) - oldSize);
+}
+
+bool MemoryObjectDbi::removeObject(const U2DataId& dataId, bool, U2OpStatus& os) {
+    QMutexLocker locker(dbi->getDbMutex());
+    const ObjectRecord* found = findObject(dataId, os);
+    CHECK_OP(os, false);
+
+    // the object specific data can reference other objects, so the record is copied
+    const ObjectRecord record = *found;
+    removeObjectSpecificData(dataId, record, os);
+    CHECK_OP(os, false);
+
+    dbi->updateUsedMemory(-getRecordSize(record));
+    objects.remove(U2DbiUtils::toDbiId(dataId));
+    return true;
+}
+
+bool MemoryObjectDbi::removeObjects(const QList<U2DataId>& dataIds, bool force, U2OpStatus& os) {
+    QMutexLocker locker(dbi->getDbMutex());
+    foreach (const U2DataId& id, dataIds) {
+        CHECK_CONTINUE(isObjectExists(id));
+        removeObject(id, force, os);
+        CHECK_OP(os, false);
+    }
+    return true;
+}
+
+void MemoryObjectDbi::createObject(U2Object& object, const QString& folder, U2DbiObjectRank rank, U2OpStatus&) {
+    QMutexLocker locker(dbi->getDbMutex());
+    ObjectRecord record;
+    record.type = object.getType();
+    record.rank = rank;
+    record.name = object.visualName;
+    record.trackModType = object.trackModType;
+    if (U2DbiObjectRank_TopLevel == rank) {
+        record.folder = U2DbiUtils::makeFolderCanonical(folder);
+        folders.insert(record.folder);
+    }
+
+    object.id = dbi->createId(record.type);
+    object.dbiId = dbi->getDbiId();
+    object.version = record.version;
+
+    objects.insert(U2DbiUtils::toDbiId(object.id), record);
+    dbi->updateUsedMemory(getRecordSize(record));
+}
+
+void MemoryObjectDbi::updateObject(U2Object& object, U2OpStatus& os) {
+    QMutexLocker locker(dbi->getDbMutex());
+    ObjectRecord* record = findObject(object.id, os);
+    CHECK_OP(os, );
+
+    const qint64 oldSize = getRecordSize(*record);
+    record->name = object.visualName;
+    record->version++;
+    object.version = record->version;
+    dbi->updateUsedMemory(getRecordSize(*record) - oldSize);
+}
+
+void MemoryObjectDbi::incrementVersion(const U2DataId& objectId, U2OpStatus& os) {
+    QMutexLocker locker(dbi->getDbMutex());
+    ObjectRecord* record = findObject(objectId, os);
+    CHECK_OP(os, );
+    record->version++;
+}
+
+void MemoryObjectDbi::removeParent(const U2DataId& parentId, const U2DataId& childId, bool removeChild, U2OpStatus& os) {
+    QMutexLocker locker(dbi->getDbMutex());
+    ObjectRecord* child = findObject(childId, os);
+    CHECK_OP(os, );
+    child->parents.removeAll(parentId);
+
+    CHECK(removeChild && child->parents.isEmpty() && U2DbiObjectRank_TopLevel != child->rank, );
+    removeObject(childId, true, os);
+}
+
+bool MemoryObjectDbi::isObjectExists(const U2DataId& id) const {
+    QMutexLocker locker(dbi->getDbMutex());
+    return objects.contains(U2DbiUtils::toDbiId(id));
+}
+
+QString MemoryObjectDbi::getObjectName(const U2DataId& id) const {
+    QMutexLocker locker(dbi->getDbMutex());
+    return objects.value(U2DbiUtils::toDbiId(id)).name;
+}
+
+const MemoryObjectDbi::ObjectRecord* MemoryObjectDbi::findObject(const U2DataId& id, U2OpStatus& os) const {
+    QMap<quint64, ObjectRecord>::ConstIterator it = objects.constFind(U2DbiUtils::toDbiId(id));
+    CHECK_EXT(it != objects.constEnd(), os.setError(U2DbiL10n::tr("Object not found.")), NULL);
+    return &it.value();
+}
+
+MemoryObjectDbi::ObjectRecord* MemoryObjectDbi::findObject(const U2DataId& id, U2OpStatus& os) {
+    QMap<quint64, ObjectRecord>::Iterator it = objects.find(U2DbiUtils::toDbiId(id));
+    CHECK_EXT(it != objects.end(), os.setError(U2DbiL10n::tr("Object not found.")), NULL);
+    return &it.value();
+}
+
+void MemoryObjectDbi::removeObjectSpecificData(const U2DataId& id, const ObjectRecord& record, U2OpStatus& os) {
+    switch (record.type) {
+    case U2Type::Sequence:
+        dbi->getMemorySequenceDbi()->removeSequenceData(id);
+        break;
+    case U2Type::Msa:
+    case U2Type::Mca:
+        dbi->getMemoryMsaDbi()->removeMsaData(id, os);
+        break;
+    case U2Type::AnnotationTable:
+        dbi->getMemoryFeatureDbi()->removeAnnotationTableData(id, os);
+        break;
+    default:
+        break;
+    }
+    CHECK_OP(os, );
+
+    dbi->getMemoryAttributeDbi()->removeObjectAttributes(id, os);
+    CHECK_OP(os, );
+
+    dbi->getMemoryObjectRelationsDbi()->removeAllObjectRelations(id, os);
+}
+
+QList<U2DataId> MemoryObjectDbi::selectTopLevelObjects(U2DataType type, const QString& folder, qint64 offset, qint64 count) const {
+    QList<U2DataId> result;
+    qint64 skipped = 0;
+    for (QMap<quint64, ObjectRecord>::ConstIterator it = objects.constBegin(); it != objects.constEnd(); ++it) {
+        CHECK_BREAK(U2DbiOptions::U2_DBI_NO_LIMIT == count || result.size() < count);
+        CHECK_CONTINUE(U2DbiObjectRank_TopLevel == it->rank);
+        CHECK_CONTINUE(U2Type::Unknown == type || type == it->type);
+        CHECK_CONTINUE(folder.isEmpty() || folder == it->folder);
+        if (skipped < offset) {
+            skipped++;
+            continue;
+        }
+        result << U2DbiUtils::toU2DataId(it.key(), it->type);
+    }
+    return result;
+}
+
+qint64 MemoryObjectDbi::getRecordSize(const ObjectRecord& record) {
+    return sizeof(ObjectRecord) + record.name.size() * sizeof(QChar);
+}
+
+/************************************************************************/
+/* MemoryObjectRelationsDbi */
+/************************************************************************/
+MemoryObjectRelationsDbi::MemoryObjectRelationsDbi(MemoryDbi* dbi)
+    : U2ObjectRelationsDbi(dbi),
+      MemoryChildDbiCommon(dbi)
+{
+
+}
+
+void MemoryObjectRelationsDbi::createObjectRelation(U2ObjectRelation& relation, U2OpStatus& os) {
+    QMutexLocker locker(dbi->getDbMutex());
+    MemoryObjectDbi* objectDbi = dbi->getMemoryObjectDbi();
+    CHECK_EXT(objectDbi->isObjectExists(relation.id) && objectDbi->isObjectExists(relation.referencedObject),
+              os.setError(U2DbiL10n::tr("Object not found.")), );
+    relations << relation;
+}
+
+QList<U2ObjectRelation> MemoryObjectRelationsDbi::getObjectRelations(const U2DataId& object, U2OpStatus&) {
+    QMutexLocker locker(dbi->getDbMutex());
+    QList<U2ObjectRelation> result;
+    foreach (U2ObjectRelation relation, relations) {
+        CHECK_CONTINUE(relation.id == object);
+        relation.referencedName = dbi->getMemoryObjectDbi()->getObjectName(relation.referencedObject);
+        relation.referencedType = U2ObjectTypeUtils::toGObjectType(U2DbiUtils::toType(relation.referencedObject));
+        result << relation;
+    }
+    return result;
+}
+
+QList<U2DataId> MemoryObjectRelationsDbi::getReferenceRelatedObjects(const U2DataId& reference, GObjectRelationRole relationRole, U2OpStatus&) {
+    QMutexLocker locker(dbi->getDbMutex());
+    QList<U2DataId> result;
+    foreach (const U2ObjectRelation& relation, relations) {
+        if (relation.referencedObject == reference && relation.relationRole == relationRole) {
+            result << relation.id;
+        }
+    }
+    return result;
+}
+
+void MemoryObjectRelationsDbi::removeObjectRelation(U2ObjectRelation& relation, U2OpStatus&) {
+    QMutexLocker locker(dbi->getDbMutex());
+    for (int i = relations.size() - 1; i >= 0; i--) {
+        if (relations[i].id == relation.id && relations[i].referencedObject == relation.referencedObject) {
+            relations.removeAt(i);
+        }
+    }
+}
+
+void MemoryObjectRelationsDbi::removeAllObjectRelations(const U2DataId& object, U2OpStatus&) {
+    QMutexLocker locker(dbi->getDbMutex());
+    for (int i = relations.size() - 1; i >= 0; i--) {
+        if (relations[i].id == object || relations[i].referencedObject == object) {
+            relations.removeAt(i);
+        }
+    }
+}
+
+void MemoryObjectRelationsDbi::removeReferencesForObject(const U2DataId& object, U2OpStatus&) {
+    QMutexLocker locker(dbi->getDbMutex());
+    for (int i = relations.size() - 1; i >= 0; i--) {
+        if (relations[i].id == object) {
+            relations.removeAt(i);
+        }
+    }
+}
+
+}   // namespace U2
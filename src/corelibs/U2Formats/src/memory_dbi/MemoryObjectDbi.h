@@ -0,0 +1,126 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef _U2_MEMORY_OBJECT_DBI_H_
+#define _U2_MEMORY_OBJECT_DBI_H_
+
+#include "MemoryDbi.h"
+
+namespace U2 {
+
+class MemoryObjectDbi : public U2SimpleObjectDbi, public MemoryChildDbiCommon {
+public:
+    MemoryObjectDbi(MemoryDbi* dbi);
+
+    virtual qint64 countObjects(U2OpStatus& os);
+    virtual qint64 countObjects(U2DataType type, U2OpStatus& os);
+    virtual qint64 countObjects(const QString& folder, U2OpStatus& os);
+
+    virtual void getObject(U2Object& object, const U2DataId& id, U2OpStatus& os);
+    virtual U2DataId getObject(qint64 objectId, U2OpStatus& os);
+
+    virtual QList<U2DataId> getObjects(qint64 offset, qint64 count, U2OpStatus& os);
+    virtual QList<U2DataId> getObjects(U2DataType type, qint64 offset, qint64 count, U2OpStatus& os);
+    virtual QList<U2DataId> getObjects(const QString& folder, qint64 offset, qint64 count, U2OpStatus& os);
+    virtual QHash<U2DataId, QString> getObjectNames(qint64 offset, qint64 count, U2OpStatus& os);
+    virtual U2DbiIterator<U2DataId>* getObjectsByVisualName(const QString& visualName, U2DataType type, U2OpStatus& os);
+
+    virtual QList<U2DataId> getParents(const U2DataId& entityId, U2OpStatus& os);
+    virtual void setParent(const U2DataId& parentId, const U2DataId& childId, U2OpStatus& os);
+
+    virtual QStringList getFolders(U2OpStatus& os);
+    virtual QHash<U2Object, QString> getObjectFolders(U2OpStatus& os);
+    virtual QStringList getObjectFolders(const U2DataId& objectId, U2OpStatus& os);
+    virtual qint64 getFolderLocalVersion(const QString& folder, U2OpStatus& os);
+    virtual qint64 getFolderGlobalVersion(const QString& folder, U2OpStatus& os);
+    virtual void createFolder(const QString& path, U2OpStatus& os);
+
+    virtual qint64 getObjectVersion(const U2DataId& objectId, U2OpStatus& os);
+    virtual void setTrackModType(const U2DataId& objectId, U2TrackModType trackModType, U2OpStatus& os);
+    virtual U2TrackModType getTrackModType(const U2DataId& objectId, U2OpStatus& os);
+    virtual void setObjectRank(const U2DataId& objectId, U2DbiObjectRank newRank, U2OpStatus& os);
+    virtual U2DbiObjectRank getObjectRank(const U2DataId& objectId, U2OpStatus& os);
+    virtual void renameObject(const U2DataId& id, const QString& newName, U2OpStatus& os);
+
+    virtual bool removeObject(const U2DataId& dataId, bool force, U2OpStatus& os);
+    virtual bool removeObjects(const QList<U2DataId>& dataIds, bool force, U2OpStatus& os);
+
+    /** Registers a new object and sets the id, the dbi id and the version on the passed instance */
+    void createObject(U2Object& object, const QString& folder, U2DbiObjectRank rank, U2OpStatus& os);
+
+    /** Updates the object name and increments its version */
+    void updateObject(U2Object& object, U2OpStatus& os);
+
+    void incrementVersion(const U2DataId& objectId, U2OpStatus& os);
+
+    /** Removes @parentId from the @childId parents and removes the child if it becomes an orphan and @removeChild is set */
+    void removeParent(const U2DataId& parentId, const U2DataId& childId, bool removeChild, U2OpStatus& os);
+
+    bool isObjectExists(const U2DataId& id) const;
+
+    /** Returns the name of the object or an empty string if there is no such object */
+    QString getObjectName(const U2DataId& id) const;
+
+private:
+    struct ObjectRecord {
+        ObjectRecord();
+
+        U2DataType          type;
+        U2DbiObjectRank     rank;
+        QString             name;
+        qint64              version;
+        U2TrackModType      trackModType;
+        QString             folder;
+        QList<U2DataId>     parents;
+    };
+
+    const ObjectRecord* findObject(const U2DataId& id, U2OpStatus& os) const;
+    ObjectRecord* findObject(const U2DataId& id, U2OpStatus& os);
+
+    void removeObjectSpecificData(const U2DataId& id, const ObjectRecord& record, U2OpStatus& os);
+    QList<U2DataId> selectTopLevelObjects(U2DataType type, const QString& folder, qint64 offset, qint64 count) const;
+
+    static qint64 getRecordSize(const ObjectRecord& record);
+
+    /** Objects sorted by the creation order */
+    QMap<quint64, ObjectRecord> objects;
+    QSet<QString> folders;
+};
+
+class MemoryObjectRelationsDbi : public U2ObjectRelationsDbi, public MemoryChildDbiCommon {
+public:
+    MemoryObjectRelationsDbi(MemoryDbi* dbi);
+
+    virtual void createObjectRelation(U2ObjectRelation& relation, U2OpStatus& os);
+    virtual QList<U2ObjectRelation> getObjectRelations(const U2DataId& object, U2OpStatus& os);
+    virtual QList<U2DataId> getReferenceRelatedObjects(const U2DataId& reference, GObjectRelationRole relationRole, U2OpStatus& os);
+    virtual void removeObjectRelation(U2ObjectRelation& relation, U2OpStatus& os);
+    virtual void removeAllObjectRelations(const U2DataId& object, U2OpStatus& os);
+    virtual void removeReferencesForObject(const U2DataId& object, U2OpStatus& os);
+
+private:
+    /** All relations have the object the relation belongs to as an id */
+    QList<U2ObjectRelation> relations;
+};
+
+}   // namespace U2
+
+#endif // _U2_MEMORY_OBJECT_DBI_H_
@@ -0,0 +1,132 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include <U2Core/U2SafePoints.h>
+#include <U2Core/U2SequenceUtils.h>
+#include <U2Core/U2SqlHelpers.h>
+
+#include "MemoryObjectDbi.h"
+#include "MemorySequenceDbi.h"
+
+namespace U2 {
+
+MemorySequenceDbi::MemorySequenceDbi(MemoryDbi* dbi)
+    : U2SequenceDbi(dbi),
+      MemoryChildDbiCommon(dbi)
+{
+
+}
+
+U2Sequence MemorySequenceDbi::getSequenceObject(const U2DataId& sequenceId, U2OpStatus& os) {
+    U2Sequence res;
+    DBI_TYPE_CHECK(sequenceId, U2Type::Sequence, os, res);
+
+    QMutexLocker locker(dbi->getDbMutex());
+    dbi->getMemoryObjectDbi()->getObject(res, sequenceId, os);
+    CHECK_OP(os, res);
+
+    QHash<U2DataId, SequenceRecord>::ConstIterator it = sequences.constFind(sequenceId);
+    CHECK_EXT(it != sequences.constEnd(), os.setError(U2DbiL10n::tr("Sequence object not found.")), res);
+
+    res.length = it->length;
+    res.alphabet = it->alphabet;
+    res.circular = it->circular;
+    return res;
+}
+
+QByteArray MemorySequenceDbi::getSequenceData(const U2DataId& sequenceId, const U2Region& region, U2OpStatus& os) {
+    QMutexLocker locker(dbi->getDbMutex());
+    QHash<U2DataId, SequenceRecord>::ConstIterator it = sequences.constFind(sequenceId);
+    CHECK_EXT(it != sequences.constEnd(), os.setError(U2DbiL10n::tr("Sequence object not found.")), QByteArray());
+    CHECK(0 != region.length, QByteArray());
+
+    const QByteArray& data = it->data;
+    const qint64 startPos = qBound(qint64(0), region.startPos, qint64(data.size()));
+    const qint64 endPos = qBound(startPos, region.endPos(), qint64(data.size()));
+    return data.mid(static_cast<int>(startPos), static_cast<int>(endPos - startPos));
+}
+
+void MemorySequenceDbi::createSequenceObject(U2Sequence& sequence, const QString& folder, U2OpStatus& os, U2DbiObjectRank rank) {
+    QMutexLocker locker(dbi->getDbMutex());
+    dbi->getMemoryObjectDbi()->createObject(sequence, folder, rank, os);
+    CHECK_OP(os, );
+
+    SequenceRecord record;
+    record.alphabet = sequence.alphabet;
+    record.length = sequence.length;
+    record.circular = sequence.circular;
+    sequences.insert(sequence.id, record);
+}
+
+void MemorySequenceDbi::updateSequenceObject(U2Sequence& sequence, U2OpStatus& os) {
+    QMutexLocker locker(dbi->getDbMutex());
+    QHash<U2DataId, SequenceRecord>::Iterator it = sequences.find(sequence.id);
+    CHECK_EXT(it != sequences.end(), os.setError(U2DbiL10n::tr("Sequence object not found.")), );
+
+    it->alphabet = sequence.alphabet;
+    it->circular = sequence.circular;
+
+    dbi->getMemoryObjectDbi()->updateObject(sequence, os);
+}
+
+void MemorySequenceDbi::updateSequenceData(const U2DataId& sequenceId, const U2Region& regionToReplace, const QByteArray& dataToInsert, const QVariantMap& hints, U2OpStatus& os) {
+    updateSequenceData(sequenceId, sequenceId, regionToReplace, dataToInsert, hints, os);
+}
+
+void MemorySequenceDbi::updateSequenceData(const U2DataId& masterId, const U2DataId& sequenceId, const U2Region& regionToReplace,
+                                           const QByteArray& dataToInsert, const QVariantMap& hints, U2OpStatus& os) {
+    QMutexLocker locker(dbi->getDbMutex());
+    QHash<U2DataId, SequenceRecord>::Iterator it = sequences.find(sequenceId);
+    CHECK_EXT(it != sequences.end(), os.setError(U2DbiL10n::tr("Sequence object not found.")), );
+
+    const bool updateLength = hints.value(U2SequenceDbiHints::UPDATE_SEQUENCE_LENGTH, true).toBool();
+    const bool emptySequence = hints.value(U2SequenceDbiHints::EMPTY_SEQUENCE, false).toBool();
+
+    QByteArray& data = it->data;
+    const qint64 oldSize = data.size();
+    if (emptySequence || data.isEmpty()) {
+        data = dataToInsert;
+    } else {
+        const qint64 startPos = qBound(qint64(0), regionToReplace.startPos, oldSize);
+        const qint64 endPos = qBound(startPos, regionToReplace.endPos(), oldSize);
+        data.replace(static_cast<int>(startPos), static_cast<int>(endPos - startPos), dataToInsert);
+    }
+    dbi->updateUsedMemory(data.size() - oldSize);
+
+    if (updateLength) {
+        it->length = data.size();
+    }
+
+    dbi->getMemoryObjectDbi()->incrementVersion(masterId, os);
+    CHECK_OP(os, );
+    if (masterId != sequenceId) {
+        dbi->getMemoryObjectDbi()->incrementVersion(sequenceId, os);
+    }
+}
+
+void MemorySequenceDbi::removeSequenceData(const U2DataId& sequenceId) {
+    QMutexLocker locker(dbi->getDbMutex());
+    CHECK(sequences.contains(sequenceId), );
+    dbi->updateUsedMemory(-sequences[sequenceId].data.size());
+    sequences.remove(sequenceId);
+}
+
+}   // namespace U2
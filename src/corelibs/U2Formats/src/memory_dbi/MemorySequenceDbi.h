@@ -0,0 +1,63 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef _U2_MEMORY_SEQUENCE_DBI_H_
+#define _U2_MEMORY_SEQUENCE_DBI_H_
+
+#include "MemoryDbi.h"
+
+namespace U2 {
+
+class MemorySequenceDbi : public U2SequenceDbi, public MemoryChildDbiCommon {
+public:
+    MemorySequenceDbi(MemoryDbi* dbi);
+
+    virtual U2Sequence getSequenceObject(const U2DataId& sequenceId, U2OpStatus& os);
+
+    virtual QByteArray getSequenceData(const U2DataId& sequenceId, const U2Region& region, U2OpStatus& os);
+
+    virtual void createSequenceObject(U2Sequence& sequence, const QString& folder, U2OpStatus& os, U2DbiObjectRank rank);
+
+    virtual void updateSequenceObject(U2Sequence& sequence, U2OpStatus& os);
+
+    virtual void updateSequenceData(const U2DataId& sequenceId, const U2Region& regionToReplace, const QByteArray& dataToInsert, const QVariantMap& hints, U2OpStatus& os);
+    virtual void updateSequenceData(const U2DataId& masterId, const U2DataId& sequenceId, const U2Region& regionToReplace,
+                                    const QByteArray& dataToInsert, const QVariantMap& hints, U2OpStatus& os);
+
+    /** Removes the sequence data, the object itself is removed by the object DBI */
+    void removeSequenceData(const U2DataId& sequenceId);
+
+private:
+    struct SequenceRecord {
+        SequenceRecord() : length(0), circular(false) {}
+
+        U2AlphabetId    alphabet;
+        qint64          length;
+        bool            circular;
+        QByteArray      data;
+    };
+
+    QHash<U2DataId, SequenceRecord> sequences;
+};
+
+}   // namespace U2
+
+#endif // _U2_MEMORY_SEQUENCE_DBI_H_
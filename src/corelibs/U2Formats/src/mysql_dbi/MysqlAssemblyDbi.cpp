@@ -23,6 +23,7 @@
 
 #include <U2Core/AppContext.h>
 #include <U2Core/Timer.h>
+#include <U2Core/U2AssemblyBinnedCoverage.h>
 #include <U2Core/U2AssemblyUtils.h>
 #include <U2Core/U2OpStatusUtils.h>
 #include <U2Core/U2SafePoints.h>
@@ -295,6 +296,9 @@ void MysqlAssemblyDbi::updateAssemblyObject(U2Assembly& assembly, U2OpStatus& os
 void MysqlAssemblyDbi::removeReads(const U2DataId& assemblyId, const QList<U2DataId>& rowIds, U2OpStatus& os){
     MysqlAssemblyAdapter* a = getAdapter(assemblyId, os);
     if ( a != NULL ) {
+        // the stored coverage does not describe the rest of the reads
+        U2AssemblyBinnedCoverage::removeStored(dbi->getAttributeDbi(), assemblyId, os);
+        CHECK_OP(os, );
         a->removeReads(rowIds, os);
     }
 }
@@ -340,6 +344,9 @@ void MysqlAssemblyDbi::correctAssemblyType(U2Assembly &assembly, U2OpStatus &os)
 void MysqlAssemblyDbi::addReads(const U2DataId& assemblyId, U2DbiIterator<U2AssemblyRead>* it, U2OpStatus& os) {
     MysqlAssemblyAdapter* a = getAdapter(assemblyId, os);
     if ( a != NULL ) {
+        // AssemblyImporter takes the stored coverage before and saves the new one
+        U2AssemblyBinnedCoverage::removeStored(dbi->getAttributeDbi(), assemblyId, os);
+        CHECK_OP(os, );
         U2AssemblyReadsImportInfo ii;
         addReads(a, it, ii, os);
     }
@@ -31,6 +31,7 @@
 
 #include <U2Core/AppContext.h>
 #include <U2Core/Timer.h>
+#include <U2Core/U2AssemblyBinnedCoverage.h>
 #include <U2Core/U2AssemblyUtils.h>
 #include <U2Core/U2SqlHelpers.h>
 #include <U2Core/U2SafePoints.h>
@@ -273,6 +274,9 @@ void SQLiteAssemblyDbi::updateAssemblyObject(U2Assembly& assembly, U2OpStatus& o
 void SQLiteAssemblyDbi::removeReads(const U2DataId& assemblyId, const QList<U2DataId>& rowIds, U2OpStatus& os){
     AssemblyAdapter* a = getAdapter(assemblyId, os);
     if ( a != NULL ) {
+        // the stored coverage does not describe the rest of the reads
+        U2AssemblyBinnedCoverage::removeStored(dbi->getAttributeDbi(), assemblyId, os);
+        CHECK_OP(os, );
         a->removeReads(rowIds, os);
     }
 }
@@ -313,6 +317,9 @@ void SQLiteAssemblyDbi::removeAssemblyEntry(const U2DataId &assemblyId, U2OpStat
 void SQLiteAssemblyDbi::addReads(const U2DataId& assemblyId, U2DbiIterator<U2AssemblyRead>* it, U2OpStatus& os) {
     AssemblyAdapter* a = getAdapter(assemblyId, os);
     if ( a != NULL ) {
+        // AssemblyImporter takes the stored coverage before and saves the new one
+        U2AssemblyBinnedCoverage::removeStored(dbi->getAttributeDbi(), assemblyId, os);
+        CHECK_OP(os, );
         U2AssemblyReadsImportInfo ii;
         addReads(a, it, ii, os);
     }
@@ -26,18 +26,12 @@
 #include <U2Core/IOAdapter.h>
 #include <U2Core/IOAdapterUtils.h>
 #include <U2Core/U2SafePoints.h>
-#include <QDir>
 
+#include <U2Formats/ParallelBgzfCompressor.h>
 
-namespace U2 {
+#include <QDir>
 
-class BGZF_wrapper {
-public:
-    BGZF_wrapper(BGZF *adapter) : adapter(adapter) {}
-    ~BGZF_wrapper(){ bgzf_close(adapter); }
-private:
-    BGZF *adapter;
-};
+namespace U2 {
 
 BgzipTask::BgzipTask(const GUrl& fileUrl, const GUrl& bgzfUrl)
     : Task(tr("Bgzip Compression task"), (TaskFlag)(TaskFlag_ReportingIsSupported | TaskFlag_ReportingIsEnabled)),
@@ -65,12 +59,14 @@ void BgzipTask::run() {
         bgzfUrl = GUrl(fileUrl.getURLString() + ".gz");
     }
 
-    BGZF* out = bgzf_open( bgzfUrl.getURLString().toLatin1().data(), "w");
-    BGZF_wrapper out_wr(out);
-    if (out == NULL) {
+    QScopedPointer<IOAdapter> out(ioFactory->createIOAdapter());
+    SAFE_POINT_EXT(!out.isNull(), setError(tr("Can not create IOAdapter!")), );
+    res = out->open(bgzfUrl, IOAdapterMode_Write);
+    if (!res) {
         Task::setError(tr("Can not open output file '%2'").arg(bgzfUrl.getURLString()));
         return;
     }
+    ParallelBgzfCompressor compressor(out.data());
 
     const int BUFFER_SIZE = 2097152;
     QByteArray readBuffer(BUFFER_SIZE, '\0');
@@ -85,14 +81,19 @@ void BgzipTask::run() {
             stateInfo.setError(tr("Error reading file"));
             return;
         }
-        int written = bgzf_write(out, buffer, len);
-        if (written == -1) {
+        compressor.write(buffer, len, stateInfo);
+        if (stateInfo.hasError()) {
             stateInfo.setError(tr("Error writing to file"));
             return;
         }
 
         stateInfo.setProgress( in->getProgress() );
     }
+    compressor.finish(stateInfo);
+    if (stateInfo.hasError()) {
+        stateInfo.setError(tr("Error writing to file"));
+        return;
+    }
 
     taskLog.details(tr("Bgzip compression finished"));
 }
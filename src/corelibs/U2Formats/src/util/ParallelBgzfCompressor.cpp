@@ -0,0 +1,234 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+
+#include <QRunnable>
+#include <QScopedPointer>
+
+#include <3rdparty/zlib/zlib.h>
+
+#include <U2Core/AppContext.h>
+#include <U2Core/AppResources.h>
+#include <U2Core/AppSettings.h>
+#include <U2Core/IOAdapter.h>
+#include <U2Core/U2SafePoints.h>
+
+#include "ParallelBgzfCompressor.h"
+
+namespace U2 {
+
+/** A block of data to compress and its compressed representation with the BGZF header and footer */
+class BgzfCompressedBlock {
+public:
+    BgzfCompressedBlock(const QByteArray &data) : data(data), ready(false) {}
+
+    QByteArray data;
+    QByteArray compressed;
+    QString error;
+    bool ready;
+};
+
+namespace {
+
+const int BGZF_HEADER_SIZE = 18;
+const int BGZF_FOOTER_SIZE = 8;
+const int BGZF_MAX_BLOCK_SIZE = 65536;
+const int BLOCKS_PER_THREAD = 4;
+
+const char BGZF_HEADER[BGZF_HEADER_SIZE] = {
+    '\37', '\213', '\10', '\4',     // ID1, ID2, CM = deflate, FLG = FEXTRA
+    0, 0, 0, 0,                     // MTIME
+    0, '\377',                      // XFL, OS = unknown
+    6, 0,                           // XLEN
+    'B', 'C', 2, 0,                 // BGZF subfield: SI1, SI2, SLEN
+    0, 0                            // BSIZE, filled for each block
+};
+
+const char BGZF_EOF_MARKER[] = "\37\213\10\4\0\0\0\0\0\377\6\0\102\103\2\0\33\0\3\0\0\0\0\0\0\0\0\0";
+const int BGZF_EOF_MARKER_SIZE = 28;
+
+void writeUInt32(char *dst, quint32 value) {
+    dst[0] = (char)(value & 0xff);
+    dst[1] = (char)((value >> 8) & 0xff);
+    dst[2] = (char)((value >> 16) & 0xff);
+    dst[3] = (char)((value >> 24) & 0xff);
+}
+
+class CompressBlockRunnable : public QRunnable {
+public:
+    CompressBlockRunnable(ParallelBgzfCompressor *compressor, BgzfCompressedBlock *block)
+        : compressor(compressor), block(block) {}
+
+    void run() {
+        compressor->compressBlock(block);
+    }
+
+private:
+    ParallelBgzfCompressor *compressor;
+    BgzfCompressedBlock *block;
+};
+
+}   // namespace
+
+const int ParallelBgzfCompressor::BLOCK_DATA_SIZE = 0xff00;
+
+ParallelBgzfCompressor::ParallelBgzfCompressor(IOAdapter *io, int threadCount, int compressionLevel)
+    : io(io),
+      compressionLevel(qBound(-1, compressionLevel, 9)),
+      maxPendingBlocks(0),
+      finished(false),
+      writtenBytes(0)
+{
+    if (threadCount < 1) {
+        threadCount = AppContext::getAppSettings()->getAppResourcePool()->getIdealThreadCount();
+    }
+    threadPool.setMaxThreadCount(qMax(1, threadCount));
+    maxPendingBlocks = BLOCKS_PER_THREAD * threadPool.maxThreadCount();
+    currentBlockData.reserve(BLOCK_DATA_SIZE);
+}
+
+ParallelBgzfCompressor::~ParallelBgzfCompressor() {
+    dropPendingBlocks();
+}
+
+void ParallelBgzfCompressor::write(const char *data, qint64 size, U2OpStatus &os) {
+    SAFE_POINT_EXT(!finished, os.setError("BGZF compressor is already finished"), );
+    qint64 written = 0;
+    while (written < size) {
+        int toCopy = (int)qMin(size - written, (qint64)(BLOCK_DATA_SIZE - currentBlockData.size()));
+        currentBlockData.append(data + written, toCopy);
+        written += toCopy;
+        if (BLOCK_DATA_SIZE == currentBlockData.size()) {
+            submitCurrentBlock(os);
+            CHECK_OP(os, );
+        }
+    }
+}
+
+void ParallelBgzfCompressor::finish(U2OpStatus &os) {
+    SAFE_POINT_EXT(!finished, os.setError("BGZF compressor is already finished"), );
+    if (!currentBlockData.isEmpty()) {
+        submitCurrentBlock(os);
+        CHECK_OP(os, );
+    }
+    flush(os);
+    CHECK_OP(os, );
+    if (io->writeBlock(BGZF_EOF_MARKER, BGZF_EOF_MARKER_SIZE) != BGZF_EOF_MARKER_SIZE) {
+        os.setError(QObject::tr("Can't write output"));
+        return;
+    }
+    writtenBytes += BGZF_EOF_MARKER_SIZE;
+    finished = true;
+}
+
+void ParallelBgzfCompressor::flush(U2OpStatus &os) {
+    while (!pendingBlocks.isEmpty()) {
+        writeFirstPendingBlock(os);
+        CHECK_OP(os, );
+    }
+}
+
+qint64 ParallelBgzfCompressor::getBlockOffset(U2OpStatus &os) {
+    flush(os);
+    return writtenBytes;
+}
+
+void ParallelBgzfCompressor::compressBlock(BgzfCompressedBlock *block) {
+    QByteArray compressed(BGZF_MAX_BLOCK_SIZE, 0);
+    char *buffer = compressed.data();
+    QString error;
+
+    z_stream stream;
+    stream.zalloc = Z_NULL;
+    stream.zfree = Z_NULL;
+    stream.opaque = Z_NULL;
+    stream.next_in = (Bytef *)block->data.constData();
+    stream.avail_in = block->data.size();
+    stream.next_out = (Bytef *)(buffer + BGZF_HEADER_SIZE);
+    stream.avail_out = BGZF_MAX_BLOCK_SIZE - BGZF_HEADER_SIZE - BGZF_FOOTER_SIZE;
+    if (Z_OK != deflateInit2(&stream, compressionLevel, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY)) {
+        error = QObject::tr("Can't initialize zlib");
+    } else {
+        if (Z_STREAM_END != deflate(&stream, Z_FINISH)) {
+            error = QObject::tr("Can't compress data");
+        }
+        deflateEnd(&stream);
+    }
+
+    if (error.isEmpty()) {
+        int blockSize = BGZF_HEADER_SIZE + stream.total_out + BGZF_FOOTER_SIZE;
+        memcpy(buffer, BGZF_HEADER, BGZF_HEADER_SIZE);
+        buffer[16] = (char)((blockSize - 1) & 0xff);
+        buffer[17] = (char)((blockSize - 1) >> 8);
+        quint32 crc = crc32(crc32(0, Z_NULL, 0), (const Bytef *)block->data.constData(), block->data.size());
+        writeUInt32(buffer + blockSize - BGZF_FOOTER_SIZE, crc);
+        writeUInt32(buffer + blockSize - 4, block->data.size());
+        compressed.resize(blockSize);
+    }
+
+    QMutexLocker locker(&blocksMutex);
+    block->data.clear();
+    block->compressed = compressed;
+    block->error = error;
+    block->ready = true;
+    blockReady.wakeAll();
+}
+
+void ParallelBgzfCompressor::submitCurrentBlock(U2OpStatus &os) {
+    while (pendingBlocks.size() >= maxPendingBlocks) {
+        writeFirstPendingBlock(os);
+        CHECK_OP(os, );
+    }
+    BgzfCompressedBlock *block = new BgzfCompressedBlock(currentBlockData);
+    currentBlockData.clear();
+    currentBlockData.reserve(BLOCK_DATA_SIZE);
+    pendingBlocks << block;
+    threadPool.start(new CompressBlockRunnable(this, block));
+}
+
+void ParallelBgzfCompressor::writeFirstPendingBlock(U2OpStatus &os) {
+    BgzfCompressedBlock *block = pendingBlocks.first();
+    {
+        QMutexLocker locker(&blocksMutex);
+        while (!block->ready) {
+            blockReady.wait(&blocksMutex);
+        }
+    }
+    pendingBlocks.removeFirst();
+    QScopedPointer<BgzfCompressedBlock> blockDeleter(block);
+    if (!block->error.isEmpty()) {
+        os.setError(block->error);
+        return;
+    }
+    if (io->writeBlock(block->compressed) != block->compressed.size()) {
+        os.setError(QObject::tr("Can't write output"));
+        return;
+    }
+    writtenBytes += block->compressed.size();
+}
+
+void ParallelBgzfCompressor::dropPendingBlocks() {
+    threadPool.waitForDone();
+    qDeleteAll(pendingBlocks);
+    pendingBlocks.clear();
+}
+
+}   // namespace U2
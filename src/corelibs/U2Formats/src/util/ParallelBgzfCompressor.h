@@ -0,0 +1,94 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+
+#ifndef _U2_PARALLEL_BGZF_COMPRESSOR_H_
+#define _U2_PARALLEL_BGZF_COMPRESSOR_H_
+
+#include <QMutex>
+#include <QThreadPool>
+#include <QWaitCondition>
+
+#include <U2Core/global.h>
+#include <U2Core/U2OpStatus.h>
+
+namespace U2 {
+
+class IOAdapter;
+class BgzfCompressedBlock;
+
+/**
+ * Splits the written data into BGZF blocks, compresses the blocks in several threads
+ * and writes them to the output adapter in the original order.
+ * The output is a valid BGZF file (including the EOF marker block) when 'finish' is called.
+ */
+class U2FORMATS_EXPORT ParallelBgzfCompressor {
+public:
+    /**
+     * 'io' is an opened output adapter, it is not owned by the compressor.
+     * 'threadCount' less than 1 means the ideal thread count of the application.
+     * 'compressionLevel' is a zlib compression level: from 0 (no compression) to 9, -1 is the zlib default.
+     */
+    ParallelBgzfCompressor(IOAdapter *io, int threadCount = -1, int compressionLevel = -1);
+    ~ParallelBgzfCompressor();
+
+    void write(const char *data, qint64 size, U2OpStatus &os);
+
+    /** Compresses the rest of the data, writes all the blocks and the EOF marker */
+    void finish(U2OpStatus &os);
+
+    /** Waits until all the filled blocks are compressed and written */
+    void flush(U2OpStatus &os);
+
+    /** Offset of the current block in the output file, the pending blocks are flushed to get it */
+    qint64 getBlockOffset(U2OpStatus &os);
+
+    /** Offset of the next written byte inside the current uncompressed block */
+    int getOffsetInBlock() const {return currentBlockData.size();}
+
+    // compresses the block in the worker thread
+    void compressBlock(BgzfCompressedBlock *block);
+
+    /** Maximum size of uncompressed data in a block: the compressed block must fit into 64 Kb */
+    static const int BLOCK_DATA_SIZE;
+
+private:
+    void submitCurrentBlock(U2OpStatus &os);
+    void writeFirstPendingBlock(U2OpStatus &os);
+    void dropPendingBlocks();
+
+    IOAdapter *io;
+    int compressionLevel;
+    int maxPendingBlocks;
+    bool finished;
+
+    QByteArray currentBlockData;
+    qint64 writtenBytes;
+
+    QThreadPool threadPool;
+    QMutex blocksMutex;
+    QWaitCondition blockReady;
+    QList<BgzfCompressedBlock *> pendingBlocks;
+};
+
+}   // namespace U2
+
+#endif // _U2_PARALLEL_BGZF_COMPRESSOR_H_
@@ -11,6 +11,7 @@ HEADERS += src/library/BaseActorCategories.h \
            src/library/BaseTypes.h \
            src/library/LastReadyScheduler.h \
            src/library/LocalDomain.h \
+           src/library/ParallelScheduler.h \
            src/model/ActorPrototypeRegistry.h \
            src/model/Aliasing.h \
            src/model/Attribute.h \
@@ -128,6 +129,7 @@ SOURCES += src/library/BaseActorCategories.cpp \
            src/library/BaseTypes.cpp \
            src/library/LastReadyScheduler.cpp \
            src/library/LocalDomain.cpp \
+           src/library/ParallelScheduler.cpp \
            src/model/ActorPrototypeRegistry.cpp \
            src/model/Aliasing.cpp \
            src/model/Attribute.cpp \
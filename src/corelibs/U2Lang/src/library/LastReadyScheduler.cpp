@@ -65,22 +65,22 @@ bool LastReadyScheduler::isReady() const {
     return false;
 }
 
-inline ActorId LastReadyScheduler::actorId() const {
+ActorId LastReadyScheduler::actorId() const {
     CHECK(NULL != lastWorker, "");
     return lastWorker->getActor()->getId();
 }
 
-inline bool LastReadyScheduler::hasValidFinishedTask() const {
+bool LastReadyScheduler::hasValidFinishedTask() const {
     return (NULL != lastWorker) && (NULL != lastTask) && (lastTask->isFinished());
 }
 
-inline qint64 LastReadyScheduler::lastTaskTimeSec() const {
+qint64 LastReadyScheduler::lastTaskTimeSec() const {
     qint64 startMks = lastTask->getTimeInfo().startTime;
     qint64 endMks = lastTask->getTimeInfo().finishTime;
     return endMks - startMks;
 }
 
-inline void LastReadyScheduler::measuredTick() {
+void LastReadyScheduler::measuredTick() {
     CHECK(NULL != lastWorker, );
     lastWorker->deleteBackupMessagesFromPreviousTick();
 
@@ -20,6 +20,8 @@
  */
 
 #include <U2Core/AppContext.h>
+#include <U2Core/AppResources.h>
+#include <U2Core/AppSettings.h>
 #include <U2Core/CMDLineRegistry.h>
 #include <U2Core/CMDLineUtils.h>
 #include <U2Core/Log.h>
@@ -29,6 +31,7 @@
 #include <U2Lang/BaseAttributes.h>
 #include <U2Lang/IntegralBusType.h>
 #include <U2Lang/LastReadyScheduler.h>
+#include <U2Lang/ParallelScheduler.h>
 #include <U2Lang/Schema.h>
 #include <U2Lang/WorkflowMonitor.h>
 #include <U2Lang/WorkflowSettings.h>
@@ -252,7 +255,9 @@ Task * BaseWorker::tick(bool &canResultBeCanceled) {
 /*****************************
  * SimpleQueue
  *****************************/
-SimpleQueue::SimpleQueue() : ended(false), takenMsgs(0) {
+const int SimpleQueue::DEFAULT_CAPACITY = 1000;
+
+SimpleQueue::SimpleQueue() : ended(false), takenMsgs(0), maxMessages(DEFAULT_CAPACITY) {
 }
 
 Message SimpleQueue::get() {
@@ -282,7 +287,7 @@ int SimpleQueue::takenMessages() const {
 }
 
 int SimpleQueue::hasRoom(const DataType* ) const {
-    return 1000;
+    return qMax(0, maxMessages - que.size());
 }
 
 bool SimpleQueue::isEnded() const {
@@ -294,10 +299,11 @@ void SimpleQueue::setEnded() {
 }
 
 int SimpleQueue::capacity() const {
-    return INT_MAX;
+    return maxMessages;
 }
 
-void SimpleQueue::setCapacity(int) {
+void SimpleQueue::setCapacity(int newCapacity) {
+    maxMessages = newCapacity;
 }
 
 QQueue<Message> SimpleQueue::getMessages(int startIndex, int endIndex) const {
@@ -418,7 +424,13 @@ CommunicationChannel* LocalDomainFactory::createConnection(Link* l) {
 }
 
 Scheduler* LocalDomainFactory::createScheduler(Schema* sh) {
-    Scheduler *sc = new LastReadyScheduler(sh);
+    Scheduler *sc = NULL;
+    if (WorkflowSettings::isDebuggerEnabled()) {
+        // breakpoints and steps suppose a single running worker
+        sc = new LastReadyScheduler(sh);
+    } else {
+        sc = new ParallelScheduler(sh, AppContext::getAppSettings()->getAppResourcePool()->getIdealThreadCount());
+    }
     return sc;
 }
 
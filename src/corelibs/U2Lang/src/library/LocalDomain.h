@@ -123,6 +123,8 @@ protected:
  */
 class U2LANG_EXPORT SimpleQueue : public CommunicationChannel {
 public:
+    static const int DEFAULT_CAPACITY;
+
     SimpleQueue();
     virtual ~SimpleQueue(){}
 
@@ -135,9 +137,8 @@ public:
     virtual int hasRoom(const DataType* ) const;
     virtual bool isEnded() const;
     virtual void setEnded();
-    // capacity is INT_MAX
+    // capacity is DEFAULT_CAPACITY by default, it is checked by ParallelScheduler only
     virtual int capacity() const;
-    // does nothing
     virtual void setCapacity(int);
     virtual QQueue<Message> getMessages(int startIndex = 0, int endIndex = -1) const;
 
@@ -148,6 +149,8 @@ protected:
     bool ended;
     //
     int takenMsgs;
+    // how many messages the channel can contain before the producer is stopped
+    int maxMessages;
 
 }; // SimpleQueue
 
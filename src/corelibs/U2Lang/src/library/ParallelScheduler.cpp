@@ -0,0 +1,157 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include <U2Core/U2SafePoints.h>
+
+#include <U2Lang/ElapsedTimeUpdater.h>
+#include <U2Lang/IntegralBus.h>
+#include <U2Lang/WorkflowDebugStatus.h>
+#include <U2Lang/WorkflowMonitor.h>
+
+#include "ParallelScheduler.h"
+
+namespace U2 {
+
+namespace LocalWorkflow {
+
+ParallelScheduler::ParallelScheduler(Schema *sh, int maxThreads)
+    : LastReadyScheduler(sh), maxRunningTasks(qMax(1, maxThreads - 1))
+{
+
+}
+
+ParallelScheduler::~ParallelScheduler() {
+    qDeleteAll(timeUpdaters);
+}
+
+bool ParallelScheduler::isReady() const {
+    CHECK(countRunningTasks() < maxRunningTasks, false);
+    return NULL != findWorkerToTick();
+}
+
+Task * ParallelScheduler::tick() {
+    removeFinishedTasks();
+
+    BaseWorker *w = findWorkerToTick();
+    SAFE_POINT(NULL != w, "No worker is ready", NULL);
+
+    lastWorker = w;
+    w->deleteBackupMessagesFromPreviousTick();
+    lastTask = w->tick(canLastTaskBeCanceled);
+
+    if (NULL != lastTask) {
+        ElapsedTimeUpdater *timeUpdater = new ElapsedTimeUpdater(actorId(), context->getMonitor(), lastTask);
+        timeUpdater->start(1000);
+        timeUpdaters[w] = timeUpdater;
+        runningTasks[w] = lastTask;
+
+        context->getMonitor()->registerTask(lastTask, actorId());
+    }
+    debugInfo->checkActorForBreakpoint(w->getActor());
+    return lastTask;
+}
+
+void ParallelScheduler::cleanup() {
+    removeFinishedTasks();
+    LastReadyScheduler::cleanup();
+}
+
+int ParallelScheduler::getMaxParallelTasks() const {
+    return maxRunningTasks;
+}
+
+bool ParallelScheduler::cancelCurrentTaskIfAllowed() {
+    // there is no single current task to replay it later
+    return false;
+}
+
+WorkerState ParallelScheduler::getWorkerState(const Actor *a) {
+    BaseWorker *w = a->castPeer<BaseWorker>();
+    if (isRunning(w)) {
+        return WorkerRunning;
+    }
+    if (w->isDone()) {
+        return WorkerDone;
+    } else if (w->isReady()) {
+        return WorkerReady;
+    }
+    return WorkerWaiting;
+}
+
+BaseWorker * ParallelScheduler::findWorkerToTick() const {
+    BaseWorker *blockedWorker = NULL;
+    for (int vertexLabel = 0; vertexLabel < topologicSortedGraph.size(); vertexLabel++) {
+        foreach (Actor *a, topologicSortedGraph.value(vertexLabel)) {
+            BaseWorker *w = a->castPeer<BaseWorker>();
+            if (isRunning(w) || !w->isReady()) {
+                continue;
+            }
+            if (hasRoomForOutput(w)) {
+                return w;
+            }
+            if (NULL == blockedWorker) {
+                blockedWorker = w;
+            }
+        }
+    }
+    // the back-pressure must not stop the workflow: if nothing can free the channels, tick anyway
+    return (0 == countRunningTasks()) ? blockedWorker : NULL;
+}
+
+bool ParallelScheduler::isRunning(BaseWorker *w) const {
+    const QPointer<Task> task = runningTasks.value(w);
+    return !task.isNull() && !task->isFinished();
+}
+
+int ParallelScheduler::countRunningTasks() const {
+    int result = 0;
+    foreach (BaseWorker *w, runningTasks.keys()) {
+        result += isRunning(w) ? 1 : 0;
+    }
+    return result;
+}
+
+bool ParallelScheduler::hasRoomForOutput(BaseWorker *w) {
+    foreach (Port *p, w->getActor()->getOutputPorts()) {
+        if (p->getLinks().isEmpty()) {
+            // the messages of an unconnected port are not stored anywhere
+            continue;
+        }
+        IntegralBus *bus = w->getPorts().value(p->getId());
+        if (NULL != bus && bus->hasRoom() <= 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void ParallelScheduler::removeFinishedTasks() {
+    foreach (BaseWorker *w, runningTasks.keys()) {
+        if (!isRunning(w)) {
+            runningTasks.remove(w);
+            delete timeUpdaters.take(w);
+        }
+    }
+}
+
+} // LocalWorkflow
+
+} // U2
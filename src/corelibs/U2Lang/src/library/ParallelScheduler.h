@@ -0,0 +1,75 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef _WORKFLOW_PARALLEL_SCHEDULER_H_
+#define _WORKFLOW_PARALLEL_SCHEDULER_H_
+
+#include <QPointer>
+
+#include <U2Lang/LastReadyScheduler.h>
+
+namespace U2 {
+
+namespace LocalWorkflow {
+
+/**
+ * ticks all ready workers without waiting for the tasks of the previous ticks,
+ * so independent branches of a workflow are executed simultaneously
+ * a worker is not ticked while its task is running
+ * a worker is not ticked while one of its output channels is full (back-pressure),
+ * unless there are no running tasks at all
+ * is not used in debugging mode: breakpoints and steps suppose a single running worker
+ */
+class ParallelScheduler : public LastReadyScheduler {
+public:
+    // @maxThreads counts the calling thread too: the workers are ticked in it while the tasks are running,
+    // so at most maxThreads - 1 tasks (at least one) run simultaneously
+    ParallelScheduler(Schema *sh, int maxThreads);
+    virtual ~ParallelScheduler();
+
+    // reimplemented from Worker
+    virtual bool isReady() const;
+    virtual Task *tick();
+    virtual void cleanup();
+
+    virtual int getMaxParallelTasks() const;
+    virtual bool cancelCurrentTaskIfAllowed();
+
+protected:
+    virtual WorkerState getWorkerState(const Actor *a);
+
+private:
+    BaseWorker * findWorkerToTick() const;
+    bool isRunning(BaseWorker *w) const;
+    int countRunningTasks() const;
+    static bool hasRoomForOutput(BaseWorker *w);
+    void removeFinishedTasks();
+
+    int maxRunningTasks;
+    QMap<BaseWorker *, QPointer<Task> > runningTasks;
+    QMap<BaseWorker *, ElapsedTimeUpdater *> timeUpdaters;
+};
+
+} // LocalWorkflow
+
+} // U2
+
+#endif // _WORKFLOW_PARALLEL_SCHEDULER_H_
@@ -20,6 +20,7 @@
  */
 
 #include <QFile>
+#include <QMutexLocker>
 
 #include <U2Core/AnnotationTableObject.h>
 #include <U2Core/AppContext.h>
@@ -44,14 +45,18 @@
 #include <U2Core/U2VariantDbi.h>
 #include <U2Core/UserApplicationsSettings.h>
 
+#include <U2Lang/WorkflowSettings.h>
+
 #include "DbiDataStorage.h"
 
 namespace U2 {
 
 namespace Workflow {
 
+const int DbiDataStorage::MESSAGE_DBI_CHECK_INTERVAL = 64;
+
 DbiDataStorage::DbiDataStorage()
-: dbiHandle(NULL)
+: dbiHandle(NULL), memoryDbiHandle(NULL), memoryLimit(0), messageDbiUses(0)
 {
 
 }
@@ -69,6 +74,7 @@ DbiDataStorage::~DbiDataStorage() {
             }
         }
     }
+    delete memoryDbiHandle;
     delete dbiHandle;
 }
 
@@ -81,6 +87,18 @@ bool DbiDataStorage::init() {
     CHECK_OP(os, false);
 
     connections[dbiHandle->getDbiRef().dbiId] = connection.take();
+
+    memoryLimit = qint64(WorkflowSettings::getMessageStorageMemoryLimit()) * 1024 * 1024;
+    CHECK(memoryLimit > 0, true);
+
+    QScopedPointer<TmpDbiHandle> memoryHandle(new TmpDbiHandle(WORKFLOW_SESSION_MEMORY_DBI_ALIAS, os, MEMORY_DBI_ID));
+    CHECK_OP(os, false);
+
+    QScopedPointer<DbiConnection> memoryConnection(new DbiConnection(memoryHandle->getDbiRef(), os));
+    CHECK_OP(os, false);
+
+    connections[memoryHandle->getDbiRef().dbiId] = memoryConnection.take();
+    memoryDbiHandle = memoryHandle.take();
     return true;
 }
 
@@ -141,10 +159,11 @@ SharedDbiDataHandler DbiDataStorage::putSequence(const DNASequence &dnaSeq) {
     assert(NULL != dbiHandle);
 
     U2OpStatusImpl os;
-    U2EntityRef ent = U2SequenceUtils::import(os, dbiHandle->getDbiRef(), dnaSeq);
+    const U2DbiRef dbiRef = getMessageDbiRef();
+    U2EntityRef ent = U2SequenceUtils::import(os, dbiRef, dnaSeq);
     CHECK_OP(os, SharedDbiDataHandler());
 
-    DbiConnection *connection = this->getConnection(dbiHandle->getDbiRef(), os);
+    DbiConnection *connection = this->getConnection(dbiRef, os);
     CHECK_OP(os, SharedDbiDataHandler());
 
     SharedDbiDataHandler handler(new DbiDataHandler(ent, connection->dbi->getObjectDbi(), true));
@@ -159,13 +178,13 @@ SharedDbiDataHandler DbiDataStorage::putSequence(const U2SequenceObject *sequenc
     U2OpStatusImpl os;
 
     U2EntityRef entityRef = sequenceObject->getEntityRef();
-    if (sequenceObject->getEntityRef().dbiRef != dbiHandle->getDbiRef()) {
-        QScopedPointer<U2SequenceObject> clonedSequenceObject(qobject_cast<U2SequenceObject *>(sequenceObject->clone(dbiHandle->getDbiRef(), os)));
+    if (!isStorageDbi(entityRef.dbiRef)) {
+        QScopedPointer<U2SequenceObject> clonedSequenceObject(qobject_cast<U2SequenceObject *>(sequenceObject->clone(getMessageDbiRef(), os)));
         SAFE_POINT_OP(os, SharedDbiDataHandler());
         entityRef = clonedSequenceObject->getEntityRef();
     }
 
-    DbiConnection *connection = getConnection(dbiHandle->getDbiRef(), os);
+    DbiConnection *connection = getConnection(entityRef.dbiRef, os);
     SAFE_POINT_OP(os, SharedDbiDataHandler());
 
     return SharedDbiDataHandler(new DbiDataHandler(entityRef, connection->dbi->getObjectDbi(), true));
@@ -176,10 +195,11 @@ SharedDbiDataHandler DbiDataStorage::putAlignment(const MultipleSequenceAlignmen
 
     U2OpStatus2Log os;
     MultipleSequenceAlignment copiedAlignment = al->getCopy();
-    QScopedPointer<MultipleSequenceAlignmentObject> obj(MultipleSequenceAlignmentImporter::createAlignment(dbiHandle->getDbiRef(), copiedAlignment, os));
+    const U2DbiRef dbiRef = getMessageDbiRef();
+    QScopedPointer<MultipleSequenceAlignmentObject> obj(MultipleSequenceAlignmentImporter::createAlignment(dbiRef, copiedAlignment, os));
     CHECK_OP(os, SharedDbiDataHandler());
 
-    DbiConnection *connection = this->getConnection(dbiHandle->getDbiRef(), os);
+    DbiConnection *connection = this->getConnection(dbiRef, os);
     CHECK_OP(os, SharedDbiDataHandler());
 
     SharedDbiDataHandler handler(new DbiDataHandler(obj->getEntityRef(), connection->dbi->getObjectDbi(), true));
@@ -190,14 +210,15 @@ SharedDbiDataHandler DbiDataStorage::putAlignment(const MultipleSequenceAlignmen
 SharedDbiDataHandler DbiDataStorage::putAnnotationTable(const QList<SharedAnnotationData> &anns, const QString annTableName) {
     SAFE_POINT(NULL != dbiHandle, "Invalid DBI handle!", SharedDbiDataHandler());
 
-    AnnotationTableObject obj(annTableName, dbiHandle->getDbiRef());
+    const U2DbiRef dbiRef = getMessageDbiRef();
+    AnnotationTableObject obj(annTableName, dbiRef);
     U2OpStatusImpl os;
     obj.addAnnotations(anns);
     SAFE_POINT_OP(os, SharedDbiDataHandler());
 
     U2EntityRef ent = obj.getEntityRef();
 
-    DbiConnection *connection = this->getConnection(dbiHandle->getDbiRef(), os);
+    DbiConnection *connection = this->getConnection(dbiRef, os);
     SAFE_POINT_OP(os, SharedDbiDataHandler());
 
     SharedDbiDataHandler handler(new DbiDataHandler(ent, connection->dbi->getObjectDbi(), true));
@@ -212,13 +233,13 @@ SharedDbiDataHandler DbiDataStorage::putAnnotationTable(AnnotationTableObject *a
     U2OpStatusImpl os;
 
     U2EntityRef entityRef = annTable->getEntityRef();
-    if (annTable->getEntityRef().dbiRef != dbiHandle->getDbiRef()) {
-        QScopedPointer<AnnotationTableObject> clonedTable(qobject_cast<AnnotationTableObject *>(annTable->clone(dbiHandle->getDbiRef(), os)));
+    if (!isStorageDbi(entityRef.dbiRef)) {
+        QScopedPointer<AnnotationTableObject> clonedTable(qobject_cast<AnnotationTableObject *>(annTable->clone(getMessageDbiRef(), os)));
         SAFE_POINT_OP(os, SharedDbiDataHandler());
         entityRef = clonedTable->getEntityRef();
     }
 
-    DbiConnection *connection = getConnection(dbiHandle->getDbiRef(), os);
+    DbiConnection *connection = getConnection(entityRef.dbiRef, os);
     SAFE_POINT_OP(os, SharedDbiDataHandler());
 
     return SharedDbiDataHandler(new DbiDataHandler(entityRef, connection->dbi->getObjectDbi(), true));
@@ -248,7 +269,7 @@ SharedDbiDataHandler DbiDataStorage::getDataHandler(const U2EntityRef &entRef, b
 }
 
 DbiConnection *DbiDataStorage::getConnection(const U2DbiRef &dbiRef, U2OpStatus &os) {
-    // TODO: mutex
+    QMutexLocker locker(&connectionsMutex);
     if (connections.contains(dbiRef.dbiId)) {
         return connections[dbiRef.dbiId];
     } else {
@@ -260,8 +281,36 @@ DbiConnection *DbiDataStorage::getConnection(const U2DbiRef &dbiRef, U2OpStatus
     }
 }
 
+U2DbiRef DbiDataStorage::getMessageDbiRef() {
+    SAFE_POINT(NULL != dbiHandle, "Invalid DBI handle", U2DbiRef());
+    CHECK(NULL != memoryDbiHandle, dbiHandle->getDbiRef());
+
+    QMutexLocker locker(&messageDbiMutex);
+    // the used memory grows slowly: it is checked once per MESSAGE_DBI_CHECK_INTERVAL puts, not on every put
+    const bool checkMemory = (0 == messageDbiUses);
+    messageDbiUses = (messageDbiUses + 1) % MESSAGE_DBI_CHECK_INTERVAL;
+    if (checkMemory) {
+        messageDbiRef = dbiHandle->getDbiRef();
+
+        U2OpStatusImpl os;
+        DbiConnection *connection = getConnection(memoryDbiHandle->getDbiRef(), os);
+        CHECK_OP(os, messageDbiRef);
+
+        const qint64 usedMemory = connection->dbi->getProperty(MEMORY_DBI_USED_MEMORY_PROPERTY, "0", os).toLongLong();
+        CHECK_OP(os, messageDbiRef);
+        if (usedMemory < memoryLimit) {
+            messageDbiRef = memoryDbiHandle->getDbiRef();
+        }
+    }
+    return messageDbiRef;
+}
+
+bool DbiDataStorage::isStorageDbi(const U2DbiRef &dbiRef) const {
+    return dbiRef == dbiHandle->getDbiRef() || (NULL != memoryDbiHandle && dbiRef == memoryDbiHandle->getDbiRef());
+}
+
 U2DbiRef DbiDataStorage::createTmpDbi(U2OpStatus &os) {
-    // TODO: mutex
+    QMutexLocker locker(&connectionsMutex);
     QString tmpDirPath = AppContext::getAppSettings()->getUserAppsSettings()->getCurrentProcessTemporaryDirPath();
 
     U2DbiRef dbiRef;
@@ -285,6 +334,7 @@ void DbiDataStorage::openDbi(const U2DbiRef &dbiRef, U2OpStatus &os) {
     QScopedPointer<DbiConnection> con(new DbiConnection(dbiRef, false, os));
     CHECK_OP(os,);
 
+    QMutexLocker locker(&connectionsMutex);
     dbiList[dbiRef.dbiId] = false;
     connections[dbiRef.dbiId] = con.take();
 }
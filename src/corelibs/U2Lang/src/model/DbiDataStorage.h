@@ -22,6 +22,8 @@
 #ifndef _WORKFLOW_DBI_DATA_STORAGE_H_
 #define _WORKFLOW_DBI_DATA_STORAGE_H_
 
+#include <QMutex>
+
 #include <U2Core/AnnotationData.h>
 #include <U2Core/AssemblyObject.h>
 #include <U2Core/DNASequence.h>
@@ -68,11 +70,25 @@ public:
 private:
     DbiDataStorage(const DbiDataStorage &) {}
     TmpDbiHandle *dbiHandle;
+    /* Sequences, alignments and annotation tables are kept in memory while the memory limit is not exceeded */
+    TmpDbiHandle *memoryDbiHandle;
+    qint64 memoryLimit;
+    /* The result of getMessageDbiRef() is reused between the memory checks */
+    QMutex messageDbiMutex;
+    U2DbiRef messageDbiRef;
+    int messageDbiUses;
+    /* Workers of parallel workflow branches use the storage simultaneously: guards 'connections' and 'dbiList' */
+    QMutex connectionsMutex;
     QMap<U2DbiId, DbiConnection*> connections;
     /* DbiRef <-> temporary */
     QMap<U2DbiId, bool> dbiList;
 
     DbiConnection *getConnection(const U2DbiRef &dbiRef, U2OpStatus &os);
+    /* Returns the memory database if it is available and has free space, the temporary file database otherwise */
+    U2DbiRef getMessageDbiRef();
+    bool isStorageDbi(const U2DbiRef &dbiRef) const;
+
+    static const int MESSAGE_DBI_CHECK_INTERVAL;
 };
 
 class U2LANG_EXPORT StorageUtils {
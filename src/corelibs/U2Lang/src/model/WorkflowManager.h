@@ -97,6 +97,8 @@ public:
     // returning value indicates if current task was canceled
     virtual bool cancelCurrentTaskIfAllowed() = 0;
     virtual void makeOneTick(const ActorId &) = 0;
+    // how many tasks returned by tick() can be run simultaneously
+    virtual int getMaxParallelTasks() const {return 1;}
     virtual void setDebugInfo(WorkflowDebugStatus *newDebugInfo) {
         Q_ASSERT(NULL != newDebugInfo);
         debugInfo = newDebugInfo;
@@ -263,12 +263,15 @@ void WorkflowIterationRunTask::prepare() {
     scheduler->setContext(context);
     scheduler->init();
     scheduler->setDebugInfo(debugInfo);
+    setMaxParallelSubtasks(scheduler->getMaxParallelTasks());
     context->getMonitor()->start();
     while(scheduler->isReady() && !isCanceled()) {
         Task* t = scheduler->tick();
         if (t) {
             addSubTask(t);
-            break;
+            if (1 == scheduler->getMaxParallelTasks()) {
+                break;
+            }
         }
     }
 }
@@ -299,7 +302,9 @@ QList<Task*> WorkflowIterationRunTask::onSubTaskFinished(Task* subTask) {
         Task* t = scheduler->tick();
         if (t) {
             tasks << t;
-            break;
+            if (1 == scheduler->getMaxParallelTasks()) {
+                break;
+            }
         }
     }
     emit si_ticked();
@@ -51,6 +51,7 @@ namespace U2 {
 #define INCLUDED_WORKER_PATH        SETTINGS + "includedWorkerPath"
 #define WORKFLOW_OUTPUT_PATH        SETTINGS + "workflowOutputPath"
 #define SHOW_LOAD_BUTTON_HINT       SETTINGS + "showLoadButtonHint"
+#define MESSAGE_STORAGE_MEMORY      SETTINGS + "messageStorageMemoryLimit"
 
 Watcher* const WorkflowSettings::watcher = new Watcher;
 
@@ -282,4 +283,18 @@ void WorkflowSettings::setShowLoadButtonHint(bool value) {
     s->setValue(SHOW_LOAD_BUTTON_HINT, value);
 }
 
+int WorkflowSettings::getMessageStorageMemoryLimit() {
+    Settings *s = AppContext::getSettings();
+    SAFE_POINT(NULL != s, "NULL settings!", 0);
+
+    return qMax(0, s->getValue(MESSAGE_STORAGE_MEMORY, QVariant(256)).toInt());
+}
+
+void WorkflowSettings::setMessageStorageMemoryLimit(int megabytes) {
+    Settings *s = AppContext::getSettings();
+    SAFE_POINT(NULL != s, "NULL settings!", );
+
+    s->setValue(MESSAGE_STORAGE_MEMORY, megabytes);
+}
+
 }//namespace
@@ -88,6 +88,11 @@ public:
     static bool isShowLoadButtonHint();
     static void setShowLoadButtonHint(bool value);
 
+    /** Amount of memory (in megabytes) that can be used to keep the data passed between workflow elements.
+        The data exceeding the limit is stored in a temporary file. Zero disables keeping the data in memory */
+    static int getMessageStorageMemoryLimit();
+    static void setMessageStorageMemoryLimit(int megabytes);
+
     static Watcher * const watcher;
 };
 
@@ -40,8 +40,10 @@
 #include <U2Formats/GFFFormat.h>
 #include <U2Formats/GTFFormat.h>
 #include <U2Formats/GenbankPlainTextFormat.h>
+#include <U2Formats/IndexedFastaDbi.h>
 #include <U2Formats/MSFFormat.h>
 #include <U2Formats/MegaFormat.h>
+#include <U2Formats/MemoryDbi.h>
 #include <U2Formats/MysqlDbi.h>
 #include <U2Formats/NEXUSFormat.h>
 #include <U2Formats/NewickFormat.h>
@@ -220,6 +222,8 @@ void DocumentFormatRegistryImpl::init() {
 
     AppContext::getDbiRegistry()->registerDbiFactory(new SQLiteDbiFactory());
     AppContext::getDbiRegistry()->registerDbiFactory(new MysqlDbiFactory());
+    AppContext::getDbiRegistry()->registerDbiFactory(new MemoryDbiFactory());
+    AppContext::getDbiRegistry()->registerDbiFactory(new IndexedFastaDbiFactory());
 
     DocumentFormatFlags flags(DocumentFormatFlag_SupportWriting | DocumentFormatFlag_CannotBeCompressed);
     DbiDocumentFormat* sdbi = new DbiDocumentFormat(SQLiteDbiFactory::ID, BaseDocumentFormats::UGENEDB, tr("UGENE Database"), QStringList()<<"ugenedb", flags);
@@ -86,12 +86,16 @@ TaskSchedulerImpl::TaskSchedulerImpl(AppResourcePool* rp) {
     stateChangesObserved = false;
     threadsResource = resourcePool->getResource(RESOURCE_THREAD);
 
+    workerPool = new TaskWorkerPool(qMax(1, resourcePool->getIdealThreadCount()));
+    connect(workerPool, SIGNAL(si_runFinished()), SLOT(sl_threadFinished()), Qt::QueuedConnection);
+
     createSleepPreventer();
 }
 
 TaskSchedulerImpl::~TaskSchedulerImpl() {
     assert(topLevelTasks.empty());
     assert(priorityQueue.isEmpty());
+    delete workerPool;
     delete sleepPreventer;
 }
 
@@ -180,7 +184,7 @@ bool TaskSchedulerImpl::processFinishedTasks() {
             continue;
         }
 
-        if (ti->selfRunFinished && ti->hasLockedRunResources) {
+        if (isSelfRunFinished(ti) && ti->hasLockedRunResources) {
             releaseResources(ti, false); //release resources for RUN stage
         }
 
@@ -314,12 +318,12 @@ void TaskSchedulerImpl::runReady() {
             if (state == Task::State_Prepared) {
                 promoteTask(ti, Task::State_Running);
             }
-            if (ti->thread == NULL) {
+            if (ti->thread == NULL && !ti->pooled) {
                 ti->selfRunFinished = true;
             }
             continue;
         }
-        if (ti->thread!=NULL) { //task is already running in a separate thread
+        if (ti->thread != NULL || ti->pooled) { //task is already running in a separate thread or in the worker pool
             assert(state == Task::State_Running);
             continue;
         }
@@ -360,11 +364,34 @@ void TaskSchedulerImpl::runThread(TaskInfo* ti) {
     assert(!ti->task->hasError());
     assert(!ti->selfRunFinished);
 #endif
+    if (canRunInPool(ti)) {
+        ti->pooled = true;
+        workerPool->submit(ti);
+        return;
+    }
     ti->thread = new TaskThread(ti);
     connect(ti->thread, SIGNAL(finished()), SLOT(sl_threadFinished()));
     ti->thread->start();
 }
 
+bool TaskSchedulerImpl::canRunInPool(TaskInfo* ti) const {
+    // The pool has a fixed number of workers: a task that waits for another task can deadlock it,
+    // so only the leaf subtasks that explicitly ask for it are run in the pool
+    Task* task = ti->task;
+    return task->hasFlags(TaskFlag_RunInWorkerPool)
+        && !task->isTopLevelTask()
+        && task->getSubtasks().isEmpty()
+        && !task->hasFlags(TaskFlag_RunMessageLoopOnly)
+        && !task->hasFlags(TaskFlag_RunBeforeSubtasksFinished);
+}
+
+bool TaskSchedulerImpl::isSelfRunFinished(TaskInfo* ti) const {
+    if (ti->pooled) {
+        return workerPool->isRunFinished(ti);
+    }
+    return ti->selfRunFinished;
+}
+
 QString TaskSchedulerImpl::tryLockResources(Task* task, bool prepareStage, bool& hasLockedResourcesAfterCall) {
 
     QString errorString = QString::null;
@@ -624,6 +651,8 @@ void TaskSchedulerImpl::stopTask(Task* task) {
             cancelTask(task);
             if (ti->thread!=NULL && !ti->thread->isFinished()) {
                 ti->thread->wait();//TODO: try avoid blocking here
+            } else if (ti->pooled) {
+                workerPool->waitForRunFinished(ti);
             }
             assert(readyToFinish(ti));
             break;
@@ -642,7 +671,7 @@ bool TaskSchedulerImpl::readyToFinish(TaskInfo* ti) {
     if (ti->numFinishedSubtasks < ti->task->getSubtasks().size()) {
         return false;
     }
-    if (!ti->selfRunFinished) {
+    if (!isSelfRunFinished(ti)) {
         return false;
     }
 #ifdef _DEBUG
@@ -791,7 +820,7 @@ void TaskSchedulerImpl::promoteTask(TaskInfo* ti, Task::State newState) {
             tti.finishTime = GTimer::currentTimeMicros();
             tsi.setDescription(QString());
             if (pti != NULL) {
-                if (ti->selfRunFinished) {
+                if (isSelfRunFinished(ti)) {
                     pti->numRunningSubtasks--;
                 }
                 assert(pti->numRunningSubtasks>=0);
@@ -976,7 +1005,12 @@ Task * TaskSchedulerImpl::getTopLevelTaskById( qint64 id ) const {
 
 void TaskSchedulerImpl::pauseThreadWithTask(const Task *task) {
     foreach(TaskInfo *ti, priorityQueue) {
-        if(task == ti->task) {
+        if (task != ti->task) {
+            continue;
+        }
+        if (ti->pooled) {
+            workerPool->pause(ti);
+        } else if (NULL != ti->thread) {
             QCoreApplication::postEvent(ti->thread,
                 new QEvent(static_cast<QEvent::Type>(PAUSE_THREAD_EVENT_TYPE)));
         }
@@ -985,7 +1019,12 @@ void TaskSchedulerImpl::pauseThreadWithTask(const Task *task) {
 
 void TaskSchedulerImpl::resumeThreadWithTask(const Task *task) {
     foreach(TaskInfo *ti, priorityQueue) {
-        if(task == ti->task && NULL != ti->thread && ti->thread->isPaused) {
+        if (task != ti->task) {
+            continue;
+        }
+        if (ti->pooled) {
+            workerPool->resume(ti);
+        } else if (NULL != ti->thread && ti->thread->isPaused) {
             ti->thread->resume();
         }
     }
@@ -1122,6 +1161,169 @@ void TaskThread::resume() {
     }
 }
 
+TaskWorker::TaskWorker(TaskWorkerPool* _pool, int _index)
+    : pool(_pool),
+      index(_index)
+{
+}
+
+void TaskWorker::run() {
+    forever {
+        TaskInfo* ti = pool->takeTask(this);
+        if (ti == NULL) {
+            break;
+        }
+        pool->runTask(ti);
+    }
+}
+
+TaskWorkerPool::TaskWorkerPool(int nWorkers)
+    : nextWorker(0),
+      nQueued(0),
+      stopped(false)
+{
+    for (int i = 0; i < nWorkers; i++) {
+        TaskWorker* worker = new TaskWorker(this, i);
+        workers << worker;
+        worker->start(QThread::LowPriority);
+    }
+}
+
+TaskWorkerPool::~TaskWorkerPool() {
+    poolLocker.lock();
+    stopped = true;
+    hasWork.wakeAll();
+    poolLocker.unlock();
+
+    foreach (TaskWorker* worker, workers) {
+        worker->wait();
+    }
+    qDeleteAll(workers);
+}
+
+void TaskWorkerPool::submit(TaskInfo* ti) {
+    SAFE_POINT(!workers.isEmpty(), "There are no workers in the pool",);
+    assert(!ti->selfRunFinished);
+
+    TaskWorker* worker = workers[nextWorker];
+    nextWorker = (nextWorker + 1) % workers.size();
+
+    worker->dequeLocker.lock();
+    worker->deque.append(ti);
+    worker->dequeLocker.unlock();
+
+    QMutexLocker locker(&poolLocker);
+    nQueued++;
+    hasWork.wakeOne();
+}
+
+void TaskWorkerPool::waitForRunFinished(TaskInfo* ti) {
+    QMutexLocker locker(&poolLocker);
+    while (!ti->selfRunFinished) {
+        runFinished.wait(&poolLocker);
+    }
+}
+
+bool TaskWorkerPool::isRunFinished(TaskInfo* ti) {
+    QMutexLocker locker(&poolLocker);
+    return ti->selfRunFinished;
+}
+
+void TaskWorkerPool::pause(TaskInfo* ti) {
+    QMutexLocker locker(&poolLocker);
+    if (!ti->selfRunFinished) {
+        pausedTasks.insert(ti);
+    }
+}
+
+void TaskWorkerPool::resume(TaskInfo* ti) {
+    poolLocker.lock();
+    pausedTasks.remove(ti);
+    bool wasHeld = heldTasks.removeOne(ti);
+    poolLocker.unlock();
+
+    if (wasHeld) {
+        submit(ti);
+    }
+}
+
+TaskInfo* TaskWorkerPool::takeTask(TaskWorker* worker) {
+    forever {
+        TaskInfo* ti = tryTakeTask(worker);
+        QMutexLocker locker(&poolLocker);
+        if (ti != NULL) {
+            nQueued--;
+            if (pausedTasks.contains(ti)) {
+                // a paused task is not started until it is resumed
+                heldTasks.append(ti);
+                continue;
+            }
+            return ti;
+        }
+        if (stopped) {
+            return NULL;
+        }
+        if (nQueued == 0) {
+            hasWork.wait(&poolLocker);
+        }
+    }
+}
+
+TaskInfo* TaskWorkerPool::tryTakeTask(TaskWorker* worker) {
+    {
+        QMutexLocker locker(&worker->dequeLocker);
+        if (!worker->deque.isEmpty()) {
+            return worker->deque.takeFirst();
+        }
+    }
+    for (int i = 1, n = workers.size(); i < n; i++) {
+        TaskWorker* victim = workers[(worker->index + i) % n];
+        QMutexLocker locker(&victim->dequeLocker);
+        if (!victim->deque.isEmpty()) {
+            return victim->deque.takeLast();
+        }
+    }
+    return NULL;
+}
+
+void TaskWorkerPool::runTask(TaskInfo* ti) {
+    Task* task = ti->task;
+    assert(task->getState() == Task::State_Running);
+
+    lock.lock();
+    AppContext::getTaskScheduler()->addThreadId(task->getTaskId(), QThread::currentThreadId());
+    lock.unlock();
+
+    QThread* thread = QThread::currentThread();
+    QThread::Priority tp = getThreadPriority(task->getTopLevelParentTask());
+    if (thread->priority() != tp) {
+        thread->setPriority(tp);
+    }
+
+    // the task could be canceled while it was waiting in the queue
+    if (!task->isCanceled() && !task->hasError()) {
+        try {
+            task->run();
+            assert(task->getState() == Task::State_Running);
+        } catch (const std::bad_alloc &) {
+            onBadAlloc(task);
+        }
+    }
+
+    lock.lock();
+    AppContext::getTaskScheduler()->removeThreadId(task->getTaskId());
+    lock.unlock();
+
+    // 'ti' can be deleted by the scheduler right after the flag is set
+    poolLocker.lock();
+    ti->selfRunFinished = true;
+    pausedTasks.remove(ti);
+    runFinished.wakeAll();
+    poolLocker.unlock();
+
+    emit si_runFinished();
+}
+
 TaskInfo::~TaskInfo() {
     if (thread!=NULL) {
         if (!thread->isFinished()) {
@@ -29,6 +29,7 @@
 #include <QTimer>
 #include <QMap>
 #include <QMutex>
+#include <QSet>
 #include <QWaitCondition>
 
 namespace U2 {
@@ -76,12 +77,80 @@ private:
 };
 
 
+class TaskWorkerPool;
+
+/**
+ * A thread of the TaskWorkerPool. Every worker owns a deque of tasks:
+ * the worker takes tasks from the head of its own deque and idle workers steal tasks from the tail.
+ */
+class TaskWorker : public QThread {
+public:
+    TaskWorker(TaskWorkerPool* pool, int index);
+    void run();
+
+    TaskWorkerPool*     pool;
+    int                 index;
+    QMutex              dequeLocker;
+    QList<TaskInfo*>    deque;
+};
+
+/**
+ * A fixed-size pool of worker threads (one per core by default) with work stealing.
+ * It is used to run the leaf subtasks with TaskFlag_RunInWorkerPool (e.g. SequenceWalkerSubtask)
+ * without creating a new thread for every task.
+ * The scheduler is notified with the 'si_runFinished' signal as soon as a task's run is finished.
+ */
+class TaskWorkerPool : public QObject {
+    Q_OBJECT
+public:
+    TaskWorkerPool(int nWorkers);
+    ~TaskWorkerPool();
+
+    // Queues the task to be run by one of the workers. The task must not be run in the pool yet
+    void submit(TaskInfo* ti);
+
+    // Blocks the calling thread until the 'run' of the submitted task is finished
+    void waitForRunFinished(TaskInfo* ti);
+
+    // Reads the 'selfRunFinished' flag of the submitted task under the pool lock
+    bool isRunFinished(TaskInfo* ti);
+
+    // A paused task is held by the pool until it is resumed. A task that is already running can't be paused
+    void pause(TaskInfo* ti);
+    void resume(TaskInfo* ti);
+
+    int getWorkersCount() const {return workers.size();}
+
+signals:
+    void si_runFinished();
+
+private:
+    friend class TaskWorker;
+
+    // Returns a task from the worker's own deque or steals it from other workers; blocks if there are no tasks.
+    // Returns NULL if the pool is stopped
+    TaskInfo* takeTask(TaskWorker* worker);
+    TaskInfo* tryTakeTask(TaskWorker* worker);
+    void runTask(TaskInfo* ti);
+
+    QList<TaskWorker*>  workers;
+    int                 nextWorker;     // round-robin index for submitting
+
+    QMutex              poolLocker;     // guards the fields below and the 'selfRunFinished' flag of the pooled tasks
+    QWaitCondition      hasWork;
+    QWaitCondition      runFinished;
+    int                 nQueued;
+    bool                stopped;
+    QSet<TaskInfo*>     pausedTasks;
+    QList<TaskInfo*>    heldTasks;      // paused tasks taken from the deques
+};
+
 class TaskInfo {
 public:
     TaskInfo(Task* t, TaskInfo* p)
         : task(t), parentTaskInfo(p), wasPrepared(false), subtasksWereCanceled(false), selfRunFinished(false),
         hasLockedPrepareResources(false), hasLockedRunResources(false),
-        prevProgress(0), numPreparedSubtasks(0), numRunningSubtasks(0), numFinishedSubtasks(0),  thread(NULL) {}
+        prevProgress(0), numPreparedSubtasks(0), numRunningSubtasks(0), numFinishedSubtasks(0),  thread(NULL), pooled(false) {}
 
     virtual ~TaskInfo();
 
@@ -106,6 +175,7 @@ public:
     int             numFinishedSubtasks;
 
     TaskThread*     thread;
+    bool            pooled;         // 'true' if the task is run by the TaskWorkerPool instead of a dedicated thread
 
     inline int numActiveSubtasks() const {
         return numPreparedSubtasks+numRunningSubtasks;
@@ -159,6 +229,8 @@ private:
     bool readyToFinish(TaskInfo* ti);
     bool addToPriorityQueue(Task* t, TaskInfo* parentInfo); //return true if added. Failure can be caused if a task requires resources
     void runThread(TaskInfo* pi);
+    bool canRunInPool(TaskInfo* ti) const;
+    bool isSelfRunFinished(TaskInfo* ti) const;
     void stopTask(Task* t);
     void updateTaskProgressAndDesc(TaskInfo* ti);
     void promoteTask(TaskInfo* ti, Task::State newState);
@@ -186,6 +258,7 @@ private:
     AppResource*            threadsResource;
     bool                    stateChangesObserved;
     SleepPreventer*         sleepPreventer;
+    TaskWorkerPool*         workerPool;
 };
 
 } //namespace
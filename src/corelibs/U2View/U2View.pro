@@ -20,6 +20,7 @@ HEADERS += src/LicenseDialog.h \
            src/ov_assembly/AssemblyNavigationWidget.h \
            src/ov_assembly/AssemblyReadsArea.h \
            src/ov_assembly/AssemblyReadsAreaHint.h \
+           src/ov_assembly/AssemblyReadsTileCache.h \
            src/ov_assembly/AssemblyReferenceArea.h \
            src/ov_assembly/AssemblyRuler.h \
            src/ov_assembly/AssemblySettingsWidget.h \
@@ -286,6 +287,7 @@ SOURCES += src/LicenseDialog.cpp \
            src/ov_assembly/AssemblyNavigationWidget.cpp \
            src/ov_assembly/AssemblyReadsArea.cpp \
            src/ov_assembly/AssemblyReadsAreaHint.cpp \
+           src/ov_assembly/AssemblyReadsTileCache.cpp \
            src/ov_assembly/AssemblyReferenceArea.cpp \
            src/ov_assembly/AssemblyRuler.cpp \
            src/ov_assembly/AssemblySettingsWidget.cpp \
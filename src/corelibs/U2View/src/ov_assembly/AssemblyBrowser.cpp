@@ -112,6 +112,7 @@ exportToSamAction(NULL), setReferenceAction(NULL), extractAssemblyRegionAction(N
         const U2EntityRef& ref= gobject->getEntityRef();
         model = QSharedPointer<AssemblyModel>(new AssemblyModel(DbiConnection(ref.dbiRef, dbiOpStatus)));
         connect(model.data(), SIGNAL(si_referenceChanged()), SLOT(sl_referenceChanged()));
+        connect(gobject, SIGNAL(si_modifiedStateChanged()), SLOT(sl_assemblyModifiedStateChanged()));
         assemblyLoaded();
         CHECK_OP(dbiOpStatus, );
     }
@@ -128,6 +129,11 @@ void AssemblyBrowser::removeReferenceSequence(){
     }
 }
 
+void AssemblyBrowser::sl_assemblyModifiedStateChanged() {
+    // the reads could be changed in the database
+    model->clearReadsCache();
+}
+
 void AssemblyBrowser::sl_referenceChanged() {
     removeReferenceSequence();
 
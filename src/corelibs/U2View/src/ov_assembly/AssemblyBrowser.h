@@ -160,6 +160,7 @@ private slots:
     void sl_exportCoverage();
     void sl_unassociateReference();
     void sl_referenceChanged();
+    void sl_assemblyModifiedStateChanged();
     void sl_trackRemoved(VariantTrackObject *obj);
     void sl_setReference();
     void sl_onReferenceLoaded();
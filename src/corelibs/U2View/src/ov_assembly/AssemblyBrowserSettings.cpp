@@ -34,6 +34,9 @@ static const QString SHOW_RULER_COORDS(SETTINGS_PREFIX + "show_coords_on_ruler")
 static const QString SHOW_RULER_COVERAGE(SETTINGS_PREFIX + "show_coverage_on_ruler");
 static const QString READ_HINT(SETTINGS_PREFIX + "read_hint");
 static const QString OPTIMIZE_SCROLL(SETTINGS_PREFIX + "optimize_scroll");
+static const QString READS_CACHE_SIZE(SETTINGS_PREFIX + "reads_cache_size_mb");
+
+static const int DEFAULT_READS_CACHE_SIZE_MB = 256;
 
 AssemblyBrowserSettings::OverviewScaleType AssemblyBrowserSettings::getOverviewScaleType() {
     return OverviewScaleType(AppContext::getSettings()->getValue(SCALE_TYPE, Scale_Linear).value<int>());
@@ -75,4 +78,13 @@ void AssemblyBrowserSettings::setOptimizeRenderOnScroll(bool what) {
     AppContext::getSettings()->setValue(OPTIMIZE_SCROLL, what);
 }
 
+int AssemblyBrowserSettings::getReadsCacheSizeMb() {
+    int sizeMb = AppContext::getSettings()->getValue(READS_CACHE_SIZE, DEFAULT_READS_CACHE_SIZE_MB).value<int>();
+    return sizeMb > 0 ? sizeMb : DEFAULT_READS_CACHE_SIZE_MB;
+}
+
+void AssemblyBrowserSettings::setReadsCacheSizeMb(int sizeMb) {
+    AppContext::getSettings()->setValue(READS_CACHE_SIZE, sizeMb);
+}
+
 } // U2
@@ -44,6 +44,10 @@ public:
 
     static bool getOptimizeRenderOnScroll();
     static void setOptimizeRenderOnScroll(bool what);
+
+    // memory budget of the reads tile cache, in megabytes
+    static int getReadsCacheSizeMb();
+    static void setReadsCacheSizeMb(int sizeMb);
     
 }; // AssemblyBrowserSettings
 
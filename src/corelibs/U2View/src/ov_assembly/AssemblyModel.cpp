@@ -50,7 +50,9 @@
 #include <U2Gui/ObjectViewTasks.h>
 
 #include "AssemblyBrowser.h"
+#include "AssemblyBrowserSettings.h"
 #include "AssemblyModel.h"
+#include "AssemblyReadsTileCache.h"
 
 namespace U2 {
 
@@ -63,7 +65,7 @@ const QByteArray AssemblyModel::COVERAGE_STAT_ATTRIBUTE_NAME(U2BaseAttributeName
 AssemblyModel::AssemblyModel(const DbiConnection& dbiCon_) :
     cachedModelLength(NO_VAL), cachedModelHeight(NO_VAL), assemblyDbi(NULL), dbiHandle(dbiCon_),
     loadingReference(false), refObj(NULL), md5Retrieved(false), cachedReadsNumber(NO_VAL), speciesRetrieved(false),
-    uriRetrieved(false)
+    uriRetrieved(false), binnedCoverageLoaded(false)
 {
     Project * prj = AppContext::getProject();
     if (prj != NULL) {
@@ -90,6 +92,7 @@ void AssemblyModel::dissociateReference() {
         assembly.referenceId.clear();
         assemblyDbi->updateAssemblyObject(assembly, status);
         LOG_OP(status);
+        clearReadsCache();
         unsetReference();
 
         removeCrossDatabaseReference(refId);
@@ -103,8 +106,29 @@ bool AssemblyModel::isEmpty() const {
 }
 
 QList<U2AssemblyRead> AssemblyModel::getReadsFromAssembly(const U2Region & r, qint64 minRow, qint64 maxRow, U2OpStatus & os) {
-    QScopedPointer< U2DbiIterator<U2AssemblyRead> > it(assemblyDbi->getReadsByRow(assembly.id, r, minRow, maxRow, os));
-    return U2DbiUtils::toList(it.data());
+    SAFE_POINT_EXT(!readsCache.isNull(), os.setError("Reads cache is not initialized"), QList<U2AssemblyRead>());
+    return readsCache->getReads(r, minRow, maxRow, os);
+}
+
+int AssemblyModel::prefetchReads(const U2Region & r, qint64 minRow, qint64 maxRow, U2OpStatus & os) {
+    CHECK(!readsCache.isNull(), 0);
+    return readsCache->prefetch(r, minRow, maxRow, os);
+}
+
+bool AssemblyModel::isReadsPrefetched(const U2Region & r, qint64 minRow, qint64 maxRow) {
+    CHECK(!readsCache.isNull(), true);
+    return readsCache->isPrefetched(r, minRow, maxRow);
+}
+
+void AssemblyModel::clearReadsCache() {
+    {
+        // the dbi has removed the stored coverage if the reads were changed
+        QMutexLocker mutexLocker(&binnedCoverageMutex);
+        binnedCoverageLoaded = false;
+        binnedCoverage = U2AssemblyBinnedCoverage();
+    }
+    CHECK(!readsCache.isNull(), );
+    readsCache->clear();
 }
 
 U2DbiIterator<U2AssemblyRead>* AssemblyModel::getReads(const U2Region & r, U2OpStatus & os) {
@@ -112,9 +136,33 @@ U2DbiIterator<U2AssemblyRead>* AssemblyModel::getReads(const U2Region & r, U2OpS
 }
 
 void AssemblyModel::calculateCoverageStat(const U2Region & r, U2AssemblyCoverageStat& coverageStat, U2OpStatus & os) {
+    if (calculateCoverageStatFromBins(r, coverageStat)) {
+        return;
+    }
     return assemblyDbi->calculateCoverage(assembly.id, r, coverageStat, os);
 }
 
+bool AssemblyModel::calculateCoverageStatFromBins(const U2Region & r, U2AssemblyCoverageStat& coverageStat) {
+    QMutexLocker mutexLocker(&binnedCoverageMutex);
+    Q_UNUSED(mutexLocker);
+    if (!binnedCoverageLoaded) {
+        binnedCoverageLoaded = true;
+        U2AttributeDbi * attributeDbi = dbiHandle.dbi->getAttributeDbi();
+        CHECK(NULL != attributeDbi, false);
+        U2OpStatusImpl status;
+        U2ByteArrayAttribute attr = U2AttributeUtils::findByteArrayAttribute(attributeDbi, assembly.id, U2BaseAttributeName::binned_coverage, status);
+        CHECK_OP(status, false);
+        CHECK(attr.hasValidId(), false);
+        binnedCoverage = U2AssemblyBinnedCoverage::deserialize(attr.value, status);
+        if (status.hasError()) {
+            coreLog.details(status.getError());
+            binnedCoverage = U2AssemblyBinnedCoverage();
+        }
+    }
+    CHECK(!binnedCoverage.isEmpty(), false);
+    return binnedCoverage.getCoverage(r, coverageStat);
+}
+
 bool AssemblyModel::hasCachedCoverageStat() {
     if(!cachedCoverageStat.isEmpty()) {
         return true;
@@ -266,6 +314,8 @@ void AssemblyModel::setAssembly(U2AssemblyDbi * dbi, const U2Assembly & assm) {
     assert(assemblyDbi == NULL);
     assemblyDbi = dbi;
     assembly = assm;
+    readsCache.reset(new AssemblyReadsTileCache(assemblyDbi, assembly.id));
+    readsCache->setMemoryLimit(qint64(AssemblyBrowserSettings::getReadsCacheSizeMb()) * 1024 * 1024);
 
     // check if have reference
     if(!assembly.referenceId.isEmpty()) {
@@ -512,6 +562,7 @@ void AssemblyModel::associateWithReference(const U2DataId& refId) {
     U2OpStatusImpl status;
     assemblyDbi->updateAssemblyObject(assembly, status);
     LOG_OP(status);
+    clearReadsCache();
     emit si_referenceChanged();
 }
 
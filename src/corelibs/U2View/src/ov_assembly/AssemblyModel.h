@@ -26,11 +26,14 @@
 #include <QMutex>
 #include <QMutexLocker>
 #include <QFile>
+#include <QScopedPointer>
+#include <U2Core/U2AssemblyBinnedCoverage.h>
 #include <U2Core/U2DbiUtils.h>
 #include <U2Core/GObject.h>
 
 namespace U2 {
 
+class AssemblyReadsTileCache;
 class Document;
 class Task;
 class U2SequenceObject;
@@ -46,6 +49,12 @@ public:
     bool isEmpty() const;
 
     QList<U2AssemblyRead> getReadsFromAssembly(const U2Region & r, qint64 minRow, qint64 maxRow, U2OpStatus & os);
+    // loads reads around the given area into the reads cache, returns the number of loaded tiles
+    int prefetchReads(const U2Region & r, qint64 minRow, qint64 maxRow, U2OpStatus & os);
+    // returns true if all the reads loaded by 'prefetchReads' for the area are still cached
+    bool isReadsPrefetched(const U2Region & r, qint64 minRow, qint64 maxRow);
+    // must be called when the reads in the database are changed, the binned coverage is loaded again too
+    void clearReadsCache();
     U2DbiIterator<U2AssemblyRead> * getReads(const U2Region & r, U2OpStatus & os);
 
     void calculateCoverageStat(const U2Region & r, U2AssemblyCoverageStat& coverageStat, U2OpStatus & os);
@@ -105,6 +114,8 @@ private:
         association in ugenedb still exists
     */
     void unsetReference();
+    // returns false if the coverage must be calculated from the reads
+    bool calculateCoverageStatFromBins(const U2Region & r, U2AssemblyCoverageStat& coverageStat);
     void startLoadReferenceTask(Task * t);
     Task * createLoadReferenceAndAddToProjectTask(const U2CrossDatabaseReference& ref);
     void onReferenceRemoved();
@@ -155,6 +166,12 @@ private:
 
     U2AssemblyCoverageStat cachedCoverageStat;
 
+    QScopedPointer<AssemblyReadsTileCache> readsCache;
+
+    U2AssemblyBinnedCoverage binnedCoverage;
+    bool binnedCoverageLoaded;
+    QMutex binnedCoverageMutex;
+
     QMutex mutex;
 }; // AssemblyModel
 
@@ -53,6 +53,7 @@
 #include "AssemblyBrowser.h"
 #include "AssemblyConsensusArea.h"
 #include "AssemblyReadsArea.h"
+#include "AssemblyReadsTileCache.h"
 #include "ExportReadsDialog.h"
 #include "ZoomableAssemblyOverview.h"
 
@@ -410,6 +411,7 @@ void AssemblyReadsArea::drawReads(QPainter & p) {
         LOG_OP(status);
         return;
     }
+    startReadsPrefetching();
 
     QByteArray referenceRegion;
     if(browser->areCellsVisible()) {
@@ -614,6 +616,19 @@ void AssemblyReadsArea::drawCurrentReadHighlight(QPainter &p) {
     }
 }
 
+void AssemblyReadsArea::startReadsPrefetching() {
+    const U2Region &bases = cachedReads.visibleBases;
+    const U2Region &rows = cachedReads.visibleRows;
+    // the running task already loads the tiles around the visible area
+    CHECK(readsPrefetcher.isIdle() || !prefetchingBases.contains(bases) || !prefetchingRows.contains(rows), );
+    CHECK(!model->isReadsPrefetched(bases, rows.startPos, rows.endPos()), );
+
+    readsPrefetcher.cancel();
+    readsPrefetcher.run(new AssemblyReadsPrefetchTask(model, bases, rows));
+    prefetchingBases = U2Region(bases.startPos - AssemblyReadsTileCache::TILE_BASES, bases.length + 2 * AssemblyReadsTileCache::TILE_BASES);
+    prefetchingRows = U2Region(rows.startPos - AssemblyReadsTileCache::TILE_ROWS, rows.length + 2 * AssemblyReadsTileCache::TILE_ROWS);
+}
+
 void AssemblyReadsArea::drawReadsShadowing(QPainter &p) {
      if (shadowingEnabled) {
         int screenLinePos = 0;
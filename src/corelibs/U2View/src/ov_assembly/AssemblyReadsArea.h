@@ -29,6 +29,7 @@
 #include <QSharedPointer>
 #include <QWidget>
 
+#include <U2Core/BackgroundTaskRunner.h>
 #include <U2Core/U2Assembly.h>
 
 #include "AssemblyCellRenderer.h"
@@ -92,6 +93,8 @@ private:
 
     void drawAll();
     void drawReads(QPainter & p);
+    // starts loading the reads around the visible area unless they are cached or are being loaded
+    void startReadsPrefetching();
 
     void drawCurrentReadHighlight(QPainter &p);
     void drawReadsShadowing(QPainter &p);
@@ -190,6 +193,11 @@ private:
         qint64 yOffsetInAssembly;
     };
     ReadsCache cachedReads;
+    // loads reads around the visible area into the model's reads cache
+    BackgroundTaskRunner<int> readsPrefetcher;
+    // the area covered by the last started prefetching
+    U2Region prefetchingBases;
+    U2Region prefetchingRows;
     QPoint curPos;
 
     struct HintData {
@@ -0,0 +1,210 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include <limits.h>
+
+#include <QMutexLocker>
+
+#include <U2Core/U2AssemblyDbi.h>
+#include <U2Core/U2DbiUtils.h>
+#include <U2Core/U2SafePoints.h>
+
+#include "AssemblyModel.h"
+#include "AssemblyReadsTileCache.h"
+
+namespace U2 {
+
+//==============================================================================
+// AssemblyReadsTileCache
+//==============================================================================
+
+const qint64 AssemblyReadsTileCache::TILE_BASES = 2048;
+const qint64 AssemblyReadsTileCache::TILE_ROWS = 128;
+
+AssemblyReadsTileCache::AssemblyReadsTileCache(U2AssemblyDbi *assemblyDbi, const U2DataId &assemblyId)
+    : assemblyDbi(assemblyDbi), assemblyId(assemblyId), generation(0)
+{
+}
+
+QList<U2AssemblyRead> AssemblyReadsTileCache::getReads(const U2Region &region, qint64 minRow, qint64 maxRow, U2OpStatus &os) {
+    QList<U2AssemblyRead> result;
+    minRow = qMax(qint64(0), minRow);
+    CHECK(!region.isEmpty() && region.startPos >= 0 && minRow < maxRow, result);
+
+    const qint64 firstColumn = region.startPos / TILE_BASES;
+    const qint64 lastColumn = (region.endPos() - 1) / TILE_BASES;
+    const qint64 firstRow = minRow / TILE_ROWS;
+    const qint64 lastRow = (maxRow - 1) / TILE_ROWS;
+
+    for (qint64 row = firstRow; row <= lastRow; row++) {
+        for (qint64 column = firstColumn; column <= lastColumn; column++) {
+            const QList<U2AssemblyRead> tileReads = getTile(TileKey(column, row), os);
+            CHECK_OP(os, QList<U2AssemblyRead>());
+
+            const qint64 tileStart = column * TILE_BASES;
+            foreach (const U2AssemblyRead &read, tileReads) {
+                // the read is also stored in the left neighbour tile, it has been taken from there
+                if (column != firstColumn && read->leftmostPos < tileStart) {
+                    continue;
+                }
+                if (read->packedViewRow < minRow || read->packedViewRow >= maxRow) {
+                    continue;
+                }
+                if (!region.intersects(U2Region(read->leftmostPos, read->effectiveLen))) {
+                    continue;
+                }
+                result << read;
+            }
+        }
+    }
+    return result;
+}
+
+int AssemblyReadsTileCache::prefetch(const U2Region &region, qint64 minRow, qint64 maxRow, U2OpStatus &os) {
+    minRow = qMax(qint64(0), minRow);
+    CHECK(!region.isEmpty() && region.startPos >= 0 && minRow < maxRow, 0);
+
+    qint64 firstColumn = 0;
+    qint64 lastColumn = 0;
+    qint64 firstRow = 0;
+    qint64 lastRow = 0;
+    getPrefetchTiles(region, minRow, maxRow, firstColumn, lastColumn, firstRow, lastRow);
+
+    int loaded = 0;
+    for (qint64 row = firstRow; row <= lastRow; row++) {
+        for (qint64 column = firstColumn; column <= lastColumn; column++) {
+            CHECK(!os.isCanceled(), loaded);
+            const TileKey key(column, row);
+            if (hasTile(key)) {
+                continue;
+            }
+            getTile(key, os);
+            CHECK_OP(os, loaded);
+            loaded++;
+        }
+    }
+    return loaded;
+}
+
+bool AssemblyReadsTileCache::isPrefetched(const U2Region &region, qint64 minRow, qint64 maxRow) {
+    minRow = qMax(qint64(0), minRow);
+    CHECK(!region.isEmpty() && region.startPos >= 0 && minRow < maxRow, true);
+
+    qint64 firstColumn = 0;
+    qint64 lastColumn = 0;
+    qint64 firstRow = 0;
+    qint64 lastRow = 0;
+    getPrefetchTiles(region, minRow, maxRow, firstColumn, lastColumn, firstRow, lastRow);
+
+    QMutexLocker locker(&mutex);
+    for (qint64 row = firstRow; row <= lastRow; row++) {
+        for (qint64 column = firstColumn; column <= lastColumn; column++) {
+            if (!tiles.contains(TileKey(column, row))) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+void AssemblyReadsTileCache::getPrefetchTiles(const U2Region &region, qint64 minRow, qint64 maxRow,
+                                              qint64 &firstColumn, qint64 &lastColumn, qint64 &firstRow, qint64 &lastRow) {
+    // the visible tiles and one tile around them
+    firstColumn = qMax(qint64(0), region.startPos / TILE_BASES - 1);
+    lastColumn = (region.endPos() - 1) / TILE_BASES + 1;
+    firstRow = qMax(qint64(0), minRow / TILE_ROWS - 1);
+    lastRow = (maxRow - 1) / TILE_ROWS + 1;
+}
+
+void AssemblyReadsTileCache::clear() {
+    QMutexLocker locker(&mutex);
+    tiles.clear();
+    generation++;
+}
+
+void AssemblyReadsTileCache::setMemoryLimit(qint64 bytes) {
+    QMutexLocker locker(&mutex);
+    tiles.setMaxCost(int(qBound(qint64(1), bytes / 1024, qint64(INT_MAX))));
+}
+
+QList<U2AssemblyRead> AssemblyReadsTileCache::getTile(const TileKey &key, U2OpStatus &os) {
+    qint64 loadGeneration = 0;
+    {
+        QMutexLocker locker(&mutex);
+        QList<U2AssemblyRead> *tile = tiles.object(key);
+        if (NULL != tile) {
+            return *tile;
+        }
+        loadGeneration = generation;
+    }
+
+    // the database is queried without holding the lock: the UI thread must not wait for the prefetching
+    QList<U2AssemblyRead> reads = loadTile(key, os);
+    CHECK_OP(os, QList<U2AssemblyRead>());
+
+    QMutexLocker locker(&mutex);
+    // the reads may be changed after the loading has started
+    CHECK(loadGeneration == generation, reads);
+    tiles.insert(key, new QList<U2AssemblyRead>(reads), estimateCost(reads));
+    return reads;
+}
+
+bool AssemblyReadsTileCache::hasTile(const TileKey &key) {
+    QMutexLocker locker(&mutex);
+    return tiles.contains(key);
+}
+
+QList<U2AssemblyRead> AssemblyReadsTileCache::loadTile(const TileKey &key, U2OpStatus &os) {
+    SAFE_POINT_EXT(NULL != assemblyDbi, os.setError("Assembly dbi is NULL"), QList<U2AssemblyRead>());
+    const U2Region tileRegion(key.first * TILE_BASES, TILE_BASES);
+    const qint64 tileMinRow = key.second * TILE_ROWS;
+    QScopedPointer< U2DbiIterator<U2AssemblyRead> > it(assemblyDbi->getReadsByRow(assemblyId, tileRegion, tileMinRow, tileMinRow + TILE_ROWS, os));
+    CHECK_OP(os, QList<U2AssemblyRead>());
+    return U2DbiUtils::toList(it.data());
+}
+
+int AssemblyReadsTileCache::estimateCost(const QList<U2AssemblyRead> &reads) {
+    qint64 bytes = sizeof(QList<U2AssemblyRead>);
+    foreach (const U2AssemblyRead &read, reads) {
+        bytes += sizeof(U2AssemblyReadData) + read->id.size() + read->name.size() + read->readSequence.size()
+            + read->quality.size() + read->rnext.size() + read->cigar.size() * sizeof(U2CigarToken);
+        foreach (const U2AuxData &aux, read->aux) {
+            bytes += sizeof(U2AuxData) + aux.value.size();
+        }
+    }
+    return int(qMin(bytes / 1024 + 1, qint64(INT_MAX)));
+}
+
+//==============================================================================
+// AssemblyReadsPrefetchTask
+//==============================================================================
+
+AssemblyReadsPrefetchTask::AssemblyReadsPrefetchTask(const QSharedPointer<AssemblyModel> &model, const U2Region &visibleBases, const U2Region &visibleRows)
+    : BackgroundTask<int>(tr("Prefetch assembly reads"), TaskFlag_None), model(model), visibleBases(visibleBases), visibleRows(visibleRows)
+{
+    result = 0;
+}
+
+void AssemblyReadsPrefetchTask::run() {
+    result = model->prefetchReads(visibleBases, visibleRows.startPos, visibleRows.endPos(), stateInfo);
+}
+
+} // U2
@@ -0,0 +1,103 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef _U2_ASSEMBLY_READS_TILE_CACHE_H_
+#define _U2_ASSEMBLY_READS_TILE_CACHE_H_
+
+#include <QCache>
+#include <QMutex>
+#include <QPair>
+#include <QSharedPointer>
+
+#include <U2Core/BackgroundTaskRunner.h>
+#include <U2Core/U2Assembly.h>
+#include <U2Core/U2Region.h>
+
+namespace U2 {
+
+class AssemblyModel;
+class U2AssemblyDbi;
+class U2OpStatus;
+
+/**
+    Caches reads of an assembly in fixed-size 2D tiles (a range of bases x a range of packed rows).
+    Tiles are evicted in LRU order when the estimated memory of the cached reads exceeds the budget.
+    A read that crosses a tile border is stored in every tile it intersects.
+    The cache is thread safe: tiles can be prefetched from a background task while the UI reads them.
+*/
+class AssemblyReadsTileCache {
+public:
+    AssemblyReadsTileCache(U2AssemblyDbi *assemblyDbi, const U2DataId &assemblyId);
+
+    /** Returns the same reads as U2AssemblyDbi::getReadsByRow() does, loading missing tiles from the dbi */
+    QList<U2AssemblyRead> getReads(const U2Region &region, qint64 minRow, qint64 maxRow, U2OpStatus &os);
+
+    /** Loads the missing tiles that surround the given area. Returns the number of loaded tiles */
+    int prefetch(const U2Region &region, qint64 minRow, qint64 maxRow, U2OpStatus &os);
+
+    /** Returns true if all the tiles that 'prefetch' loads for the area are cached */
+    bool isPrefetched(const U2Region &region, qint64 minRow, qint64 maxRow);
+
+    void clear();
+
+    void setMemoryLimit(qint64 bytes);
+
+    static const qint64 TILE_BASES;
+    static const qint64 TILE_ROWS;
+
+private:
+    typedef QPair<qint64, qint64> TileKey;  // (column, row)
+
+    QList<U2AssemblyRead> getTile(const TileKey &key, U2OpStatus &os);
+    bool hasTile(const TileKey &key);
+    static void getPrefetchTiles(const U2Region &region, qint64 minRow, qint64 maxRow,
+                                 qint64 &firstColumn, qint64 &lastColumn, qint64 &firstRow, qint64 &lastRow);
+    QList<U2AssemblyRead> loadTile(const TileKey &key, U2OpStatus &os);
+
+    static int estimateCost(const QList<U2AssemblyRead> &reads);
+
+    U2AssemblyDbi *assemblyDbi;
+    U2DataId assemblyId;
+    // cost is measured in kilobytes
+    QCache<TileKey, QList<U2AssemblyRead> > tiles;
+    // incremented by 'clear': a tile loaded before the clearing is not cached
+    qint64 generation;
+    QMutex mutex;
+};
+
+/**
+    A background task for AssemblyReadsArea: loads tiles around the visible area into the model's reads cache
+*/
+class AssemblyReadsPrefetchTask : public BackgroundTask<int> {
+    Q_OBJECT
+public:
+    AssemblyReadsPrefetchTask(const QSharedPointer<AssemblyModel> &model, const U2Region &visibleBases, const U2Region &visibleRows);
+    void run();
+
+private:
+    QSharedPointer<AssemblyModel> model;
+    U2Region visibleBases;
+    U2Region visibleRows;
+};
+
+} // U2
+
+#endif // _U2_ASSEMBLY_READS_TILE_CACHE_H_
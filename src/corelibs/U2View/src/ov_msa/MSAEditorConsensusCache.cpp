@@ -24,19 +24,22 @@
 
 #include <U2Algorithm/MSAConsensusAlgorithm.h>
 
+#include <U2Core/MaModificationInfo.h>
 #include <U2Core/MultipleAlignmentObject.h>
 #include <U2Core/MultipleChromatogramAlignmentObject.h>
 #include <U2Core/U2SafePoints.h>
 
 namespace U2 {
 
+const int MSAEditorConsensusCache::MAX_UPDATE_RUN_LENGTH = 256;
+
 MSAEditorConsensusCache::MSAEditorConsensusCache(QObject* p, MultipleAlignmentObject* o, MSAConsensusAlgorithmFactory* factory)
 : QObject(p), curCacheSize(0), aliObj(o), algorithm(NULL)
 {
     setConsensusAlgorithm(factory);
 
     connect(aliObj, SIGNAL(si_alignmentChanged(const MultipleAlignment&, const MaModificationInfo&)),
-        SLOT(sl_alignmentChanged()));
+        SLOT(sl_alignmentChanged(const MultipleAlignment&, const MaModificationInfo&)));
     connect(aliObj, SIGNAL(si_invalidateAlignmentObject()), SLOT(sl_invalidateAlignmentObject()));
 
     curCacheSize = aliObj->getLength();
@@ -68,15 +71,30 @@ QByteArray MSAEditorConsensusCache::getConsensusLine(const U2Region &region, boo
     return res;
 }
 
-void MSAEditorConsensusCache::sl_alignmentChanged() {
-    if(curCacheSize != aliObj->getLength()) {
+void MSAEditorConsensusCache::sl_alignmentChanged(const MultipleAlignment&, const MaModificationInfo& modInfo) {
+    const bool cacheResized = curCacheSize != aliObj->getLength();
+    if (cacheResized) {
         curCacheSize = aliObj->getLength();
         updateMap.resize(curCacheSize);
         cache.resize(aliObj->getLength());
 
         emit si_cacheResized(curCacheSize);
     }
-    updateMap.fill(false);
+
+    // the listeners of si_cacheResized reset their values, so all the columns are emitted again after the resize
+    if (cacheResized || modInfo.modifiedColumns.isEmpty() || modInfo.alphabetChanged) {
+        updateMap.fill(false);
+        return;
+    }
+
+    // only the modified columns are recomputed, the rest of the cache stays valid
+    const U2Region cacheRegion(0, curCacheSize);
+    foreach (const U2Region& columns, modInfo.modifiedColumns) {
+        const U2Region outdatedColumns = columns.intersect(cacheRegion);
+        if (!outdatedColumns.isEmpty()) {
+            updateMap.fill(false, static_cast<int>(outdatedColumns.startPos), static_cast<int>(outdatedColumns.endPos()));
+        }
+    }
 }
 
 void MSAEditorConsensusCache::updateCacheItem(int pos) {
@@ -87,17 +105,27 @@ void MSAEditorConsensusCache::updateCacheItem(int pos) {
         SAFE_POINT(pos >= 0 && pos < curCacheSize, errorMessage,);
         SAFE_POINT(curCacheSize == ma->getLength(), errorMessage,);
 
-        CacheItem& ci = cache[pos];
-        int count = 0;
         int nSeq = ma->getNumRows();
         SAFE_POINT(0 != nSeq, errorMessage,);
 
-        ci.topChar = algorithm->getConsensusCharAndScore(ma, pos, count);
-        ci.topPercent = (char)qRound(count * 100. / nSeq);
-        assert(ci.topPercent >=0 && ci.topPercent<=100);
-        updateMap.setBit(pos, true);
+        // the neighbour columns are usually requested next: compute the whole run of outdated columns at once
+        int runEnd = pos + 1;
+        while (runEnd < curCacheSize && runEnd - pos < MAX_UPDATE_RUN_LENGTH && !updateMap.at(runEnd)) {
+            runEnd++;
+        }
 
-        emit si_cachedItemUpdated(pos, ci.topChar);
+        QByteArray chars;
+        QVector<int> counts;
+        algorithm->getConsensusCharsAndScores(ma, U2Region(pos, runEnd - pos), chars, counts);
+        for (int column = pos; column < runEnd; column++) {
+            CacheItem& ci = cache[column];
+            ci.topChar = chars[column - pos];
+            ci.topPercent = (char)qRound(counts[column - pos] * 100. / nSeq);
+            assert(ci.topPercent >=0 && ci.topPercent<=100);
+            updateMap.setBit(column, true);
+
+            emit si_cachedItemUpdated(column, ci.topChar);
+        }
     }
 }
 
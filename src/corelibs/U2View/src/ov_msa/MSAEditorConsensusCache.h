@@ -66,7 +66,7 @@ signals:
     void si_cacheResized(int newSize);
 
 private slots:
-    void sl_alignmentChanged();
+    void sl_alignmentChanged(const MultipleAlignment& maBefore, const MaModificationInfo& modInfo);
     void sl_thresholdChanged(int newValue);
     void sl_invalidateAlignmentObject();
 
@@ -79,6 +79,9 @@ private:
 
     void updateCacheItem(int pos);
 
+    // max number of columns that are computed by one updateCacheItem() call
+    static const int MAX_UPDATE_RUN_LENGTH;
+
     int                         curCacheSize;
     QVector<CacheItem>          cache;
     QBitArray                   updateMap;
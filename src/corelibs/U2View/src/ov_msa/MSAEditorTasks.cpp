@@ -338,21 +338,25 @@ void ExtractConsensusTask::run() {
 
     MSAConsensusAlgorithm *algorithm = ma->getUI()->getConsensusArea()->getConsensusAlgorithm();
     const MultipleAlignment alignment = ma->getMaObject()->getMultipleAlignmentCopy();
-    for (int i = 0, n = alignment->getLength(); i < n; i++) {
+    SAFE_POINT(0 != alignment->getNumRows(), tr("No sequences in alignment"), );
+
+    static const int COLUMNS_CHUNK_SIZE = 4096;
+    QByteArray chars;
+    QVector<int> counts;
+    for (qint64 chunkStart = 0, n = alignment->getLength(); chunkStart < n; chunkStart += COLUMNS_CHUNK_SIZE) {
         if (stateInfo.isCoR()) {
             return;
         }
-        int count = 0;
-        int nSeq = alignment->getNumRows();
-        SAFE_POINT(0 != nSeq, tr("No sequences in alignment"), );
-
-        QChar c = algorithm->getConsensusCharAndScore(alignment, i, count);
-        if (c == MSAConsensusAlgorithm::INVALID_CONS_CHAR) {
-            c = U2Msa::GAP_CHAR;
-        }
-        if (c != U2Msa::GAP_CHAR || keepGaps) {
-            filteredConsensus.append(c);
+        algorithm->getConsensusCharsAndScores(alignment, U2Region(chunkStart, qMin(qint64(COLUMNS_CHUNK_SIZE), n - chunkStart)), chars, counts);
+        foreach (char c, chars) {
+            if (c == MSAConsensusAlgorithm::INVALID_CONS_CHAR) {
+                c = U2Msa::GAP_CHAR;
+            }
+            if (c != U2Msa::GAP_CHAR || keepGaps) {
+                filteredConsensus.append(c);
+            }
         }
+        stateInfo.setProgress(int(100 * (chunkStart + chars.size()) / n));
     }
 }
 
@@ -129,13 +129,12 @@ ConsensusRenderData MaConsensusAreaRenderer::getConsensusRenderData(const QList<
 
     MSAConsensusAlgorithm *algorithm = area->getConsensusAlgorithm();
     const MultipleAlignment ma = editor->getMaObject()->getMultipleAlignment();
+    QVector<int> scores;
+    algorithm->getConsensusCharsAndScores(ma, region, consensusRenderData.data, scores);
     for (int i = 0, n = static_cast<int>(region.length); i < n; i++) {
         const int column = region.startPos + i;
-        int score = 0;
-        const char consensusChar = algorithm->getConsensusCharAndScore(ma, column, score);
-        consensusRenderData.data += consensusChar;
-        consensusRenderData.percentage << qRound(score * 100. / seqIdx.size());
-        consensusRenderData.mismatches[i] = (consensusChar != editor->getReferenceCharAt(column));
+        consensusRenderData.percentage << qRound(scores[i] * 100. / seqIdx.size());
+        consensusRenderData.mismatches[i] = (consensusRenderData.data[i] != editor->getReferenceCharAt(column));
     }
 
     return consensusRenderData;
@@ -56,6 +56,94 @@ const QByteArray & GSequenceGraphAlgorithm::getSequenceData(U2SequenceObject *se
     return lastSeqData;
 }
 
+const int GSequenceGraphMinMaxSummary::BLOCK_SIZE = 16;
+
+GSequenceGraphMinMaxSummary::GSequenceGraphMinMaxSummary(const QVector<float>& _values)
+    : values(_values)
+{
+    int levelSize = values.size() / BLOCK_SIZE; // only the complete blocks are summarized
+    CHECK(levelSize > 0, );
+
+    QVector<float> mins(levelSize);
+    QVector<float> maxs(levelSize);
+    const float* v = values.constData();
+    for (int i = 0; i < levelSize; i++) {
+        const float* block = v + i * BLOCK_SIZE;
+        float min = block[0];
+        float max = block[0];
+        for (int j = 1; j < BLOCK_SIZE; j++) {
+            min = qMin(min, block[j]);
+            max = qMax(max, block[j]);
+        }
+        mins[i] = min;
+        maxs[i] = max;
+    }
+    minLevels.append(mins);
+    maxLevels.append(maxs);
+
+    while (levelSize > 1) {
+        const QVector<float>& prevMins = minLevels.last();
+        const QVector<float>& prevMaxs = maxLevels.last();
+        int prevSize = levelSize;
+        levelSize = (levelSize + 1) / 2;
+        QVector<float> nextMins(levelSize);
+        QVector<float> nextMaxs(levelSize);
+        for (int i = 0; i < levelSize; i++) {
+            int second = qMin(2 * i + 1, prevSize - 1);
+            nextMins[i] = qMin(prevMins[2 * i], prevMins[second]);
+            nextMaxs[i] = qMax(prevMaxs[2 * i], prevMaxs[second]);
+        }
+        minLevels.append(nextMins);
+        maxLevels.append(nextMaxs);
+    }
+}
+
+void GSequenceGraphMinMaxSummary::getMinMax(int first, int last, float& min, float& max) const {
+    SAFE_POINT(0 <= first && first < last && last <= values.size(), "Incorrect graph values range", );
+    const float* v = values.constData();
+    min = max = v[first];
+
+    int firstBlock = (first + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    int lastBlock = last / BLOCK_SIZE;
+    if (firstBlock >= lastBlock) {
+        for (int i = first + 1; i < last; i++) {
+            min = qMin(min, v[i]);
+            max = qMax(max, v[i]);
+        }
+        return;
+    }
+
+    // the values out of the complete blocks
+    for (int i = first + 1, n = firstBlock * BLOCK_SIZE; i < n; i++) {
+        min = qMin(min, v[i]);
+        max = qMax(max, v[i]);
+    }
+    for (int i = lastBlock * BLOCK_SIZE; i < last; i++) {
+        min = qMin(min, v[i]);
+        max = qMax(max, v[i]);
+    }
+
+    // the blocks: on every level at most one block is taken from each side of the range
+    for (int level = 0; firstBlock < lastBlock; level++) {
+        const float* mins = minLevels[level].constData();
+        const float* maxs = maxLevels[level].constData();
+        if (firstBlock & 1) {
+            min = qMin(min, mins[firstBlock]);
+            max = qMax(max, maxs[firstBlock]);
+            firstBlock++;
+        }
+        if (lastBlock & 1) {
+            lastBlock--;
+            min = qMin(min, mins[lastBlock]);
+            max = qMax(max, maxs[lastBlock]);
+        }
+        firstBlock /= 2;
+        lastBlock /= 2;
+    }
+}
+
+const int GSequenceGraphData::SUMMARY_CACHE_SIZE = 2;
+
 GSequenceGraphData::GSequenceGraphData(const QString& _graphName) : graphName(_graphName), ga(NULL)
 {
     cachedFrom = cachedLen = cachedW = cachedS = 0;
@@ -65,6 +153,33 @@ GSequenceGraphData::~GSequenceGraphData() {
     delete ga;
 }
 
+QSharedPointer<GSequenceGraphMinMaxSummary> GSequenceGraphData::getSummary(qint64 seqLen, const GSequenceGraphWindowData& wd) {
+    QMutexLocker locker(&summaryCacheMutex);
+    for (int i = 0; i < summaryCache.size(); i++) {
+        const SummaryCacheItem& item = summaryCache[i];
+        if (item.seqLen == seqLen && item.window == wd.window && item.step == wd.step) {
+            summaryCache.move(i, 0);
+            return summaryCache.first().summary;
+        }
+    }
+    return QSharedPointer<GSequenceGraphMinMaxSummary>();
+}
+
+QSharedPointer<GSequenceGraphMinMaxSummary> GSequenceGraphData::addSummary(qint64 seqLen, const GSequenceGraphWindowData& wd, const QVector<float>& values) {
+    SummaryCacheItem item;
+    item.seqLen = seqLen;
+    item.window = wd.window;
+    item.step = wd.step;
+    item.summary = QSharedPointer<GSequenceGraphMinMaxSummary>(new GSequenceGraphMinMaxSummary(values));
+
+    QMutexLocker locker(&summaryCacheMutex);
+    summaryCache.prepend(item);
+    while (summaryCache.size() > SUMMARY_CACHE_SIZE) {
+        summaryCache.removeLast();
+    }
+    return item.summary;
+}
+
 void GSequenceGraphUtils::calculateMinMax(const QVector<float>& data, float& min, float& max, U2OpStatus &os)  {
     assert(data.size() > 0);
     min = max = data.first();
@@ -918,10 +1033,17 @@ GraphPointsUpdater::GraphPointsUpdater(const QSharedPointer<GSequenceGraphData>&
 void GraphPointsUpdater::recalculateGraphData() {
     CHECK(!o.isNull(),);
 
-    QVector<float> newCutoff;
-    int lastAligned = o->getSequenceLength() - o->getSequenceLength() % wdata.step;
-    U2Region r = U2Region(0, lastAligned);
-    d->ga->calculate(result.allCutoffPoints, o, r, &wdata, os);
+    qint64 seqLen = o->getSequenceLength();
+    summary = d->getSummary(seqLen, wdata);
+    if (summary.isNull()) {
+        QVector<float> values;
+        int lastAligned = seqLen - seqLen % wdata.step;
+        U2Region r = U2Region(0, lastAligned);
+        d->ga->calculate(values, o, r, &wdata, os);
+        CHECK_OP(os, );
+        summary = d->addSummary(seqLen, wdata, values);
+    }
+    result.allCutoffPoints = summary->getValues();
 
     updateGraphData();
 }
@@ -929,8 +1051,14 @@ void GraphPointsUpdater::recalculateGraphData() {
 void GraphPointsUpdater::updateGraphData() {
     setChahedDataParametrs();
 
+    if (summary.isNull() && !o.isNull()) {
+        summary = d->getSummary(o->getSequenceLength(), wdata);
+    }
     if (result.allCutoffPoints.isEmpty()) {
-        result.allCutoffPoints = d->cachedData.allCutoffPoints;
+        result.allCutoffPoints = summary.isNull() ? d->cachedData.allCutoffPoints : summary->getValues();
+    }
+    if (summary.isNull() && !o.isNull() && !result.allCutoffPoints.isEmpty()) {
+        summary = d->addSummary(o->getSequenceLength(), wdata, result.allCutoffPoints);
     }
     calculateCutoffPoints();
     CHECK_OP(os, );
@@ -956,23 +1084,25 @@ void GraphPointsUpdater::calculateWithFit() {
     int nPoints = result.firstPoints.size();
     float basesPerPoint = (alignedLast - alignedFirst) / float(nPoints);
     CHECK(int(basesPerPoint) >= wdata.step, ); //ensure that every point is associated with some step data
-    QVector<float> pointData;
+    CHECK(!summary.isNull(), );
     qint64 len = qMax(qint64(basesPerPoint), wdata.window);
 
     int lastBase = alignedLast + wdata.window;
+    int nValues = summary->getValues().size();
 
     for (int i = 0; i < nPoints; i++) {
-        pointData.clear();
         qint64 startPos = alignedFirst + qint64(i * basesPerPoint);
         qint64 endPos = startPos + len;
         CHECK(endPos <= lastBase, );
+        CHECK_OP(os, );
 
-        pointData = GraphPointsUpdater::getCutoffRegion(startPos, endPos - wdata.window);
+        // the same values as GraphPointsUpdater::getCutoffRegion(startPos, endPos - wdata.window) returns
+        int firstValueIndex = startPos / wdata.step;
+        int lastValueIndex = qMin((endPos - wdata.window) / wdata.step + 1, (qint64)nValues);
+        CHECK_CONTINUE(firstValueIndex < lastValueIndex);
 
-        CHECK_OP(os, );
         float min, max;
-        GSequenceGraphUtils::calculateMinMax(pointData, min, max, os);
-        CHECK_OP(os, );
+        summary->getMinMax(firstValueIndex, lastValueIndex, min, max);
 
         result.firstPoints[i] = max; //BUG:422: support interval based graph!!!
         result.secondPoints[i] = min;
@@ -26,9 +26,11 @@
 #include <U2Core/U2Region.h>
 #include <U2Core/BackgroundTaskRunner.h>
 
+#include <QMutex>
 #include <QVector>
 #include <QPixmap>
 #include <QPointer>
+#include <QSharedPointer>
 
 #include "GraphLabelModel.h"
 
@@ -157,11 +159,39 @@ protected:
 };
 
 
+/**
+ * Graph values of all the steps of a sequence together with a multi-resolution min/max summary:
+ * the first level keeps extremes of blocks of BLOCK_SIZE values, every next level
+ * keeps extremes of pairs of blocks of the previous one.
+ * So the extremes of any range of steps are found in O(log(n)) and the fitted graph
+ * is drawn in time proportional to the number of its points, whatever the zoom is.
+ */
+class U2VIEW_EXPORT GSequenceGraphMinMaxSummary {
+public:
+    GSequenceGraphMinMaxSummary(const QVector<float>& values);
+
+    const QVector<float>& getValues() const {return values;}
+
+    // finds min and max of the values with indexes in [first, last)
+    void getMinMax(int first, int last, float& min, float& max) const;
+
+private:
+    QVector<float> values;
+    QVector< QVector<float> > minLevels;
+    QVector< QVector<float> > maxLevels;
+
+    static const int BLOCK_SIZE;
+};
+
 class U2VIEW_EXPORT GSequenceGraphData {
 public:
     GSequenceGraphData(const QString& _graphName);
     virtual ~GSequenceGraphData();
 
+    // returns NULL if the values are not calculated for these sequence length and window data yet
+    QSharedPointer<GSequenceGraphMinMaxSummary> getSummary(qint64 seqLen, const GSequenceGraphWindowData& wd);
+    QSharedPointer<GSequenceGraphMinMaxSummary> addSummary(qint64 seqLen, const GSequenceGraphWindowData& wd, const QVector<float>& values);
+
     QString                     graphName;
     GSequenceGraphAlgorithm*    ga;
 
@@ -170,6 +200,19 @@ public:
     PairVector                  cachedData;
 
     MultiLabel                  graphLabels;
+
+private:
+    struct SummaryCacheItem {
+        qint64 seqLen;
+        qint64 window;
+        qint64 step;
+        QSharedPointer<GSequenceGraphMinMaxSummary> summary;
+    };
+    // the recently used window data go first
+    QList<SummaryCacheItem>     summaryCache;
+    QMutex                      summaryCacheMutex;
+
+    static const int SUMMARY_CACHE_SIZE;
 };
 
 
@@ -207,6 +250,7 @@ private:
     void setChahedDataParametrs();
 
     QSharedPointer<GSequenceGraphData> d;
+    QSharedPointer<GSequenceGraphMinMaxSummary> summary;
     PairVector result;
     int alignedFirst;
     int alignedLast;
@@ -24,6 +24,7 @@
 #include <QMovie>
 #include <QMessageBox>
 
+#include <U2Algorithm/ByteRegExp.h>
 #include <U2Algorithm/FindAlgorithmTask.h>
 
 #include <U2Core/AnnotationTableObject.h>
@@ -908,7 +909,7 @@ void FindPatternWidget::verifyPatternAlphabet()
     }
 
     if(selectedAlgorithm == FindAlgorithmPatternSettings_RegExp){
-        QRegExp regExp(textPattern->toPlainText());
+        ByteRegExp regExp(textPattern->toPlainText().toLatin1());
         if(regExp.isValid()){
             showHideMessage(false, PatternWrongRegExp);
         }else{
@@ -1114,7 +1115,7 @@ void FindPatternWidget::initFindPatternTask(const QList<NamePattern> &patterns)
     CHECK(!patterns.isEmpty(), );
 
     if (selectedAlgorithm == FindAlgorithmPatternSettings_RegExp) {
-        QRegExp regExp(textPattern->toPlainText());
+        ByteRegExp regExp(textPattern->toPlainText().toLatin1());
         CHECK(regExp.isValid(), );
     }
     ADVSequenceObjectContext* activeContext = annotatedDnaView->getSequenceInFocus();
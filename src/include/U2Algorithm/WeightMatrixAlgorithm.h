@@ -0,0 +1 @@
+#include "../../corelibs/U2Algorithm/src/util_weight_matrix/WeightMatrixAlgorithm.h"
@@ -0,0 +1 @@
+#include "../../corelibs/U2Core/src/io/MappedFileAdapter.h"
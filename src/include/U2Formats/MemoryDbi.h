@@ -0,0 +1 @@
+#include "../../corelibs/U2Formats/src/memory_dbi/MemoryDbi.h"
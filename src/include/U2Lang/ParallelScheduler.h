@@ -0,0 +1 @@
+#include "../../corelibs/U2Lang/src/library/ParallelScheduler.h"
@@ -5,6 +5,14 @@ HEADERS += \
     src/ApiTestsPlugin.h \
     src/unittest.h \
     src/UnitTestSuite.h \
+    src/algorithm/BinaryFindUnitTests.h \
+    src/algorithm/ByteRegExpUnitTests.h \
+    src/algorithm/FindAlgorithmUnitTests.h \
+    src/algorithm/FindEnzymesAlgorithmUnitTests.h \
+    src/algorithm/ORFFinderUnitTests.h \
+    src/algorithm/PrimerSeedIndexUnitTests.h \
+    src/algorithm/SyncSortUnitTests.h \
+    src/algorithm/WeightMatrixScannerUnitTests.h \
     src/core/datatype/annotations/AnnotationGroupUnitTests.h \
     src/core/datatype/annotations/AnnotationUnitTests.h \
     src/core/datatype/msa/MsaRowUnitTests.h \
@@ -22,6 +30,9 @@ HEADERS += \
     src/core/external_script/base_scheme_interface/CInterfaceManualTests.h \
     src/core/external_script/base_scheme_interface/CInterfaceSasTests.h \
     src/core/external_script/base_scheme_interface/SchemeSimilarityUtils.h \
+    src/core/format/fasta/FastaIndexUnitTests.h \
+    src/core/format/fasta/IndexedFastaDbiUnitTests.h \
+    src/core/format/fastq/FastqRecordReaderUnitTests.h \
     src/core/format/fastq/FastqUnitTests.h \
     src/core/format/genbank/LocationParserUnitTests.h \
     src/core/format/sqlite_mod_dbi/ModDbiSQLiteSpecificUnitTests.h \
@@ -34,6 +45,7 @@ HEADERS += \
     src/core/gobjects/MsaObjectUnitTests.h \
     src/core/gobjects/PhyTreeObjectUnitTests.h \
     src/core/gobjects/TextObjectUnitTests.h \
+    src/core/io/ZlibAdapterUnitTests.h \
     src/core/util/DatatypeSerializeUtilsUnitTest.h \
     src/core/util/MsaDbiUtilsUnitTests.h \
     src/core/util/MsaImporterExporterUnitTests.h \
@@ -42,6 +54,14 @@ HEADERS += \
 SOURCES += \
     src/ApiTestsPlugin.cpp \
     src/UnitTestSuite.cpp \
+    src/algorithm/BinaryFindUnitTests.cpp \
+    src/algorithm/ByteRegExpUnitTests.cpp \
+    src/algorithm/FindAlgorithmUnitTests.cpp \
+    src/algorithm/FindEnzymesAlgorithmUnitTests.cpp \
+    src/algorithm/ORFFinderUnitTests.cpp \
+    src/algorithm/PrimerSeedIndexUnitTests.cpp \
+    src/algorithm/SyncSortUnitTests.cpp \
+    src/algorithm/WeightMatrixScannerUnitTests.cpp \
     src/core/datatype/annotations/AnnotationGroupUnitTests.cpp \
     src/core/datatype/annotations/AnnotationUnitTests.cpp \
     src/core/datatype/msa/MsaRowUnitTests.cpp \
@@ -59,6 +79,9 @@ SOURCES += \
     src/core/external_script/base_scheme_interface/CInterfaceManualTests.cpp \
     src/core/external_script/base_scheme_interface/CInterfaceSasTests.cpp \
     src/core/external_script/base_scheme_interface/SchemeSimilarityUtils.cpp \
+    src/core/format/fasta/FastaIndexUnitTests.cpp \
+    src/core/format/fasta/IndexedFastaDbiUnitTests.cpp \
+    src/core/format/fastq/FastqRecordReaderUnitTests.cpp \
     src/core/format/fastq/FastqUnitTests.cpp \
     src/core/format/genbank/LocationParserUnitTests.cpp \
     src/core/format/sqlite_mod_dbi/ModDbiSQLiteSpecificUnitTests.cpp \
@@ -71,6 +94,7 @@ SOURCES += \
     src/core/gobjects/MsaObjectUnitTests.cpp \
     src/core/gobjects/PhyTreeObjectUnitTests.cpp \
     src/core/gobjects/TextObjectUnitTests.cpp \
+    src/core/io/ZlibAdapterUnitTests.cpp \
     src/core/util/DatatypeSerializeUtilsUnitTest.cpp \
     src/core/util/MsaDbiUtilsUnitTests.cpp \
     src/core/util/MsaImporterExporterUnitTests.cpp \
@@ -0,0 +1,115 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include <QtAlgorithms>
+
+#include <U2Algorithm/BinaryFind.h>
+
+#include <U2Core/U2SafePoints.h>
+
+#include "BinaryFindUnitTests.h"
+
+namespace U2 {
+
+static quint64 nextRandom(quint64 &state) {
+    state = state * Q_UINT64_C(6364136223846793005) + Q_UINT64_C(1442695040888963407);
+    return state >> 2;
+}
+
+QVector<quint64> BinaryFindTestUtils::getSortedValues(int size, uint seed) {
+    QVector<quint64> values(size);
+    quint64 state = seed;
+    for (int i = 0; i < size; i++) {
+        // the values differ in the last characters only sometimes, so the filtered values repeat
+        values[i] = nextRandom(state) & ~(quint64(0xFFFF) << (nextRandom(state) % 2 == 0 ? 0 : 16));
+    }
+    qSort(values);
+    return values;
+}
+
+void BinaryFindTestUtils::getNeedles(const QVector<quint64> &haystack, int size, uint seed, QVector<quint64> &needles, QVector<quint64> &filters) {
+    needles.resize(size);
+    filters.resize(size);
+    quint64 state = seed;
+    for (int i = 0; i < size; i++) {
+        const bool present = !haystack.isEmpty() && nextRandom(state) % 2 == 0;
+        needles[i] = present ? haystack[nextRandom(state) % haystack.size()] : nextRandom(state);
+        const int w = 1 + nextRandom(state) % 31;
+        filters[i] = (quint64(0) - 1) << (62 - w * 2);
+    }
+    if (size > 1) {
+        needles[0] = 0;
+        needles[size - 1] = Q_UINT64_C(0x3FFFFFFFFFFFFFFF);
+    }
+}
+
+qint64 BinaryFindTestUtils::findLinear(const QVector<quint64> &haystack, quint64 needle, quint64 filter) {
+    for (int i = 0; i < haystack.size(); i++) {
+        CHECK_CONTINUE((haystack[i] & filter) == (needle & filter));
+        return i;
+    }
+    return -1;
+}
+
+IMPLEMENT_TEST(BinaryFindUnitTests, find_singleNeedle) {
+    const QVector<quint64> haystack = BinaryFindTestUtils::getSortedValues(10000, 1);
+    QVector<quint64> needles;
+    QVector<quint64> filters;
+    BinaryFindTestUtils::getNeedles(haystack, 2000, 2, needles, filters);
+
+    int found = 0;
+    for (int i = 0; i < needles.size(); i++) {
+        const qint64 expected = BinaryFindTestUtils::findLinear(haystack, needles[i], filters[i]);
+        CHECK_EQUAL(expected, BinaryFind::find(haystack.constData(), haystack.size(), needles[i], filters[i]), QString("result %1").arg(i));
+        found += (-1 == expected) ? 0 : 1;
+    }
+    CHECK_TRUE(found > 0 && found < needles.size(), "the needles are all found or all not found");
+}
+
+IMPLEMENT_TEST(BinaryFindUnitTests, find_batch) {
+    const QVector<quint64> haystack = BinaryFindTestUtils::getSortedValues(10000, 3);
+    QVector<quint64> needles;
+    QVector<quint64> filters;
+    // not a multiple of the batch group size
+    BinaryFindTestUtils::getNeedles(haystack, 2003, 4, needles, filters);
+
+    QVector<qint64> results(needles.size(), -2);
+    BinaryFind::find(haystack.constData(), haystack.size(), needles.constData(), filters.constData(), needles.size(), results.data());
+    for (int i = 0; i < needles.size(); i++) {
+        CHECK_EQUAL(BinaryFind::find(haystack.constData(), haystack.size(), needles[i], filters[i]), results[i], QString("result %1").arg(i));
+    }
+}
+
+IMPLEMENT_TEST(BinaryFindUnitTests, find_emptyHaystack) {
+    const QVector<quint64> haystack;
+    QVector<quint64> needles;
+    QVector<quint64> filters;
+    BinaryFindTestUtils::getNeedles(haystack, 20, 5, needles, filters);
+
+    QVector<qint64> results(needles.size(), -2);
+    BinaryFind::find(haystack.constData(), 0, needles.constData(), filters.constData(), needles.size(), results.data());
+    for (int i = 0; i < needles.size(); i++) {
+        CHECK_EQUAL(-1, BinaryFind::find(haystack.constData(), 0, needles[i], filters[i]), QString("single result %1").arg(i));
+        CHECK_EQUAL(-1, results[i], QString("batch result %1").arg(i));
+    }
+}
+
+} // U2
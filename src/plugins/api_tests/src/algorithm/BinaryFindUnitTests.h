@@ -0,0 +1,54 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef _U2_BINARY_FIND_UNIT_TESTS_H_
+#define _U2_BINARY_FIND_UNIT_TESTS_H_
+
+#include <QVector>
+
+#include <unittest.h>
+
+namespace U2 {
+
+class BinaryFindTestUtils {
+public:
+    // sorted 62-bit values with repeats, like the bit masks of a genome aligner index part
+    static QVector<quint64> getSortedValues(int size, uint seed);
+    // the needles that are found and the ones that are not, and the filters of 1 to 31 first characters
+    static void getNeedles(const QVector<quint64> &haystack, int size, uint seed, QVector<quint64> &needles, QVector<quint64> &filters);
+    // returns the index of the first element equal to the needle under the filter or -1
+    static qint64 findLinear(const QVector<quint64> &haystack, quint64 needle, quint64 filter);
+};
+
+/* The single needle search finds the first equal element */
+DECLARE_TEST(BinaryFindUnitTests, find_singleNeedle);
+/* The batch search gives the same results as the single needle search */
+DECLARE_TEST(BinaryFindUnitTests, find_batch);
+/* Nothing is found in an empty array */
+DECLARE_TEST(BinaryFindUnitTests, find_emptyHaystack);
+
+} // U2
+
+DECLARE_METATYPE(BinaryFindUnitTests, find_singleNeedle);
+DECLARE_METATYPE(BinaryFindUnitTests, find_batch);
+DECLARE_METATYPE(BinaryFindUnitTests, find_emptyHaystack);
+
+#endif // _U2_BINARY_FIND_UNIT_TESTS_H_
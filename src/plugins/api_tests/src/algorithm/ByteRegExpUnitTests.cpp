@@ -0,0 +1,139 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include <QRegExp>
+#include <QStringList>
+
+#include "ByteRegExpUnitTests.h"
+
+namespace U2 {
+
+namespace {
+
+const QByteArray TEXT = "ACGTNacgt-19 _\tXY{}";
+
+}
+
+bool ByteRegExpTestUtils::exactMatch(ByteRegExp &regExp, const QByteArray &text) {
+    int state = regExp.getStartState();
+    for (int i = 0; i < text.length() && !ByteRegExp::isDead(state); i++) {
+        state = regExp.next(state, text.at(i));
+    }
+    return regExp.isAccepting(state);
+}
+
+QString ByteRegExpTestUtils::compareWithQRegExp(const QByteArray &pattern, const QByteArray &text) {
+    ByteRegExp regExp(pattern);
+    CHECK(regExp.isValid(), QString("'%1' is not valid: %2").arg(QString(pattern)).arg(regExp.getError()));
+    QRegExp qRegExp(QString::fromLatin1(pattern));
+    CHECK(qRegExp.isValid(), QString("'%1' is not valid for QRegExp").arg(QString(pattern)));
+
+    for (int start = 0; start <= text.length(); start++) {
+        for (int length = 0; start + length <= text.length(); length++) {
+            const QByteArray part = text.mid(start, length);
+            const bool expected = qRegExp.exactMatch(QString::fromLatin1(part));
+            CHECK(expected == exactMatch(regExp, part),
+                  QString("'%1' %2 '%3'").arg(QString(pattern)).arg(expected ? "doesn't match" : "unexpectedly matches").arg(QString(part)));
+        }
+    }
+    return QString();
+}
+
+IMPLEMENT_TEST(ByteRegExpUnitTests, sets) {
+    QStringList patterns;
+    patterns << "ACG" << "A.G" << "..." << "[AC]G" << "[^AC]" << "[A-Z]" << "[a-cX-Y]"
+             << "[-1]" << "\\." << "\\[";
+    foreach (const QString &pattern, patterns) {
+        const QString error = ByteRegExpTestUtils::compareWithQRegExp(pattern.toLatin1(), TEXT);
+        CHECK_TRUE(error.isEmpty(), error);
+    }
+}
+
+IMPLEMENT_TEST(ByteRegExpUnitTests, escapes) {
+    QStringList patterns;
+    patterns << "\\d" << "\\D" << "\\s" << "\\S" << "\\w" << "\\W" << "\\t" << "\\x41" << "[\\d\\s]"
+             << "[^\\w]" << "\\{\\}" << "\\-\\d";
+    foreach (const QString &pattern, patterns) {
+        const QString error = ByteRegExpTestUtils::compareWithQRegExp(pattern.toLatin1(), TEXT);
+        CHECK_TRUE(error.isEmpty(), error);
+    }
+}
+
+IMPLEMENT_TEST(ByteRegExpUnitTests, quantifiers) {
+    QStringList patterns;
+    patterns << "A*" << "[A-Z]+" << "A?C" << "\\d{2}" << "[a-z]{1,}" << "[a-z]{2,3}" << "[A-Z]{,2}"
+             << "(AC|GT)+" << "(?:AC)*G" << "A|C|-" << "((A|C)G?)*T" << "(.)*" << "\\w+\\s*\\W?";
+    foreach (const QString &pattern, patterns) {
+        const QString error = ByteRegExpTestUtils::compareWithQRegExp(pattern.toLatin1(), TEXT);
+        CHECK_TRUE(error.isEmpty(), error);
+    }
+}
+
+IMPLEMENT_TEST(ByteRegExpUnitTests, anchors) {
+    QStringList patterns;
+    patterns << "^AC" << "t$" << "^ACGT$" << "^[A-Z]+$" << "\\$";
+    foreach (const QString &pattern, patterns) {
+        const QString error = ByteRegExpTestUtils::compareWithQRegExp(pattern.toLatin1(), TEXT);
+        CHECK_TRUE(error.isEmpty(), error);
+    }
+
+    ByteRegExp regExp("^AC$");
+    CHECK_TRUE(regExp.isAnchoredAtStart(), "the expression is not anchored at start");
+    CHECK_TRUE(regExp.isAnchoredAtEnd(), "the expression is not anchored at end");
+
+    ByteRegExp escaped("AC\\$");
+    CHECK_FALSE(escaped.isAnchoredAtEnd(), "the escaped '$' is an anchor");
+}
+
+IMPLEMENT_TEST(ByteRegExpUnitTests, unsupportedSyntax) {
+    QStringList patterns;
+    patterns << "(A)\\1" << "A(?=C)" << "A(?!C)" << "\\bAC" << "AC\\B" << "A^C" << "A$C"
+             << "*A" << "A{2,1}" << "A{2" << "(AC" << "AC)" << "[AC" << "[C-A]" << "A\\";
+    foreach (const QString &pattern, patterns) {
+        ByteRegExp regExp(pattern.toLatin1());
+        CHECK_FALSE(regExp.isValid(), QString("'%1' is accepted").arg(pattern));
+        CHECK_FALSE(regExp.getError().isEmpty(), QString("no error message for '%1'").arg(pattern));
+    }
+}
+
+IMPLEMENT_TEST(ByteRegExpUnitTests, dfaReset) {
+    // the DFA state remembers the positions of 'A' among the last 13 characters: there are 8192 states
+    const int tailLength = 12;
+    ByteRegExp regExp("(A|C)*A(A|C){12}");
+    CHECK_TRUE(regExp.isValid(), regExp.getError());
+
+    QByteArray text(100000, 'A');
+    uint random = 1;
+    for (int i = 0; i < text.length(); i++) {
+        random = random * 1103515245 + 12345;
+        text[i] = ((random >> 16) & 1) ? 'A' : 'C';
+    }
+
+    int state = regExp.getStartState();
+    for (int i = 0; i < text.length(); i++) {
+        state = regExp.next(state, text.at(i));
+        CHECK_FALSE(ByteRegExp::isDead(state), "the state is dead");
+        const bool expected = i >= tailLength && 'A' == text.at(i - tailLength);
+        CHECK_TRUE(expected == regExp.isAccepting(state), QString("unexpected match result at the position %1").arg(i));
+    }
+}
+
+} // U2
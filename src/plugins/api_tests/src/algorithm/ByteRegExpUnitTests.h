@@ -0,0 +1,61 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef _U2_BYTE_REG_EXP_UNIT_TESTS_H_
+#define _U2_BYTE_REG_EXP_UNIT_TESTS_H_
+
+#include <U2Algorithm/ByteRegExp.h>
+
+#include <unittest.h>
+
+namespace U2 {
+
+class ByteRegExpTestUtils {
+public:
+    // true if the whole 'text' is matched by the expression
+    static bool exactMatch(ByteRegExp &regExp, const QByteArray &text);
+    // compares the matches of all substrings of 'text' with QRegExp, returns an empty string if they are the same
+    static QString compareWithQRegExp(const QByteArray &pattern, const QByteArray &text);
+};
+
+/* Literals, '.' and character classes */
+DECLARE_TEST(ByteRegExpUnitTests, sets);
+/* The \d \D \s \S \w \W and character escapes */
+DECLARE_TEST(ByteRegExpUnitTests, escapes);
+/* Groups, alternation and quantifiers */
+DECLARE_TEST(ByteRegExpUnitTests, quantifiers);
+/* '^' and '$' at the pattern boundaries */
+DECLARE_TEST(ByteRegExpUnitTests, anchors);
+/* The syntax that can't be expressed with a DFA is reported as an error */
+DECLARE_TEST(ByteRegExpUnitTests, unsupportedSyntax);
+/* The DFA is rebuilt when it grows too large and the matches are still correct */
+DECLARE_TEST(ByteRegExpUnitTests, dfaReset);
+
+} // U2
+
+DECLARE_METATYPE(ByteRegExpUnitTests, sets);
+DECLARE_METATYPE(ByteRegExpUnitTests, escapes);
+DECLARE_METATYPE(ByteRegExpUnitTests, quantifiers);
+DECLARE_METATYPE(ByteRegExpUnitTests, anchors);
+DECLARE_METATYPE(ByteRegExpUnitTests, unsupportedSyntax);
+DECLARE_METATYPE(ByteRegExpUnitTests, dfaReset);
+
+#endif // _U2_BYTE_REG_EXP_UNIT_TESTS_H_
@@ -0,0 +1,231 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include <U2Algorithm/DynTable.h>
+
+#include "FindAlgorithmUnitTests.h"
+
+namespace U2 {
+
+void FindAlgorithmTestResults::onResult(const FindAlgorithmResult &r) {
+    results << r;
+}
+
+QByteArray FindAlgorithmTestUtils::getRandomSequence(int length, uint seed) {
+    static const char BASES[] = "ACGT";
+    QByteArray sequence(length, 'A');
+    uint state = seed;
+    for (int i = 0; i < length; i++) {
+        state = state * 1103515245 + 12345;
+        sequence[i] = BASES[(state >> 16) & 3];
+    }
+    return sequence;
+}
+
+QList<FindAlgorithmResult> FindAlgorithmTestUtils::find(const QByteArray &sequence, const QByteArray &pattern,
+    FindAlgorithmPatternSettings patternSettings, int maxErr, bool useAmbiguousBases)
+{
+    FindAlgorithmTestResults listener;
+    int stopFlag = 0;
+    int percentsCompleted = 0;
+    FindAlgorithm::find(&listener, NULL, NULL, FindAlgorithmStrand_Direct, patternSettings, useAmbiguousBases,
+        sequence.constData(), sequence.size(), false, U2Region(0, sequence.size()),
+        pattern.constData(), pattern.size(), maxErr, 0, stopFlag, percentsCompleted);
+    qSort(listener.results.begin(), listener.results.end(), FindAlgorithmResult::lessByRegionStartPos);
+    return listener.results;
+}
+
+QList<FindAlgorithmResult> FindAlgorithmTestUtils::findInsDelWithDynTable(const QByteArray &sequence, const QByteArray &pattern,
+    int maxErr, bool useAmbiguousBases)
+{
+    const int patternLen = pattern.size();
+    DynTable table(patternLen + maxErr, patternLen, true);
+    QList<FindAlgorithmResult> results;
+    FindAlgorithmResult res;
+    for (int i = 0; i < sequence.size(); i++) {
+        for (int j = 0; j < patternLen; j++) {
+            const bool matched = useAmbiguousBases ? FindAlgorithm::cmpAmbiguous(sequence[i], pattern[j]) : sequence[i] == pattern[j];
+            table.match(j, matched);
+        }
+        const int err = table.getLast();
+        if (!res.isEmpty() && (err > maxErr || (i - res.region.startPos) >= patternLen)) {
+            results << res;
+            res.clear();
+        }
+        if (err <= maxErr) {
+            const int newLen = table.getLastLen();
+            if (res.isEmpty() || res.err > err || (res.err == err && newLen < res.region.length)) {
+                res.region = U2Region(i - newLen + 1, newLen);
+                res.err = err;
+                res.strand = U2Strand::Direct;
+            }
+        }
+        table.shiftColumn();
+    }
+    if (!res.isEmpty()) {
+        results << res;
+    }
+    qSort(results.begin(), results.end(), FindAlgorithmResult::lessByRegionStartPos);
+    return results;
+}
+
+QString FindAlgorithmTestUtils::compareWithDynTable(const QByteArray &sequence, const QByteArray &pattern, int maxErr, bool useAmbiguousBases) {
+    const QList<FindAlgorithmResult> expected = findInsDelWithDynTable(sequence, pattern, maxErr, useAmbiguousBases);
+    const QList<FindAlgorithmResult> actual = find(sequence, pattern, FindAlgorithmPatternSettings_InsDel, maxErr, useAmbiguousBases);
+    const QString context = QString("pattern %1, max errors %2: ").arg(pattern.constData()).arg(maxErr);
+    CHECK(expected.size() == actual.size(), context + QString("expected %1 results, found %2").arg(expected.size()).arg(actual.size()));
+    for (int i = 0; i < expected.size(); i++) {
+        CHECK(expected[i].region == actual[i].region && expected[i].err == actual[i].err,
+              context + QString("unexpected result %1: expected %2..%3 with %4 errors, found %5..%6 with %7 errors").arg(i)
+              .arg(expected[i].region.startPos).arg(expected[i].region.endPos()).arg(expected[i].err)
+              .arg(actual[i].region.startPos).arg(actual[i].region.endPos()).arg(actual[i].err));
+    }
+    return QString();
+}
+
+QByteArray FindAlgorithmTestUtils::getMutatedPattern(const QByteArray &sequence, int length, int mutations, uint seed) {
+    static const char BASES[] = "ACGT";
+    uint state = seed;
+    state = state * 1103515245 + 12345;
+    QByteArray pattern = sequence.mid((state >> 8) % (sequence.size() - length), length);
+    for (int i = 0; i < mutations && pattern.size() > mutations + 1; i++) {
+        state = state * 1103515245 + 12345;
+        const int pos = (state >> 8) % pattern.size();
+        const char base = BASES[(state >> 4) & 3];
+        switch ((state >> 16) % 3) {
+        case 0:
+            pattern[pos] = base;
+            break;
+        case 1:
+            pattern.insert(pos, base);
+            break;
+        default:
+            pattern.remove(pos, 1);
+            break;
+        }
+    }
+    return pattern;
+}
+
+IMPLEMENT_TEST(FindAlgorithmUnitTests, insDel_exactMatches) {
+    const QByteArray sequence = FindAlgorithmTestUtils::getRandomSequence(2000, 1);
+    const QByteArray pattern = "ACGTAC";
+
+    const QList<FindAlgorithmResult> substResults = FindAlgorithmTestUtils::find(sequence, pattern, FindAlgorithmPatternSettings_Subst, 0);
+    const QList<FindAlgorithmResult> insDelResults = FindAlgorithmTestUtils::find(sequence, pattern, FindAlgorithmPatternSettings_InsDel, 0);
+
+    CHECK_FALSE(substResults.isEmpty(), "no exact matches");
+    CHECK_EQUAL(substResults.size(), insDelResults.size(), "results count");
+    for (int i = 0; i < substResults.size(); i++) {
+        CHECK_TRUE(substResults[i].region == insDelResults[i].region, QString("unexpected region of the result %1").arg(i));
+        CHECK_EQUAL(0, insDelResults[i].err, "errors count");
+    }
+}
+
+IMPLEMENT_TEST(FindAlgorithmUnitTests, insDel_longPatternDeletion) {
+    const QByteArray pattern = FindAlgorithmTestUtils::getRandomSequence(100, 2);
+    QByteArray planted = pattern;
+    planted.remove(70, 1);
+    const QByteArray sequence = FindAlgorithmTestUtils::getRandomSequence(50, 3) + planted + FindAlgorithmTestUtils::getRandomSequence(50, 4);
+
+    const QList<FindAlgorithmResult> results = FindAlgorithmTestUtils::find(sequence, pattern, FindAlgorithmPatternSettings_InsDel, 1);
+
+    bool found = false;
+    foreach (const FindAlgorithmResult &result, results) {
+        CHECK_TRUE(result.err <= 1, "too many errors");
+        CHECK_TRUE(result.region.intersects(U2Region(50, planted.size())), "unexpected result region");
+        found = found || (result.err == 1 && result.region == U2Region(50, planted.size()));
+    }
+    CHECK_TRUE(found, "the planted pattern is not found");
+}
+
+IMPLEMENT_TEST(FindAlgorithmUnitTests, insDel_longPatternInsertion) {
+    const QByteArray pattern = FindAlgorithmTestUtils::getRandomSequence(150, 5);
+    QByteArray planted = pattern;
+    planted.insert(64, 'N');
+    const QByteArray sequence = FindAlgorithmTestUtils::getRandomSequence(50, 6) + planted + FindAlgorithmTestUtils::getRandomSequence(50, 7);
+
+    const QList<FindAlgorithmResult> results = FindAlgorithmTestUtils::find(sequence, pattern, FindAlgorithmPatternSettings_InsDel, 1);
+
+    bool found = false;
+    foreach (const FindAlgorithmResult &result, results) {
+        CHECK_TRUE(result.err <= 1, "too many errors");
+        CHECK_TRUE(result.region.intersects(U2Region(50, planted.size())), "unexpected result region");
+        found = found || (result.err == 1 && result.region == U2Region(50, planted.size()));
+    }
+    CHECK_TRUE(found, "the planted pattern is not found");
+}
+
+IMPLEMENT_TEST(FindAlgorithmUnitTests, insDel_noMatch) {
+    const QByteArray pattern = FindAlgorithmTestUtils::getRandomSequence(100, 8);
+    const QByteArray sequence = FindAlgorithmTestUtils::getRandomSequence(1000, 9);
+
+    const QList<FindAlgorithmResult> results = FindAlgorithmTestUtils::find(sequence, pattern, FindAlgorithmPatternSettings_InsDel, 1);
+    CHECK_TRUE(results.isEmpty(), "unexpected results");
+}
+
+IMPLEMENT_TEST(FindAlgorithmUnitTests, insDel_ambiguousBases) {
+    const QByteArray sequence = "TTTACGTCACGTTTT";
+    const QByteArray pattern = "ACGTNACGT";
+
+    const QList<FindAlgorithmResult> results = FindAlgorithmTestUtils::find(sequence, pattern, FindAlgorithmPatternSettings_InsDel, 0, true);
+    CHECK_EQUAL(1, results.size(), "results count");
+    CHECK_TRUE(results.first().region == U2Region(3, 9), "unexpected result region");
+    CHECK_EQUAL(0, results.first().err, "errors count");
+
+    const QList<FindAlgorithmResult> exactResults = FindAlgorithmTestUtils::find(sequence, pattern, FindAlgorithmPatternSettings_InsDel, 0, false);
+    CHECK_TRUE(exactResults.isEmpty(), "unexpected results without ambiguous bases");
+}
+
+IMPLEMENT_TEST(FindAlgorithmUnitTests, insDel_dynTableParity) {
+    // the lengths cover patterns of one, two and three machine words
+    static const int LENGTHS[] = {1, 3, 8, 20, 63, 64, 65, 100, 128, 129, 150};
+    static const int LENGTHS_COUNT = sizeof(LENGTHS) / sizeof(LENGTHS[0]);
+    for (int i = 0; i < LENGTHS_COUNT; i++) {
+        const QByteArray sequence = FindAlgorithmTestUtils::getRandomSequence(1500, 50 + i);
+        for (int maxErr = 0; maxErr < qMin(LENGTHS[i], 5); maxErr++) {
+            const QByteArray pattern = FindAlgorithmTestUtils::getMutatedPattern(sequence, LENGTHS[i], maxErr, 100 * i + maxErr);
+            CHECK_TRUE(pattern.size() > maxErr, "too short pattern");
+            const QString error = FindAlgorithmTestUtils::compareWithDynTable(sequence, pattern, maxErr, false);
+            CHECK_TRUE(error.isEmpty(), error);
+        }
+    }
+}
+
+IMPLEMENT_TEST(FindAlgorithmUnitTests, insDel_dynTableParity_ambiguousBases) {
+    static const char AMBIGUOUS_BASES[] = "NRYKMSWBDHV";
+    for (int i = 0; i < 12; i++) {
+        QByteArray sequence = FindAlgorithmTestUtils::getRandomSequence(1000, 70 + i);
+        for (int pos = i; pos < sequence.size(); pos += 97) {
+            sequence[pos] = AMBIGUOUS_BASES[pos % (sizeof(AMBIGUOUS_BASES) - 1)];
+        }
+        const int maxErr = i % 4;
+        QByteArray pattern = FindAlgorithmTestUtils::getMutatedPattern(sequence, 10 + 12 * i, maxErr, 200 + i);
+        for (int pos = i % 5; pos < pattern.size(); pos += 7) {
+            pattern[pos] = AMBIGUOUS_BASES[(pos + i) % (sizeof(AMBIGUOUS_BASES) - 1)];
+        }
+        CHECK_TRUE(pattern.size() > maxErr, "too short pattern");
+        const QString error = FindAlgorithmTestUtils::compareWithDynTable(sequence, pattern, maxErr, true);
+        CHECK_TRUE(error.isEmpty(), error);
+    }
+}
+
+} // U2
@@ -0,0 +1,77 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef _U2_FIND_ALGORITHM_UNIT_TESTS_H_
+#define _U2_FIND_ALGORITHM_UNIT_TESTS_H_
+
+#include <U2Algorithm/FindAlgorithm.h>
+
+#include <unittest.h>
+
+namespace U2 {
+
+class FindAlgorithmTestResults : public FindAlgorithmResultsListener {
+public:
+    void onResult(const FindAlgorithmResult &r);
+
+    QList<FindAlgorithmResult> results;
+};
+
+class FindAlgorithmTestUtils {
+public:
+    static QByteArray getRandomSequence(int length, uint seed);
+    static QList<FindAlgorithmResult> find(const QByteArray &sequence, const QByteArray &pattern,
+        FindAlgorithmPatternSettings patternSettings, int maxErr, bool useAmbiguousBases = false);
+    // the InsDel search of the direct strand that fills a full DynTable column for every sequence position
+    static QList<FindAlgorithmResult> findInsDelWithDynTable(const QByteArray &sequence, const QByteArray &pattern,
+        int maxErr, bool useAmbiguousBases);
+    // returns an empty string if the InsDel search finds the same results as the DynTable search
+    static QString compareWithDynTable(const QByteArray &sequence, const QByteArray &pattern, int maxErr, bool useAmbiguousBases);
+    // a copy of a sequence part with random substitutions, insertions and deletions, it stays longer than the mutations count
+    static QByteArray getMutatedPattern(const QByteArray &sequence, int length, int mutations, uint seed);
+};
+
+/* InsDel search without errors finds the same regions as the substitution search */
+DECLARE_TEST(FindAlgorithmUnitTests, insDel_exactMatches);
+/* A pattern longer than one machine word is found with a deleted base */
+DECLARE_TEST(FindAlgorithmUnitTests, insDel_longPatternDeletion);
+/* A pattern longer than two machine words is found with an inserted base */
+DECLARE_TEST(FindAlgorithmUnitTests, insDel_longPatternInsertion);
+/* Nothing is found in an unrelated sequence */
+DECLARE_TEST(FindAlgorithmUnitTests, insDel_noMatch);
+/* Ambiguous pattern bases match only when the ambiguous bases are enabled */
+DECLARE_TEST(FindAlgorithmUnitTests, insDel_ambiguousBases);
+/* Random patterns, sequences and error counts give the same results as the DynTable search */
+DECLARE_TEST(FindAlgorithmUnitTests, insDel_dynTableParity);
+/* Random ambiguous patterns and sequences give the same results as the DynTable search */
+DECLARE_TEST(FindAlgorithmUnitTests, insDel_dynTableParity_ambiguousBases);
+
+} // U2
+
+DECLARE_METATYPE(FindAlgorithmUnitTests, insDel_exactMatches);
+DECLARE_METATYPE(FindAlgorithmUnitTests, insDel_longPatternDeletion);
+DECLARE_METATYPE(FindAlgorithmUnitTests, insDel_longPatternInsertion);
+DECLARE_METATYPE(FindAlgorithmUnitTests, insDel_noMatch);
+DECLARE_METATYPE(FindAlgorithmUnitTests, insDel_ambiguousBases);
+DECLARE_METATYPE(FindAlgorithmUnitTests, insDel_dynTableParity);
+DECLARE_METATYPE(FindAlgorithmUnitTests, insDel_dynTableParity_ambiguousBases);
+
+#endif // _U2_FIND_ALGORITHM_UNIT_TESTS_H_
@@ -0,0 +1,162 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include <U2Core/AppContext.h>
+#include <U2Core/DNAAlphabet.h>
+#include <U2Core/DNASequence.h>
+#include <U2Core/U2AlphabetUtils.h>
+
+#include "FindAlgorithmUnitTests.h"
+#include "FindEnzymesAlgorithmUnitTests.h"
+
+namespace U2 {
+
+void FindEnzymesTestResults::onResult(int pos, const SEnzymeData& enzyme, const U2Strand& strand) {
+    results << QString("%1:%2:%3").arg(enzyme->id).arg(pos).arg(strand.isDirect() ? "direct" : "complementary");
+}
+
+SEnzymeData FindEnzymesAlgorithmTestUtils::createEnzyme(const QString &id, const QByteArray &site, const QString &alphabetId) {
+    SEnzymeData enzyme(new EnzymeData());
+    enzyme->id = id;
+    enzyme->seq = site;
+    enzyme->alphabet = AppContext::getDNAAlphabetRegistry()->findById(alphabetId);
+    return enzyme;
+}
+
+QString FindEnzymesAlgorithmTestUtils::compareWithSingleEnzymeSearch(const QByteArray &sequence, const QString &alphabetId, const QList<SEnzymeData> &enzymes) {
+    const DNAAlphabet *alphabet = AppContext::getDNAAlphabetRegistry()->findById(alphabetId);
+    CHECK(NULL != alphabet, "no sequence alphabet");
+    TaskStateInfo ti;
+
+    FindMultipleEnzymesAlgorithm multipleAlgorithm(enzymes, alphabet);
+    CHECK(multipleAlgorithm.getUnsupportedEnzymes().isEmpty(), "unexpected unsupported enzymes");
+    FindEnzymesTestResults multipleResults;
+    multipleAlgorithm.run(sequence.constData(), sequence.length(), sequence.length(), &multipleResults, ti);
+
+    FindEnzymesTestResults singleResults;
+    const DNASequence dnaSequence(sequence, alphabet);
+    const U2Region range(0, sequence.length());
+    foreach (const SEnzymeData &enzyme, enzymes) {
+        if (FindMultipleEnzymesAlgorithm::useExtendedComparator(enzyme->alphabet, alphabet)) {
+            FindEnzymesAlgorithm<ExtendedDNAlphabetComparator> algorithm;
+            algorithm.run(dnaSequence, range, enzyme, &singleResults, ti);
+        } else {
+            FindEnzymesAlgorithm<ExactDNAAlphabetComparatorN1M_N2M> algorithm;
+            algorithm.run(dnaSequence, range, enzyme, &singleResults, ti);
+        }
+    }
+
+    CHECK(!singleResults.results.isEmpty(), "no sites are found");
+    singleResults.results.sort();
+    multipleResults.results.sort();
+    CHECK(singleResults.results == multipleResults.results,
+          QString("expected sites: %1; found: %2").arg(singleResults.results.join(", ")).arg(multipleResults.results.join(", ")));
+    return QString();
+}
+
+IMPLEMENT_TEST(FindEnzymesAlgorithmUnitTests, sites) {
+    QByteArray sequence = FindAlgorithmTestUtils::getRandomSequence(5000, 20);
+    sequence.replace(100, 6, "GAATTC");
+    sequence.replace(1000, 6, "GGTCTC");
+    sequence.replace(2000, 6, "GAGACC");
+    sequence.replace(3000, 5, "GGACC");
+    sequence.replace(4000, 5, "CCAGG");
+
+    QList<SEnzymeData> enzymes;
+    enzymes << FindEnzymesAlgorithmTestUtils::createEnzyme("EcoRI", "GAATTC", BaseDNAAlphabetIds::NUCL_DNA_DEFAULT());
+    enzymes << FindEnzymesAlgorithmTestUtils::createEnzyme("BsaI", "GGTCTC", BaseDNAAlphabetIds::NUCL_DNA_DEFAULT());
+    enzymes << FindEnzymesAlgorithmTestUtils::createEnzyme("Sau96I", "GGNCC", BaseDNAAlphabetIds::NUCL_DNA_EXTENDED());
+    enzymes << FindEnzymesAlgorithmTestUtils::createEnzyme("BstNI", "CCWGG", BaseDNAAlphabetIds::NUCL_DNA_EXTENDED());
+
+    const QString error = FindEnzymesAlgorithmTestUtils::compareWithSingleEnzymeSearch(sequence, BaseDNAAlphabetIds::NUCL_DNA_DEFAULT(), enzymes);
+    CHECK_TRUE(error.isEmpty(), error);
+}
+
+IMPLEMENT_TEST(FindEnzymesAlgorithmUnitTests, manyWords) {
+    QByteArray sequence = FindAlgorithmTestUtils::getRandomSequence(10000, 21);
+    QList<SEnzymeData> enzymes;
+    for (int i = 0; i < 40; i++) {
+        const QByteArray site = FindAlgorithmTestUtils::getRandomSequence(6 + i % 5, 100 + i);
+        enzymes << FindEnzymesAlgorithmTestUtils::createEnzyme(QString("E%1").arg(i), site, BaseDNAAlphabetIds::NUCL_DNA_DEFAULT());
+        sequence.replace(i * 200, site.length(), site);
+    }
+    const QByteArray longSite = FindAlgorithmTestUtils::getRandomSequence(FindMultipleEnzymesAlgorithm::MAX_SITE_LENGTH, 22);
+    enzymes << FindEnzymesAlgorithmTestUtils::createEnzyme("Long", longSite, BaseDNAAlphabetIds::NUCL_DNA_DEFAULT());
+    sequence.replace(9000, longSite.length(), longSite);
+
+    const QString error = FindEnzymesAlgorithmTestUtils::compareWithSingleEnzymeSearch(sequence, BaseDNAAlphabetIds::NUCL_DNA_DEFAULT(), enzymes);
+    CHECK_TRUE(error.isEmpty(), error);
+}
+
+IMPLEMENT_TEST(FindEnzymesAlgorithmUnitTests, unsupportedSite) {
+    const DNAAlphabet *alphabet = AppContext::getDNAAlphabetRegistry()->findById(BaseDNAAlphabetIds::NUCL_DNA_DEFAULT());
+    CHECK_TRUE(NULL != alphabet, "no sequence alphabet");
+    const QByteArray longSite = FindAlgorithmTestUtils::getRandomSequence(FindMultipleEnzymesAlgorithm::MAX_SITE_LENGTH + 1, 23);
+
+    QList<SEnzymeData> enzymes;
+    enzymes << FindEnzymesAlgorithmTestUtils::createEnzyme("TooLong", longSite, BaseDNAAlphabetIds::NUCL_DNA_DEFAULT());
+    enzymes << FindEnzymesAlgorithmTestUtils::createEnzyme("EcoRI", "GAATTC", BaseDNAAlphabetIds::NUCL_DNA_DEFAULT());
+    FindMultipleEnzymesAlgorithm algorithm(enzymes, alphabet);
+
+    CHECK_EQUAL(1, algorithm.getUnsupportedEnzymes().size(), "unsupported enzymes count");
+    CHECK_EQUAL(QString("TooLong"), algorithm.getUnsupportedEnzymes().first()->id, "unsupported enzyme");
+    CHECK_EQUAL(6, algorithm.getMaxSiteLength(), "max site length");
+}
+
+IMPLEMENT_TEST(FindEnzymesAlgorithmUnitTests, sequenceAmbiguousBases) {
+    QByteArray sequence = FindAlgorithmTestUtils::getRandomSequence(5000, 24);
+    sequence.replace(100, 6, "GAATTC");
+    sequence.replace(200, 6, "GANTTC");
+    sequence.replace(300, 6, "GRATTC");
+    sequence.replace(400, 5, "GGWCC");
+    for (int i = 500; i < sequence.length(); i += 37) {
+        sequence[i] = "NRYWS"[(i / 37) % 5];
+    }
+
+    QList<SEnzymeData> enzymes;
+    enzymes << FindEnzymesAlgorithmTestUtils::createEnzyme("EcoRI", "GAATTC", BaseDNAAlphabetIds::NUCL_DNA_DEFAULT());
+    enzymes << FindEnzymesAlgorithmTestUtils::createEnzyme("Sau96I", "GGNCC", BaseDNAAlphabetIds::NUCL_DNA_EXTENDED());
+    enzymes << FindEnzymesAlgorithmTestUtils::createEnzyme("BstNI", "CCWGG", BaseDNAAlphabetIds::NUCL_DNA_EXTENDED());
+
+    const QString error = FindEnzymesAlgorithmTestUtils::compareWithSingleEnzymeSearch(sequence, BaseDNAAlphabetIds::NUCL_DNA_EXTENDED(), enzymes);
+    CHECK_TRUE(error.isEmpty(), error);
+}
+
+IMPLEMENT_TEST(FindEnzymesAlgorithmUnitTests, reportLimit) {
+    const DNAAlphabet *alphabet = AppContext::getDNAAlphabetRegistry()->findById(BaseDNAAlphabetIds::NUCL_DNA_DEFAULT());
+    CHECK_TRUE(NULL != alphabet, "no sequence alphabet");
+    QByteArray sequence(1000, 'A');
+    sequence.replace(100, 6, "GAATTC");
+    sequence.replace(500, 6, "GAATTC");
+    sequence.replace(900, 6, "GAATTC");
+
+    QList<SEnzymeData> enzymes;
+    enzymes << FindEnzymesAlgorithmTestUtils::createEnzyme("EcoRI", "GAATTC", BaseDNAAlphabetIds::NUCL_DNA_DEFAULT());
+    FindMultipleEnzymesAlgorithm algorithm(enzymes, alphabet);
+    FindEnzymesTestResults listener;
+    TaskStateInfo ti;
+    algorithm.run(sequence.constData(), sequence.length(), 500, &listener, ti, 10000);
+
+    CHECK_EQUAL(1, listener.results.size(), "sites count");
+    CHECK_EQUAL(QString("EcoRI:10100:direct"), listener.results.first(), "site");
+}
+
+} // U2
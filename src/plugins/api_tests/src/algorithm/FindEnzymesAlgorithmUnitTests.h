@@ -0,0 +1,65 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef _U2_FIND_ENZYMES_ALGORITHM_UNIT_TESTS_H_
+#define _U2_FIND_ENZYMES_ALGORITHM_UNIT_TESTS_H_
+
+#include <U2Algorithm/FindEnzymesAlgorithm.h>
+
+#include <unittest.h>
+
+namespace U2 {
+
+class FindEnzymesTestResults : public FindEnzymesAlgListener {
+public:
+    virtual void onResult(int pos, const SEnzymeData& enzyme, const U2Strand& strand);
+
+    // "enzyme:position:strand" strings
+    QStringList results;
+};
+
+class FindEnzymesAlgorithmTestUtils {
+public:
+    static SEnzymeData createEnzyme(const QString &id, const QByteArray &site, const QString &alphabetId);
+    // searches the enzymes in a single pass and one by one, returns an empty string if the results are the same
+    static QString compareWithSingleEnzymeSearch(const QByteArray &sequence, const QString &alphabetId, const QList<SEnzymeData> &enzymes);
+};
+
+/* Palindromic, non-palindromic and degenerate sites */
+DECLARE_TEST(FindEnzymesAlgorithmUnitTests, sites);
+/* Many enzymes are packed to several words, the longest site takes a whole word */
+DECLARE_TEST(FindEnzymesAlgorithmUnitTests, manyWords);
+/* The sites longer than a word are not searched */
+DECLARE_TEST(FindEnzymesAlgorithmUnitTests, unsupportedSite);
+/* Ambiguous characters of the sequence */
+DECLARE_TEST(FindEnzymesAlgorithmUnitTests, sequenceAmbiguousBases);
+/* The sites starting after the report limit are skipped, the positions are shifted */
+DECLARE_TEST(FindEnzymesAlgorithmUnitTests, reportLimit);
+
+} // U2
+
+DECLARE_METATYPE(FindEnzymesAlgorithmUnitTests, sites);
+DECLARE_METATYPE(FindEnzymesAlgorithmUnitTests, manyWords);
+DECLARE_METATYPE(FindEnzymesAlgorithmUnitTests, unsupportedSite);
+DECLARE_METATYPE(FindEnzymesAlgorithmUnitTests, sequenceAmbiguousBases);
+DECLARE_METATYPE(FindEnzymesAlgorithmUnitTests, reportLimit);
+
+#endif // _U2_FIND_ENZYMES_ALGORITHM_UNIT_TESTS_H_
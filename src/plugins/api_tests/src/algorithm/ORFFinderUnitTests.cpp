@@ -0,0 +1,203 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include <U2Core/AppContext.h>
+#include <U2Core/DNAAlphabet.h>
+#include <U2Core/DNASequence.h>
+#include <U2Core/DNATranslation.h>
+#include <U2Core/DNATranslationImpl.h>
+#include <U2Core/U2OpStatusUtils.h>
+#include <U2Core/U2SafePoints.h>
+#include <U2Core/U2SequenceUtils.h>
+
+#include "core/dbi/DbiTest.h"
+
+#include "ORFFinderUnitTests.h"
+
+namespace U2 {
+
+void ORFFinderTestResults::onResult(const ORFFindResult& r, U2OpStatus& /*os*/) {
+    QString result = QString("%1:%2:%3").arg(r.frame).arg(r.region.startPos).arg(r.region.length);
+    if (r.isJoined) {
+        result += QString("+%1:%2").arg(r.joinedRegion.startPos).arg(r.joinedRegion.length);
+    }
+    results << result;
+}
+
+QByteArray ORFFinderTestUtils::getRandomSequence(int length, uint seed) {
+    static const char BASES[] = "ACGT";
+    QByteArray sequence(length, 'A');
+    uint state = seed;
+    for (int i = 0; i < length; i++) {
+        state = state * 1103515245 + 12345;
+        sequence[i] = BASES[(state >> 16) & 3];
+    }
+    return sequence;
+}
+
+QList<DNATranslation*> ORFFinderTestUtils::getAminoTranslations() {
+    const DNAAlphabet *alphabet = AppContext::getDNAAlphabetRegistry()->findById(BaseDNAAlphabetIds::NUCL_DNA_DEFAULT());
+    CHECK(NULL != alphabet, QList<DNATranslation*>());
+    return AppContext::getDNATranslationRegistry()->lookupTranslation(alphabet, DNATranslationType_NUCL_2_AMINO);
+}
+
+DNATranslation * ORFFinderTestUtils::getComplementTranslation() {
+    const DNAAlphabet *alphabet = AppContext::getDNAAlphabetRegistry()->findById(BaseDNAAlphabetIds::NUCL_DNA_DEFAULT());
+    CHECK(NULL != alphabet, NULL);
+    return AppContext::getDNATranslationRegistry()->lookupComplementTranslation(alphabet);
+}
+
+U2EntityRef ORFFinderTestUtils::importSequence(const U2DbiRef &dbiRef, const QByteArray &sequence, U2OpStatus &os) {
+    const DNAAlphabet *alphabet = AppContext::getDNAAlphabetRegistry()->findById(BaseDNAAlphabetIds::NUCL_DNA_EXTENDED());
+    SAFE_POINT_EXT(NULL != alphabet, os.setError("no sequence alphabet"), U2EntityRef());
+    return U2SequenceUtils::import(os, dbiRef, DNASequence("orf", sequence, alphabet));
+}
+
+QString ORFFinderTestUtils::compareWithSequentialSearch(U2EntityRef &entityRef, const ORFAlgorithmSettings &settings, int &resultsCount) {
+    int stopFlag = 0;
+    int percentsCompleted = 0;
+
+    ORFFinderTestResults parallelResults;
+    ORFFindAlgorithm::findInBothStrandsParallel(&parallelResults, settings, entityRef, stopFlag, percentsCompleted);
+
+    ORFFinderTestResults sequentialResults;
+    ORFAlgorithmSettings strandSettings = settings;
+    strandSettings.strand = ORFAlgorithmStrand_Direct;
+    ORFFindAlgorithm::find(&sequentialResults, strandSettings, entityRef, stopFlag, percentsCompleted);
+    strandSettings.strand = ORFAlgorithmStrand_Complement;
+    ORFFindAlgorithm::find(&sequentialResults, strandSettings, entityRef, stopFlag, percentsCompleted);
+
+    resultsCount = sequentialResults.results.size();
+    CHECK(parallelResults.results.size() == sequentialResults.results.size(),
+          QString("expected %1 ORFs, found %2").arg(sequentialResults.results.size()).arg(parallelResults.results.size()));
+    for (int i = 0; i < sequentialResults.results.size(); i++) {
+        CHECK(parallelResults.results[i] == sequentialResults.results[i],
+              QString("unexpected ORF %1: expected %2, found %3").arg(i).arg(sequentialResults.results[i]).arg(parallelResults.results[i]));
+    }
+    return QString();
+}
+
+IMPLEMENT_TEST(ORFFinderUnitTests, codonClassifier) {
+    static const QByteArray CHARS("ACGTUNacgtu-");
+    const QList<DNATranslation*> translations = ORFFinderTestUtils::getAminoTranslations();
+    CHECK_TRUE(!translations.isEmpty(), "no amino translations");
+
+    foreach (DNATranslation *translation, translations) {
+        DNATranslation3to1Impl *aTT = dynamic_cast<DNATranslation3to1Impl*>(translation);
+        CHECK_TRUE(NULL != aTT, "not a 3to1 translation: " + translation->getTranslationId());
+        const ORFCodonClassifier classifier(aTT);
+        char codon[3];
+        for (int i = 0; i < CHARS.size() * CHARS.size() * CHARS.size(); i++) {
+            codon[0] = CHARS[i / (CHARS.size() * CHARS.size())];
+            codon[1] = CHARS[(i / CHARS.size()) % CHARS.size()];
+            codon[2] = CHARS[i % CHARS.size()];
+            const QString context = translation->getTranslationId() + ", " + QByteArray(codon, 3);
+            CHECK_EQUAL(aTT->isStopCodon(codon), classifier.isStop(codon), "stop codon: " + context);
+            CHECK_EQUAL(aTT->isStartCodon(codon), classifier.isStart(codon, false), "start codon: " + context);
+            const bool isAltStart = aTT->isStartCodon(codon) || aTT->isCodon(DNATranslationRole_Start_Alternative, codon);
+            CHECK_EQUAL(isAltStart, classifier.isStart(codon, true), "alternative start codon: " + context);
+        }
+    }
+}
+
+IMPLEMENT_TEST(ORFFinderUnitTests, bothStrandsParallel) {
+    TestDbiProvider dbiProvider;
+    CHECK_TRUE(dbiProvider.init("orf-finder.ugenedb", true), "dbi provider failed to initialize");
+    QByteArray sequence = ORFFinderTestUtils::getRandomSequence(20000, 40);
+    for (int i = 300; i < sequence.length(); i += 1013) {
+        sequence[i] = 'N';
+    }
+    U2OpStatusImpl os;
+    U2EntityRef entityRef = ORFFinderTestUtils::importSequence(dbiProvider.getDbi()->getDbiRef(), sequence, os);
+    CHECK_NO_ERROR(os);
+
+    DNATranslation *complementTT = ORFFinderTestUtils::getComplementTranslation();
+    CHECK_TRUE(NULL != complementTT, "no complement translation");
+    const QList<DNATranslation*> translations = ORFFinderTestUtils::getAminoTranslations();
+    CHECK_TRUE(!translations.isEmpty(), "no amino translations");
+
+    ORFAlgorithmSettings settings(ORFAlgorithmStrand_Both, complementTT, translations.first(), U2Region(0, sequence.length()), 30);
+    settings.isResultsLimited = false;
+    settings.maxResult2Search = 0;
+
+    int resultsCount = 0;
+    const QString error = ORFFinderTestUtils::compareWithSequentialSearch(entityRef, settings, resultsCount);
+    CHECK_TRUE(error.isEmpty(), error);
+    CHECK_TRUE(resultsCount > 0, "no ORFs are found");
+}
+
+IMPLEMENT_TEST(ORFFinderUnitTests, bothStrandsParallel_settings) {
+    TestDbiProvider dbiProvider;
+    CHECK_TRUE(dbiProvider.init("orf-finder.ugenedb", true), "dbi provider failed to initialize");
+    const QByteArray sequence = ORFFinderTestUtils::getRandomSequence(6000, 41);
+    U2OpStatusImpl os;
+    U2EntityRef entityRef = ORFFinderTestUtils::importSequence(dbiProvider.getDbi()->getDbiRef(), sequence, os);
+    CHECK_NO_ERROR(os);
+
+    DNATranslation *complementTT = ORFFinderTestUtils::getComplementTranslation();
+    CHECK_TRUE(NULL != complementTT, "no complement translation");
+    const QList<DNATranslation*> translations = ORFFinderTestUtils::getAminoTranslations();
+    CHECK_TRUE(!translations.isEmpty(), "no amino translations");
+
+    for (int i = 0; i < translations.size(); i++) {
+        // every bit of the variant switches one of the settings
+        for (int variant = 0; variant < 32; variant += 1 + i % 3) {
+            ORFAlgorithmSettings settings(ORFAlgorithmStrand_Both, complementTT, translations[i], U2Region(0, sequence.length()), 9,
+                                          (variant & 1) != 0, (variant & 2) != 0, (variant & 4) != 0, (variant & 8) != 0, (i % 2) != 0, (variant & 16) != 0);
+            settings.isResultsLimited = false;
+            settings.maxResult2Search = 0;
+
+            int resultsCount = 0;
+            const QString error = ORFFinderTestUtils::compareWithSequentialSearch(entityRef, settings, resultsCount);
+            CHECK_TRUE(error.isEmpty(), QString("%1, settings variant %2: %3").arg(translations[i]->getTranslationId()).arg(variant).arg(error));
+        }
+    }
+}
+
+IMPLEMENT_TEST(ORFFinderUnitTests, bothStrandsParallel_progress) {
+    TestDbiProvider dbiProvider;
+    CHECK_TRUE(dbiProvider.init("orf-finder.ugenedb", true), "dbi provider failed to initialize");
+    const QByteArray sequence = ORFFinderTestUtils::getRandomSequence(10000, 42);
+    U2OpStatusImpl os;
+    U2EntityRef entityRef = ORFFinderTestUtils::importSequence(dbiProvider.getDbi()->getDbiRef(), sequence, os);
+    CHECK_NO_ERROR(os);
+
+    DNATranslation *complementTT = ORFFinderTestUtils::getComplementTranslation();
+    CHECK_TRUE(NULL != complementTT, "no complement translation");
+    const QList<DNATranslation*> translations = ORFFinderTestUtils::getAminoTranslations();
+    CHECK_TRUE(!translations.isEmpty(), "no amino translations");
+
+    ORFAlgorithmSettings settings(ORFAlgorithmStrand_Both, complementTT, translations.first(), U2Region(0, sequence.length()));
+    settings.isResultsLimited = false;
+    settings.maxResult2Search = 0;
+
+    int stopFlag = 0;
+    int percentsCompleted = 0;
+    ORFFinderTestResults results;
+    ORFFindAlgorithm::findInBothStrandsParallel(&results, settings, entityRef, stopFlag, percentsCompleted);
+    CHECK_EQUAL(100, percentsCompleted, "progress of both strands");
+
+    settings.strand = ORFAlgorithmStrand_Direct;
+    ORFFindAlgorithm::find(&results, settings, entityRef, stopFlag, percentsCompleted);
+    CHECK_EQUAL(100, percentsCompleted, "progress of a single strand");
+}
+
+} // U2
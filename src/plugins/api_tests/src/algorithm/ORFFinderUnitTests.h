@@ -0,0 +1,65 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef _U2_ORF_FINDER_UNIT_TESTS_H_
+#define _U2_ORF_FINDER_UNIT_TESTS_H_
+
+#include <U2Algorithm/ORFFinder.h>
+
+#include <unittest.h>
+
+namespace U2 {
+
+class ORFFinderTestResults : public ORFFindResultsListener {
+public:
+    void onResult(const ORFFindResult& r, U2OpStatus& os);
+
+    QStringList results;
+};
+
+class ORFFinderTestUtils {
+public:
+    static QByteArray getRandomSequence(int length, uint seed);
+    static QList<DNATranslation*> getAminoTranslations();
+    static DNATranslation * getComplementTranslation();
+    static U2EntityRef importSequence(const U2DbiRef &dbiRef, const QByteArray &sequence, U2OpStatus &os);
+    // searches both strands in parallel and each strand separately,
+    // returns an empty string if the results and their order are the same
+    static QString compareWithSequentialSearch(U2EntityRef &entityRef, const ORFAlgorithmSettings &settings, int &resultsCount);
+};
+
+/* The table classifier gives the same codon classes as the codon lists of all genetic codes */
+DECLARE_TEST(ORFFinderUnitTests, codonClassifier);
+/* The parallel search of both strands finds the same ORFs in the same order as the sequential one */
+DECLARE_TEST(ORFFinderUnitTests, bothStrandsParallel);
+/* The parallel search of both strands with various settings and genetic codes */
+DECLARE_TEST(ORFFinderUnitTests, bothStrandsParallel_settings);
+/* Each strand of the parallel search gives a half of the progress */
+DECLARE_TEST(ORFFinderUnitTests, bothStrandsParallel_progress);
+
+} // U2
+
+DECLARE_METATYPE(ORFFinderUnitTests, codonClassifier);
+DECLARE_METATYPE(ORFFinderUnitTests, bothStrandsParallel);
+DECLARE_METATYPE(ORFFinderUnitTests, bothStrandsParallel_settings);
+DECLARE_METATYPE(ORFFinderUnitTests, bothStrandsParallel_progress);
+
+#endif // _U2_ORF_FINDER_UNIT_TESTS_H_
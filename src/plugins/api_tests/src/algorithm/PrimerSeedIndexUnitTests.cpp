@@ -0,0 +1,157 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include <U2Algorithm/PrimerSeedIndex.h>
+
+#include <U2Core/AppContext.h>
+#include <U2Core/DNAAlphabet.h>
+#include <U2Core/DNATranslation.h>
+#include <U2Core/TextUtils.h>
+#include <U2Core/U2OpStatusUtils.h>
+
+#include "FindAlgorithmUnitTests.h"
+#include "PrimerSeedIndexUnitTests.h"
+
+namespace U2 {
+
+DNATranslation * PrimerSeedIndexTestUtils::getComplementTranslation() {
+    const DNAAlphabet *alphabet = AppContext::getDNAAlphabetRegistry()->findById(BaseDNAAlphabetIds::NUCL_DNA_DEFAULT());
+    CHECK(NULL != alphabet, NULL);
+    return AppContext::getDNATranslationRegistry()->lookupComplementTranslation(alphabet);
+}
+
+QString PrimerSeedIndexTestUtils::compareWithFindAlgorithm(const QByteArray &sequence, bool isCircular, const QByteArray &pattern, int maxErr, int seedLength) {
+    DNATranslation *complTT = getComplementTranslation();
+    CHECK(NULL != complTT, "no complement translation");
+
+    PrimerSeedIndex index(sequence, isCircular, pattern.length(), seedLength);
+    U2OpStatusImpl os;
+    index.prepare(os);
+    CHECK_OP(os, os.getError());
+    const QList<FindAlgorithmResult> indexResults = index.find(pattern, maxErr, complTT, os);
+    CHECK_OP(os, os.getError());
+
+    FindAlgorithmTestResults listener;
+    int stopFlag = 0;
+    int percentsCompleted = 0;
+    FindAlgorithm::find(&listener, NULL, complTT, FindAlgorithmStrand_Both, FindAlgorithmPatternSettings_Subst, true,
+        sequence.constData(), sequence.length(), isCircular, U2Region(0, sequence.length()),
+        pattern.constData(), pattern.length(), maxErr, 0, stopFlag, percentsCompleted);
+
+    CHECK(!listener.results.isEmpty(), "FindAlgorithm finds nothing");
+    CHECK(listener.results.size() == indexResults.size(),
+          QString("expected %1 sites, the index finds %2").arg(listener.results.size()).arg(indexResults.size()));
+    for (int i = 0; i < indexResults.size(); i++) {
+        const FindAlgorithmResult &expected = listener.results[i];
+        const FindAlgorithmResult &actual = indexResults[i];
+        CHECK(expected.region == actual.region && expected.strand == actual.strand && expected.err == actual.err,
+              QString("unexpected site %1: expected %2..%3, got %4..%5")
+              .arg(i).arg(expected.region.startPos).arg(expected.region.endPos()).arg(actual.region.startPos).arg(actual.region.endPos()));
+    }
+    return QString();
+}
+
+IMPLEMENT_TEST(PrimerSeedIndexUnitTests, substitutions) {
+    const QByteArray pattern = FindAlgorithmTestUtils::getRandomSequence(20, 10);
+    QByteArray sequence = FindAlgorithmTestUtils::getRandomSequence(5000, 11);
+    QByteArray mismatched = pattern;
+    mismatched[3] = ('A' == mismatched[3]) ? 'C' : 'A';
+    mismatched[15] = ('G' == mismatched[15]) ? 'T' : 'G';
+    sequence.replace(100, pattern.length(), pattern);
+    sequence.replace(2000, mismatched.length(), mismatched);
+
+    QByteArray complement(pattern.length(), 0);
+    DNATranslation *complTT = PrimerSeedIndexTestUtils::getComplementTranslation();
+    CHECK_TRUE(NULL != complTT, "no complement translation");
+    TextUtils::translate(complTT->getOne2OneMapper(), pattern.constData(), pattern.length(), complement.data());
+    TextUtils::reverse(complement.data(), complement.length());
+    sequence.replace(3500, complement.length(), complement);
+
+    const int maxErr = 2;
+    const QString error = PrimerSeedIndexTestUtils::compareWithFindAlgorithm(sequence, false, pattern, maxErr, PrimerSeedIndex::getSeedLength(pattern.length(), maxErr));
+    CHECK_TRUE(error.isEmpty(), error);
+}
+
+IMPLEMENT_TEST(PrimerSeedIndexUnitTests, ambiguousBases) {
+    const QByteArray site = FindAlgorithmTestUtils::getRandomSequence(24, 12);
+    QByteArray sequence = FindAlgorithmTestUtils::getRandomSequence(3000, 13);
+    sequence.replace(500, site.length(), site);
+    sequence.replace(1500, site.length(), site);
+    sequence[1510] = 'N';
+    sequence[2500] = 'R';
+
+    QByteArray pattern = site;
+    pattern[2] = 'N';
+    pattern[9] = 'Y';
+    pattern[20] = 'S';
+
+    const int maxErr = 1;
+    const QString error = PrimerSeedIndexTestUtils::compareWithFindAlgorithm(sequence, false, pattern, maxErr, PrimerSeedIndex::getSeedLength(pattern.length(), maxErr));
+    CHECK_TRUE(error.isEmpty(), error);
+}
+
+IMPLEMENT_TEST(PrimerSeedIndexUnitTests, circular) {
+    const QByteArray pattern = FindAlgorithmTestUtils::getRandomSequence(22, 14);
+    QByteArray sequence = FindAlgorithmTestUtils::getRandomSequence(2000, 15);
+    sequence.replace(0, 10, pattern.right(10));
+    sequence.replace(sequence.length() - 12, 12, pattern.left(12));
+    sequence.replace(1000, pattern.length(), pattern);
+
+    const int maxErr = 1;
+    const QString error = PrimerSeedIndexTestUtils::compareWithFindAlgorithm(sequence, true, pattern, maxErr, PrimerSeedIndex::getSeedLength(pattern.length(), maxErr));
+    CHECK_TRUE(error.isEmpty(), error);
+}
+
+IMPLEMENT_TEST(PrimerSeedIndexUnitTests, shortPattern) {
+    const QByteArray pattern = FindAlgorithmTestUtils::getRandomSequence(10, 16);
+    QByteArray sequence = FindAlgorithmTestUtils::getRandomSequence(2000, 17);
+    sequence.replace(700, pattern.length(), pattern);
+
+    // the seeds of 6 bases need 18 pattern bases for 2 mismatches
+    const QString error = PrimerSeedIndexTestUtils::compareWithFindAlgorithm(sequence, false, pattern, 2, 6);
+    CHECK_TRUE(error.isEmpty(), error);
+}
+
+IMPLEMENT_TEST(PrimerSeedIndexUnitTests, canceledPrepare) {
+    DNATranslation *complTT = PrimerSeedIndexTestUtils::getComplementTranslation();
+    CHECK_TRUE(NULL != complTT, "no complement translation");
+    const QByteArray pattern = FindAlgorithmTestUtils::getRandomSequence(20, 18);
+    QByteArray sequence = FindAlgorithmTestUtils::getRandomSequence(2000, 19);
+    sequence.replace(300, pattern.length(), pattern);
+
+    PrimerSeedIndex index(sequence, false, pattern.length(), PrimerSeedIndex::getSeedLength(pattern.length(), 1));
+    U2OpStatusImpl canceledOs;
+    canceledOs.setCanceled(true);
+    index.prepare(canceledOs);
+
+    U2OpStatusImpl os;
+    index.prepare(os);
+    CHECK_NO_ERROR(os);
+    const QList<FindAlgorithmResult> results = index.find(pattern, 1, complTT, os);
+    CHECK_NO_ERROR(os);
+    bool found = false;
+    foreach (const FindAlgorithmResult &result, results) {
+        found = found || (result.region == U2Region(300, pattern.length()) && result.strand == U2Strand::Direct && 0 == result.err);
+    }
+    CHECK_TRUE(found, "the site is not found");
+}
+
+} // U2
@@ -0,0 +1,59 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef _U2_PRIMER_SEED_INDEX_UNIT_TESTS_H_
+#define _U2_PRIMER_SEED_INDEX_UNIT_TESTS_H_
+
+#include <U2Algorithm/FindAlgorithm.h>
+
+#include <unittest.h>
+
+namespace U2 {
+
+class DNATranslation;
+
+class PrimerSeedIndexTestUtils {
+public:
+    static DNATranslation * getComplementTranslation();
+    // searches the pattern with the index and with FindAlgorithm, returns an empty string if the results are the same
+    static QString compareWithFindAlgorithm(const QByteArray &sequence, bool isCircular, const QByteArray &pattern, int maxErr, int seedLength);
+};
+
+/* The sites with substitutions are the same as FindAlgorithm finds */
+DECLARE_TEST(PrimerSeedIndexUnitTests, substitutions);
+/* Degenerate primer bases and ambiguous sequence characters */
+DECLARE_TEST(PrimerSeedIndexUnitTests, ambiguousBases);
+/* The sites that continue at the beginning of a circular sequence */
+DECLARE_TEST(PrimerSeedIndexUnitTests, circular);
+/* The sequence is scanned if the pattern is too short for the seeds */
+DECLARE_TEST(PrimerSeedIndexUnitTests, shortPattern);
+/* The canceled preparation leaves the index not prepared, so it can be prepared again */
+DECLARE_TEST(PrimerSeedIndexUnitTests, canceledPrepare);
+
+} // U2
+
+DECLARE_METATYPE(PrimerSeedIndexUnitTests, substitutions);
+DECLARE_METATYPE(PrimerSeedIndexUnitTests, ambiguousBases);
+DECLARE_METATYPE(PrimerSeedIndexUnitTests, circular);
+DECLARE_METATYPE(PrimerSeedIndexUnitTests, shortPattern);
+DECLARE_METATYPE(PrimerSeedIndexUnitTests, canceledPrepare);
+
+#endif // _U2_PRIMER_SEED_INDEX_UNIT_TESTS_H_
@@ -0,0 +1,97 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include <U2Algorithm/SyncSort.h>
+
+#include "SyncSortUnitTests.h"
+
+namespace U2 {
+
+QVector<quint64> SyncSortTestUtils::getRandomValues(int size, quint64 valuesCount, uint seed) {
+    QVector<quint64> values(size);
+    quint64 state = seed;
+    for (int i = 0; i < size; i++) {
+        state = state * Q_UINT64_C(6364136223846793005) + Q_UINT64_C(1442695040888963407);
+        values[i] = (state >> 20) % valuesCount;
+    }
+    return values;
+}
+
+QString SyncSortTestUtils::compareWithSequentialSort(const QVector<quint64> &values, int threadCount) {
+    QVector<int> indexes(values.size());
+    for (int i = 0; i < indexes.size(); i++) {
+        indexes[i] = i;
+    }
+
+    QVector<quint64> expectedValues = values;
+    QVector<int> expectedIndexes = indexes;
+    SyncSort<quint64, int> sequentialSort(expectedValues, expectedIndexes);
+    sequentialSort.sort();
+
+    QVector<quint64> actualValues = values;
+    QVector<int> actualIndexes = indexes;
+    SyncSort<quint64, int> parallelSort(actualValues, actualIndexes);
+    parallelSort.sort(threadCount);
+
+    for (int i = 0; i < values.size(); i++) {
+        CHECK(i == 0 || expectedValues[i - 1] <= expectedValues[i], QString("the values are not sorted at %1").arg(i));
+        CHECK(values[expectedIndexes[i]] == expectedValues[i], QString("the index does not follow the value at %1").arg(i));
+        CHECK(expectedValues[i] == actualValues[i] && expectedIndexes[i] == actualIndexes[i],
+              QString("unexpected element %1: expected %2 (index %3), got %4 (index %5)")
+              .arg(i).arg(expectedValues[i]).arg(expectedIndexes[i]).arg(actualValues[i]).arg(actualIndexes[i]));
+    }
+    return QString();
+}
+
+IMPLEMENT_TEST(SyncSortUnitTests, parallel_randomValues) {
+    const QVector<quint64> values = SyncSortTestUtils::getRandomValues(500000, Q_UINT64_C(1) << 40, 1);
+    const QString error = SyncSortTestUtils::compareWithSequentialSort(values, 4);
+    CHECK_TRUE(error.isEmpty(), error);
+}
+
+IMPLEMENT_TEST(SyncSortUnitTests, parallel_repeatedValues) {
+    const QVector<quint64> values = SyncSortTestUtils::getRandomValues(300000, 16, 2);
+    const QString error = SyncSortTestUtils::compareWithSequentialSort(values, 8);
+    CHECK_TRUE(error.isEmpty(), error);
+}
+
+IMPLEMENT_TEST(SyncSortUnitTests, parallel_sortedValues) {
+    QVector<quint64> values(200000);
+    for (int i = 0; i < values.size(); i++) {
+        values[i] = i / 3;
+    }
+    QString error = SyncSortTestUtils::compareWithSequentialSort(values, 4);
+    CHECK_TRUE(error.isEmpty(), error);
+
+    for (int i = 0; i < values.size(); i++) {
+        values[i] = values.size() - i / 3;
+    }
+    error = SyncSortTestUtils::compareWithSequentialSort(values, 4);
+    CHECK_TRUE(error.isEmpty(), error);
+}
+
+IMPLEMENT_TEST(SyncSortUnitTests, parallel_smallArray) {
+    const QVector<quint64> values = SyncSortTestUtils::getRandomValues(1000, 100, 3);
+    const QString error = SyncSortTestUtils::compareWithSequentialSort(values, 4);
+    CHECK_TRUE(error.isEmpty(), error);
+}
+
+} // U2
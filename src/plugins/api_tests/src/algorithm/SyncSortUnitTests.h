@@ -0,0 +1,54 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef _U2_SYNC_SORT_UNIT_TESTS_H_
+#define _U2_SYNC_SORT_UNIT_TESTS_H_
+
+#include <QVector>
+
+#include <unittest.h>
+
+namespace U2 {
+
+class SyncSortTestUtils {
+public:
+    static QVector<quint64> getRandomValues(int size, quint64 valuesCount, uint seed);
+    // sorts the values with sort() and sort(threadCount), returns an empty string if the values and the indexes are the same
+    static QString compareWithSequentialSort(const QVector<quint64> &values, int threadCount);
+};
+
+/* Several threads give the same order as one thread */
+DECLARE_TEST(SyncSortUnitTests, parallel_randomValues);
+/* The order of the indexes of equal values is the same as the order of the sequential sort */
+DECLARE_TEST(SyncSortUnitTests, parallel_repeatedValues);
+/* Sorted and reversed values */
+DECLARE_TEST(SyncSortUnitTests, parallel_sortedValues);
+/* The array that is too small for threads is sorted */
+DECLARE_TEST(SyncSortUnitTests, parallel_smallArray);
+
+} // U2
+
+DECLARE_METATYPE(SyncSortUnitTests, parallel_randomValues);
+DECLARE_METATYPE(SyncSortUnitTests, parallel_repeatedValues);
+DECLARE_METATYPE(SyncSortUnitTests, parallel_sortedValues);
+DECLARE_METATYPE(SyncSortUnitTests, parallel_smallArray);
+
+#endif // _U2_SYNC_SORT_UNIT_TESTS_H_
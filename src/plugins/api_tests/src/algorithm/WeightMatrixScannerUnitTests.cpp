@@ -0,0 +1,139 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include <U2Algorithm/WeightMatrixAlgorithm.h>
+
+#include <U2Core/AppContext.h>
+#include <U2Core/DIProperties.h>
+#include <U2Core/DNAAlphabet.h>
+#include <U2Core/DNATranslation.h>
+#include <U2Core/U2SafePoints.h>
+
+#include "WeightMatrixScannerUnitTests.h"
+
+namespace U2 {
+
+QByteArray WeightMatrixScannerTestUtils::getRandomSequence(int length, uint seed) {
+    static const char BASES[] = "ACGT";
+    QByteArray sequence(length, 'A');
+    uint state = seed;
+    for (int i = 0; i < length; i++) {
+        state = state * 1103515245 + 12345;
+        sequence[i] = BASES[(state >> 16) & 3];
+    }
+    return sequence;
+}
+
+DNATranslation * WeightMatrixScannerTestUtils::getComplementTranslation() {
+    const DNAAlphabet *alphabet = AppContext::getDNAAlphabetRegistry()->findById(BaseDNAAlphabetIds::NUCL_DNA_DEFAULT());
+    CHECK(NULL != alphabet, NULL);
+    return AppContext::getDNATranslationRegistry()->lookupComplementTranslation(alphabet);
+}
+
+PWMatrix WeightMatrixScannerTestUtils::getRandomMatrix(int length, PWMatrixType type, uint seed) {
+    const int rows = (PWM_MONONUCLEOTIDE == type) ? 4 : 16;
+    QVarLengthArray<float> values(rows * length);
+    uint state = seed;
+    for (int i = 0; i < values.size(); i++) {
+        state = state * 1103515245 + 12345;
+        values[i] = ((state >> 16) & 0x3FF) / 256.0f - 2.0f;
+    }
+    return PWMatrix(values, type);
+}
+
+QByteArray WeightMatrixScannerTestUtils::getConsensus(const PWMatrix &matrix) {
+    QByteArray consensus(matrix.getLength(), 'A');
+    for (int i = 0; i < matrix.getLength(); i++) {
+        int best = 0;
+        for (int j = 1; j < 4; j++) {
+            best = (matrix.getValue(j, i) > matrix.getValue(best, i)) ? j : best;
+        }
+        consensus[i] = DiProperty::fromIndex(best);
+    }
+    return consensus;
+}
+
+QString WeightMatrixScannerTestUtils::compareWithGetScore(const QByteArray &sequence, const PWMatrix &matrix, float minScore, int &acceptedCount) {
+    DNATranslation *complTT = getComplementTranslation();
+    CHECK(NULL != complTT, "no complement translation");
+    WeightMatrixSequenceCodes codes(sequence, complTT);
+    codes.prepare();
+    WeightMatrixScanner scanner(matrix);
+
+    acceptedCount = 0;
+    for (int pos = 0; pos + matrix.getLength() <= sequence.length(); pos++) {
+        for (int strand = 0; strand < 2; strand++) {
+            const bool complement = (1 == strand);
+            const float expected = WeightMatrixAlgorithm::getScore(sequence.constData() + pos, matrix.getLength(), matrix, complement ? complTT : NULL);
+            float actual = -1;
+            const bool accepted = scanner.getScore(codes, pos, complement, minScore, actual);
+            CHECK(accepted || expected < minScore,
+                  QString("the position %1 (complement: %2) with the score %3 is pruned").arg(pos).arg(complement ? "yes" : "no").arg(expected));
+            CHECK(!accepted || expected == actual,
+                  QString("unexpected score at %1 (complement: %2): expected %3, got %4").arg(pos).arg(complement ? "yes" : "no").arg(expected).arg(actual));
+            acceptedCount += accepted ? 1 : 0;
+        }
+    }
+    return QString();
+}
+
+IMPLEMENT_TEST(WeightMatrixScannerUnitTests, mononucleotide) {
+    QByteArray sequence = WeightMatrixScannerTestUtils::getRandomSequence(3000, 30);
+    sequence[10] = 'N';
+    sequence[sequence.length() - 3] = 'N';
+    const PWMatrix matrix = WeightMatrixScannerTestUtils::getRandomMatrix(12, PWM_MONONUCLEOTIDE, 31);
+
+    int acceptedCount = 0;
+    const QString error = WeightMatrixScannerTestUtils::compareWithGetScore(sequence, matrix, 0.0f, acceptedCount);
+    CHECK_TRUE(error.isEmpty(), error);
+    CHECK_EQUAL(2 * (sequence.length() - matrix.getLength() + 1), acceptedCount, "accepted positions count");
+}
+
+IMPLEMENT_TEST(WeightMatrixScannerUnitTests, dinucleotide) {
+    QByteArray sequence = WeightMatrixScannerTestUtils::getRandomSequence(3000, 32);
+    sequence[20] = 'N';
+    const PWMatrix matrix = WeightMatrixScannerTestUtils::getRandomMatrix(10, PWM_DINUCLEOTIDE, 33);
+
+    int acceptedCount = 0;
+    const QString error = WeightMatrixScannerTestUtils::compareWithGetScore(sequence, matrix, 0.0f, acceptedCount);
+    CHECK_TRUE(error.isEmpty(), error);
+    CHECK_EQUAL(2 * (sequence.length() - matrix.getLength() + 1), acceptedCount, "accepted positions count");
+}
+
+IMPLEMENT_TEST(WeightMatrixScannerUnitTests, pruning) {
+    const PWMatrix matrix = WeightMatrixScannerTestUtils::getRandomMatrix(15, PWM_MONONUCLEOTIDE, 34);
+    QByteArray sequence = WeightMatrixScannerTestUtils::getRandomSequence(5000, 35);
+    sequence.replace(1000, matrix.getLength(), WeightMatrixScannerTestUtils::getConsensus(matrix));
+
+    const float minScores[] = {0.5f, 0.8f, 0.95f, 1.0f};
+    int previousCount = -1;
+    for (int i = 0; i < 4; i++) {
+        int acceptedCount = 0;
+        const QString error = WeightMatrixScannerTestUtils::compareWithGetScore(sequence, matrix, minScores[i], acceptedCount);
+        CHECK_TRUE(error.isEmpty(), error);
+        // the consensus always reaches the maximum score
+        CHECK_TRUE(acceptedCount > 0, QString("nothing is found with the minimum score %1").arg(minScores[i]));
+        CHECK_TRUE(previousCount < 0 || acceptedCount <= previousCount, "a higher minimum score accepts more positions");
+        previousCount = acceptedCount;
+    }
+}
+
+} // U2
@@ -0,0 +1,58 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef _U2_WEIGHT_MATRIX_SCANNER_UNIT_TESTS_H_
+#define _U2_WEIGHT_MATRIX_SCANNER_UNIT_TESTS_H_
+
+#include <U2Core/PWMatrix.h>
+
+#include <unittest.h>
+
+namespace U2 {
+
+class DNATranslation;
+
+class WeightMatrixScannerTestUtils {
+public:
+    static QByteArray getRandomSequence(int length, uint seed);
+    static DNATranslation * getComplementTranslation();
+    static PWMatrix getRandomMatrix(int length, PWMatrixType type, uint seed);
+    // the sequence of the maximum values of the mononucleotide matrix columns
+    static QByteArray getConsensus(const PWMatrix &matrix);
+    // scores all positions of both strands with the scanner and with WeightMatrixAlgorithm::getScore,
+    // returns an empty string if the scanner keeps exactly the positions with the scores not less than the minimum
+    static QString compareWithGetScore(const QByteArray &sequence, const PWMatrix &matrix, float minScore, int &acceptedCount);
+};
+
+/* The mononucleotide scores of both strands are equal to WeightMatrixAlgorithm::getScore */
+DECLARE_TEST(WeightMatrixScannerUnitTests, mononucleotide);
+/* The dinucleotide scores of both strands are equal to WeightMatrixAlgorithm::getScore */
+DECLARE_TEST(WeightMatrixScannerUnitTests, dinucleotide);
+/* The positions that reach the minimum score are not pruned */
+DECLARE_TEST(WeightMatrixScannerUnitTests, pruning);
+
+} // U2
+
+DECLARE_METATYPE(WeightMatrixScannerUnitTests, mononucleotide);
+DECLARE_METATYPE(WeightMatrixScannerUnitTests, dinucleotide);
+DECLARE_METATYPE(WeightMatrixScannerUnitTests, pruning);
+
+#endif // _U2_WEIGHT_MATRIX_SCANNER_UNIT_TESTS_H_
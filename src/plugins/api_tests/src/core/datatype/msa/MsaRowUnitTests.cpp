@@ -22,6 +22,7 @@
 #include "MsaRowUnitTests.h"
 
 #include <U2Core/DNASequence.h>
+#include <U2Core/MsaRowGapIndex.h>
 #include <U2Core/U2Msa.h>
 #include <U2Core/U2OpStatusUtils.h>
 
@@ -70,6 +71,12 @@ MultipleSequenceAlignmentRow MsaRowTestUtils::initTestRowForModification(Multipl
     return almnt->getMsaRow(0)->getExplicitCopy(); // "A---ACG--GTT-A-C---G"
 }
 
+MultipleSequenceAlignmentRow MsaRowTestUtils::initTestRowWithManyGaps(MultipleSequenceAlignment& almnt) {
+    almnt->setName("For row with many gaps");
+    almnt->addRow("Row with many gaps", "--" + QByteArray("AC-G--").repeated(MsaRowGapIndexCache::MIN_GAPS_COUNT_TO_INDEX) + "T");
+    return almnt->getMsaRow(0)->getExplicitCopy(); // "--AC-G--AC-G-- ... AC-G--T"
+}
+
 QString MsaRowTestUtils::getRowData(const MultipleSequenceAlignmentRow &row) {
     U2OpStatusImpl os;
     QString result = row->toByteArray(os, row->getRowLength()).data();
@@ -77,6 +84,19 @@ QString MsaRowTestUtils::getRowData(const MultipleSequenceAlignmentRow &row) {
     return result;
 }
 
+bool MsaRowTestUtils::checkCharAt(const MultipleSequenceAlignmentRow &row, const QString &expectedData) {
+    for (int i = -1; i <= expectedData.length() + 1; i++) {
+        const char expectedChar = (i >= 0 && i < expectedData.length()) ? expectedData[i].toLatin1() : U2Msa::GAP_CHAR;
+        if (expectedChar != row->charAt(i)) {
+            return false;
+        }
+        if (i >= 0 && (U2Msa::GAP_CHAR == expectedChar) != row->isGap(i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
 
 /** Tests createRow */
 IMPLEMENT_TEST(MsaRowUnitTests, createRow_fromBytes) {
@@ -1039,6 +1059,58 @@ IMPLEMENT_TEST(MsaRowUnitTests, charAt_onlyCharsInRow) {
     CHECK_EQUAL('-', ch, "char 3");
 }
 
+IMPLEMENT_TEST(MsaRowUnitTests, charAt_manyGaps) {
+    MultipleSequenceAlignment almnt;
+    MultipleSequenceAlignmentRow row = MsaRowTestUtils::initTestRowWithManyGaps(almnt);
+    CHECK_TRUE(row->getGapModel().size() >= MsaRowGapIndexCache::MIN_GAPS_COUNT_TO_INDEX, "The row gaps are not indexed");
+
+    const QString expectedData = "--" + QString("AC-G--").repeated(MsaRowGapIndexCache::MIN_GAPS_COUNT_TO_INDEX) + "T";
+    CHECK_EQUAL(expectedData, MsaRowTestUtils::getRowData(row), "row data");
+    CHECK_TRUE(MsaRowTestUtils::checkCharAt(row, expectedData), "Incorrect chars in the row");
+}
+
+IMPLEMENT_TEST(MsaRowUnitTests, charAt_manyGapsModified) {
+    MultipleSequenceAlignment almnt;
+    MultipleSequenceAlignmentRow row = MsaRowTestUtils::initTestRowWithManyGaps(almnt);
+    CHECK_TRUE(MsaRowTestUtils::checkCharAt(row, MsaRowTestUtils::getRowData(row)), "Incorrect chars in the row");
+
+    U2OpStatusImpl os;
+    row->insertGaps(3, 2, os);
+    CHECK_NO_ERROR(os);
+    CHECK_TRUE(MsaRowTestUtils::checkCharAt(row, MsaRowTestUtils::getRowData(row)), "Incorrect chars after the gaps insertion");
+
+    row->removeChars(10, 7, os);
+    CHECK_NO_ERROR(os);
+    CHECK_TRUE(MsaRowTestUtils::checkCharAt(row, MsaRowTestUtils::getRowData(row)), "Incorrect chars after the chars removing");
+
+    row->replaceChars('C', U2Msa::GAP_CHAR, os);
+    CHECK_NO_ERROR(os);
+    CHECK_TRUE(MsaRowTestUtils::checkCharAt(row, MsaRowTestUtils::getRowData(row)), "Incorrect chars after the chars replacing");
+
+    row->crop(os, 5, 40);
+    CHECK_NO_ERROR(os);
+    CHECK_TRUE(MsaRowTestUtils::checkCharAt(row, MsaRowTestUtils::getRowData(row)), "Incorrect chars after the row cropping");
+
+    row->simplify();
+    CHECK_TRUE(row->getGapModel().isEmpty(), "The row has gaps after simplifying");
+    CHECK_TRUE(MsaRowTestUtils::checkCharAt(row, MsaRowTestUtils::getRowData(row)), "Incorrect chars after the row simplifying");
+}
+
+IMPLEMENT_TEST(MsaRowUnitTests, charAt_manyGapsCopy) {
+    MultipleSequenceAlignment almnt;
+    MultipleSequenceAlignmentRow row = MsaRowTestUtils::initTestRowWithManyGaps(almnt);
+    const QString expectedData = MsaRowTestUtils::getRowData(row);
+    CHECK_TRUE(MsaRowTestUtils::checkCharAt(row, expectedData), "Incorrect chars in the row");
+
+    MultipleSequenceAlignmentRow rowCopy = row->getExplicitCopy();
+    CHECK_TRUE(MsaRowTestUtils::checkCharAt(rowCopy, expectedData), "Incorrect chars in the row copy");
+
+    U2OpStatusImpl os;
+    rowCopy->insertGaps(0, 3, os);
+    CHECK_NO_ERROR(os);
+    CHECK_TRUE(MsaRowTestUtils::checkCharAt(rowCopy, MsaRowTestUtils::getRowData(rowCopy)), "Incorrect chars in the modified row copy");
+    CHECK_TRUE(MsaRowTestUtils::checkCharAt(row, expectedData), "The original row is changed");
+}
 
 /** Tests rowEqual */
 IMPLEMENT_TEST(MsaRowUnitTests, rowsEqual_sameContent) {
@@ -37,7 +37,10 @@ public:
     static MultipleSequenceAlignmentRow initTestRowWithoutGaps(MultipleSequenceAlignment& ma);
     static MultipleSequenceAlignmentRow initTestRowForModification(MultipleSequenceAlignment& ma);
     static MultipleSequenceAlignmentRow initEmptyRow(MultipleSequenceAlignment& ma);
+    static MultipleSequenceAlignmentRow initTestRowWithManyGaps(MultipleSequenceAlignment& ma);
     static QString getRowData(const MultipleSequenceAlignmentRow &row);
+    /** Verifies charAt() and isGap() for each row position against the expected row data */
+    static bool checkCharAt(const MultipleSequenceAlignmentRow &row, const QString &expectedData);
 
     static const int rowWithGapsLength;
     static const int rowWithGapsInMiddleLength;
@@ -232,10 +235,16 @@ DECLARE_TEST(MsaRowUnitTests, remove_oneCharInGaps);
  *   ^ allCharsNoOffset  - verify all indexes of a row without gap offset in the beginning
  *   ^ offsetAndTrailing - verify gaps at the beginning and end of a row
  *   ^ onlyCharsInRow    - there are no gaps in the row
+ *   ^ manyGaps          - the row has enough gaps to be indexed, verify all indexes and isGap()
+ *   ^ manyGapsModified  - the indexed row is modified: the index must be rebuilt
+ *   ^ manyGapsCopy      - a copy of the indexed row is modified: the original row must not change
  */
 DECLARE_TEST(MsaRowUnitTests, charAt_allCharsNoOffset);
 DECLARE_TEST(MsaRowUnitTests, charAt_offsetAndTrailing);
 DECLARE_TEST(MsaRowUnitTests, charAt_onlyCharsInRow);
+DECLARE_TEST(MsaRowUnitTests, charAt_manyGaps);
+DECLARE_TEST(MsaRowUnitTests, charAt_manyGapsModified);
+DECLARE_TEST(MsaRowUnitTests, charAt_manyGapsCopy);
 
 /**
  * Checking if rows are equal (method "isRowContentEqual", "operator==", "operator!="):
@@ -418,6 +427,9 @@ DECLARE_METATYPE(MsaRowUnitTests, remove_oneCharInGaps)
 DECLARE_METATYPE(MsaRowUnitTests, charAt_allCharsNoOffset)
 DECLARE_METATYPE(MsaRowUnitTests, charAt_offsetAndTrailing)
 DECLARE_METATYPE(MsaRowUnitTests, charAt_onlyCharsInRow)
+DECLARE_METATYPE(MsaRowUnitTests, charAt_manyGaps)
+DECLARE_METATYPE(MsaRowUnitTests, charAt_manyGapsModified)
+DECLARE_METATYPE(MsaRowUnitTests, charAt_manyGapsCopy)
 DECLARE_METATYPE(MsaRowUnitTests, rowsEqual_sameContent)
 DECLARE_METATYPE(MsaRowUnitTests, rowsEqual_noGaps)
 DECLARE_METATYPE(MsaRowUnitTests, rowsEqual_trailingInFirst)
@@ -43,12 +43,30 @@ TestDbiProvider::TestDbiProvider() :
 TestDbiProvider::~TestDbiProvider(){
     close();
 }
-bool TestDbiProvider::init(const QString& dbiFileName, bool _useConnectionPool){
+bool TestDbiProvider::init(const QString& dbiFileName, bool _useConnectionPool, const QString& dbiFactoryId){
     if(initialized){
         close();
         initialized = false;
     }
 
+    U2DbiFactory *factory = AppContext::getDbiRegistry()->getDbiFactoryById(dbiFactoryId);
+    SAFE_POINT(factory!=NULL, "No dbi factory", false);
+
+    if (MEMORY_DBI_ID == dbiFactoryId) {
+        dbUrl = dbiFileName;
+        useConnectionPool = false;
+        dbi = factory->createDbi();
+        SAFE_POINT(NULL != dbi, "dbi not created", false);
+        QHash<QString, QString> properties;
+        properties[U2DbiOptions::U2_DBI_OPTION_CREATE] = U2DbiOptions::U2_DBI_VALUE_ON;
+        properties[U2DbiOptions::U2_DBI_OPTION_URL] = dbUrl;
+        U2OpStatusImpl opStatus;
+        dbi->init(properties, QVariantMap(), opStatus);
+        SAFE_POINT_OP(opStatus, false);
+        initialized = true;
+        return true;
+    }
+
     TestRunnerSettings* trs = AppContext::getAppSettings()->getTestRunnerSettings();
     QString originalFile = trs->getVar("COMMON_DATA_DIR") + "/" + dbiFileName;
 
@@ -68,8 +86,6 @@ bool TestDbiProvider::init(const QString& dbiFileName, bool _useConnectionPool){
     dbUrl = tmpFile;
     useConnectionPool = _useConnectionPool;
 
-    U2DbiFactory *factory = AppContext::getDbiRegistry()->getDbiFactoryById(SQLITE_DBI_ID);
-    SAFE_POINT(factory!=NULL, "No dbi factory", false);
     U2OpStatusImpl opStatus;
 
     if(useConnectionPool){
@@ -2,20 +2,22 @@
 #define DBITEST_H
 
 #include <U2Core/U2Dbi.h>
+#include <U2Core/U2DbiRegistry.h>
 #include <unittest.h>
 
 namespace U2 {
 
 /*Helper to provide dbi for tests tests.
 In case you need to open a connection within your test useConnectionPool must be true to use the connection pool
-if you don't need to open connections within your test useConnectionPool must be false to use created dbi without the pool*/
+if you don't need to open connections within your test useConnectionPool must be false to use created dbi without the pool.
+The dbi of MEMORY_DBI_ID factory is always created empty: dbiFileName is used as its URL only*/
 
 class TestDbiProvider{
 public:
     TestDbiProvider();
     ~TestDbiProvider();
 
-    bool init(const QString& dbiFileName, bool useConnectionPool);
+    bool init(const QString& dbiFileName, bool useConnectionPool, const QString& dbiFactoryId = SQLITE_DBI_ID);
     void close();
     U2Dbi* getDbi();
 private:
@@ -25,6 +27,33 @@ private:
     U2Dbi* dbi;
 };
 
+/** Declares a dbi test and its "_memoryDbi" twin that runs the same body against the in-memory dbi.
+    'dataClass' must provide static setDbiFactoryId(): the test data is reinitialized when the factory changes */
+#define DECLARE_DBI_TEST(suite, name, dataClass) \
+    class TEST_CLASS(suite, name) : public UnitTest { \
+    public: \
+        virtual void SetUp() { dataClass::setDbiFactoryId(SQLITE_DBI_ID); } \
+        virtual void Test(); \
+    }; \
+    class TEST_CLASS(suite, name##_memoryDbi) : public TEST_CLASS(suite, name) { \
+    public: \
+        virtual void SetUp() { dataClass::setDbiFactoryId(MEMORY_DBI_ID); } \
+    }
+
+/** Place this in header file, outside (!) namespace U2, for the tests declared with DECLARE_DBI_TEST */
+#define DECLARE_DBI_METATYPE(suite, name) \
+    DECLARE_METATYPE(suite, name); \
+    DECLARE_METATYPE(suite, name##_memoryDbi)
+
+/** Registers the "_memoryDbi" twin, place it in cpp file before the IMPLEMENT_TEST of a test declared with DECLARE_DBI_TEST */
+#define REGISTER_MEMORY_DBI_TEST(suite, name) \
+    static const int _##suite##_##name##_memoryDbi_type ATTR_UNUSED = qRegisterMetaType<U2::TEST_CLASS(suite, name##_memoryDbi)>(TEST_CLASS_STR(suite, name##_memoryDbi))
+
+/** The same as IMPLEMENT_TEST, registers the "_memoryDbi" twin too */
+#define IMPLEMENT_DBI_TEST(suite, name) \
+    REGISTER_MEMORY_DBI_TEST(suite, name); \
+    IMPLEMENT_TEST(suite, name)
+
 template<> inline QString toString<U2DataId>(const U2DataId &a) { return "0x" + QString(a.toHex()); }
 template<> inline QString toString<U2Region>(const U2Region &r) { return r.toString(); }
 
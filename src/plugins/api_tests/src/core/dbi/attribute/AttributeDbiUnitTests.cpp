@@ -7,6 +7,7 @@
 #include <U2Core/U2ObjectDbi.h>
 #include <U2Core/U2SqlHelpers.h>
 #include <U2Core/U2SafePoints.h>
+#include <U2Core/U2SequenceDbi.h>
 
 namespace U2 {
 
@@ -23,31 +24,46 @@ const QString& AttributeTestData::ATT_DB_URL("attribute-dbi.ugenedb");
 U2AttributeDbi* AttributeTestData::attributeDbi = NULL;
 QList<U2DataId>* AttributeTestData::objects = NULL;
 TestDbiProvider AttributeTestData::dbiProvider = TestDbiProvider();
+QString AttributeTestData::dbiFactoryId = SQLITE_DBI_ID;
 
 static bool registerTests(){
     qRegisterMetaType<U2::AttributeDbiUnitTests_ByteArrayAttribute>("AttributeDbiUnitTests_ByteArrayAttribute");
+    qRegisterMetaType<U2::AttributeDbiUnitTests_ByteArrayAttribute_memoryDbi>("AttributeDbiUnitTests_ByteArrayAttribute_memoryDbi");
     qRegisterMetaType<U2::AttributeDbiUnitTests_getAvailableAttributeNames>("AttributeDbiUnitTests_getAvailableAttributeNames");
     qRegisterMetaType<U2::AttributeDbiUnitTests_getObjectAttributes>("AttributeDbiUnitTests_getObjectAttributes");
     qRegisterMetaType<U2::AttributeDbiUnitTests_getObjectAttributesByName>("AttributeDbiUnitTests_getObjectAttributesByName");
     qRegisterMetaType<U2::AttributeDbiUnitTests_getObjectPairAttributes>("AttributeDbiUnitTests_getObjectPairAttributes");
     qRegisterMetaType<U2::AttributeDbiUnitTests_getObjectPairAttributesByName>("AttributeDbiUnitTests_getObjectPairAttributesByName");
     qRegisterMetaType<U2::AttributeDbiUnitTests_IntegerAttribute>("AttributeDbiUnitTests_IntegerAttribute");
+    qRegisterMetaType<U2::AttributeDbiUnitTests_IntegerAttribute_memoryDbi>("AttributeDbiUnitTests_IntegerAttribute_memoryDbi");
     qRegisterMetaType<U2::AttributeDbiUnitTests_RealAttribute>("AttributeDbiUnitTests_RealAttribute");
+    qRegisterMetaType<U2::AttributeDbiUnitTests_RealAttribute_memoryDbi>("AttributeDbiUnitTests_RealAttribute_memoryDbi");
     qRegisterMetaType<U2::AttributeDbiUnitTests_removeAttributes>("AttributeDbiUnitTests_removeAttributes");
+    qRegisterMetaType<U2::AttributeDbiUnitTests_removeAttributes_memoryDbi>("AttributeDbiUnitTests_removeAttributes_memoryDbi");
     qRegisterMetaType<U2::AttributeDbiUnitTests_removeObjectAttributes>("AttributeDbiUnitTests_removeObjectAttributes");
+    qRegisterMetaType<U2::AttributeDbiUnitTests_removeObjectAttributes_memoryDbi>("AttributeDbiUnitTests_removeObjectAttributes_memoryDbi");
     qRegisterMetaType<U2::AttributeDbiUnitTests_StringAttribute>("AttributeDbiUnitTests_StringAttribute");
+    qRegisterMetaType<U2::AttributeDbiUnitTests_StringAttribute_memoryDbi>("AttributeDbiUnitTests_StringAttribute_memoryDbi");
     return true;
 }
 
 bool AttributeTestData::registerTest = registerTests();
 
 void AttributeTestData::init() {
-    bool ok = dbiProvider.init(ATT_DB_URL, false);
+    bool ok = dbiProvider.init(ATT_DB_URL, false, dbiFactoryId);
     SAFE_POINT(ok, "dbi provider failed to initialize",);
     U2Dbi* dbi = dbiProvider.getDbi();
     U2ObjectDbi* objDbi = dbi->getObjectDbi();
     U2OpStatusImpl opStatus;
 
+    if (MEMORY_DBI_ID == dbiFactoryId) {
+        // the memory dbi is created empty: the attributes need an object
+        U2Sequence sequence;
+        sequence.alphabet = BaseDNAAlphabetIds::NUCL_DNA_DEFAULT();
+        dbi->getSequenceDbi()->createSequenceObject(sequence, "/", opStatus);
+        SAFE_POINT_OP(opStatus, );
+    }
+
     objects = new QList<U2DataId>(objDbi->getObjects("/", 0, U2DbiOptions::U2_DBI_NO_LIMIT, opStatus));
     SAFE_POINT_OP(opStatus, );
 
@@ -67,10 +83,18 @@ void AttributeTestData::shutdown() {
         U2OpStatusImpl opStatus;
         dbiProvider.close();
         attributeDbi = NULL;
+        delete objects;
+        objects = NULL;
         SAFE_POINT_OP(opStatus, );
     }
 }
 
+void AttributeTestData::setDbiFactoryId(const QString& newDbiFactoryId) {
+    CHECK(dbiFactoryId != newDbiFactoryId, );
+    shutdown();
+    dbiFactoryId = newDbiFactoryId;
+}
+
 static bool compareAttributesBase(const U2Attribute& attr1, const U2Attribute& attr2) {
     if (attr1.objectId != attr2.objectId) {
         return false;
@@ -16,6 +16,7 @@ public:
     static QList<U2DataId>* getObjects() { return objects; }
     static void init();
     static void shutdown();
+    static void setDbiFactoryId(const QString& dbiFactoryId);
     static void testAttributesMatch(QList<U2IntegerAttribute>& expectedInt,
                          QList<U2RealAttribute>& expectedReal,
                          QList<U2StringAttribute>& expectedString,
@@ -32,6 +33,7 @@ protected:
     static const QString& ATT_DB_URL;
 
     static TestDbiProvider dbiProvider;
+    static QString dbiFactoryId;
     static bool registerTest;
 };
 
@@ -69,36 +71,18 @@ public:
     void Test();
 };
 
-class AttributeDbiUnitTests_removeAttributes : public UnitTest {
-public:
-    void Test();
-};
+DECLARE_DBI_TEST(AttributeDbiUnitTests, removeAttributes, AttributeTestData);
 
-class AttributeDbiUnitTests_removeObjectAttributes : public UnitTest {
-public:
-    void Test();
-};
+DECLARE_DBI_TEST(AttributeDbiUnitTests, removeObjectAttributes, AttributeTestData);
 
-class AttributeDbiUnitTests_IntegerAttribute : public UnitTest {
-public:
-    void Test();
-};
+DECLARE_DBI_TEST(AttributeDbiUnitTests, IntegerAttribute, AttributeTestData);
 
-class AttributeDbiUnitTests_RealAttribute : public UnitTest {
-public:
-    void Test();
-};
+DECLARE_DBI_TEST(AttributeDbiUnitTests, RealAttribute, AttributeTestData);
 
 
-class AttributeDbiUnitTests_StringAttribute : public UnitTest {
-public:
-    void Test();
-};
+DECLARE_DBI_TEST(AttributeDbiUnitTests, StringAttribute, AttributeTestData);
 
-class AttributeDbiUnitTests_ByteArrayAttribute : public UnitTest {
-public:
-    void Test();
-};
+DECLARE_DBI_TEST(AttributeDbiUnitTests, ByteArrayAttribute, AttributeTestData);
 
 } //namespace
 
@@ -109,15 +93,21 @@ Q_DECLARE_METATYPE(U2::U2ByteArrayAttribute);
 Q_DECLARE_METATYPE(U2::ObjectAttributesTestData);
 
 Q_DECLARE_METATYPE(U2::AttributeDbiUnitTests_ByteArrayAttribute);
+Q_DECLARE_METATYPE(U2::AttributeDbiUnitTests_ByteArrayAttribute_memoryDbi);
 Q_DECLARE_METATYPE(U2::AttributeDbiUnitTests_getAvailableAttributeNames);
 Q_DECLARE_METATYPE(U2::AttributeDbiUnitTests_getObjectAttributes);
 Q_DECLARE_METATYPE(U2::AttributeDbiUnitTests_getObjectAttributesByName);
 Q_DECLARE_METATYPE(U2::AttributeDbiUnitTests_getObjectPairAttributes);
 Q_DECLARE_METATYPE(U2::AttributeDbiUnitTests_getObjectPairAttributesByName);
 Q_DECLARE_METATYPE(U2::AttributeDbiUnitTests_IntegerAttribute);
+Q_DECLARE_METATYPE(U2::AttributeDbiUnitTests_IntegerAttribute_memoryDbi);
 Q_DECLARE_METATYPE(U2::AttributeDbiUnitTests_RealAttribute);
+Q_DECLARE_METATYPE(U2::AttributeDbiUnitTests_RealAttribute_memoryDbi);
 Q_DECLARE_METATYPE(U2::AttributeDbiUnitTests_removeAttributes);
+Q_DECLARE_METATYPE(U2::AttributeDbiUnitTests_removeAttributes_memoryDbi);
 Q_DECLARE_METATYPE(U2::AttributeDbiUnitTests_removeObjectAttributes);
+Q_DECLARE_METATYPE(U2::AttributeDbiUnitTests_removeObjectAttributes_memoryDbi);
 Q_DECLARE_METATYPE(U2::AttributeDbiUnitTests_StringAttribute);
+Q_DECLARE_METATYPE(U2::AttributeDbiUnitTests_StringAttribute_memoryDbi);
 
 #endif
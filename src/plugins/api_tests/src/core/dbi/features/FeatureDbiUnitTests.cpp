@@ -35,6 +35,7 @@ TestDbiProvider FeatureTestData::dbiProvider = TestDbiProvider();
 TestDbiProvider FeatureTestData::subgroupsDbiProvider = TestDbiProvider();
 const QString FeatureTestData::featureDbiUrl("features-dbi.ugenedb");
 const QString FeatureTestData::subgroupDbiUrl("featureSubgroupsSorting.ugenedb");
+QString FeatureTestData::dbiFactoryId = SQLITE_DBI_ID;
 U2FeatureDbi *FeatureTestData::featureDbi = NULL;
 U2FeatureDbi *FeatureTestData::subgroupDbi = NULL;
 U2SequenceDbi *FeatureTestData::sequenceDbi = NULL;
@@ -42,7 +43,7 @@ U2SequenceDbi *FeatureTestData::sequenceDbi = NULL;
 void FeatureTestData::init() {
     SAFE_POINT(NULL == featureDbi, "featuresDbi has been already initialized!",);
 
-    bool ok = dbiProvider.init(featureDbiUrl, false);
+    bool ok = dbiProvider.init(featureDbiUrl, false, dbiFactoryId);
     SAFE_POINT(ok, "Dbi provider failed to initialize in FeaturesTestData::init()!",);
 
     U2Dbi *dbi = dbiProvider.getDbi();
@@ -81,6 +82,12 @@ void FeatureTestData::shutdown() {
     }
 }
 
+void FeatureTestData::setDbiFactoryId(const QString& newDbiFactoryId) {
+    CHECK(dbiFactoryId != newDbiFactoryId, );
+    shutdown();
+    dbiFactoryId = newDbiFactoryId;
+}
+
 U2FeatureDbi *FeatureTestData::getFeatureDbi() {
     if (NULL == featureDbi) {
         init();
@@ -176,7 +183,7 @@ U2Feature FeatureTestData::createTestFeatureWithoutKeys(const U2Sequence &seq, U
     return feature;
 }
 
-IMPLEMENT_TEST(FeatureDbiUnitTests, createFeature) {
+IMPLEMENT_DBI_TEST(FeatureDbiUnitTests, createFeature) {
     U2FeatureDbi *featureDbi = FeatureTestData::getFeatureDbi();
     U2SequenceDbi *sequenceDbi = FeatureTestData::getSequenceDbi();
 
@@ -200,7 +207,7 @@ IMPLEMENT_TEST(FeatureDbiUnitTests, createFeature) {
     CHECK_EQUAL(featureBackup.name, newFeature.name, "name");
 }
 
-IMPLEMENT_TEST(FeatureDbiUnitTests, getFeature) {
+IMPLEMENT_DBI_TEST(FeatureDbiUnitTests, getFeature) {
     U2FeatureDbi *featureDbi = FeatureTestData::getFeatureDbi();
     U2SequenceDbi *sequenceDbi = FeatureTestData::getSequenceDbi();
 
@@ -227,7 +234,7 @@ IMPLEMENT_TEST(FeatureDbiUnitTests, getFeature) {
     CHECK_EQUAL(featureBackup.name, newFeature.name, "name");
 }
 
-IMPLEMENT_TEST(FeatureDbiUnitTests, countFeatures) {
+IMPLEMENT_DBI_TEST(FeatureDbiUnitTests, countFeatures) {
     U2FeatureDbi *featureDbi = FeatureTestData::getFeatureDbi();
     U2SequenceDbi *sequenceDbi = FeatureTestData::getSequenceDbi();
 
@@ -295,7 +302,7 @@ IMPLEMENT_TEST(FeatureDbiUnitTests, countFeatures) {
     CHECK_EQUAL(1, queryResult, "sixth query count");
 }
 
-IMPLEMENT_TEST(FeatureDbiUnitTests, getFeatures) {
+IMPLEMENT_DBI_TEST(FeatureDbiUnitTests, getFeatures) {
     U2FeatureDbi *featureDbi = FeatureTestData::getFeatureDbi();
     U2SequenceDbi *sequenceDbi = FeatureTestData::getSequenceDbi();
 
@@ -377,7 +384,7 @@ IMPLEMENT_TEST(FeatureDbiUnitTests, getFeatures) {
     }
 }
 
-IMPLEMENT_TEST(FeatureDbiUnitTests, getFeatureKeys) {
+IMPLEMENT_DBI_TEST(FeatureDbiUnitTests, getFeatureKeys) {
     U2FeatureDbi *featureDbi = FeatureTestData::getFeatureDbi();
     U2SequenceDbi *sequenceDbi = FeatureTestData::getSequenceDbi();
 
@@ -412,7 +419,7 @@ IMPLEMENT_TEST(FeatureDbiUnitTests, getFeatureKeys) {
         "feature key count");
 }
 
-IMPLEMENT_TEST(FeatureDbiUnitTests, addKey) {
+IMPLEMENT_DBI_TEST(FeatureDbiUnitTests, addKey) {
     U2FeatureDbi *featureDbi = FeatureTestData::getFeatureDbi();
     U2SequenceDbi *sequenceDbi = FeatureTestData::getSequenceDbi();
 
@@ -440,7 +447,7 @@ IMPLEMENT_TEST(FeatureDbiUnitTests, addKey) {
     CHECK_EQUAL(keys.at(2).value, "value", "third feature key's value");
 }
 
-IMPLEMENT_TEST(FeatureDbiUnitTests, removeAllKeysByName) {
+IMPLEMENT_DBI_TEST(FeatureDbiUnitTests, removeAllKeysByName) {
     U2FeatureDbi *featureDbi = FeatureTestData::getFeatureDbi();
     U2SequenceDbi *sequenceDbi = FeatureTestData::getSequenceDbi();
 
@@ -477,7 +484,7 @@ IMPLEMENT_TEST(FeatureDbiUnitTests, removeAllKeysByName) {
     CHECK_EQUAL(0, keys.size(), "second feature key count");
 }
 
-IMPLEMENT_TEST(FeatureDbiUnitTests, removeAllKeys) {
+IMPLEMENT_DBI_TEST(FeatureDbiUnitTests, removeAllKeys) {
     U2FeatureDbi *featureDbi = FeatureTestData::getFeatureDbi();
     U2SequenceDbi *sequenceDbi = FeatureTestData::getSequenceDbi();
 
@@ -530,7 +537,7 @@ IMPLEMENT_TEST(FeatureDbiUnitTests, removeAllKeys) {
     CHECK_EQUAL(0, keys.size(), "first feature key count");
 }
 
-IMPLEMENT_TEST(FeatureDbiUnitTests, updateKeyValue) {
+IMPLEMENT_DBI_TEST(FeatureDbiUnitTests, updateKeyValue) {
     U2FeatureDbi *featureDbi = FeatureTestData::getFeatureDbi();
     U2SequenceDbi *sequenceDbi = FeatureTestData::getSequenceDbi();
 
@@ -578,7 +585,7 @@ IMPLEMENT_TEST(FeatureDbiUnitTests, updateKeyValue) {
     CHECK_EQUAL(keys.at(2).value, "C", "second feature 2nd key's value");
 }
 
-IMPLEMENT_TEST(FeatureDbiUnitTests, updateLocation) {
+IMPLEMENT_DBI_TEST(FeatureDbiUnitTests, updateLocation) {
     U2FeatureDbi *featureDbi = FeatureTestData::getFeatureDbi();
     U2SequenceDbi *sequenceDbi = FeatureTestData::getSequenceDbi();
 
@@ -603,7 +610,7 @@ IMPLEMENT_TEST(FeatureDbiUnitTests, updateLocation) {
         changedFeature.location.strand.getDirectionValue(), "feature region strand");
 }
 
-IMPLEMENT_TEST(FeatureDbiUnitTests, updateName) {
+IMPLEMENT_DBI_TEST(FeatureDbiUnitTests, updateName) {
     U2FeatureDbi *featureDbi = FeatureTestData::getFeatureDbi();
     U2SequenceDbi *sequenceDbi = FeatureTestData::getSequenceDbi();
 
@@ -623,7 +630,7 @@ IMPLEMENT_TEST(FeatureDbiUnitTests, updateName) {
     CHECK_EQUAL(newName, changedFeature.name, "feature name");
 }
 
-IMPLEMENT_TEST(FeatureDbiUnitTests, updateParentId) {
+IMPLEMENT_DBI_TEST(FeatureDbiUnitTests, updateParentId) {
     U2FeatureDbi *featureDbi = FeatureTestData::getFeatureDbi();
     U2SequenceDbi *sequenceDbi = FeatureTestData::getSequenceDbi();
 
@@ -645,7 +652,7 @@ IMPLEMENT_TEST(FeatureDbiUnitTests, updateParentId) {
     CHECK_EQUAL(secondParentFeature.id, changedFeature.parentFeatureId, "feature parent id");
 }
 
-IMPLEMENT_TEST(FeatureDbiUnitTests, removeFeature) {
+IMPLEMENT_DBI_TEST(FeatureDbiUnitTests, removeFeature) {
     U2FeatureDbi *featureDbi = FeatureTestData::getFeatureDbi();
     U2SequenceDbi *sequenceDbi = FeatureTestData::getSequenceDbi();
 
@@ -663,7 +670,7 @@ IMPLEMENT_TEST(FeatureDbiUnitTests, removeFeature) {
     CHECK_TRUE(changedFeature.id.isEmpty(), "Unexpected value of feature ID");
 }
 
-IMPLEMENT_TEST(FeatureDbiUnitTests, getFeaturesByRegion) {
+IMPLEMENT_DBI_TEST(FeatureDbiUnitTests, getFeaturesByRegion) {
     U2FeatureDbi *featureDbi = FeatureTestData::getFeatureDbi();
     U2SequenceDbi *sequenceDbi = FeatureTestData::getSequenceDbi();
 
@@ -689,7 +696,7 @@ IMPLEMENT_TEST(FeatureDbiUnitTests, getFeaturesByRegion) {
     }
 }
 
-IMPLEMENT_TEST(FeatureDbiUnitTests, getSubFeatures) {
+IMPLEMENT_DBI_TEST(FeatureDbiUnitTests, getSubFeatures) {
     U2FeatureDbi *featureDbi = FeatureTestData::getFeatureDbi();
     U2SequenceDbi *sequenceDbi = FeatureTestData::getSequenceDbi();
 
@@ -715,7 +722,7 @@ IMPLEMENT_TEST(FeatureDbiUnitTests, getSubFeatures) {
     }
 }
 
-IMPLEMENT_TEST(FeatureDbiUnitTests, getFeaturesBySequence) {
+IMPLEMENT_DBI_TEST(FeatureDbiUnitTests, getFeaturesBySequence) {
     U2FeatureDbi *featureDbi = FeatureTestData::getFeatureDbi();
     U2SequenceDbi *sequenceDbi = FeatureTestData::getSequenceDbi();
 
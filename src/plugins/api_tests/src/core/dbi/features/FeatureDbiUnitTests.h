@@ -35,6 +35,7 @@ class U2SequenceDbi;
 
 class FeatureTestData {
 public:
+    static void setDbiFactoryId(const QString& dbiFactoryId);
     static U2FeatureDbi * getFeatureDbi( );
     static U2SequenceDbi * getSequenceDbi( );
     static U2FeatureDbi *getSubgroupDbi();
@@ -54,6 +55,7 @@ private:
     static void init( );
 
     static TestDbiProvider dbiProvider;
+    static QString dbiFactoryId;
     static TestDbiProvider subgroupsDbiProvider;
     static const QString featureDbiUrl;
     static const QString subgroupDbiUrl;
@@ -63,56 +65,56 @@ private:
 };
 
 /** Creates new feature in DB */
-DECLARE_TEST( FeatureDbiUnitTests, createFeature );
+DECLARE_DBI_TEST(FeatureDbiUnitTests, createFeature, FeatureTestData);
 /** Gets feature from DB by ID */
-DECLARE_TEST( FeatureDbiUnitTests, getFeature );
+DECLARE_DBI_TEST(FeatureDbiUnitTests, getFeature, FeatureTestData);
 /** Counts features that matched the query */
-DECLARE_TEST( FeatureDbiUnitTests, countFeatures );
+DECLARE_DBI_TEST(FeatureDbiUnitTests, countFeatures, FeatureTestData);
 /** Get features that matched the query */
-DECLARE_TEST( FeatureDbiUnitTests, getFeatures );
+DECLARE_DBI_TEST(FeatureDbiUnitTests, getFeatures, FeatureTestData);
 /** Get all keys of a specified feature */
-DECLARE_TEST( FeatureDbiUnitTests, getFeatureKeys );
+DECLARE_DBI_TEST(FeatureDbiUnitTests, getFeatureKeys, FeatureTestData);
 /** Add key to feature */
-DECLARE_TEST( FeatureDbiUnitTests, addKey );
+DECLARE_DBI_TEST(FeatureDbiUnitTests, addKey, FeatureTestData);
 /** Remove all feature keys with a specified name */
-DECLARE_TEST( FeatureDbiUnitTests, removeAllKeysByName );
+DECLARE_DBI_TEST(FeatureDbiUnitTests, removeAllKeysByName, FeatureTestData);
 /** Remove all feature keys with a specified name and value */
-DECLARE_TEST( FeatureDbiUnitTests, removeAllKeys );
+DECLARE_DBI_TEST(FeatureDbiUnitTests, removeAllKeys, FeatureTestData);
 /** Update feature key */
-DECLARE_TEST( FeatureDbiUnitTests, updateKeyValue );
+DECLARE_DBI_TEST(FeatureDbiUnitTests, updateKeyValue, FeatureTestData);
 /** Updates feature location */
-DECLARE_TEST( FeatureDbiUnitTests, updateLocation );
+DECLARE_DBI_TEST(FeatureDbiUnitTests, updateLocation, FeatureTestData);
 /** Updates feature name */
-DECLARE_TEST( FeatureDbiUnitTests, updateName );
+DECLARE_DBI_TEST(FeatureDbiUnitTests, updateName, FeatureTestData);
 /** Update feature parent */
-DECLARE_TEST( FeatureDbiUnitTests, updateParentId );
+DECLARE_DBI_TEST(FeatureDbiUnitTests, updateParentId, FeatureTestData);
 /** Remove the feature from database */
-DECLARE_TEST( FeatureDbiUnitTests, removeFeature );
+DECLARE_DBI_TEST(FeatureDbiUnitTests, removeFeature, FeatureTestData);
 /** Return features that matched the query */
-DECLARE_TEST( FeatureDbiUnitTests, getFeaturesByRegion );
-DECLARE_TEST( FeatureDbiUnitTests, getSubFeatures );
-DECLARE_TEST( FeatureDbiUnitTests, getFeaturesBySequence );
+DECLARE_DBI_TEST(FeatureDbiUnitTests, getFeaturesByRegion, FeatureTestData);
+DECLARE_DBI_TEST(FeatureDbiUnitTests, getSubFeatures, FeatureTestData);
+DECLARE_DBI_TEST(FeatureDbiUnitTests, getFeaturesBySequence, FeatureTestData);
 /** Testing properly sorting of annotation subgroups */
 DECLARE_TEST( FeatureDbiUnitTests, sortingSubgroups );
 
 } // namespace U2
 
-DECLARE_METATYPE( FeatureDbiUnitTests, createFeature );
-DECLARE_METATYPE( FeatureDbiUnitTests, getFeature );
-DECLARE_METATYPE( FeatureDbiUnitTests, countFeatures );
-DECLARE_METATYPE( FeatureDbiUnitTests, getFeatures );
-DECLARE_METATYPE( FeatureDbiUnitTests, getFeatureKeys );
-DECLARE_METATYPE( FeatureDbiUnitTests, addKey );
-DECLARE_METATYPE( FeatureDbiUnitTests, removeAllKeysByName );
-DECLARE_METATYPE( FeatureDbiUnitTests, removeAllKeys );
-DECLARE_METATYPE( FeatureDbiUnitTests, updateKeyValue );
-DECLARE_METATYPE( FeatureDbiUnitTests, updateLocation );
-DECLARE_METATYPE( FeatureDbiUnitTests, updateName );
-DECLARE_METATYPE( FeatureDbiUnitTests, updateParentId );
-DECLARE_METATYPE( FeatureDbiUnitTests, removeFeature );
-DECLARE_METATYPE( FeatureDbiUnitTests, getFeaturesByRegion );
-DECLARE_METATYPE( FeatureDbiUnitTests, getSubFeatures );
-DECLARE_METATYPE( FeatureDbiUnitTests, getFeaturesBySequence );
+DECLARE_DBI_METATYPE(FeatureDbiUnitTests, createFeature);
+DECLARE_DBI_METATYPE(FeatureDbiUnitTests, getFeature);
+DECLARE_DBI_METATYPE(FeatureDbiUnitTests, countFeatures);
+DECLARE_DBI_METATYPE(FeatureDbiUnitTests, getFeatures);
+DECLARE_DBI_METATYPE(FeatureDbiUnitTests, getFeatureKeys);
+DECLARE_DBI_METATYPE(FeatureDbiUnitTests, addKey);
+DECLARE_DBI_METATYPE(FeatureDbiUnitTests, removeAllKeysByName);
+DECLARE_DBI_METATYPE(FeatureDbiUnitTests, removeAllKeys);
+DECLARE_DBI_METATYPE(FeatureDbiUnitTests, updateKeyValue);
+DECLARE_DBI_METATYPE(FeatureDbiUnitTests, updateLocation);
+DECLARE_DBI_METATYPE(FeatureDbiUnitTests, updateName);
+DECLARE_DBI_METATYPE(FeatureDbiUnitTests, updateParentId);
+DECLARE_DBI_METATYPE(FeatureDbiUnitTests, removeFeature);
+DECLARE_DBI_METATYPE(FeatureDbiUnitTests, getFeaturesByRegion);
+DECLARE_DBI_METATYPE(FeatureDbiUnitTests, getSubFeatures);
+DECLARE_DBI_METATYPE(FeatureDbiUnitTests, getFeaturesBySequence);
 DECLARE_METATYPE( FeatureDbiUnitTests, sortingSubgroups );
 
 #endif // _U2_FEATURES_DBI_UNIT_TESTS_H_
@@ -34,6 +34,7 @@ namespace U2 {
 
 TestDbiProvider MsaTestData::dbiProvider = TestDbiProvider();
 const QString& MsaTestData::MSA_DB_URL("msa-dbi.ugenedb");
+QString MsaTestData::dbiFactoryId = SQLITE_DBI_ID;
 U2MsaDbi* MsaTestData::msaDbi = NULL;
 U2SequenceDbi* MsaTestData::sequenceDbi = NULL;
 
@@ -42,7 +43,7 @@ void MsaTestData::init() {
     SAFE_POINT(NULL == msaDbi, "msaDbi has been already initialized!", );
     SAFE_POINT(NULL == sequenceDbi, "sequenceDbi has been already initialized!", );
 
-    bool ok = dbiProvider.init(MSA_DB_URL, false);
+    bool ok = dbiProvider.init(MSA_DB_URL, false, dbiFactoryId);
     SAFE_POINT(ok, "Dbi provider failed to initialize in MsaTestData::init()!",);
 
     U2Dbi* dbi = dbiProvider.getDbi();
@@ -65,6 +66,12 @@ void MsaTestData::shutdown() {
     }
 }
 
+void MsaTestData::setDbiFactoryId(const QString& newDbiFactoryId) {
+    CHECK(dbiFactoryId != newDbiFactoryId, );
+    shutdown();
+    dbiFactoryId = newDbiFactoryId;
+}
+
 U2MsaDbi* MsaTestData::getMsaDbi() {
     if (NULL == msaDbi) {
         init();
@@ -79,7 +86,7 @@ U2SequenceDbi* MsaTestData::getSequenceDbi() {
     return sequenceDbi;
 }
 
-IMPLEMENT_TEST(MsaDbiUnitTests, createMsaObject) {
+IMPLEMENT_DBI_TEST(MsaDbiUnitTests, createMsaObject) {
     U2MsaDbi* msaDbi = MsaTestData::getMsaDbi();
 
     U2AlphabetId testAlphabet = BaseDNAAlphabetIds::AMINO_DEFAULT();
@@ -99,7 +106,7 @@ IMPLEMENT_TEST(MsaDbiUnitTests, createMsaObject) {
     CHECK_EQUAL(0, actualNumOfRows, "number of rows");
 }
 
-IMPLEMENT_TEST(MsaDbiUnitTests, addRows) {
+IMPLEMENT_DBI_TEST(MsaDbiUnitTests, addRows) {
     U2OpStatusImpl os;
     U2MsaDbi* msaDbi = MsaTestData::getMsaDbi();
 
@@ -171,7 +178,7 @@ IMPLEMENT_TEST(MsaDbiUnitTests, addRows) {
     CHECK_EQUAL(0, actualRow2.gaps.count(), "second row gaps");
 }
 
-IMPLEMENT_TEST(MsaDbiUnitTests, removeRows) {
+IMPLEMENT_DBI_TEST(MsaDbiUnitTests, removeRows) {
     U2OpStatusImpl os;
     U2MsaDbi* msaDbi = MsaTestData::getMsaDbi();
 
@@ -37,29 +37,31 @@ public:
     static void init();
     static void shutdown();
 
+    static void setDbiFactoryId(const QString& dbiFactoryId);
     static U2MsaDbi* getMsaDbi();
     static U2SequenceDbi* getSequenceDbi();
 
 private:
     static TestDbiProvider dbiProvider;
+    static QString dbiFactoryId;
     static const QString& MSA_DB_URL;
     static U2MsaDbi* msaDbi;
     static U2SequenceDbi* sequenceDbi;
 };
 
 /** Create and get a MSA */
-DECLARE_TEST(MsaDbiUnitTests, createMsaObject);
+DECLARE_DBI_TEST(MsaDbiUnitTests, createMsaObject, MsaTestData);
 
 /** Add rows to a MSA and get them */
-DECLARE_TEST(MsaDbiUnitTests, addRows);
+DECLARE_DBI_TEST(MsaDbiUnitTests, addRows, MsaTestData);
 
 /** Remove rows from a MSA */
-DECLARE_TEST(MsaDbiUnitTests, removeRows);
+DECLARE_DBI_TEST(MsaDbiUnitTests, removeRows, MsaTestData);
 
 } // namespace
 
-DECLARE_METATYPE(MsaDbiUnitTests, createMsaObject);
-DECLARE_METATYPE(MsaDbiUnitTests, addRows);
-DECLARE_METATYPE(MsaDbiUnitTests, removeRows);
+DECLARE_DBI_METATYPE(MsaDbiUnitTests, createMsaObject);
+DECLARE_DBI_METATYPE(MsaDbiUnitTests, addRows);
+DECLARE_DBI_METATYPE(MsaDbiUnitTests, removeRows);
 
 #endif
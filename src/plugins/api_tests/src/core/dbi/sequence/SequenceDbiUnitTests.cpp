@@ -41,18 +41,23 @@ const QString& SequenceTestData::SEQ_DB_URL("sequence-dbi.ugenedb");
 QList<U2DataId>* SequenceTestData::sequences = NULL;
 U2SequenceDbi* SequenceTestData::sequenceDbi = NULL;
 TestDbiProvider SequenceTestData::dbiProvider = TestDbiProvider();
+QString SequenceTestData::dbiFactoryId = SQLITE_DBI_ID;
 
 static bool registerTests(){
     qRegisterMetaType<U2::SequenceDbiUnitTests_createSequenceObject>("SequenceDbiUnitTests_createSequenceObject");
+    qRegisterMetaType<U2::SequenceDbiUnitTests_createSequenceObject_memoryDbi>("SequenceDbiUnitTests_createSequenceObject_memoryDbi");
     qRegisterMetaType<U2::SequenceDbiUnitTests_getAllSequenceObjects>("SequenceDbiUnitTests_getAllSequenceObjects");
     qRegisterMetaType<U2::SequenceDbiUnitTests_getSequenceData>("SequenceDbiUnitTests_getSequenceData");
     qRegisterMetaType<U2::SequenceDbiUnitTests_getLongSequenceData>("SequenceDbiUnitTests_getLongSequenceData");
     qRegisterMetaType<U2::SequenceDbiUnitTests_getSequenceDataInvalid>("SequenceDbiUnitTests_getSequenceDataInvalid");
+    qRegisterMetaType<U2::SequenceDbiUnitTests_getSequenceDataInvalid_memoryDbi>("SequenceDbiUnitTests_getSequenceDataInvalid_memoryDbi");
     qRegisterMetaType<U2::SequenceDbiUnitTests_getSequenceObject>("SequenceDbiUnitTests_getSequenceObject");
     qRegisterMetaType<U2::SequenceDbiUnitTests_getSequenceObjectInvalid>("SequenceDbiUnitTests_getSequenceObjectInvalid");
+    qRegisterMetaType<U2::SequenceDbiUnitTests_getSequenceObjectInvalid_memoryDbi>("SequenceDbiUnitTests_getSequenceObjectInvalid_memoryDbi");
     qRegisterMetaType<U2::SequenceDbiUnitTests_updateHugeSequenceData>("SequenceDbiUnitTests_updateHugeSequenceData");
     qRegisterMetaType<U2::SequenceDbiUnitTests_updateSequenceData>("SequenceDbiUnitTests_updateSequenceData");
     qRegisterMetaType<U2::SequenceDbiUnitTests_updateSequenceObject>("SequenceDbiUnitTests_updateSequenceObject");
+    qRegisterMetaType<U2::SequenceDbiUnitTests_updateSequenceObject_memoryDbi>("SequenceDbiUnitTests_updateSequenceObject_memoryDbi");
     qRegisterMetaType<U2::SequenceDbiUnitTests_updateSequencesData>("SequenceDbiUnitTests_updateSequencesData");
     return true;
 }
@@ -60,7 +65,7 @@ static bool registerTests(){
 bool SequenceTestData::registerTest = registerTests();
 
 void SequenceTestData::init() {
-    bool ok = dbiProvider.init(SEQ_DB_URL, false);
+    bool ok = dbiProvider.init(SEQ_DB_URL, false, dbiFactoryId);
     SAFE_POINT(ok, "dbi provider failed to initialize",);
     U2Dbi* dbi = dbiProvider.getDbi();
     U2ObjectDbi* objDbi = dbi->getObjectDbi();
@@ -85,10 +90,18 @@ void SequenceTestData::shutdown() {
         U2OpStatusImpl opStatus;
         dbiProvider.close();
         sequenceDbi = NULL;
+        delete sequences;
+        sequences = NULL;
         SAFE_POINT_OP(opStatus, );
     }
 }
 
+void SequenceTestData::setDbiFactoryId(const QString& newDbiFactoryId) {
+    CHECK(dbiFactoryId != newDbiFactoryId, );
+    shutdown();
+    dbiFactoryId = newDbiFactoryId;
+}
+
 bool SequenceTestData::compareSequences(const U2Sequence& s1, const U2Sequence& s2) {
     if (s1.id == s2.id && s1.alphabet.id == s2.alphabet.id &&
         s1.circular == s2.circular && s1.length == s2.length) {
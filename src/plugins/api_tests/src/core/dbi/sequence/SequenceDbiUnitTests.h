@@ -24,6 +24,7 @@ class SequenceTestData {
 public:
     static void init();
     static void shutdown();
+    static void setDbiFactoryId(const QString& dbiFactoryId);
     static U2SequenceDbi* getSequenceDbi();
     static QList<U2DataId>* getSequences() { return sequences; };
     static bool compareSequences(const U2Sequence& s1, const U2Sequence& s2);
@@ -41,6 +42,7 @@ public:
 
 protected:
     static TestDbiProvider dbiProvider;
+    static QString dbiFactoryId;
     static bool registerTest;
 };
 
@@ -54,20 +56,11 @@ public:
     void Test();
 };
 
-class SequenceDbiUnitTests_getSequenceObjectInvalid : public UnitTest {
-public:
-    void Test();
-};
+DECLARE_DBI_TEST(SequenceDbiUnitTests, getSequenceObjectInvalid, SequenceTestData);
 
-class SequenceDbiUnitTests_createSequenceObject : public UnitTest {
-public:
-    void Test();
-};
+DECLARE_DBI_TEST(SequenceDbiUnitTests, createSequenceObject, SequenceTestData);
 
-class SequenceDbiUnitTests_updateSequenceObject : public UnitTest {
-public:
-    void Test();
-};
+DECLARE_DBI_TEST(SequenceDbiUnitTests, updateSequenceObject, SequenceTestData);
 
 class SequenceDbiUnitTests_getSequenceData : public UnitTest {
 public:
@@ -79,10 +72,7 @@ public:
     void Test();
 };
 
-class SequenceDbiUnitTests_getSequenceDataInvalid : public UnitTest {
-public:
-    void Test();
-};
+DECLARE_DBI_TEST(SequenceDbiUnitTests, getSequenceDataInvalid, SequenceTestData);
 
 class SequenceDbiUnitTests_updateSequenceData : public UnitTest {
 public:
@@ -110,15 +100,19 @@ Q_DECLARE_METATYPE(U2::U2Sequence);
 Q_DECLARE_METATYPE(U2::UpdateSequenceArgs);
 
 Q_DECLARE_METATYPE(U2::SequenceDbiUnitTests_createSequenceObject);
+Q_DECLARE_METATYPE(U2::SequenceDbiUnitTests_createSequenceObject_memoryDbi);
 Q_DECLARE_METATYPE(U2::SequenceDbiUnitTests_getAllSequenceObjects);
 Q_DECLARE_METATYPE(U2::SequenceDbiUnitTests_getSequenceData);
 Q_DECLARE_METATYPE(U2::SequenceDbiUnitTests_getLongSequenceData);
 Q_DECLARE_METATYPE(U2::SequenceDbiUnitTests_getSequenceDataInvalid);
+Q_DECLARE_METATYPE(U2::SequenceDbiUnitTests_getSequenceDataInvalid_memoryDbi);
 Q_DECLARE_METATYPE(U2::SequenceDbiUnitTests_getSequenceObject);
 Q_DECLARE_METATYPE(U2::SequenceDbiUnitTests_getSequenceObjectInvalid);
+Q_DECLARE_METATYPE(U2::SequenceDbiUnitTests_getSequenceObjectInvalid_memoryDbi);
 Q_DECLARE_METATYPE(U2::SequenceDbiUnitTests_updateHugeSequenceData);
 Q_DECLARE_METATYPE(U2::SequenceDbiUnitTests_updateSequenceData);
 Q_DECLARE_METATYPE(U2::SequenceDbiUnitTests_updateSequenceObject);
+Q_DECLARE_METATYPE(U2::SequenceDbiUnitTests_updateSequenceObject_memoryDbi);
 Q_DECLARE_METATYPE(U2::SequenceDbiUnitTests_updateSequencesData);
 
 #endif //_U2_SEQUENCE_DBI_UNITTESTS_H_
@@ -0,0 +1,171 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include <QDir>
+#include <QFile>
+#include <QScopedPointer>
+
+#include <U2Core/IOAdapter.h>
+#include <U2Core/IOAdapterUtils.h>
+#include <U2Core/U2OpStatusUtils.h>
+
+#include "FastaIndexUnitTests.h"
+
+namespace U2 {
+
+GUrl FastaIndexTestUtils::writeFile(const QString &fileName, const QByteArray &data, U2OpStatus &os) {
+    const GUrl url(QDir::temp().absoluteFilePath(fileName));
+    QFile::remove(url.getURLString());
+    QScopedPointer<IOAdapter> io(IOAdapterUtils::open(url, os, IOAdapterMode_Write));
+    CHECK_OP(os, url);
+    CHECK_EXT(data.size() == io->writeBlock(data), os.setError("Write error"), url);
+    return url;
+}
+
+FastaIndex FastaIndexTestUtils::build(const QString &fileName, const QByteArray &data, U2OpStatus &os) {
+    const GUrl url = writeFile(fileName, data, os);
+    CHECK_OP(os, FastaIndex());
+    QScopedPointer<IOAdapter> io(IOAdapterUtils::open(url, os));
+    CHECK_OP(os, FastaIndex());
+    return FastaIndex::build(io.data(), os);
+}
+
+QString FastaIndexTestUtils::checkEntry(const FastaIndexEntry &entry, const QString &name, qint64 length, qint64 offset, int lineBases, int lineWidth) {
+    const QString expected = QString("%1\t%2\t%3\t%4\t%5").arg(name).arg(length).arg(offset).arg(lineBases).arg(lineWidth);
+    const QString actual = QString("%1\t%2\t%3\t%4\t%5").arg(entry.name).arg(entry.length).arg(entry.offset).arg(entry.lineBases).arg(entry.lineWidth);
+    CHECK(expected == actual, QString("unexpected entry: expected '%1', got '%2'").arg(expected).arg(actual));
+    return QString();
+}
+
+IMPLEMENT_TEST(FastaIndexUnitTests, build_lastLineShort) {
+    U2OpStatusImpl os;
+    const FastaIndex index = FastaIndexTestUtils::build("FastaIndexUnitTests.fa", ">s1\nACGTA\nAC\n>s2 description\nAAA\n", os);
+    CHECK_NO_ERROR(os);
+    CHECK_EQUAL(2, index.getEntries().size(), "entries count");
+
+    QString error = FastaIndexTestUtils::checkEntry(index.getEntries()[0], "s1", 7, 4, 5, 6);
+    CHECK_TRUE(error.isEmpty(), error);
+    error = FastaIndexTestUtils::checkEntry(index.getEntries()[1], "s2", 3, 29, 3, 4);
+    CHECK_TRUE(error.isEmpty(), error);
+    CHECK_EQUAL(1, index.indexOf("s2"), "sequence index");
+    CHECK_EQUAL(-1, index.indexOf("s3"), "sequence index");
+}
+
+IMPLEMENT_TEST(FastaIndexUnitTests, build_unevenLines) {
+    QList<QByteArray> files;
+    files << ">s1\nACGT\nAC\nACGT\n" << ">s1\nACGT\nACGTA\n" << ">s1\nACGT\n\nACGT\n" << ">s1\nACGT\nACGT\r\n";
+    foreach (const QByteArray &data, files) {
+        U2OpStatusImpl os;
+        FastaIndexTestUtils::build("FastaIndexUnitTests.fa", data, os);
+        CHECK_TRUE(os.hasError(), QString("uneven lines are accepted: %1").arg(QString::fromLatin1(data)));
+    }
+}
+
+IMPLEMENT_TEST(FastaIndexUnitTests, build_crlf) {
+    U2OpStatusImpl os;
+    const QByteArray data = ">s1 desc\r\nACGT\r\nAC\r\n>s2\r\nGG\r\n";
+    const FastaIndex index = FastaIndexTestUtils::build("FastaIndexUnitTests.fa", data, os);
+    CHECK_NO_ERROR(os);
+    CHECK_EQUAL(2, index.getEntries().size(), "entries count");
+
+    QString error = FastaIndexTestUtils::checkEntry(index.getEntries()[0], "s1", 6, 10, 4, 6);
+    CHECK_TRUE(error.isEmpty(), error);
+    error = FastaIndexTestUtils::checkEntry(index.getEntries()[1], "s2", 2, 25, 2, 4);
+    CHECK_TRUE(error.isEmpty(), error);
+
+    const qint64 offset = index.getEntries()[0].getOffset(5);
+    CHECK_EQUAL(17, offset, "offset of the sequence position");
+    CHECK_EQUAL('C', data.at(int(offset)), "character at the offset");
+}
+
+IMPLEMENT_TEST(FastaIndexUnitTests, build_headerAtEof) {
+    U2OpStatusImpl os;
+    FastaIndex index = FastaIndexTestUtils::build("FastaIndexUnitTests.fa", ">s1\nACGT\n>s2", os);
+    CHECK_NO_ERROR(os);
+    CHECK_EQUAL(2, index.getEntries().size(), "entries count");
+    QString error = FastaIndexTestUtils::checkEntry(index.getEntries()[1], "s2", 0, 12, 0, 0);
+    CHECK_TRUE(error.isEmpty(), error);
+
+    index = FastaIndexTestUtils::build("FastaIndexUnitTests.fa", ">s1\nACGT\n>s2\n", os);
+    CHECK_NO_ERROR(os);
+    CHECK_EQUAL(2, index.getEntries().size(), "entries count");
+    error = FastaIndexTestUtils::checkEntry(index.getEntries()[1], "s2", 0, 13, 0, 0);
+    CHECK_TRUE(error.isEmpty(), error);
+}
+
+IMPLEMENT_TEST(FastaIndexUnitTests, build_noEolAtEof) {
+    U2OpStatusImpl os;
+    FastaIndex index = FastaIndexTestUtils::build("FastaIndexUnitTests.fa", ">s1\nACGT\nAC", os);
+    CHECK_NO_ERROR(os);
+    CHECK_EQUAL(1, index.getEntries().size(), "entries count");
+    QString error = FastaIndexTestUtils::checkEntry(index.getEntries()[0], "s1", 6, 4, 4, 5);
+    CHECK_TRUE(error.isEmpty(), error);
+
+    index = FastaIndexTestUtils::build("FastaIndexUnitTests.fa", ">s1\r\nACGT\r\nAC", os);
+    CHECK_NO_ERROR(os);
+    CHECK_EQUAL(1, index.getEntries().size(), "entries count");
+    error = FastaIndexTestUtils::checkEntry(index.getEntries()[0], "s1", 6, 5, 4, 6);
+    CHECK_TRUE(error.isEmpty(), error);
+}
+
+IMPLEMENT_TEST(FastaIndexUnitTests, build_gzipped) {
+    U2OpStatusImpl os;
+    const QByteArray data = ">s1\nACGTA\nAC\n>s2 description\nAAA\n";
+    const FastaIndex plainIndex = FastaIndexTestUtils::build("FastaIndexUnitTests.fa", data, os);
+    CHECK_NO_ERROR(os);
+    const FastaIndex gzippedIndex = FastaIndexTestUtils::build("FastaIndexUnitTests.fa.gz", data, os);
+    CHECK_NO_ERROR(os);
+
+    CHECK_EQUAL(plainIndex.getEntries().size(), gzippedIndex.getEntries().size(), "entries count");
+    for (int i = 0; i < plainIndex.getEntries().size(); i++) {
+        const FastaIndexEntry &entry = plainIndex.getEntries()[i];
+        const QString error = FastaIndexTestUtils::checkEntry(gzippedIndex.getEntries()[i], entry.name, entry.length, entry.offset, entry.lineBases, entry.lineWidth);
+        CHECK_TRUE(error.isEmpty(), error);
+    }
+}
+
+IMPLEMENT_TEST(FastaIndexUnitTests, saveLoad) {
+    U2OpStatusImpl os;
+    const FastaIndex index = FastaIndexTestUtils::build("FastaIndexUnitTests.fa", ">s1 desc\r\nACGT\r\nAC\r\n>s2\r\nGG\r\n", os);
+    CHECK_NO_ERROR(os);
+    const GUrl faiUrl(QDir::temp().absoluteFilePath("FastaIndexUnitTests.fa.fai"));
+    index.save(faiUrl, os);
+    CHECK_NO_ERROR(os);
+
+    const FastaIndex loaded = FastaIndex::load(faiUrl, os);
+    CHECK_NO_ERROR(os);
+    CHECK_EQUAL(index.getEntries().size(), loaded.getEntries().size(), "entries count");
+    for (int i = 0; i < index.getEntries().size(); i++) {
+        const FastaIndexEntry &entry = index.getEntries()[i];
+        const QString error = FastaIndexTestUtils::checkEntry(loaded.getEntries()[i], entry.name, entry.length, entry.offset, entry.lineBases, entry.lineWidth);
+        CHECK_TRUE(error.isEmpty(), error);
+    }
+}
+
+IMPLEMENT_TEST(FastaIndexUnitTests, load_invalid) {
+    U2OpStatusImpl os;
+    const GUrl faiUrl = FastaIndexTestUtils::writeFile("FastaIndexUnitTests.fa.fai", "s1\t6\t4\t4\n", os);
+    CHECK_NO_ERROR(os);
+    FastaIndex::load(faiUrl, os);
+    CHECK_TRUE(os.hasError(), "an invalid index is loaded");
+}
+
+} // U2
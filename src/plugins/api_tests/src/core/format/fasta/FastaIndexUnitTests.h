@@ -0,0 +1,67 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef _U2_FASTA_INDEX_UNIT_TESTS_H_
+#define _U2_FASTA_INDEX_UNIT_TESTS_H_
+
+#include <U2Formats/FastaIndex.h>
+
+#include <unittest.h>
+
+namespace U2 {
+
+class FastaIndexTestUtils {
+public:
+    // writes the data to a temporary file, a ".gz" file is gzipped
+    static GUrl writeFile(const QString &fileName, const QByteArray &data, U2OpStatus &os);
+    static FastaIndex build(const QString &fileName, const QByteArray &data, U2OpStatus &os);
+    static QString checkEntry(const FastaIndexEntry &entry, const QString &name, qint64 length, qint64 offset, int lineBases, int lineWidth);
+};
+
+/* The last line of a sequence can be shorter than the others */
+DECLARE_TEST(FastaIndexUnitTests, build_lastLineShort);
+/* The lines with different lengths in the middle of a sequence are rejected */
+DECLARE_TEST(FastaIndexUnitTests, build_unevenLines);
+/* The CRLF line ends are counted in the line width, but not in the bases */
+DECLARE_TEST(FastaIndexUnitTests, build_crlf);
+/* A header at the end of the file, with and without the end of line */
+DECLARE_TEST(FastaIndexUnitTests, build_headerAtEof);
+/* The last sequence line without the end of line */
+DECLARE_TEST(FastaIndexUnitTests, build_noEolAtEof);
+/* The offsets of a gzipped file are positions in the uncompressed data */
+DECLARE_TEST(FastaIndexUnitTests, build_gzipped);
+/* The saved index is loaded with the same entries */
+DECLARE_TEST(FastaIndexUnitTests, saveLoad);
+/* An index with a wrong number of columns is rejected */
+DECLARE_TEST(FastaIndexUnitTests, load_invalid);
+
+} // U2
+
+DECLARE_METATYPE(FastaIndexUnitTests, build_lastLineShort);
+DECLARE_METATYPE(FastaIndexUnitTests, build_unevenLines);
+DECLARE_METATYPE(FastaIndexUnitTests, build_crlf);
+DECLARE_METATYPE(FastaIndexUnitTests, build_headerAtEof);
+DECLARE_METATYPE(FastaIndexUnitTests, build_noEolAtEof);
+DECLARE_METATYPE(FastaIndexUnitTests, build_gzipped);
+DECLARE_METATYPE(FastaIndexUnitTests, saveLoad);
+DECLARE_METATYPE(FastaIndexUnitTests, load_invalid);
+
+#endif // _U2_FASTA_INDEX_UNIT_TESTS_H_
@@ -0,0 +1,271 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include <QFile>
+#include <QScopedPointer>
+
+#include <U2Core/AppContext.h>
+#include <U2Core/BaseDocumentFormats.h>
+#include <U2Core/BaseIOAdapters.h>
+#include <U2Core/DNAAlphabet.h>
+#include <U2Core/DNASequenceObject.h>
+#include <U2Core/DocumentModel.h>
+#include <U2Core/IOAdapter.h>
+#include <U2Core/U2DbiUtils.h>
+#include <U2Core/U2ObjectDbi.h>
+#include <U2Core/U2OpStatusUtils.h>
+#include <U2Core/U2SafePoints.h>
+#include <U2Core/U2SequenceDbi.h>
+
+#include <U2Formats/FastaIndex.h>
+
+#include "FastaIndexUnitTests.h"
+#include "IndexedFastaDbiUnitTests.h"
+
+namespace U2 {
+
+namespace {
+
+const QByteArray SEQUENCES_DATA = ">s1 description\nACGTA\nCCGTT\nGGA\n>s2\nacgtacgt\nac\n";
+const QByteArray SEQUENCE_1 = "ACGTACCGTTGGA";
+const QByteArray SEQUENCE_2 = "ACGTACGTAC";
+
+}
+
+GUrl IndexedFastaDbiTestUtils::writeFasta(const QString &fileName, const QByteArray &data, U2OpStatus &os) {
+    const GUrl url = FastaIndexTestUtils::writeFile(fileName, data, os);
+    QFile::remove(FastaIndex::getIndexUrl(url).getURLString());
+    QFile::remove(url.getURLString() + ".gzidx");
+    return url;
+}
+
+IndexedFastaDbi * IndexedFastaDbiTestUtils::openDbi(const GUrl &url, U2OpStatus &os) {
+    QHash<QString, QString> properties;
+    properties[U2DbiOptions::U2_DBI_OPTION_URL] = url.getURLString();
+    IndexedFastaDbi *dbi = new IndexedFastaDbi();
+    dbi->init(properties, QVariantMap(), os);
+    CHECK_OP_EXT(os, delete dbi, NULL);
+    return dbi;
+}
+
+QString IndexedFastaDbiTestUtils::checkAllRegions(IndexedFastaDbi *dbi, int entryNumber, const QByteArray &expected) {
+    const U2DataId id = IndexedFastaDbi::getSequenceId(entryNumber);
+    for (int start = 0; start < expected.size(); start++) {
+        for (int length = 1; start + length <= expected.size(); length++) {
+            U2OpStatusImpl os;
+            const QByteArray data = dbi->getSequenceDbi()->getSequenceData(id, U2Region(start, length), os);
+            CHECK_OP(os, os.getError());
+            CHECK(expected.mid(start, length) == data, QString("unexpected data of the region %1..%2 of the sequence %3: '%4'")
+                .arg(start).arg(start + length - 1).arg(entryNumber).arg(QString::fromLatin1(data)));
+        }
+    }
+    return QString();
+}
+
+QString IndexedFastaDbiTestUtils::checkSequenceReading(const QString &fileName) {
+    U2OpStatusImpl os;
+    const GUrl url = writeFasta(fileName, SEQUENCES_DATA, os);
+    CHECK_OP(os, os.getError());
+    QScopedPointer<IndexedFastaDbi> dbi(openDbi(url, os));
+    CHECK_OP(os, os.getError());
+    CHECK(2 == dbi->getEntries().size(), QString("unexpected entries count: %1").arg(dbi->getEntries().size()));
+
+    QString error = checkAllRegions(dbi.data(), 0, SEQUENCE_1);
+    CHECK(error.isEmpty(), error);
+    error = checkAllRegions(dbi.data(), 1, SEQUENCE_2);
+    CHECK(error.isEmpty(), error);
+    // the first sequence again: the file is read backward
+    return checkAllRegions(dbi.data(), 0, SEQUENCE_1);
+}
+
+IMPLEMENT_TEST(IndexedFastaDbiUnitTests, getSequenceData_plain) {
+    const QString error = IndexedFastaDbiTestUtils::checkSequenceReading("IndexedFastaDbiUnitTests.fa");
+    CHECK_TRUE(error.isEmpty(), error);
+}
+
+IMPLEMENT_TEST(IndexedFastaDbiUnitTests, getSequenceData_gzipped) {
+    const QString error = IndexedFastaDbiTestUtils::checkSequenceReading("IndexedFastaDbiUnitTests.fa.gz");
+    CHECK_TRUE(error.isEmpty(), error);
+}
+
+IMPLEMENT_TEST(IndexedFastaDbiUnitTests, getSequenceData_outOfRange) {
+    U2OpStatusImpl os;
+    const GUrl url = IndexedFastaDbiTestUtils::writeFasta("IndexedFastaDbiUnitTests.fa", SEQUENCES_DATA, os);
+    CHECK_NO_ERROR(os);
+    QScopedPointer<IndexedFastaDbi> dbi(IndexedFastaDbiTestUtils::openDbi(url, os));
+    CHECK_NO_ERROR(os);
+
+    const U2DataId id = IndexedFastaDbi::getSequenceId(0);
+    QByteArray data = dbi->getSequenceDbi()->getSequenceData(id, U2Region(10, 100), os);
+    CHECK_NO_ERROR(os);
+    CHECK_TRUE("GGA" == data, QString("unexpected data: '%1'").arg(QString::fromLatin1(data)));
+
+    data = dbi->getSequenceDbi()->getSequenceData(id, U2Region(20, 5), os);
+    CHECK_NO_ERROR(os);
+    CHECK_TRUE(data.isEmpty(), QString("unexpected data: '%1'").arg(QString::fromLatin1(data)));
+}
+
+IMPLEMENT_TEST(IndexedFastaDbiUnitTests, getSequenceData_indexMismatch) {
+    U2OpStatusImpl os;
+    const GUrl url = IndexedFastaDbiTestUtils::writeFasta("IndexedFastaDbiUnitTests.fa", ">s1\nACGT\nAC\n", os);
+    CHECK_NO_ERROR(os);
+    // the line ends are not counted in the line width
+    FastaIndexTestUtils::writeFile("IndexedFastaDbiUnitTests.fa.fai", "s1\t6\t4\t4\t4\n", os);
+    CHECK_NO_ERROR(os);
+    QScopedPointer<IndexedFastaDbi> dbi(IndexedFastaDbiTestUtils::openDbi(url, os));
+    CHECK_NO_ERROR(os);
+
+    dbi->getSequenceDbi()->getSequenceData(IndexedFastaDbi::getSequenceId(0), U2Region(0, 6), os);
+    CHECK_TRUE(os.hasError(), "the mismatch is not reported");
+    CHECK_TRUE(os.getError().startsWith("The FASTA index does not match the file"), QString("unexpected error: %1").arg(os.getError()));
+}
+
+IMPLEMENT_TEST(IndexedFastaDbiUnitTests, entryNumbers) {
+    U2OpStatusImpl os;
+    const GUrl url = IndexedFastaDbiTestUtils::writeFasta("IndexedFastaDbiUnitTests.fa", SEQUENCES_DATA, os);
+    CHECK_NO_ERROR(os);
+    QScopedPointer<IndexedFastaDbi> dbi(IndexedFastaDbiTestUtils::openDbi(url, os));
+    CHECK_NO_ERROR(os);
+
+    const QHash<U2DataId, QString> names = dbi->getObjectDbi()->getObjectNames(0, U2DbiOptions::U2_DBI_NO_LIMIT, os);
+    CHECK_NO_ERROR(os);
+    CHECK_EQUAL(2, names.size(), "objects count");
+    for (int i = 0; i < 2; i++) {
+        const U2DataId id = IndexedFastaDbi::getSequenceId(i);
+        CHECK_EQUAL(i, dbi->getEntryNumber(id), "entry number");
+        CHECK_EQUAL(dbi->getEntries()[i].name, names.value(id), "object name");
+    }
+
+    CHECK_EQUAL(-1, dbi->getEntryNumber(IndexedFastaDbi::getSequenceId(2)), "entry number of the unknown id");
+    CHECK_EQUAL(-1, dbi->getEntryNumber(IndexedFastaDbi::getSequenceId(-1)), "entry number of the unknown id");
+    CHECK_EQUAL(-1, dbi->getEntryNumber(U2DbiUtils::toU2DataId(1, U2Type::Assembly)), "entry number of the assembly id");
+    CHECK_EQUAL(-1, dbi->getEntryNumber(U2DataId()), "entry number of the empty id");
+
+    U2OpStatusImpl objectOs;
+    dbi->getSequenceDbi()->getSequenceObject(IndexedFastaDbi::getSequenceId(2), objectOs);
+    CHECK_TRUE(objectOs.hasError(), "the unknown sequence is found");
+    U2OpStatusImpl dataOs;
+    dbi->getSequenceDbi()->getSequenceData(IndexedFastaDbi::getSequenceId(2), U2Region(0, 1), dataOs);
+    CHECK_TRUE(dataOs.hasError(), "the unknown sequence is read");
+}
+
+IMPLEMENT_TEST(IndexedFastaDbiUnitTests, alphabet) {
+    U2OpStatusImpl os;
+    const GUrl url = IndexedFastaDbiTestUtils::writeFasta("IndexedFastaDbiUnitTests.fa", ">dna\nACGTACGT\n>amino\nMKLVQEWF\n>rna\nACGUACGU\n", os);
+    CHECK_NO_ERROR(os);
+    QScopedPointer<IndexedFastaDbi> dbi(IndexedFastaDbiTestUtils::openDbi(url, os));
+    CHECK_NO_ERROR(os);
+
+    QStringList expected;
+    expected << BaseDNAAlphabetIds::NUCL_DNA_EXTENDED() << BaseDNAAlphabetIds::AMINO_EXTENDED() << BaseDNAAlphabetIds::NUCL_RNA_EXTENDED();
+    for (int i = 0; i < expected.size(); i++) {
+        const U2Sequence sequence = dbi->getSequenceDbi()->getSequenceObject(IndexedFastaDbi::getSequenceId(i), os);
+        CHECK_NO_ERROR(os);
+        CHECK_EQUAL(expected[i], sequence.alphabet.id, "alphabet");
+        // the cached alphabet
+        CHECK_EQUAL(expected[i], dbi->getAlphabet(i, os).id, "alphabet");
+        CHECK_NO_ERROR(os);
+    }
+}
+
+IMPLEMENT_TEST(IndexedFastaDbiUnitTests, writeMethods) {
+    U2OpStatusImpl os;
+    const GUrl url = IndexedFastaDbiTestUtils::writeFasta("IndexedFastaDbiUnitTests.fa", SEQUENCES_DATA, os);
+    CHECK_NO_ERROR(os);
+    QScopedPointer<IndexedFastaDbi> dbi(IndexedFastaDbiTestUtils::openDbi(url, os));
+    CHECK_NO_ERROR(os);
+    CHECK_TRUE(dbi->isReadOnly(), "the dbi is not read-only");
+
+    const U2DataId id = IndexedFastaDbi::getSequenceId(0);
+    U2Sequence sequence = dbi->getSequenceDbi()->getSequenceObject(id, os);
+    CHECK_NO_ERROR(os);
+
+    U2OpStatusImpl createOs;
+    U2Sequence newSequence;
+    dbi->getSequenceDbi()->createSequenceObject(newSequence, U2ObjectDbi::ROOT_FOLDER, createOs);
+    CHECK_TRUE(createOs.hasError(), "the sequence is created");
+
+    U2OpStatusImpl updateOs;
+    dbi->getSequenceDbi()->updateSequenceObject(sequence, updateOs);
+    CHECK_TRUE(updateOs.hasError(), "the sequence is updated");
+
+    U2OpStatusImpl updateDataOs;
+    dbi->getSequenceDbi()->updateSequenceData(id, U2Region(0, 1), "T", QVariantMap(), updateDataOs);
+    CHECK_TRUE(updateDataOs.hasError(), "the sequence data is updated");
+
+    U2OpStatusImpl renameOs;
+    dbi->getObjectDbi()->renameObject(id, "renamed", renameOs);
+    CHECK_TRUE(renameOs.hasError(), "the sequence is renamed");
+
+    const QByteArray data = dbi->getSequenceDbi()->getSequenceData(id, U2Region(0, SEQUENCE_1.size()), os);
+    CHECK_NO_ERROR(os);
+    CHECK_TRUE(SEQUENCE_1 == data, QString("the sequence is changed: '%1'").arg(QString::fromLatin1(data)));
+}
+
+IMPLEMENT_TEST(IndexedFastaDbiUnitTests, loadDocument_indexed) {
+    U2OpStatusImpl os;
+    const GUrl url = IndexedFastaDbiTestUtils::writeFasta("IndexedFastaDbiUnitTests.fa", SEQUENCES_DATA, os);
+    CHECK_NO_ERROR(os);
+
+    DocumentFormat *format = AppContext::getDocumentFormatRegistry()->getFormatById(BaseDocumentFormats::FASTA);
+    IOAdapterFactory *iof = AppContext::getIOAdapterRegistry()->getIOAdapterFactoryById(BaseIOAdapters::LOCAL_FILE);
+    QVariantMap hints;
+    hints[DocumentReadingMode_IndexedLoadingMinFileSize] = 0;
+    QScopedPointer<Document> doc(format->loadDocument(iof, url, hints, os));
+    CHECK_NO_ERROR(os);
+
+    QList<QByteArray> expected;
+    expected << SEQUENCE_1 << SEQUENCE_2;
+    const QList<GObject*> objects = doc->getObjects();
+    CHECK_EQUAL(expected.size(), objects.size(), "objects count");
+    for (int i = 0; i < objects.size(); i++) {
+        U2SequenceObject *object = qobject_cast<U2SequenceObject*>(objects[i]);
+        CHECK_TRUE(NULL != object, "not a sequence object");
+        CHECK_EQUAL(IndexedFastaDbiFactory::ID, object->getEntityRef().dbiRef.dbiFactoryId, "dbi factory");
+        const QByteArray data = object->getWholeSequenceData(os);
+        CHECK_NO_ERROR(os);
+        CHECK_TRUE(expected[i] == data, QString("unexpected data: '%1'").arg(QString::fromLatin1(data)));
+    }
+}
+
+IMPLEMENT_TEST(IndexedFastaDbiUnitTests, loadDocument_unevenLines) {
+    U2OpStatusImpl os;
+    const GUrl url = IndexedFastaDbiTestUtils::writeFasta("IndexedFastaDbiUnitTests.fa", ">s1\nACGT\nAC\nACGT\n", os);
+    CHECK_NO_ERROR(os);
+
+    DocumentFormat *format = AppContext::getDocumentFormatRegistry()->getFormatById(BaseDocumentFormats::FASTA);
+    IOAdapterFactory *iof = AppContext::getIOAdapterRegistry()->getIOAdapterFactoryById(BaseIOAdapters::LOCAL_FILE);
+    QVariantMap hints;
+    hints[DocumentReadingMode_IndexedLoadingMinFileSize] = 0;
+    QScopedPointer<Document> doc(format->loadDocument(iof, url, hints, os));
+    CHECK_NO_ERROR(os);
+
+    const QList<GObject*> objects = doc->getObjects();
+    CHECK_EQUAL(1, objects.size(), "objects count");
+    U2SequenceObject *object = qobject_cast<U2SequenceObject*>(objects.first());
+    CHECK_TRUE(NULL != object, "not a sequence object");
+    CHECK_NOT_EQUAL(IndexedFastaDbiFactory::ID, object->getEntityRef().dbiRef.dbiFactoryId, "dbi factory");
+    const QByteArray data = object->getWholeSequenceData(os);
+    CHECK_NO_ERROR(os);
+    CHECK_TRUE("ACGTACACGT" == data, QString("unexpected data: '%1'").arg(QString::fromLatin1(data)));
+}
+
+} // U2
@@ -0,0 +1,72 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef _U2_INDEXED_FASTA_DBI_UNIT_TESTS_H_
+#define _U2_INDEXED_FASTA_DBI_UNIT_TESTS_H_
+
+#include <U2Formats/IndexedFastaDbi.h>
+
+#include <unittest.h>
+
+namespace U2 {
+
+class IndexedFastaDbiTestUtils {
+public:
+    // writes the file and removes its stored indexes left by the previous tests
+    static GUrl writeFasta(const QString &fileName, const QByteArray &data, U2OpStatus &os);
+    static IndexedFastaDbi * openDbi(const GUrl &url, U2OpStatus &os);
+    // compares every region of the sequence with @expected
+    static QString checkAllRegions(IndexedFastaDbi *dbi, int entryNumber, const QByteArray &expected);
+    static QString checkSequenceReading(const QString &fileName);
+};
+
+/* The regions crossing the line breaks are read without the line ends and in upper case */
+DECLARE_TEST(IndexedFastaDbiUnitTests, getSequenceData_plain);
+/* The regions of a gzipped file are read as the plain ones */
+DECLARE_TEST(IndexedFastaDbiUnitTests, getSequenceData_gzipped);
+/* The region outside of the sequence is cut */
+DECLARE_TEST(IndexedFastaDbiUnitTests, getSequenceData_outOfRange);
+/* The index that does not match the file is reported */
+DECLARE_TEST(IndexedFastaDbiUnitTests, getSequenceData_indexMismatch);
+/* The ids are mapped to the entry numbers and back, the unknown ids are rejected */
+DECLARE_TEST(IndexedFastaDbiUnitTests, entryNumbers);
+/* The default alphabets are widened to the extended ones */
+DECLARE_TEST(IndexedFastaDbiUnitTests, alphabet);
+/* The write methods are not supported */
+DECLARE_TEST(IndexedFastaDbiUnitTests, writeMethods);
+/* The document sequences are read from the indexed file */
+DECLARE_TEST(IndexedFastaDbiUnitTests, loadDocument_indexed);
+/* The file with uneven lines is imported as usual */
+DECLARE_TEST(IndexedFastaDbiUnitTests, loadDocument_unevenLines);
+
+} // U2
+
+DECLARE_METATYPE(IndexedFastaDbiUnitTests, getSequenceData_plain);
+DECLARE_METATYPE(IndexedFastaDbiUnitTests, getSequenceData_gzipped);
+DECLARE_METATYPE(IndexedFastaDbiUnitTests, getSequenceData_outOfRange);
+DECLARE_METATYPE(IndexedFastaDbiUnitTests, getSequenceData_indexMismatch);
+DECLARE_METATYPE(IndexedFastaDbiUnitTests, entryNumbers);
+DECLARE_METATYPE(IndexedFastaDbiUnitTests, alphabet);
+DECLARE_METATYPE(IndexedFastaDbiUnitTests, writeMethods);
+DECLARE_METATYPE(IndexedFastaDbiUnitTests, loadDocument_indexed);
+DECLARE_METATYPE(IndexedFastaDbiUnitTests, loadDocument_unevenLines);
+
+#endif // _U2_INDEXED_FASTA_DBI_UNIT_TESTS_H_
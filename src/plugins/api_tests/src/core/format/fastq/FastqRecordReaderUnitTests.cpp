@@ -0,0 +1,127 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include <QDir>
+#include <QFile>
+#include <QScopedPointer>
+
+#include <U2Core/IOAdapter.h>
+#include <U2Core/IOAdapterUtils.h>
+#include <U2Core/U2OpStatusUtils.h>
+
+#include <U2Formats/FastqRecordReader.h>
+
+#include "FastqRecordReaderUnitTests.h"
+
+namespace U2 {
+
+GUrl FastqRecordReaderTestUtils::writeFile(const QString &fileName, const QByteArray &data, U2OpStatus &os) {
+    const GUrl url(QDir::temp().absoluteFilePath(fileName));
+    QFile::remove(url.getURLString());
+    QScopedPointer<IOAdapter> io(IOAdapterUtils::open(url, os, IOAdapterMode_Write));
+    CHECK_OP(os, url);
+    CHECK_EXT(data.size() == io->writeBlock(data), os.setError("Write error"), url);
+    return url;
+}
+
+QStringList FastqRecordReaderTestUtils::readAll(const QString &fileName, const QByteArray &data, U2OpStatus &os) {
+    QStringList records;
+    const GUrl url = writeFile(fileName, data, os);
+    CHECK_OP(os, records);
+    QScopedPointer<IOAdapter> io(IOAdapterUtils::open(url, os));
+    CHECK_OP(os, records);
+
+    FastqRecordReader reader(io.data());
+    FastqRecord record;
+    while (reader.readNext(record, os)) {
+        records << QString("%1|%2|%3").arg(QString::fromLatin1(record.name, record.nameLength))
+                                      .arg(QString::fromLatin1(record.seq, record.seqLength))
+                                      .arg(QString::fromLatin1(record.quality, record.qualityLength));
+    }
+    return records;
+}
+
+IMPLEMENT_TEST(FastqRecordReaderUnitTests, read_records) {
+    U2OpStatusImpl os;
+    const QByteArray data = "@r1 description\nACGT\n+\nIIII\n\n@r2\r\nGGA\r\n+r2\r\n#5I\r\n";
+    const QStringList records = FastqRecordReaderTestUtils::readAll("FastqRecordReaderUnitTests.fq", data, os);
+    CHECK_NO_ERROR(os);
+    CHECK_EQUAL(2, records.size(), "records count");
+    CHECK_EQUAL(QString("r1 description|ACGT|IIII"), records[0], "record");
+    CHECK_EQUAL(QString("r2|GGA|#5I"), records[1], "record");
+}
+
+IMPLEMENT_TEST(FastqRecordReaderUnitTests, read_multiline) {
+    U2OpStatusImpl os;
+    const QByteArray data = "@r1\nACGT\nAC\n+\n@@II\nII\n@r2\nTT\nT\n+\n@\nII";
+    const QStringList records = FastqRecordReaderTestUtils::readAll("FastqRecordReaderUnitTests.fq", data, os);
+    CHECK_NO_ERROR(os);
+    CHECK_EQUAL(2, records.size(), "records count");
+    CHECK_EQUAL(QString("r1|ACGTAC|@@IIII"), records[0], "record");
+    CHECK_EQUAL(QString("r2|TTT|@II"), records[1], "record");
+}
+
+IMPLEMENT_TEST(FastqRecordReaderUnitTests, read_malformed) {
+    U2OpStatusImpl os;
+    const QByteArray data = "garbage\nmore garbage\n@r1\nACGT\n+\nIIII\n"
+                            "@r2\nACGT\n+other\nIIII\n"
+                            "@r3\nACGT\n+\nII\n"
+                            "@r4\nAC\n+\nII\n";
+    const QStringList records = FastqRecordReaderTestUtils::readAll("FastqRecordReaderUnitTests.fq", data, os);
+    CHECK_NO_ERROR(os);
+    CHECK_EQUAL(2, records.size(), "records count");
+    CHECK_EQUAL(QString("r1|ACGT|IIII"), records[0], "record");
+    CHECK_EQUAL(QString("r4|AC|II"), records[1], "record");
+}
+
+IMPLEMENT_TEST(FastqRecordReaderUnitTests, read_bufferBoundaries) {
+    static const char BASES[] = "ACGT";
+    const int recordsCount = 50000;
+    QByteArray data;
+    for (int i = 0; i < recordsCount; i++) {
+        const QByteArray seq(60 + i % 7, BASES[i % 4]);
+        data += "@read" + QByteArray::number(i) + "\n" + seq + "\n+\n" + QByteArray(seq.length(), 'I') + "\n";
+    }
+    const QByteArray longSeq(5 * 1024 * 1024, 'A');
+    data += "@long\n" + longSeq + "\n+\n" + QByteArray(longSeq.length(), '#') + "\n";
+
+    U2OpStatusImpl os;
+    const QStringList records = FastqRecordReaderTestUtils::readAll("FastqRecordReaderUnitTests.fq", data, os);
+    CHECK_NO_ERROR(os);
+    CHECK_EQUAL(recordsCount + 1, records.size(), "records count");
+    for (int i = 0; i < recordsCount; i++) {
+        const QString seq(60 + i % 7, QLatin1Char(BASES[i % 4]));
+        CHECK_EQUAL(QString("read%1|%2|%3").arg(i).arg(seq).arg(QString(seq.length(), QLatin1Char('I'))), records[i], "record");
+    }
+    CHECK_TRUE(records.last() == QString("long|%1|%2").arg(QString::fromLatin1(longSeq)).arg(QString(longSeq.length(), QLatin1Char('#'))), "unexpected long record");
+}
+
+IMPLEMENT_TEST(FastqRecordReaderUnitTests, read_gzipped) {
+    U2OpStatusImpl os;
+    const QByteArray data = "@r1\nACGT\n+\nIIII\n@r2\nGG\n+\n##\n";
+    const QStringList records = FastqRecordReaderTestUtils::readAll("FastqRecordReaderUnitTests.fq.gz", data, os);
+    CHECK_NO_ERROR(os);
+    CHECK_EQUAL(2, records.size(), "records count");
+    CHECK_EQUAL(QString("r1|ACGT|IIII"), records[0], "record");
+    CHECK_EQUAL(QString("r2|GG|##"), records[1], "record");
+}
+
+} // U2
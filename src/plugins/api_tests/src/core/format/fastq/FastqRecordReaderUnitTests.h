@@ -0,0 +1,60 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef _U2_FASTQ_RECORD_READER_UNIT_TESTS_H_
+#define _U2_FASTQ_RECORD_READER_UNIT_TESTS_H_
+
+#include <QStringList>
+
+#include <U2Core/GUrl.h>
+
+#include <unittest.h>
+
+namespace U2 {
+
+class FastqRecordReaderTestUtils {
+public:
+    // writes the data to a temporary file, a ".gz" file is gzipped
+    static GUrl writeFile(const QString &fileName, const QByteArray &data, U2OpStatus &os);
+    // writes the data to a temporary file and reads it, the records are "name|sequence|quality" strings
+    static QStringList readAll(const QString &fileName, const QByteArray &data, U2OpStatus &os);
+};
+
+/* Single line records with blank lines and CRLF line ends */
+DECLARE_TEST(FastqRecordReaderUnitTests, read_records);
+/* Multiline sequences and qualities, a quality line can start with '@' */
+DECLARE_TEST(FastqRecordReaderUnitTests, read_multiline);
+/* Broken records are skipped and the next records are read */
+DECLARE_TEST(FastqRecordReaderUnitTests, read_malformed);
+/* The records that cross the buffer end and a record longer than the buffer */
+DECLARE_TEST(FastqRecordReaderUnitTests, read_bufferBoundaries);
+/* A gzipped file is read */
+DECLARE_TEST(FastqRecordReaderUnitTests, read_gzipped);
+
+} // U2
+
+DECLARE_METATYPE(FastqRecordReaderUnitTests, read_records);
+DECLARE_METATYPE(FastqRecordReaderUnitTests, read_multiline);
+DECLARE_METATYPE(FastqRecordReaderUnitTests, read_malformed);
+DECLARE_METATYPE(FastqRecordReaderUnitTests, read_bufferBoundaries);
+DECLARE_METATYPE(FastqRecordReaderUnitTests, read_gzipped);
+
+#endif // _U2_FASTQ_RECORD_READER_UNIT_TESTS_H_
@@ -0,0 +1,204 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#include <QDir>
+#include <QFile>
+#include <QScopedPointer>
+
+#include <U2Core/IOAdapter.h>
+#include <U2Core/IOAdapterUtils.h>
+#include <U2Core/U2OpStatusUtils.h>
+#include <U2Core/ZlibAdapter.h>
+
+#include <U2Formats/BgzipTask.h>
+
+#include "ZlibAdapterUnitTests.h"
+
+namespace U2 {
+
+namespace {
+
+const int DATA_SIZE = 3500000;
+const int READ_SIZE = 1000;
+
+}
+
+QByteArray ZlibAdapterTestUtils::createData(int size, uint seed) {
+    static const char BASES[] = "ACGT";
+    QByteArray data(size, '\n');
+    uint state = seed;
+    for (int i = 0; i < size; i++) {
+        CHECK_CONTINUE(60 != i % 61);
+        state = state * 1103515245 + 12345;
+        data[i] = BASES[(state >> 16) & 3];
+    }
+    return data;
+}
+
+GUrl ZlibAdapterTestUtils::writeGzip(const QString &fileName, const QList<QByteArray> &members, U2OpStatus &os) {
+    const GUrl url(QDir::temp().absoluteFilePath(fileName));
+    QFile::remove(ZlibAdapter::getGzipIndexUrl(url));
+    QByteArray compressed;
+    for (int i = 0; i < members.size(); i++) {
+        const GUrl memberUrl(QDir::temp().absoluteFilePath(QString("%1.member%2.gz").arg(fileName).arg(i)));
+        {
+            QScopedPointer<IOAdapter> io(IOAdapterUtils::open(memberUrl, os, IOAdapterMode_Write));
+            CHECK_OP(os, url);
+            CHECK_EXT(members[i].size() == io->writeBlock(members[i]), os.setError("Write error"), url);
+        }
+        QFile memberFile(memberUrl.getURLString());
+        CHECK_EXT(memberFile.open(QIODevice::ReadOnly), os.setError("Can't read the gzip member"), url);
+        compressed += memberFile.readAll();
+        memberFile.close();
+        memberFile.remove();
+    }
+
+    QFile file(url.getURLString());
+    CHECK_EXT(file.open(QIODevice::WriteOnly | QIODevice::Truncate), os.setError("Can't write the gzip file"), url);
+    CHECK_EXT(compressed.size() == file.write(compressed), os.setError("Write error"), url);
+    return url;
+}
+
+GUrl ZlibAdapterTestUtils::writeBgzf(const QString &fileName, const QByteArray &data, U2OpStatus &os) {
+    const GUrl url(QDir::temp().absoluteFilePath(fileName));
+    QFile::remove(ZlibAdapter::getGzipIndexUrl(url));
+    const GUrl plainUrl(QDir::temp().absoluteFilePath(fileName + ".txt"));
+    {
+        QFile plainFile(plainUrl.getURLString());
+        CHECK_EXT(plainFile.open(QIODevice::WriteOnly | QIODevice::Truncate), os.setError("Can't write the plain file"), url);
+        CHECK_EXT(data.size() == plainFile.write(data), os.setError("Write error"), url);
+    }
+
+    BgzipTask task(plainUrl, url);
+    task.run();
+    QFile::remove(plainUrl.getURLString());
+    CHECK_EXT(!task.hasError(), os.setError(task.getError()), url);
+    CHECK_EXT(BgzipTask::checkBgzf(url), os.setError("The file is not BGZF"), url);
+    return url;
+}
+
+QString ZlibAdapterTestUtils::checkSeeks(const GUrl &url, const QByteArray &data) {
+    U2OpStatusImpl os;
+    QScopedPointer<IOAdapter> io(IOAdapterUtils::open(url, os));
+    CHECK_OP(os, os.getError());
+
+    QList<qint64> positions;
+    // long forward skips, backward seeks beyond the seek buffer and short backward skips inside of it
+    positions << 2500000 << 100000 << 3000000 << 10 << 1500000 << 1490000 << 1495000 << data.size() - READ_SIZE << 0;
+    QByteArray buffer(READ_SIZE, 0);
+    foreach (qint64 pos, positions) {
+        CHECK(io->skip(pos - io->bytesRead()), QString("can't seek to %1").arg(pos));
+        CHECK(pos == io->bytesRead(), QString("unexpected position after the seek to %1: %2").arg(pos).arg(io->bytesRead()));
+        CHECK(READ_SIZE == io->readBlock(buffer.data(), READ_SIZE), QString("can't read at %1").arg(pos));
+        CHECK(data.mid(int(pos), READ_SIZE) == buffer, QString("unexpected data at %1").arg(pos));
+    }
+    return QString();
+}
+
+IMPLEMENT_TEST(ZlibAdapterUnitTests, seek_singleMember) {
+    U2OpStatusImpl os;
+    const QByteArray data = ZlibAdapterTestUtils::createData(DATA_SIZE, 1);
+    const GUrl url = ZlibAdapterTestUtils::writeGzip("ZlibAdapterUnitTests.txt.gz", QList<QByteArray>() << data, os);
+    CHECK_NO_ERROR(os);
+
+    const QString error = ZlibAdapterTestUtils::checkSeeks(url, data);
+    CHECK_TRUE(error.isEmpty(), error);
+}
+
+IMPLEMENT_TEST(ZlibAdapterUnitTests, seek_members) {
+    U2OpStatusImpl os;
+    const QByteArray data = ZlibAdapterTestUtils::createData(DATA_SIZE, 2);
+    QList<QByteArray> members;
+    members << data.left(1200000) << data.mid(1200000, 1200000) << data.mid(2400000);
+    const GUrl url = ZlibAdapterTestUtils::writeGzip("ZlibAdapterUnitTests.txt.gz", members, os);
+    CHECK_NO_ERROR(os);
+
+    const QString error = ZlibAdapterTestUtils::checkSeeks(url, data);
+    CHECK_TRUE(error.isEmpty(), error);
+}
+
+IMPLEMENT_TEST(ZlibAdapterUnitTests, seek_bgzf) {
+    U2OpStatusImpl os;
+    const QByteArray data = ZlibAdapterTestUtils::createData(DATA_SIZE, 3);
+    const GUrl url = ZlibAdapterTestUtils::writeBgzf("ZlibAdapterUnitTests.bgzf.gz", data, os);
+    CHECK_NO_ERROR(os);
+
+    const QString error = ZlibAdapterTestUtils::checkSeeks(url, data);
+    CHECK_TRUE(error.isEmpty(), error);
+}
+
+IMPLEMENT_TEST(ZlibAdapterUnitTests, storedIndex) {
+    U2OpStatusImpl os;
+    const QByteArray data = ZlibAdapterTestUtils::createData(DATA_SIZE, 4);
+    const GUrl url = ZlibAdapterTestUtils::writeGzip("ZlibAdapterUnitTests.txt.gz", QList<QByteArray>() << data, os);
+    CHECK_NO_ERROR(os);
+
+    {
+        QScopedPointer<IOAdapter> io(IOAdapterUtils::open(url, os));
+        CHECK_NO_ERROR(os);
+        CHECK_EQUAL(-1, io->left(), "left bytes without the index");
+    }
+    QString error = ZlibAdapterTestUtils::checkSeeks(url, data);
+    CHECK_TRUE(error.isEmpty(), error);
+    CHECK_TRUE(QFile::exists(ZlibAdapter::getGzipIndexUrl(url)), "the index is not stored");
+
+    QScopedPointer<IOAdapter> io(IOAdapterUtils::open(url, os));
+    CHECK_NO_ERROR(os);
+    CHECK_EQUAL(DATA_SIZE, io->left(), "left bytes with the stored index");
+    error = ZlibAdapterTestUtils::checkSeeks(url, data);
+    CHECK_TRUE(error.isEmpty(), error);
+}
+
+IMPLEMENT_TEST(ZlibAdapterUnitTests, staleIndex) {
+    U2OpStatusImpl os;
+    const QByteArray oldData = ZlibAdapterTestUtils::createData(DATA_SIZE, 5);
+    GUrl url = ZlibAdapterTestUtils::writeGzip("ZlibAdapterUnitTests.txt.gz", QList<QByteArray>() << oldData, os);
+    CHECK_NO_ERROR(os);
+    QString error = ZlibAdapterTestUtils::checkSeeks(url, oldData);
+    CHECK_TRUE(error.isEmpty(), error);
+    const QString indexUrl = ZlibAdapter::getGzipIndexUrl(url);
+    CHECK_TRUE(QFile::exists(indexUrl), "the index is not stored");
+
+    // the file is replaced, but the old index stays next to it
+    const QString oldIndexUrl = indexUrl + ".old";
+    QFile::remove(oldIndexUrl);
+    CHECK_TRUE(QFile::rename(indexUrl, oldIndexUrl), "can't keep the index");
+    const QByteArray newData = ZlibAdapterTestUtils::createData(DATA_SIZE + 100000, 6);
+    url = ZlibAdapterTestUtils::writeGzip("ZlibAdapterUnitTests.txt.gz", QList<QByteArray>() << newData, os);
+    CHECK_NO_ERROR(os);
+    CHECK_TRUE(QFile::rename(oldIndexUrl, indexUrl), "can't restore the index");
+
+    bool loaded = true;
+    ZlibAdapter::loadGzipIndex(url, &loaded);
+    CHECK_FALSE(loaded, "the stale index is loaded");
+    {
+        QScopedPointer<IOAdapter> io(IOAdapterUtils::open(url, os));
+        CHECK_NO_ERROR(os);
+        CHECK_EQUAL(-1, io->left(), "left bytes with the stale index");
+    }
+    error = ZlibAdapterTestUtils::checkSeeks(url, newData);
+    CHECK_TRUE(error.isEmpty(), error);
+
+    ZlibAdapter::loadGzipIndex(url, &loaded);
+    CHECK_TRUE(loaded, "the index is not rebuilt");
+}
+
+} // U2
@@ -0,0 +1,62 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifndef _U2_ZLIB_ADAPTER_UNIT_TESTS_H_
+#define _U2_ZLIB_ADAPTER_UNIT_TESTS_H_
+
+#include <U2Core/GUrl.h>
+
+#include <unittest.h>
+
+namespace U2 {
+
+class U2OpStatus;
+
+class ZlibAdapterTestUtils {
+public:
+    static QByteArray createData(int size, uint seed);
+    // every member is compressed separately, the members are concatenated into one file
+    static GUrl writeGzip(const QString &fileName, const QList<QByteArray> &members, U2OpStatus &os);
+    static GUrl writeBgzf(const QString &fileName, const QByteArray &data, U2OpStatus &os);
+    // seeks forward and backward through the file and compares the read data, returns an empty string if it is the same
+    static QString checkSeeks(const GUrl &url, const QByteArray &data);
+};
+
+/* Seeks in a file of one gzip member */
+DECLARE_TEST(ZlibAdapterUnitTests, seek_singleMember);
+/* Seeks across concatenated gzip members */
+DECLARE_TEST(ZlibAdapterUnitTests, seek_members);
+/* Seeks across BGZF blocks */
+DECLARE_TEST(ZlibAdapterUnitTests, seek_bgzf);
+/* The stored index is loaded on the next open and makes the uncompressed size known */
+DECLARE_TEST(ZlibAdapterUnitTests, storedIndex);
+/* The stored index of a changed file is rejected and built again */
+DECLARE_TEST(ZlibAdapterUnitTests, staleIndex);
+
+} // U2
+
+DECLARE_METATYPE(ZlibAdapterUnitTests, seek_singleMember);
+DECLARE_METATYPE(ZlibAdapterUnitTests, seek_members);
+DECLARE_METATYPE(ZlibAdapterUnitTests, seek_bgzf);
+DECLARE_METATYPE(ZlibAdapterUnitTests, storedIndex);
+DECLARE_METATYPE(ZlibAdapterUnitTests, staleIndex);
+
+#endif // _U2_ZLIB_ADAPTER_UNIT_TESTS_H_
@@ -19,6 +19,14 @@
  * MA 02110-1301, USA.
  */
 
+#include <QRunnable>
+
+#include <3rdparty/zlib/zlib.h>
+
+#include <U2Core/AppContext.h>
+#include <U2Core/AppResources.h>
+#include <U2Core/AppSettings.h>
+
 #include "BAMDbiPlugin.h"
 #include "IOException.h"
 #include "InvalidFormatException.h"
@@ -27,76 +35,91 @@
 namespace U2 {
 namespace BAM {
 
+namespace {
+
+const int GZIP_HEADER_SIZE = 12;    // fixed gzip header fields including XLEN
+const int GZIP_FOOTER_SIZE = 8;     // CRC32 and ISIZE
+const quint32 MAX_BLOCK_SIZE = 65536;
+const int BLOCKS_PER_THREAD = 4;
+// the consumed blocks kept for the seeks back, e.g. to the overlapping chunks of a BAM index
+const int DECODED_BLOCKS = 16;
+
+quint16 readUInt16(const char *data) {
+    const uchar *d = (const uchar *)data;
+    return d[0] | (d[1] << 8);
+}
+
+quint32 readUInt32(const char *data) {
+    const uchar *d = (const uchar *)data;
+    return d[0] | (d[1] << 8) | (d[2] << 16) | ((quint32)d[3] << 24);
+}
+
+class InflateBlockRunnable : public QRunnable
+{
+public:
+    InflateBlockRunnable(BgzfReader *reader, BgzfBlock *block): reader(reader), block(block) {}
+
+    void run() {
+        reader->inflateBlock(block);
+    }
+
+private:
+    BgzfReader *reader;
+    BgzfBlock *block;
+};
+
+} // namespace
+
 BgzfReader::BgzfReader(IOAdapter &ioAdapter):
     ioAdapter(ioAdapter),
-    headerOffset(ioAdapter.bytesRead()),
+    readAheadBlocks(BLOCKS_PER_THREAD),
+    maxReadAheadBlocks(BLOCKS_PER_THREAD),
+    currentBlock(NULL),
+    currentPos(0),
+    nextCoffset(ioAdapter.bytesRead()),
+    ioEnd(false),
     endOfFile(false)
 {
-    stream.zalloc = Z_NULL;
-    stream.zfree = Z_NULL;
-    stream.opaque = Z_NULL;
-    stream.next_in = Z_NULL;
-    stream.avail_in = 0;
-    stream.next_out = Z_NULL;
-    stream.avail_out = 0;
-    if(Z_OK != inflateInit2(&stream, 16 + 15)) {
-        throw Exception(BAMDbiPlugin::tr("Can't initialize zlib"));
-    }
+    int threadCount = AppContext::getAppSettings()->getAppResourcePool()->getIdealThreadCount();
+    threadPool.setMaxThreadCount(qMax(1, threadCount));
+    maxReadAheadBlocks = BLOCKS_PER_THREAD * threadPool.maxThreadCount();
+    readAheadBlocks = maxReadAheadBlocks;
 }
 
 BgzfReader::~BgzfReader() {
-    inflateEnd(&stream);
+    dropPendingBlocks();
+    qDeleteAll(decodedBlocks);
+    delete currentBlock;
 }
 
 qint64 BgzfReader::read(char *buff, qint64 maxSize) {
-    if(0 == maxSize) {
-        return 0;
-    }
-    stream.next_out = (Bytef *)buff;
-    stream.avail_out = maxSize;
-    while(stream.avail_out > 0) {
-        if(0 == stream.avail_in) {
-            qint64 returnedValue = ioAdapter.readBlock(buffer, sizeof(buffer));
-            if(-1 == returnedValue) {
-                coreLog.error(QString("in BgzfReader::read, failed to read %1 bytes from ioAdapter, after %2 bytes already read. %3")
-                              .arg(sizeof(buffer))
-                              .arg(ioAdapter.bytesRead())
-                              .arg(ioAdapter.errorString()));
-                throw IOException(BAMDbiPlugin::tr("Can't read input"));
-            } else if(0 == returnedValue) {
-                endOfFile = true;
-                break;
-            } else {
-                stream.avail_in = returnedValue;
-                stream.next_in = (Bytef *)buffer;
-            }
-        }
-        int returnedValue = inflate(&stream, Z_SYNC_FLUSH);
-        if(Z_STREAM_END == returnedValue) {
-            nextBlock();
-        } else if(Z_OK != returnedValue) {
-            coreLog.error(QString("in BgzfReader::read, failed to decompress %1 bytes, after %2 raw bytes already read")
-                          .arg(sizeof(buffer))
-                          .arg(ioAdapter.bytesRead()));
-            throw InvalidFormatException(BAMDbiPlugin::tr("Can't decompress data"));
-        }
-    }
-    if(0 == stream.avail_in) {
+    if(NULL == currentBlock && !endOfFile) {
         nextBlock();
     }
-    qint64 bytesRead = maxSize - stream.avail_out;
+    qint64 bytesRead = 0;
+    while(bytesRead < maxSize && !endOfFile) {
+        qint64 toCopy = qMin(maxSize - bytesRead, (qint64)(currentBlock->data.size() - currentPos));
+        memcpy(buff + bytesRead, currentBlock->data.constData() + currentPos, toCopy);
+        bytesRead += toCopy;
+        currentPos += toCopy;
+        if(currentPos == currentBlock->data.size()) {
+            nextSequentialBlock();
+        }
+    }
     return bytesRead;
 }
 
 qint64 BgzfReader::skip(qint64 size) {
-    char skipBuffer[1024];
+    if(NULL == currentBlock && !endOfFile) {
+        nextBlock();
+    }
     qint64 bytesSkipped = 0;
-    while(bytesSkipped < size) {
-        qint64 toRead = qMin((qint64)sizeof(skipBuffer), size - bytesSkipped);
-        qint64 returnedValue = read(skipBuffer, toRead);
-        bytesSkipped += returnedValue;
-        if(returnedValue < toRead) {
-            break;
+    while(bytesSkipped < size && !endOfFile) {
+        qint64 toSkip = qMin(size - bytesSkipped, (qint64)(currentBlock->data.size() - currentPos));
+        bytesSkipped += toSkip;
+        currentPos += toSkip;
+        if(currentPos == currentBlock->data.size()) {
+            nextSequentialBlock();
         }
     }
     return bytesSkipped;
@@ -107,79 +130,275 @@ bool BgzfReader::isEof()const {
 }
 
 VirtualOffset BgzfReader::getOffset()const {
-    return VirtualOffset(headerOffset, stream.total_out);
+    if(NULL == currentBlock) {
+        return VirtualOffset(nextCoffset, 0);
+    }
+    return VirtualOffset(currentBlock->coffset, currentPos);
 }
 
 void BgzfReader::seek(VirtualOffset offset) {
-    if((offset.getCoffset() == headerOffset) && (offset.getUoffset() >= (int)stream.total_out)) {
-        qint64 toSkip = offset.getUoffset() - stream.total_out;
-        if(skip(toSkip) < toSkip) {
-            coreLog.error(QString("in BgzfReader::seek, cannot seek to offset {coffset=%1,uoffset=%2}, failed to skip %3")
+    quint64 coffset = offset.getCoffset();
+    if((NULL == currentBlock || currentBlock->coffset != coffset) && !takeDecodedBlock(coffset)) {
+        if(!skipPendingBlocks(coffset)) {
+            // random access: the blocks after the offset may be not needed, they are read ahead when the reading goes on
+            readAheadBlocks = 1;
+            dropPendingBlocks();
+            qDeleteAll(decodedBlocks);
+            decodedBlocks.clear();
+            delete currentBlock;
+            currentBlock = NULL;
+            qint64 toSkipIo = coffset - ioAdapter.bytesRead();
+            if(!ioAdapter.skip(toSkipIo)) {
+                coreLog.error(QString("in BgzfReader::seek, cannot seek to offset {coffset=%1,uoffset=%2}, ioAdapter failed to skip %3")
+                              .arg(offset.getCoffset())
+                              .arg(offset.getUoffset())
+                              .arg(toSkipIo));
+                throw IOException(BAMDbiPlugin::tr("Can't read input"));
+            }
+            nextCoffset = coffset;
+            ioEnd = false;
+        }
+        endOfFile = false;
+        nextBlock();
+        if(endOfFile || currentBlock->coffset != coffset) {
+            if(0 == offset.getUoffset()) {
+                // the block at the offset is empty, e.g. it is the EOF marker
+                return;
+            }
+            coreLog.error(QString("in BgzfReader::seek, cannot seek to offset {coffset=%1,uoffset=%2}, there is no block at this offset")
                           .arg(offset.getCoffset())
-                          .arg(offset.getUoffset())
-                          .arg(toSkip));
+                          .arg(offset.getUoffset()));
             throw InvalidFormatException(BAMDbiPlugin::tr("Unexpected end of file"));
         }
+    }
+    if(offset.getUoffset() > currentBlock->data.size()) {
+        coreLog.error(QString("in BgzfReader::seek, cannot seek to offset {coffset=%1,uoffset=%2}, the block size is %3")
+                      .arg(offset.getCoffset())
+                      .arg(offset.getUoffset())
+                      .arg(currentBlock->data.size()));
+        throw InvalidFormatException(BAMDbiPlugin::tr("Unexpected end of file"));
+    }
+    currentPos = offset.getUoffset();
+    if(currentPos == currentBlock->data.size()) {
+        nextBlock();
+    }
+}
+
+void BgzfReader::inflateBlock(BgzfBlock *block) {
+    const QByteArray &compressed = block->compressed;
+    quint32 crc = readUInt32(compressed.constData() + compressed.size() - GZIP_FOOTER_SIZE);
+    quint32 uncompressedSize = readUInt32(compressed.constData() + compressed.size() - 4);
+    if(uncompressedSize > MAX_BLOCK_SIZE) {
+        QMutexLocker locker(&blocksMutex);
+        block->error = BAMDbiPlugin::tr("Can't decompress data");
+        block->ready = true;
+        blockReady.wakeAll();
+        return;
+    }
+    QByteArray data(uncompressedSize, 0);
+    QString error;
+
+    z_stream stream;
+    stream.zalloc = Z_NULL;
+    stream.zfree = Z_NULL;
+    stream.opaque = Z_NULL;
+    stream.next_in = (Bytef *)compressed.constData();
+    stream.avail_in = compressed.size() - GZIP_FOOTER_SIZE;
+    stream.next_out = (Bytef *)data.data();
+    stream.avail_out = uncompressedSize;
+    if(Z_OK != inflateInit2(&stream, -15)) {
+        error = BAMDbiPlugin::tr("Can't initialize zlib");
     } else {
-        qint64 toSkipIo = offset.getCoffset() - ioAdapter.bytesRead();
-        if(!ioAdapter.skip(toSkipIo)) {
-            coreLog.error(QString("in BgzfReader::seek, cannot seek to offset {coffset=%1,uoffset=%2}, ioAdapter failed to skip %3")
-                          .arg(offset.getCoffset())
-                          .arg(offset.getUoffset())
-                          .arg(toSkipIo));
-            throw IOException(BAMDbiPlugin::tr("Can't read input"));
+        int returnedValue = inflate(&stream, Z_FINISH);
+        if(Z_STREAM_END != returnedValue || stream.total_out != uncompressedSize) {
+            error = BAMDbiPlugin::tr("Can't decompress data");
+        } else if(crc != crc32(crc32(0, Z_NULL, 0), (const Bytef *)data.constData(), uncompressedSize)) {
+            error = BAMDbiPlugin::tr("Can't decompress data");
         }
-        stream.next_in = Z_NULL;
-        stream.avail_in = 0;
-        headerOffset = ioAdapter.bytesRead();
-        inflateReset(&stream);
-        qint64 toSkip = offset.getUoffset();
-        if(skip(toSkip) < toSkip) {
-            coreLog.error(QString("in BgzfReader::seek, cannot seek to offset {coffset=%1,uoffset=%2}, failed to skip %3 after ioAdapter skipped %4")
-                          .arg(offset.getCoffset())
-                          .arg(offset.getUoffset())
-                          .arg(toSkip)
-                          .arg(toSkipIo));
-            throw InvalidFormatException(BAMDbiPlugin::tr("Unexpected end of file"));
+        inflateEnd(&stream);
+    }
+
+    QMutexLocker locker(&blocksMutex);
+    block->compressed.clear();
+    block->data = data;
+    block->error = error;
+    block->ready = true;
+    blockReady.wakeAll();
+}
+
+BgzfBlock *BgzfReader::readCompressedBlock() {
+    if(ioEnd) {
+        return NULL;
+    }
+    char header[GZIP_HEADER_SIZE];
+    qint64 returnedValue = ioAdapter.readBlock(header, sizeof(header));
+    if(0 == returnedValue) {
+        ioEnd = true;
+        return NULL;
+    }
+    if((qint64)sizeof(header) != returnedValue) {
+        coreLog.error(QString("in BgzfReader::readCompressedBlock, failed to read block header at %1").arg(nextCoffset));
+        throw InvalidFormatException(BAMDbiPlugin::tr("Unexpected end of file"));
+    }
+    if(31 != (uchar)header[0] || 139 != (uchar)header[1] || 8 != header[2] || 0 == (header[3] & 4)) {
+        coreLog.error(QString("in BgzfReader::readCompressedBlock, invalid BGZF block header at %1").arg(nextCoffset));
+        throw InvalidFormatException(BAMDbiPlugin::tr("Can't decompress data"));
+    }
+
+    int extraLength = readUInt16(header + 10);
+    QByteArray extra(extraLength, 0);
+    readFully(extra.data(), extraLength);
+    int blockSize = -1;
+    for(int pos = 0; pos + 4 <= extraLength; ) {
+        int subfieldLength = readUInt16(extra.constData() + pos + 2);
+        if('B' == extra[pos] && 'C' == extra[pos + 1] && 2 == subfieldLength && pos + 6 <= extraLength) {
+            blockSize = readUInt16(extra.constData() + pos + 4) + 1;
+            break;
         }
+        pos += 4 + subfieldLength;
+    }
+    int dataSize = blockSize - GZIP_HEADER_SIZE - extraLength;
+    if(dataSize < GZIP_FOOTER_SIZE) {
+        coreLog.error(QString("in BgzfReader::readCompressedBlock, no valid BGZF block size at %1").arg(nextCoffset));
+        throw InvalidFormatException(BAMDbiPlugin::tr("Can't decompress data"));
+    }
+
+    BgzfBlock *block = new BgzfBlock();
+    block->coffset = nextCoffset;
+    block->compressed.resize(dataSize);
+    try {
+        readFully(block->compressed.data(), dataSize);
+    } catch(const Exception &) {
+        delete block;
+        throw;
+    }
+    nextCoffset += blockSize;
+    return block;
+}
+
+void BgzfReader::fillReadAhead() {
+    while(pendingBlocks.size() < readAheadBlocks) {
+        BgzfBlock *block = readCompressedBlock();
+        if(NULL == block) {
+            break;
+        }
+        pendingBlocks.append(block);
+        threadPool.start(new InflateBlockRunnable(this, block));
     }
-    endOfFile = false;
 }
 
 void BgzfReader::nextBlock() {
-    uInt oldAvailOut = stream.avail_out;
-    stream.avail_out = 0;
+    if(NULL != currentBlock) {
+        keepDecodedBlock(currentBlock);
+    }
+    currentBlock = NULL;
+    currentPos = 0;
     while(true) {
-        if(0 == stream.avail_in) {
-            qint64 returnedValue = ioAdapter.readBlock(buffer, sizeof(buffer));
-            if(-1 == returnedValue) {
-                coreLog.error(QString("in BgzfReader::nextBlock, failed to read %1 bytes from ioAdapter, after %2 bytes already read. %3")
-                              .arg(sizeof(buffer))
-                              .arg(ioAdapter.bytesRead())
-                              .arg(ioAdapter.errorString()));
-                throw IOException(BAMDbiPlugin::tr("Can't read input"));
-            } else if(0 == returnedValue) {
-                endOfFile = true;
-                break;
-            } else {
-                stream.avail_in = returnedValue;
-                stream.next_in = (Bytef *)buffer;
-            }
+        fillReadAhead();
+        if(pendingBlocks.isEmpty()) {
+            endOfFile = true;
+            return;
         }
-        int returnedValue = inflate(&stream, Z_SYNC_FLUSH);
-        if(Z_STREAM_END == returnedValue) {
-            headerOffset = ioAdapter.bytesRead() - stream.avail_in;
-            inflateReset(&stream);
-        } else if(Z_BUF_ERROR == returnedValue) {
-            break;
-        } else if(Z_OK != returnedValue) {
-            coreLog.error(QString("in BgzfReader::nextBlock, failed to decompress %1 bytes, after %2 raw bytes already read")
-                          .arg(sizeof(buffer))
-                          .arg(ioAdapter.bytesRead()));
-            throw InvalidFormatException(BAMDbiPlugin::tr("Can't decompress data"));
+        BgzfBlock *block = pendingBlocks.takeFirst();
+        waitForBlock(block);
+        if(!block->error.isEmpty()) {
+            QString error = block->error;
+            coreLog.error(QString("in BgzfReader::nextBlock, failed to decompress the block at %1").arg(block->coffset));
+            delete block;
+            throw InvalidFormatException(error);
+        }
+        if(!block->data.isEmpty()) {
+            currentBlock = block;
+            return;
+        }
+        // empty blocks, e.g. the EOF marker, are skipped
+        delete block;
+    }
+}
+
+void BgzfReader::nextSequentialBlock() {
+    readAheadBlocks = qMin(maxReadAheadBlocks, 2 * readAheadBlocks);
+    nextBlock();
+}
+
+bool BgzfReader::takeDecodedBlock(quint64 coffset) {
+    int index = decodedBlocks.size() - 1;
+    while(index >= 0 && decodedBlocks[index]->coffset != coffset) {
+        index--;
+    }
+    if(index < 0) {
+        return false;
+    }
+    // the returned blocks are decoded already
+    if(NULL != currentBlock) {
+        pendingBlocks.prepend(currentBlock);
+    }
+    while(decodedBlocks.size() > index + 1) {
+        pendingBlocks.prepend(decodedBlocks.takeLast());
+    }
+    currentBlock = decodedBlocks.takeLast();
+    currentPos = 0;
+    endOfFile = false;
+    return true;
+}
+
+bool BgzfReader::skipPendingBlocks(quint64 coffset) {
+    int index = 0;
+    while(index < pendingBlocks.size() && pendingBlocks[index]->coffset != coffset) {
+        index++;
+    }
+    if(index == pendingBlocks.size()) {
+        return false;
+    }
+    if(NULL != currentBlock) {
+        keepDecodedBlock(currentBlock);
+        currentBlock = NULL;
+    }
+    for(int i = 0; i < index; i++) {
+        BgzfBlock *block = pendingBlocks.takeFirst();
+        waitForBlock(block);
+        if(block->error.isEmpty() && !block->data.isEmpty()) {
+            keepDecodedBlock(block);
+        } else {
+            delete block;
         }
     }
-    stream.avail_out = oldAvailOut;
+    return true;
+}
+
+void BgzfReader::keepDecodedBlock(BgzfBlock *block) {
+    decodedBlocks.append(block);
+    while(decodedBlocks.size() > DECODED_BLOCKS) {
+        delete decodedBlocks.takeFirst();
+    }
+}
+
+void BgzfReader::dropPendingBlocks() {
+    foreach(BgzfBlock *block, pendingBlocks) {
+        waitForBlock(block);
+        delete block;
+    }
+    pendingBlocks.clear();
+}
+
+void BgzfReader::waitForBlock(BgzfBlock *block) {
+    QMutexLocker locker(&blocksMutex);
+    while(!block->ready) {
+        blockReady.wait(&blocksMutex);
+    }
+}
+
+void BgzfReader::readFully(char *buff, qint64 size) {
+    qint64 returnedValue = ioAdapter.readBlock(buff, size);
+    if(-1 == returnedValue) {
+        coreLog.error(QString("in BgzfReader::readFully, failed to read %1 bytes from ioAdapter, after %2 bytes already read. %3")
+                      .arg(size)
+                      .arg(ioAdapter.bytesRead())
+                      .arg(ioAdapter.errorString()));
+        throw IOException(BAMDbiPlugin::tr("Can't read input"));
+    } else if(returnedValue < size) {
+        throw InvalidFormatException(BAMDbiPlugin::tr("Unexpected end of file"));
+    }
 }
 
 } // namespace BAM
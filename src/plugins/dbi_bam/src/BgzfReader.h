@@ -22,7 +22,9 @@
 #ifndef _U2_BAM_BGZF_READER_H_
 #define _U2_BAM_BGZF_READER_H_
 
-#include <3rdparty/zlib/zlib.h>
+#include <QMutex>
+#include <QThreadPool>
+#include <QWaitCondition>
 
 #include <U2Core/IOAdapter.h>
 #include "VirtualOffset.h"
@@ -30,6 +32,28 @@
 namespace U2 {
 namespace BAM {
 
+/**
+ * A single BGZF block: compressed data read from the input and its decompressed content.
+ */
+class BgzfBlock
+{
+public:
+    BgzfBlock(): coffset(0), ready(false) {}
+
+    quint64 coffset;        // offset of the block in the compressed file
+    QByteArray compressed;  // raw deflate data followed by the CRC32 and ISIZE fields
+    QByteArray data;        // decompressed data, valid when 'ready' is true
+    QString error;          // decompression error, if any
+    bool ready;
+};
+
+/**
+ * Reads BGZF files (e.g. BAM). BGZF blocks are independently compressed:
+ * the reader reads several blocks ahead and decompresses them in parallel in worker threads.
+ * Blocks are consumed in the file order, so virtual offsets have the same meaning as in a sequential reader.
+ * A seek to a decoded or read ahead block reuses it. After a seek elsewhere only the needed block is decoded,
+ * the read-ahead grows back while the reading goes on sequentially.
+ */
 class BgzfReader
 {
 public:
@@ -43,14 +67,45 @@ public:
 
     VirtualOffset getOffset()const;
     void seek(VirtualOffset offset);
+
+    // decompresses the block in the worker thread
+    void inflateBlock(BgzfBlock *block);
+
 private:
+    // reads the next compressed block from the input, returns NULL at the end of the file
+    BgzfBlock *readCompressedBlock();
+    // keeps 'readAheadBlocks' blocks queued for decompression
+    void fillReadAhead();
+    // makes the first non-empty queued block current, sets 'endOfFile' if there are no more blocks
     void nextBlock();
+    // the reading has reached the end of the current block: the read-ahead grows
+    void nextSequentialBlock();
+    // makes the consumed block at the offset current again, the blocks after it return to the queue
+    bool takeDecodedBlock(quint64 coffset);
+    // leaves the queued block at the offset first, the blocks before it are consumed.
+    // Returns false if the block is not queued
+    bool skipPendingBlocks(quint64 coffset);
+    void keepDecodedBlock(BgzfBlock *block);
+    // waits for the queued blocks and drops them
+    void dropPendingBlocks();
+    void waitForBlock(BgzfBlock *block);
+    void readFully(char *buff, qint64 size);
 
-    static const int BUFFER_SIZE = 16384;
     IOAdapter &ioAdapter;
-    z_stream stream;
-    char buffer[BUFFER_SIZE];
-    quint64 headerOffset;
+    QThreadPool threadPool;
+    int readAheadBlocks;
+    int maxReadAheadBlocks;
+
+    QMutex blocksMutex;
+    QWaitCondition blockReady;
+    QList<BgzfBlock *> pendingBlocks;
+    // the last consumed blocks in the file order
+    QList<BgzfBlock *> decodedBlocks;
+
+    BgzfBlock *currentBlock;
+    int currentPos;
+    quint64 nextCoffset;    // offset of the next block to be read from the input
+    bool ioEnd;             // all blocks are read from the input
     bool endOfFile;
 };
 
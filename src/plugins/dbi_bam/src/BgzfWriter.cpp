@@ -19,6 +19,8 @@
  * MA 02110-1301, USA.
  */
 
+#include <U2Core/U2OpStatusUtils.h>
+
 #include "BAMDbiPlugin.h"
 #include "IOException.h"
 #include "BgzfWriter.h"
@@ -26,27 +28,16 @@
 namespace U2 {
 namespace BAM {
 
-BgzfWriter::BgzfWriter(IOAdapter &ioAdapter):
+BgzfWriter::BgzfWriter(IOAdapter &ioAdapter, int threadCount, int compressionLevel):
     ioAdapter(ioAdapter),
-    headerOffset(ioAdapter.bytesRead()),
-    blockEnd(false),
+    startOffset(ioAdapter.bytesRead()),
+    compressor(&ioAdapter, threadCount, compressionLevel),
     finished(false)
 {
-    stream.zalloc = Z_NULL;
-    stream.zfree = Z_NULL;
-    stream.opaque = Z_NULL;
-    stream.next_in = Z_NULL;
-    stream.avail_in = 0;
-    stream.next_out = Z_NULL;
-    stream.avail_out = 0;
-    if(Z_OK != deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 16 + 15, 8, Z_DEFAULT_STRATEGY)) {
-        throw Exception(BAMDbiPlugin::tr("Can't initialize zlib"));
-    }
 }
 
 BgzfWriter::~BgzfWriter() {
     assert(finished);
-    deflateEnd(&stream);
 }
 
 void BgzfWriter::write(const char *buff, qint64 size) {
@@ -54,66 +45,31 @@ void BgzfWriter::write(const char *buff, qint64 size) {
         return;
     }
     assert(!finished);
-    qint64 bytesWritten = 0;
-    while(bytesWritten < size) {
-        if(blockEnd) {
-            deflateReset(&stream);
-            blockEnd = false;
-        }
-        qint64 toWrite = qMin(size - bytesWritten, BLOCK_SIZE - (qint64)stream.total_in);
-        stream.next_in = (Bytef *)&buff[bytesWritten];
-        stream.avail_in = (uInt)toWrite;
-        while(stream.avail_in > 0) {
-            stream.next_out = (Bytef *)buffer;
-            stream.avail_out = sizeof(buffer);
-            if(Z_OK != deflate(&stream, Z_NO_FLUSH)) {
-                throw Exception(BAMDbiPlugin::tr("Can't compress data"));
-            } else {
-                qint64 toWrite = sizeof(buffer) - stream.avail_out;
-                if(ioAdapter.writeBlock(buffer, toWrite) != toWrite) {
-                    throw IOException(BAMDbiPlugin::tr("Can't write output"));
-                }
-            }
-        }
-        if(BLOCK_SIZE == (int)stream.total_in) {
-            finishBlock();
-            headerOffset = ioAdapter.bytesRead();
-        }
-        bytesWritten += toWrite;
-    }
+    U2OpStatusImpl os;
+    compressor.write(buff, size, os);
+    checkStatus(os);
 }
 
 void BgzfWriter::finish() {
     assert(!finished);
-    finishBlock();
+    U2OpStatusImpl os;
+    compressor.finish(os);
+    checkStatus(os);
     finished = true;
 }
 
-VirtualOffset BgzfWriter::getOffset()const {
-    return VirtualOffset(headerOffset, blockEnd? 0:stream.total_out);
+VirtualOffset BgzfWriter::getOffset() {
+    U2OpStatusImpl os;
+    qint64 blockOffset = compressor.getBlockOffset(os);
+    checkStatus(os);
+    return VirtualOffset(startOffset + blockOffset, compressor.getOffsetInBlock());
 }
 
-void BgzfWriter::finishBlock() {
-    stream.next_in = Z_NULL;
-    stream.avail_in = 0;
-    while(true) {
-        stream.next_out = (Bytef *)buffer;
-        stream.avail_out = sizeof(buffer);
-        int returnedValue = deflate(&stream, Z_FINISH);
-        if((Z_OK == returnedValue) || (Z_STREAM_END == returnedValue)) {
-            qint64 toWrite = sizeof(buffer) - stream.avail_out;
-            if(ioAdapter.writeBlock(buffer, toWrite) != toWrite) {
-                throw IOException(BAMDbiPlugin::tr("Can't write output"));
-            }
-            if(Z_STREAM_END == returnedValue) {
-                break;
-            }
-        } else {
-            throw Exception(BAMDbiPlugin::tr("Can't compress data"));
-        }
+void BgzfWriter::checkStatus(U2OpStatus &os) {
+    if(os.hasError()) {
+        coreLog.error(QString("in BgzfWriter, %1").arg(os.getError()));
+        throw IOException(BAMDbiPlugin::tr("Can't write output"));
     }
-    blockEnd = true;
-    headerOffset = ioAdapter.bytesRead();
 }
 
 } // namespace BAM
@@ -22,34 +22,37 @@
 #ifndef _U2_BAM_BGZF_WRITER_H_
 #define _U2_BAM_BGZF_WRITER_H_
 
-#include <3rdparty/zlib/zlib.h>
-
 #include <U2Core/IOAdapter.h>
+
+#include <U2Formats/ParallelBgzfCompressor.h>
+
 #include "VirtualOffset.h"
 
 namespace U2 {
 namespace BAM {
 
+/**
+ * Writes BGZF files, the blocks are compressed in parallel by ParallelBgzfCompressor.
+ * 'threadCount' less than 1 means the ideal thread count of the application,
+ * 'compressionLevel' is a zlib compression level.
+ */
 class BgzfWriter
 {
 public:
-    BgzfWriter(IOAdapter &ioAdapter);
+    BgzfWriter(IOAdapter &ioAdapter, int threadCount = -1, int compressionLevel = -1);
     ~BgzfWriter();
 
     void write(const char *buff, qint64 size);
     void finish();
 
-    VirtualOffset getOffset()const;
+    // waits for the pending blocks to get the compressed offset
+    VirtualOffset getOffset();
 private:
-    void finishBlock();
+    void checkStatus(U2OpStatus &os);
 
-    static const int BUFFER_SIZE = 16384;
-    static const int BLOCK_SIZE = 65536;
     IOAdapter &ioAdapter;
-    z_stream stream;
-    char buffer[BUFFER_SIZE];
-    quint64 headerOffset;
-    bool blockEnd;
+    quint64 startOffset;
+    ParallelBgzfCompressor compressor;
     bool finished;
 };
 
@@ -74,21 +74,38 @@ BaseContentGraphAlgorithm::BaseContentGraphAlgorithm(const QBitArray& _map)  :
 {
 }
 
-void BaseContentGraphAlgorithm::windowStrategyWithoutMemorize(QVector<float> &res, const QByteArray &seq,
+int BaseContentGraphAlgorithm::countBases(const char *seq, int begin, int end) const {
+    int baseCount = 0;
+    for (int x = begin; x < end; x++) {
+        if (map.testBit((uchar)seq[x])) {
+            baseCount++;
+        }
+    }
+    return baseCount;
+}
+
+void BaseContentGraphAlgorithm::slidingWindowStrategy(QVector<float> &res, const QByteArray &seqArr,
     int startPos, const GSequenceGraphWindowData *d, int nSteps, U2OpStatus &os)
 {
+    const char *seq = seqArr.constData();
+    int start = startPos;
+    int end = start + d->window;
+    int baseCount = countBases(seq, start, end);
     for (int i = 0; i < nSteps; i++) {
-        int start = startPos + i * d->step;
-        int end = start + d->window;
-        int base_count = 0;
-        for (int x = start; x < end; x++) {
-            CHECK_OP(os, );
-            char c = seq[x];
-            if (map[(uchar)c]) {
-                base_count++;
+        CHECK_OP(os, );
+        if (i > 0) {
+            // only the bases that leave and enter the window are counted
+            int nextStart = start + d->step;
+            int nextEnd = nextStart + d->window;
+            if (nextStart >= end) {
+                baseCount = countBases(seq, nextStart, nextEnd);
+            } else {
+                baseCount += countBases(seq, end, nextEnd) - countBases(seq, start, nextStart);
             }
+            start = nextStart;
+            end = nextEnd;
         }
-        res.append((base_count / (float)(d->window))*100);
+        res.append((baseCount / (float)(d->window))*100);
     }
 }
 
@@ -103,7 +120,7 @@ void BaseContentGraphAlgorithm::calculate(QVector<float> &res, U2SequenceObject
     const QByteArray &seq = getSequenceData(o, os);
     CHECK_OP(os, );
     int startPos = vr.startPos;
-    windowStrategyWithoutMemorize(res, seq, startPos, d, nSteps, os);
+    slidingWindowStrategy(res, seq, startPos, d, nSteps, os);
 }
 
 } // namespace
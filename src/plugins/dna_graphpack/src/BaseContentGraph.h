@@ -52,8 +52,9 @@ public:
     virtual void calculate(QVector<float>& res, U2SequenceObject* o, const U2Region& r, const GSequenceGraphWindowData* d, U2OpStatus &os);
 
 private:
-    void windowStrategyWithoutMemorize(QVector<float>& res, const QByteArray& seq, int startPos,
+    void slidingWindowStrategy(QVector<float>& res, const QByteArray& seq, int startPos,
         const GSequenceGraphWindowData* d, int nSteps, U2OpStatus &os);
+    int countBases(const char* seq, int begin, int end) const;
 
     QBitArray map;
 };
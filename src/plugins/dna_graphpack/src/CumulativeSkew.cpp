@@ -75,28 +75,31 @@ CumulativeSkewGraphAlgorithm::CumulativeSkewGraphAlgorithm(const QPair<char, cha
 {
 }
 
-float CumulativeSkewGraphAlgorithm::getValue(int begin, int end, const QByteArray& seq)
+float CumulativeSkewGraphAlgorithm::getWindowSkew(int begin, int len, const QByteArray& seq)
 {
-    int leap = end - begin;
     int first = 0;
     int second = 0;
-    float resultValue = 0;
-    int len;
-    for (int window = 0; window < end; window += leap)    {
-        first = 0;
-        second = 0;
-        if (window + leap > end) len = window - end; else len = leap;
-        for (int i = 0; i < len; ++i)    {
-            char c = seq[window + i];
-            if (c == p.first) {
-                first++; continue;
-            }
-            if (c == p.second) {
-                second++;
-            }
+    for (int i = 0; i < len; ++i)    {
+        char c = seq[begin + i];
+        if (c == p.first) {
+            first++; continue;
+        }
+        if (c == p.second) {
+            second++;
         }
-        if (first + second > 0)
-            resultValue += (float)(first - second)/(first + second);
+    }
+    if (first + second > 0) {
+        return (float)(first - second)/(first + second);
+    }
+    return 0;
+}
+
+float CumulativeSkewGraphAlgorithm::getValue(int begin, int end, const QByteArray& seq)
+{
+    int leap = end - begin;
+    float resultValue = 0;
+    for (int window = 0; window + leap <= end; window += leap)    {
+        resultValue += getWindowSkew(window, leap, seq);
     }
     return resultValue;
 }
@@ -111,12 +114,18 @@ void CumulativeSkewGraphAlgorithm::calculate(QVector<float> &res, U2SequenceObje
     const QByteArray &seq = getSequenceData(o, os);
     CHECK_OP(os, );
 
+    // getValue() sums the skews of all the complete windows before the end of a step,
+    // the ends grow, so the sum is continued from the previous step instead of being recalculated
+    float resultValue = 0;
+    int nextWindow = 0;
     for (int i = 0; i < nSteps; i++) {
         CHECK_OP(os, );
         int start = vr.startPos + i * d->step;
         int end = start + d->window;
-        float result = getValue(start, end, seq);
-        res.append(result);
+        for (; nextWindow + d->window <= end; nextWindow += d->window) {
+            resultValue += getWindowSkew(nextWindow, d->window, seq);
+        }
+        res.append(resultValue);
     }
 }
 
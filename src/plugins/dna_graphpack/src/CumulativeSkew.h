@@ -48,6 +48,7 @@ public:
     CumulativeSkewGraphAlgorithm(const QPair<char, char>& _p);
 
     float getValue(int begin, int end, const QByteArray& seq);
+    float getWindowSkew(int begin, int len, const QByteArray& seq);
     virtual void calculate(QVector<float>& res, U2SequenceObject* o, const U2Region& r, const GSequenceGraphWindowData* d, U2OpStatus &os);
 
 private:
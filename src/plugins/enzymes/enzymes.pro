@@ -11,7 +11,6 @@ HEADERS += src/CloningUtilTasks.h \
            src/EnzymesPlugin.h \
            src/EnzymesQuery.h \
            src/EnzymesTests.h \
-           src/FindEnzymesAlgorithm.h \
            src/FindEnzymesDialog.h \
            src/FindEnzymesTask.h
 FORMS += src/ConstructMoleculeDialog.ui \
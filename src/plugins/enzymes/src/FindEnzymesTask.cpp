@@ -107,6 +107,8 @@ Task::ReportResult FindEnzymesToAnnotationsTask::report() {
 // find multiple enzymes task
 FindEnzymesTask::FindEnzymesTask(const U2EntityRef& seqRef, const U2Region& region, const QList<SEnzymeData>& enzymes, int mr, bool _circular, QVector<U2Region> excludedRegions)
     : Task(tr("Find Enzymes"), TaskFlags_NR_FOSCOE),
+      dnaSeqRef(seqRef),
+      algorithm(NULL),
       maxResults(mr),
       excludedRegions(excludedRegions),
       circular(_circular),
@@ -116,15 +118,49 @@ FindEnzymesTask::FindEnzymesTask(const U2EntityRef& seqRef, const U2Region& regi
 
     SAFE_POINT(seq.getAlphabet()->isNucleic(), tr("Alphabet is not nucleic."), );
     seqlen = seq.getSequenceLength();
-    //for every enzymes in selection create FindSingleEnzymeTask
+
+    QList<SEnzymeData> searchedEnzymes;
     foreach(const SEnzymeData& e, enzymes) {
+        if (e->seq.isEmpty() || e->seq.length() > seqlen) {
+            continue;
+        }
+        SAFE_POINT(e->alphabet != NULL, tr("No enzyme alphabet"), );
+        if (!e->alphabet->isNucleic()) {
+            algoLog.info(tr("Non-nucleic enzyme alphabet: %1, enzyme: %2, skipping..").arg(e->alphabet->getId()).arg(e->id));
+            continue;
+        }
+        searchedEnzymes << e;
+    }
+
+    algorithm = new FindMultipleEnzymesAlgorithm(searchedEnzymes, seq.getAlphabet());
+    foreach(const SEnzymeData& e, algorithm->getUnsupportedEnzymes()) {
         addSubTask(new FindSingleEnzymeTask(seqRef, region, e, this, circular));
     }
+    CHECK(!algorithm->isEmpty(), );
+
+    const int BLOCK_READ_FROM_DB = 128000;
+    static const int chunkSize = BLOCK_READ_FROM_DB;
+
+    SequenceDbiWalkerConfig swc;
+    swc.seqRef = dnaSeqRef;
+    swc.range = region;
+    swc.chunkSize = qMax(algorithm->getMaxSiteLength(), chunkSize);
+    swc.lastChunkExtraLen = swc.chunkSize / 2;
+    swc.overlapSize = algorithm->getMaxSiteLength() - 1;
+    swc.walkCircular = circular;
+    swc.walkCircularDistance = swc.overlapSize;
+
+    addSubTask(new SequenceDbiWalkerTask(swc, this, tr("Find enzymes parallel")));
+}
+
+FindEnzymesTask::~FindEnzymesTask() {
+    delete algorithm;
 }
 
 void FindEnzymesTask::onResult(int pos, const SEnzymeData& enzyme, const U2Strand& strand) {
-    if (pos > seqlen) {
-        pos %= seqlen;
+    if (pos >= seqlen) {
+        // the site starts in the circular extension of the sequence, it has been found at the sequence start
+        return;
     }
     foreach (const U2Region &r, excludedRegions) {
         if (U2Region(pos, enzyme->seq.length()).intersects(r)) {
@@ -143,6 +179,30 @@ void FindEnzymesTask::onResult(int pos, const SEnzymeData& enzyme, const U2Stran
     results.append(FindEnzymesAlgResult(enzyme, pos, strand));
 }
 
+void FindEnzymesTask::onRegion(SequenceDbiWalkerSubtask* t, TaskStateInfo& ti) {
+    U2SequenceObject dnaSequenceObject("sequence", dnaSeqRef);
+    U2Region chunkRegion = t->getGlobalRegion();
+    QByteArray chunk;
+    if (U2Region(0, seqlen).contains(chunkRegion)) {
+        chunk = dnaSequenceObject.getSequenceData(chunkRegion, ti);
+    } else {
+        U2Region partOne = U2Region(0, seqlen).intersect(chunkRegion);
+        chunk = dnaSequenceObject.getSequenceData(partOne, ti);
+        CHECK_OP(ti, );
+        U2Region partTwo = U2Region(0, chunkRegion.endPos() % seqlen);
+        chunk.append(dnaSequenceObject.getSequenceData(partTwo, ti));
+    }
+    CHECK_OP(ti, );
+
+    // the overlap is as long as the longest site, so the shorter sites that start in it
+    // are also found in the next chunk and must be reported only once
+    int reportLimit = chunk.length();
+    if (t->hasRightOverlap()) {
+        reportLimit -= t->getGlobalConfig().overlapSize;
+    }
+    algorithm->run(chunk.constData(), chunk.length(), reportLimit, this, ti, chunkRegion.startPos);
+}
+
 QList<SharedAnnotationData> FindEnzymesTask::getResultsAsAnnotations(const QString& enzymeId) const {
     QList<SharedAnnotationData> res;
 
@@ -29,6 +29,7 @@
 #include <QObject>
 
 #include <U2Algorithm/EnzymeModel.h>
+#include <U2Algorithm/FindEnzymesAlgorithm.h>
 
 #include <U2Core/AnnotationData.h>
 #include <U2Core/AnnotationTableObject.h>
@@ -38,8 +39,6 @@
 #include <U2Core/Task.h>
 #include <U2Core/U2Region.h>
 
-#include "FindEnzymesAlgorithm.h"
-
 namespace U2 {
 
 class FindEnzymesAlgResult {
@@ -88,15 +87,21 @@ private:
     FindEnzymesTask *                   fTask;
 };
 
-class FindEnzymesTask : public Task, public FindEnzymesAlgListener {
+/**
+ * Searches all enzymes in a single pass over the sequence with FindMultipleEnzymesAlgorithm.
+ * The enzymes with too long sites are searched one by one with FindSingleEnzymeTask.
+ */
+class FindEnzymesTask : public Task, public FindEnzymesAlgListener, public SequenceDbiWalkerCallback {
     Q_OBJECT
 public:
     FindEnzymesTask(const U2EntityRef& seqRef, const U2Region& region, const QList<SEnzymeData>& enzymes, int maxResults = 0x7FFFFFFF,
                     bool _circular = false, QVector<U2Region> excludedRegions = QVector<U2Region>());
+    ~FindEnzymesTask();
 
     QList<FindEnzymesAlgResult>  getResults() const {return results;}
 
     virtual void onResult(int pos, const SEnzymeData& enzyme, const U2Strand& stand);
+    virtual void onRegion(SequenceDbiWalkerSubtask* t, TaskStateInfo& ti);
 
     ReportResult report();
 
@@ -107,6 +112,8 @@ public:
 private:
     void registerResult(const FindEnzymesAlgResult& r);
 
+    U2EntityRef                         dnaSeqRef;
+    FindMultipleEnzymesAlgorithm*       algorithm;
     int                                 maxResults;
     QVector<U2Region>                   excludedRegions;
     bool                                circular;
@@ -190,7 +190,11 @@ void ShortReadAlignerCPU::run() {
     GenomeAlignerFindTask *parent = static_cast<GenomeAlignerFindTask*>(getParentTask());
     SAFE_POINT_EXT(NULL != parent, setError("Aligner parent error"),);
 
-    QVector<int> binarySearchResults;
+    QVector<BinarySearchResult> binarySearchResults;
+    QVector<BinarySearchResult> sortedSearchResults;
+    QVector<BMType> bitFilters;
+    QVector<SearchQuery*> alignedQueries;
+    QVector<SearchQuery*> finishedQueries;
 
     SAFE_POINT_EXT (NULL != index, setError("Aligner index error"),);
     for (int part = 0; part < index->getPartCount(); part++) {
@@ -226,20 +230,25 @@ void ShortReadAlignerCPU::run() {
             dataBunch->prepareSorted();
             int binaryFound = 0;
             binarySearchResults.resize(length);
+            sortedSearchResults.resize(length);
+            bitFilters.resize(length);
             t0 = GTimer::currentTimeMicros();
             for (int i = 0; i < length; i++) {
                 int currentW = dataBunch->windowSizes.at(dataBunch->sortedIndexes[i]);
                 CHECK_LOG(0 != currentW,);
-                BMType currentBitFilter = ((quint64)0 - 1) << (62 - currentW * 2);
-                BMType bv = dataBunch->sortedBitValuesV.at(i);
-
-                binarySearchResults[dataBunch->sortedIndexes[i]] = index->bitMaskBinarySearch(bv, currentBitFilter);
-                binaryFound += binarySearchResults[dataBunch->sortedIndexes[i]] == -1 ? 0 : 1;
+                bitFilters[i] = ((quint64)0 - 1) << (62 - currentW * 2);
+            }
+            index->bitMaskBinarySearch(dataBunch->sortedBitValuesV.constData(), bitFilters.constData(), length, sortedSearchResults.data());
+            for (int i = 0; i < length; i++) {
+                binarySearchResults[dataBunch->sortedIndexes[i]] = sortedSearchResults[i];
+                binaryFound += sortedSearchResults[i] == -1 ? 0 : 1;
             }
             algoLog.trace(QString("[%1] Binary search %2 results, found %3 in %4 ms.").arg(taskNo).arg(length).arg(binaryFound).arg((GTimer::currentTimeMicros() - t0) / double(1000), 0, 'f', 3));
 
             t0 = GTimer::currentTimeMicros();
             int skipped = 0;
+            alignedQueries.clear();
+            finishedQueries.clear();
             for (int i = 0; i < length; i++) {
                 ShortReadData srData(dataBunch, i);
                 GA_CHECK_CONTINUE(srData.valid);
@@ -254,12 +263,17 @@ void ShortReadAlignerCPU::run() {
                 if (!alignContext->bestMode) {
                     if ((i == length - 1) || (srData.nextRn != srData.rn)) {
                         if (srData.shortRead->haveResult()) {
-                            writeTask->addResult(srData.shortRead);
+                            alignedQueries << srData.shortRead;
                         }
-                        srData.shortRead->onPartChanged();
+                        finishedQueries << srData.shortRead;
                     }
                 }
             }
+            // the results are passed to the writer once per data bunch to avoid locking it for every read
+            writeTask->addResults(alignedQueries);
+            foreach (SearchQuery *query, finishedQueries) {
+                query->onPartChanged();
+            }
             algoLog.trace(QString("[%1] Aligning took %2 ms").arg(taskNo).arg((GTimer::currentTimeMicros() - t0) / double(1000), 0, 'f', 3));
             algoLog.trace(QString("[%1] Skipped: %2, tried to align %3").arg(taskNo).arg(skipped).arg(length - skipped));
             float msec = (GTimer::currentTimeMicros() - fullStart);
@@ -30,6 +30,7 @@
 #include <U2Core/U2DbiRegistry.h>
 #include <U2Core/U2AlphabetUtils.h>
 #include <U2Core/U2ObjectDbi.h>
+#include <U2Core/U2SafePoints.h>
 #include <U2Core/U2OpStatusUtils.h>
 
 #include <U2Lang/BaseSlots.h>
@@ -59,7 +60,9 @@ int GenomeAlignerUrlReader::getProgress() {
 }
 
 SearchQuery *GenomeAlignerUrlReader::read() {
-    return new SearchQuery(reader.getNextSequenceObject());
+    const FastqRecord *record = reader.getNextRecord();
+    CHECK(NULL != record, NULL);
+    return new SearchQuery(*record);
 }
 
 /************************************************************************/
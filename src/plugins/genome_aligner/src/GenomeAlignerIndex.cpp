@@ -19,11 +19,17 @@
  * MA 02110-1301, USA.
  */
 
+#include <U2Core/AppContext.h>
+#include <U2Core/AppResources.h>
+#include <U2Core/AppSettings.h>
 #include <U2Core/Timer.h>
 #include <U2Core/Counter.h>
+#include <U2Algorithm/BinaryFind.h>
 #include <U2Algorithm/BinaryFindOpenCL.h>
 #include <U2Algorithm/SyncSort.h>
 #include <QFile>
+#include <QRunnable>
+#include <QThreadPool>
 #include <QtEndian>
 #include "GenomeAlignerFindTask.h"
 #include "GenomeAlignerTask.h"
@@ -217,13 +223,14 @@ bool GenomeAlignerIndex::loadPart(int part) {
         SAType arrLen = 0;
         sArray = indexPart.sArray;
         bitMask = indexPart.bitMask;
-        buildPart(indexPart.seqStarts[part], indexPart.seqLengths[part], arrLen);
+        const int threadCount = AppContext::getAppSettings()->getAppResourcePool()->getIdealThreadCount();
+        buildPart(indexPart.seqStarts[part], indexPart.seqLengths[part], arrLen, threadCount);
         indexPart.saLengths[part] = arrLen;
         indexPart.currentPart = part;
 
         qint64 t0=GTimer::currentTimeMicros();
         SyncSort<BMType, SAType> s(bitMask, sArray, 0, arrLen);
-        s.sort();
+        s.sort(threadCount);
         qint64 t1=GTimer::currentTimeMicros();
         algoLog.trace(QString("loadPart::build sort time %1 ms").arg((t1 - t0) / double(1000), 0, 'f', 3));
 
@@ -248,27 +255,11 @@ bool GenomeAlignerIndex::loadPart(int part) {
 }
 
 BinarySearchResult GenomeAlignerIndex::bitMaskBinarySearch(BMType bitValue, BMType bitFilter) {
-    int low = 0;
-    int high = indexPart.getLoadedPartSize() - 1;
-    BMType *a = indexPart.bitMask;
-    qint64 rc = 0;
-    while (low <= high) {
-        int mid = (low + high) / 2;
-        rc = (a[mid]&bitFilter) - (bitValue&bitFilter);
-        if (rc < 0) {
-            low = mid + 1;
-        } else if (rc > 0) {
-            high = mid - 1;
-        } else {
-            for(high=mid-1;high >= 0 && (a[high]&bitFilter)==(bitValue&bitFilter); high--){};
-            high++;
-            break;
-        }
-    }
-    if (0==rc) {
-        return high;
-    }
-    return -1;
+    return BinaryFind::find(indexPart.bitMask, indexPart.getLoadedPartSize(), bitValue, bitFilter);
+}
+
+void GenomeAlignerIndex::bitMaskBinarySearch(const BMType *bitValues, const BMType *bitFilters, int size, BinarySearchResult *results) {
+    BinaryFind::find(indexPart.bitMask, indexPart.getLoadedPartSize(), bitValues, bitFilters, size, results);
 }
 
 #ifdef OPENCL_SUPPORT
@@ -418,20 +409,53 @@ void GenomeAlignerIndex::alignShortRead(SearchQuery *qu, BMType bitValue, int st
 }
 
 /*build index*/
-void GenomeAlignerIndex::buildPart(SAType start, SAType length, SAType &arrLen) {
+class BuildBitMaskRunnable : public QRunnable {
+public:
+    BuildBitMaskRunnable(const GenomeAlignerIndex *index, SAType first, SAType count)
+        : index(index), first(first), count(count) {}
+
+    void run() {
+        index->buildBitMask(first, count);
+    }
+
+private:
+    const GenomeAlignerIndex *index;
+    SAType first;
+    SAType count;
+};
+
+void GenomeAlignerIndex::buildPart(SAType start, SAType length, SAType &arrLen, int threadCount) {
     qint64 t0 = GTimer::currentTimeMicros();
     initSArray(start, length, arrLen);
     qint64 t1 = GTimer::currentTimeMicros();
     algoLog.trace(QString("initSArray time %1 ms, len %2").arg((t1 - t0) / double(1000), 0, 'f', 3).arg(length));
 
+    // the chunks are independent: the bit value is recomputed at the beginning of each one
+    const SAType minChunkSize = 1048576;
+    const SAType chunkSize = qMax(minChunkSize, (arrLen + threadCount - 1) / qMax(threadCount, 1));
+    if (threadCount < 2 || arrLen <= chunkSize) {
+        buildBitMask(0, arrLen);
+    } else {
+        QThreadPool threadPool;
+        threadPool.setMaxThreadCount(threadCount);
+        for (SAType first = 0; first < arrLen; first += chunkSize) {
+            threadPool.start(new BuildBitMaskRunnable(this, first, qMin(chunkSize, arrLen - first)));
+        }
+        threadPool.waitForDone();
+    }
+    qint64 t2 = GTimer::currentTimeMicros();
+    algoLog.trace(QString("buildPart bitValue time %1 ms, len %2").arg((t2 - t1) / double(1000), 0, 'f', 3).arg(length));
+}
+
+void GenomeAlignerIndex::buildBitMask(SAType first, SAType count) const {
     const char *seq = indexPart.seq;
-    SAType *arunner = sArray;
-    BMType *mrunner = bitMask;
+    SAType *arunner = sArray + first;
+    BMType *mrunner = bitMask + first;
     BMType bitValue = 0;
     SAType expectedNext = 0;
     quint32 wCharsInMask1 = w - 1;
 
-    for (BMType *end = mrunner + arrLen; mrunner < end; arunner++, mrunner++) {
+    for (BMType *end = mrunner + count; mrunner < end; arunner++, mrunner++) {
         const char* s = seq + *arunner;
         if (*arunner == expectedNext && expectedNext != 0) { //pop first bit, push wCharsInMask1 char to the mask
             bitValue = ((bitValue << bitCharLen) | bitTable[uchar(*(s + wCharsInMask1))]) & bitFilter;
@@ -447,8 +471,6 @@ void GenomeAlignerIndex::buildPart(SAType start, SAType length, SAType &arrLen)
         expectedNext = (s + 1) - seq;
         *mrunner = bitValue;
     }
-    qint64 t2 = GTimer::currentTimeMicros();
-    algoLog.trace(QString("buildPart bitValue time %1 ms, len %2").arg((t2 - t1) / double(1000), 0, 'f', 3).arg(length));
 }
 
 void GenomeAlignerIndex::initSArray(SAType start, SAType length, SAType &arrLen) {
@@ -36,6 +36,7 @@ class AlignContext;
 class SearchQuery;
 
 class GenomeAlignerIndex {
+    friend class BuildBitMaskRunnable;
     friend class GenomeAlignerIndexTask;
     friend class GenomeAlignerSettingsWidget;
     friend class GenomeAlignerFindTask;
@@ -47,6 +48,8 @@ public:
     bool loadPart(int part);
     void alignShortRead(SearchQuery *qu, BMType bitValue, int startPos, BinarySearchResult firstResult, AlignContext *settings, BMType bitFilter, int w);
     BinarySearchResult bitMaskBinarySearch(BMType bitValue, BMType bitFilter);
+    // the same search for a batch of values: the probes of several searches are interleaved and prefetched
+    void bitMaskBinarySearch(const BMType *bitValues, const BMType *bitFilters, int size, BinarySearchResult *results);
 #ifdef OPENCL_SUPPORT
     BinarySearchResult *bitMaskBinarySearchOpenCL(const BMType *bitValues, int size, const int *windowSizes);
 #endif
@@ -92,7 +95,8 @@ private:
     /*build*/
     SAType          *sArray;
     BMType          *bitMask;
-    void buildPart(SAType start, SAType length, SAType &arrLen);
+    void buildPart(SAType start, SAType length, SAType &arrLen, int threadCount);
+    void buildBitMask(SAType first, SAType count) const;
     void initSArray(SAType start, SAType length, SAType &arrLen);
     void sort(BMType *x, int off, int len);
     inline qint64 compare(const BMType *x1, const BMType *x2) const;
@@ -61,6 +61,29 @@ qint64 SearchQuery::memoryHint() const {
     return m*2; // overhead due to many new calls of small regions
 }
 
+SearchQuery::SearchQuery(const FastqRecord &shortRead, SearchQuery *revCompl) {
+    dna = true;
+    wroteResult = false;
+    this->revCompl = revCompl;
+    seqLength = shortRead.seqLength;
+    nameLength = shortRead.nameLength;
+    seq = new char[seqLength+1];
+    name = new char[nameLength+1];
+    memcpy(seq, shortRead.seq, seqLength);
+    seq[seqLength] = '\0';
+    memcpy(name, shortRead.name, nameLength);
+    name[nameLength] = '\0';
+    if (shortRead.qualityLength > 0) {
+        quality = new DNAQuality(QByteArray(shortRead.quality, shortRead.qualityLength));
+    } else {
+        quality = NULL;
+    }
+
+    results.reserve(2);
+    mismatchCounts.reserve(2);
+    overlapResults.reserve(2);
+}
+
 SearchQuery::SearchQuery(const U2AssemblyRead &, SearchQuery *revCompl) {
     dna = false;
     wroteResult = false;
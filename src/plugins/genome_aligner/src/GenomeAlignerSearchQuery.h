@@ -24,6 +24,7 @@
 
 #include <U2Core/DNASequence.h>
 #include <U2Core/U2AssemblyUtils.h>
+#include <U2Formats/FastqRecordReader.h>
 #include "GenomeAlignerIndexPart.h"
 
 #define BinarySearchResult qint64
@@ -43,6 +44,7 @@ class SearchQuery {
 public:
     SearchQuery(const DNASequence *shortRead, SearchQuery *revCompl = NULL);
     SearchQuery(const U2AssemblyRead &shortRead, SearchQuery *revCompl = NULL);
+    SearchQuery(const FastqRecord &shortRead, SearchQuery *revCompl = NULL);
     ~SearchQuery();
 
     QString getName() const;
@@ -19,6 +19,8 @@
 * MA 02110-1301, USA.
 */
 
+#include <U2Core/U2SafePoints.h>
+
 #include "GenomeAlignerWriteTask.h"
 
 namespace U2 {
@@ -43,13 +45,32 @@ void GenomeAlignerWriteTask::addResult(SearchQuery *qu) {
         results.append(data);
     }
 
-    if (!writing && results.size() > 1000) {
+    if (!writing && results.size() > MAX_LIST_SIZE) {
         writing = true;
         waiter.wakeAll();
     }
     listMutex.unlock();
 }
 
+void GenomeAlignerWriteTask::addResults(const QVector<SearchQuery*> &queries) {
+    CHECK(!queries.isEmpty(), );
+    QMutexLocker locker(&listMutex);
+    WriteData data;
+
+    foreach (SearchQuery *qu, queries) {
+        foreach (SAType offset, qu->getResults()) {
+            data.qu = qu;
+            data.offset = offset;
+            results.append(data);
+        }
+    }
+
+    if (!writing && results.size() > MAX_LIST_SIZE) {
+        writing = true;
+        waiter.wakeAll();
+    }
+}
+
 void GenomeAlignerWriteTask::setFinished() {
     end = true;
     waiter.wakeAll();
@@ -45,6 +45,8 @@ public:
     virtual void run();
 
     void addResult(SearchQuery *qu);
+    // adds the results of several queries under a single lock
+    void addResults(const QVector<SearchQuery*> &queries);
     void flush();
     void setFinished();
     quint64 getWrittenReadsCount() const {return readsWritten;}
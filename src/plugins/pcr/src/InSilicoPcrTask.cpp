@@ -19,6 +19,8 @@
  * MA 02110-1301, USA.
  */
 
+#include <U2Algorithm/PrimerSeedIndex.h>
+
 #include <U2Core/AppContext.h>
 #include <U2Core/Counter.h>
 #include <U2Core/DNAAlphabet.h>
@@ -48,9 +50,9 @@ InSilicoPcrProduct::InSilicoPcrProduct()
 
 }
 
-InSilicoPcrTask::InSilicoPcrTask(const InSilicoPcrTaskSettings &settings)
+InSilicoPcrTask::InSilicoPcrTask(const InSilicoPcrTaskSettings &settings, const QSharedPointer<PrimerSeedIndex> &index)
 : Task(tr("In Silico PCR"), TaskFlags(TaskFlag_ReportingIsSupported) | TaskFlag_ReportingIsEnabled | TaskFlags_FOSE_COSC),
-settings(settings), forwardSearch(NULL), reverseSearch(NULL), minProductSize(0)
+settings(settings), forwardSearch(NULL), reverseSearch(NULL), index(index), minProductSize(0)
 {
     GCOUNTER(cvar, tvar, "InSilicoPcrTask");
     minProductSize = qMax(settings.forwardPrimer.length(), settings.reversePrimer.length());
@@ -89,7 +91,42 @@ FindAlgorithmTaskSettings InSilicoPcrTask::getFindPatternSettings(U2Strand::Dire
     return result;
 }
 
+QSharedPointer<PrimerSeedIndex> InSilicoPcrTask::createSeedIndex(const InSilicoPcrTaskSettings &settings, const QList< QPair<QByteArray, QByteArray> > &primerPairs) {
+    QSharedPointer<PrimerSeedIndex> result;
+    CHECK(primerPairs.size() > 1 && settings.sequence.length() <= PrimerSeedIndex::MAX_SEQUENCE_LENGTH, result);
+
+    int seedLength = 0;
+    int maxPrimerLength = 0;
+    typedef QPair<QByteArray, QByteArray> PrimerPair;
+    foreach (const PrimerPair &pair, primerPairs) {
+        int forwardSeedLength = PrimerSeedIndex::getSeedLength(pair.first.length(), getMaxError(pair.first, settings.forwardMismatches));
+        int reverseSeedLength = PrimerSeedIndex::getSeedLength(pair.second.length(), getMaxError(pair.second, settings.reverseMismatches));
+        CHECK(forwardSeedLength > 0 && reverseSeedLength > 0, result);
+        int pairSeedLength = qMin(forwardSeedLength, reverseSeedLength);
+        seedLength = (0 == seedLength) ? pairSeedLength : qMin(seedLength, pairSeedLength);
+        maxPrimerLength = qMax(maxPrimerLength, qMax(pair.first.length(), pair.second.length()));
+    }
+    result = QSharedPointer<PrimerSeedIndex>(new PrimerSeedIndex(settings.sequence, settings.isCircular, maxPrimerLength, seedLength));
+    return result;
+}
+
+QList<FindAlgorithmResult> InSilicoPcrTask::findWithIndex(U2Strand::Direction direction) {
+    QList<FindAlgorithmResult> result;
+    FindAlgorithmTaskSettings findSettings = getFindPatternSettings(direction);
+    CHECK_OP(stateInfo, result);
+    result = index->find(findSettings.pattern, findSettings.maxErr, findSettings.complementTT, stateInfo);
+    CHECK_OP(stateInfo, result);
+
+    // the same limit as FindAlgorithmTask has: the search is canceled if the primer has too many binding sites
+    if (findSettings.maxResult2Find != FindAlgorithmSettings::MAX_RESULT_TO_FIND_UNLIMITED && result.size() > findSettings.maxResult2Find) {
+        stateInfo.cancelFlag = true;
+        result.clear();
+    }
+    return result;
+}
+
 void InSilicoPcrTask::prepare() {
+    CHECK(index.isNull(), );
     FindAlgorithmTaskSettings forwardSettings = getFindPatternSettings(U2Strand::Direct);
     CHECK_OP(stateInfo, );
     FindAlgorithmTaskSettings reverseSettings = getFindPatternSettings(U2Strand::Complementary);
@@ -101,8 +138,19 @@ void InSilicoPcrTask::prepare() {
 }
 
 void InSilicoPcrTask::run() {
-    QList<FindAlgorithmResult> forwardResults = forwardSearch->popResults();
-    QList<FindAlgorithmResult> reverseResults = reverseSearch->popResults();
+    QList<FindAlgorithmResult> forwardResults;
+    QList<FindAlgorithmResult> reverseResults;
+    if (!index.isNull()) {
+        index->prepare(stateInfo);
+        CHECK_OP(stateInfo, );
+        forwardResults = findWithIndex(U2Strand::Direct);
+        CHECK_OP(stateInfo, );
+        reverseResults = findWithIndex(U2Strand::Complementary);
+        CHECK_OP(stateInfo, );
+    } else {
+        forwardResults = forwardSearch->popResults();
+        reverseResults = reverseSearch->popResults();
+    }
     algoLog.details(tr("Forward primers found: %1").arg(forwardResults.size()));
     algoLog.details(tr("Reverse primers found: %1").arg(reverseResults.size()));
 
@@ -27,6 +27,8 @@
 #include <U2Core/GObjectReference.h>
 #include <U2Core/Task.h>
 
+#include <QSharedPointer>
+
 namespace U2 {
 
 class InSilicoPcrTaskSettings {
@@ -66,10 +68,13 @@ public:
     int reversePrimerMatchLength;
 };
 
+class PrimerSeedIndex;
+
 class InSilicoPcrTask : public Task {
     Q_OBJECT
 public:
-    InSilicoPcrTask(const InSilicoPcrTaskSettings &settings);
+    /* If the index is set, the primers are searched with it instead of scanning the whole sequence */
+    InSilicoPcrTask(const InSilicoPcrTaskSettings &settings, const QSharedPointer<PrimerSeedIndex> &index = QSharedPointer<PrimerSeedIndex>());
 
     // Task
     void prepare();
@@ -79,6 +84,10 @@ public:
     const QList<InSilicoPcrProduct> & getResults() const;
     const InSilicoPcrTaskSettings & getSettings() const;
 
+    /* Creates the index that is shared by the tasks searching several primer pairs in the same sequence.
+       Returns NULL if the sequence or the primers are not suitable for indexing */
+    static QSharedPointer<PrimerSeedIndex> createSeedIndex(const InSilicoPcrTaskSettings &settings, const QList< QPair<QByteArray, QByteArray> > &primerPairs);
+
 private:
     class PrimerBind {
     public:
@@ -90,6 +99,7 @@ private:
 
     qint64 getProductSize(const U2Region &left, const U2Region &right) const;
     FindAlgorithmTaskSettings getFindPatternSettings(U2Strand::Direction direction);
+    QList<FindAlgorithmResult> findWithIndex(U2Strand::Direction direction);
     bool isCorrectProductSize(qint64 productSize, qint64 minPrimerSize) const;
     bool filter(const PrimerBind &leftBind, const PrimerBind &rightBind, qint64 productSize) const;
     bool checkPerfectMatch(const U2Region &region, QByteArray primer, U2Strand::Direction direction) const;
@@ -100,6 +110,7 @@ private:
     InSilicoPcrTaskSettings settings;
     FindAlgorithmTask *forwardSearch;
     FindAlgorithmTask *reverseSearch;
+    QSharedPointer<PrimerSeedIndex> index;
     QList<InSilicoPcrProduct> results;
     int minProductSize;
 };
@@ -348,11 +348,18 @@ Task * InSilicoPcrWorker::createTask(const Message &message, U2OpStatus &os) {
     pcrSettings.perfectMatch = getValue<int>(PERFECT_ATTR_ID);
     pcrSettings.sequenceName = seq->getSequenceName();
 
+    // all primer pairs are searched with the same sequence index instead of scanning the sequence for each primer
+    QList< QPair<QByteArray, QByteArray> > primerPairs;
+    for (int i=0; i<primers.size(); i++) {
+        primerPairs << qMakePair(primers[i].first.sequence.toLocal8Bit(), primers[i].second.sequence.toLocal8Bit());
+    }
+    QSharedPointer<PrimerSeedIndex> index = InSilicoPcrTask::createSeedIndex(pcrSettings, primerPairs);
+
     QList<Task*> tasks;
     for (int i=0; i<primers.size(); i++) {
-        pcrSettings.forwardPrimer = primers[i].first.sequence.toLocal8Bit();
-        pcrSettings.reversePrimer = primers[i].second.sequence.toLocal8Bit();
-        Task *pcrTask = new InSilicoPcrWorkflowTask(pcrSettings, productSettings);
+        pcrSettings.forwardPrimer = primerPairs[i].first;
+        pcrSettings.reversePrimer = primerPairs[i].second;
+        Task *pcrTask = new InSilicoPcrWorkflowTask(pcrSettings, productSettings, index);
         pcrTask->setProperty(PAIR_NUMBER_PROP_ID, i);
         tasks << pcrTask;
     }
@@ -23,10 +23,11 @@
 
 namespace U2 {
 
-InSilicoPcrWorkflowTask::InSilicoPcrWorkflowTask(const InSilicoPcrTaskSettings &pcrSettings, const ExtractProductSettings &productSettings)
+InSilicoPcrWorkflowTask::InSilicoPcrWorkflowTask(const InSilicoPcrTaskSettings &pcrSettings, const ExtractProductSettings &productSettings,
+                                                 const QSharedPointer<PrimerSeedIndex> &index)
 : Task(tr("In silico PCR workflow task"), TaskFlags_NR_FOSE_COSC), productSettings(productSettings)
 {
-    pcrTask = new InSilicoPcrTask(pcrSettings);
+    pcrTask = new InSilicoPcrTask(pcrSettings, index);
     addSubTask(pcrTask);
     pcrTask->setSubtaskProgressWeight(0.7);
 }
@@ -34,7 +34,8 @@ public:
         Document *doc;
         InSilicoPcrProduct product;
     };
-    InSilicoPcrWorkflowTask(const InSilicoPcrTaskSettings &pcrSettings, const ExtractProductSettings &productSettings);
+    InSilicoPcrWorkflowTask(const InSilicoPcrTaskSettings &pcrSettings, const ExtractProductSettings &productSettings,
+                            const QSharedPointer<PrimerSeedIndex> &index = QSharedPointer<PrimerSeedIndex>());
 
     QList<Result> takeResult();
     const InSilicoPcrTaskSettings & getPcrSettings() const;
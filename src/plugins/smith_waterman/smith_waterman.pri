@@ -18,6 +18,8 @@ use_sse2() {
         QMAKE_CFLAGS_RELEASE += -msse2
     }
     DEFINES += SW2_BUILD_WITH_SSE2
+    # AVX2 code is compiled with function target attributes and selected at runtime
+    DEFINES += SW2_BUILD_WITH_AVX2
 }
 
 #adding CUDA specific parameters
@@ -117,6 +117,13 @@ SWAlgorithmPlugin::SWAlgorithmPlugin()
                                                                  "SSE2");
 #endif
 
+#ifdef SW2_BUILD_WITH_AVX2
+    if (AppResourcePool::isAVX2Enabled()) {
+        coreLog.trace("Registering AVX2 SW implementation");
+        swar->registerFactory(new SWTaskFactory(SW_avx2), QString("AVX2"));
+    }
+#endif
+
     this->connect(AppContext::getPluginSupport(), SIGNAL(si_allStartUpPluginsLoaded()), SLOT(regDependedIMPLFromOtherPlugins()));
 }
 
@@ -27,6 +27,7 @@
 
 #include "SmithWatermanAlgorithmCUDA.h"
 #include "SmithWatermanAlgorithmSSE2.h"
+#include "SmithWatermanAlgorithmAVX2.h"
 #include "SmithWatermanAlgorithmOPENCL.h"
 #include "sw_cuda_cpp.h"
 
@@ -68,7 +69,10 @@ SWAlgorithmTask::SWAlgorithmTask(const SmithWatermanSettings& s,
     GCOUNTER( cvar, tvar, "SWAlgorithmTask" );
 
     algType = _algType;
-    if (algType == SW_sse2) {
+    if (algType == SW_avx2 && !AppResourcePool::isAVX2Enabled()) {
+        algType = SW_sse2;
+    }
+    if (algType == SW_sse2 || algType == SW_avx2) {
         if (sWatermanConfig.ptrn.length() < 8) {
             algType = SW_classic;
         }
@@ -121,6 +125,7 @@ void SWAlgorithmTask::setupTask(int maxScore) {
 
     switch(algType) {
         case SW_sse2:
+        case SW_avx2:
             computationMatrixSquare = 1619582300.0; //this constant is considered to be optimal computation matrix square (square = localSequence.length * pattern.length) for given algorithm realization and the least minimum score value
             c.nThreads = idealThreadCount * 2.5;
             break;
@@ -183,7 +188,9 @@ void SWAlgorithmTask::setupTask(int maxScore) {
                 true));
             break;
         case SW_sse2:
+        case SW_avx2:
 #ifdef SW2_BUILD_WITH_SSE2
+            // the AVX2 realization recomputes candidate regions with the SSE2 one, so its peak memory is the same
             addTaskResource(TaskResourceUsage(RESOURCE_MEMORY,
                 SmithWatermanAlgorithmSSE2::estimateNeededRamAmount(sWatermanConfig.ptrn,
                     sWatermanConfig.sqnc.left(c.chunkSize * c.nThreads), sWatermanConfig.gapModel.scoreGapOpen,
@@ -266,7 +273,14 @@ void SWAlgorithmTask::onRegion(SequenceWalkerSubtask* t, TaskStateInfo& ti) {
     QByteArray localSeq(t->getRegionSequence(), regionLen);
 
     SmithWatermanAlgorithm * sw = NULL;
-    if (algType == SW_sse2) {
+    if (algType == SW_avx2) {
+#ifdef SW2_BUILD_WITH_AVX2
+        sw = new SmithWatermanAlgorithmAVX2;
+#else
+        coreLog.error( "AVX2 was not enabled in this build" );
+        return;
+#endif //SW2_BUILD_WITH_AVX2
+    } else if (algType == SW_sse2) {
 #ifdef SW2_BUILD_WITH_SSE2
         sw = new SmithWatermanAlgorithmSSE2;
 #else
@@ -37,7 +37,7 @@
 
 namespace U2 {
 
-enum SW_AlgType {SW_classic, SW_sse2, SW_cuda, SW_opencl};
+enum SW_AlgType {SW_classic, SW_sse2, SW_cuda, SW_opencl, SW_avx2};
 
 class CudaGpuModel;
 class OpenCLGpuModel;
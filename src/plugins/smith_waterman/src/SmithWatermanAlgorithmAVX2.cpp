@@ -0,0 +1,255 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifdef SW2_BUILD_WITH_AVX2
+
+#include "SmithWatermanAlgorithmAVX2.h"
+
+#include <immintrin.h>
+
+#include <U2Core/DNAAlphabet.h>
+
+// the plugin is built for SSE2, AVX2 instructions are enabled only for the functions of the 8-bit pass
+#if defined(__GNUC__) || defined(__clang__)
+#define SW2_AVX2_TARGET __attribute__((target("avx2")))
+#else
+#define SW2_AVX2_TARGET
+#endif
+
+namespace U2 {
+
+namespace {
+
+// shifts the whole vector left by one byte, the first byte becomes zero
+SW2_AVX2_TARGET inline __m256i shiftLeftByOneByte(__m256i v) {
+    return _mm256_alignr_epi8(v, _mm256_permute2x128_si256(v, v, 0x08), 15);
+}
+
+// returns true if at least one byte of @a is greater than the corresponding byte of @b
+SW2_AVX2_TARGET inline bool isAnyGreater(__m256i a, __m256i b) {
+    return _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_subs_epu8(a, b), _mm256_setzero_si256())) != -1;
+}
+
+// returns true if at least one byte of @a is greater or equal to the corresponding byte of @b
+SW2_AVX2_TARGET inline bool isAnyGreaterOrEqual(__m256i a, __m256i b) {
+    return _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_max_epu8(a, b), a)) != 0;
+}
+
+}
+
+void SmithWatermanAlgorithmAVX2::launch(const SMatrix& _substitutionMatrix, const QByteArray & _patternSeq,
+    const QByteArray & _searchSeq, int _gapOpen, int _gapExtension, int _minScore, SmithWatermanSettings::SWResultView _resultView) {
+    setValues(_substitutionMatrix, _patternSeq, _searchSeq, _gapOpen, _gapExtension, _minScore, _resultView);
+    if (!isValidParams() || !calculateMatrixLength()) {
+        return;
+    }
+
+    QList<CandidateRegion> regions;
+    if (!findCandidateRegions(regions)) {
+        SmithWatermanAlgorithmSSE2::launch(_substitutionMatrix, _patternSeq, _searchSeq, _gapOpen, _gapExtension, _minScore, _resultView);
+        return;
+    }
+    if (regions.isEmpty()) {
+        return;
+    }
+
+    if (SmithWatermanSettings::MULTIPLE_ALIGNMENT == resultView) {
+        // alignment results are collected on the whole sequence, the 8-bit pass only estimates the max score
+        CandidateRegion wholeSequence(U2Region(0, searchSeq.length()));
+        foreach (const CandidateRegion &candidate, regions) {
+            wholeSequence.saturated = wholeSequence.saturated || candidate.saturated;
+            wholeSequence.maxScore = qMax(wholeSequence.maxScore, candidate.maxScore);
+        }
+        calculateRegionResults(wholeSequence);
+        return;
+    }
+
+    const QByteArray wholeSearchSeq = searchSeq;
+    foreach (const CandidateRegion &candidate, regions) {
+        searchSeq = wholeSearchSeq.mid(candidate.region.startPos, candidate.region.length);
+        calculateMatrixLength();
+
+        const int firstRegionResult = pairAlignmentStrings.size();
+        calculateRegionResults(candidate);
+        for (int i = firstRegionResult; i < pairAlignmentStrings.size(); i++) {
+            pairAlignmentStrings[i].refSubseqInterval.startPos += candidate.region.startPos;
+        }
+    }
+    searchSeq = wholeSearchSeq;
+    calculateMatrixLength();
+}
+
+void SmithWatermanAlgorithmAVX2::calculateRegionResults(const CandidateRegion &candidate) {
+    int maxScore = candidate.maxScore;
+    if (candidate.saturated) {
+        maxScore = calculateMatrixSSE2(patternSeq.length(), (unsigned char *)searchSeq.data(),
+            searchSeq.length(), (-1)*(gapOpen + gapExtension), (-1)*(gapExtension));
+    }
+    if (minScore <= maxScore) {
+        calculateResults(maxScore);
+    }
+}
+
+SW2_AVX2_TARGET bool SmithWatermanAlgorithmAVX2::findCandidateRegions(QList<CandidateRegion> &regions) {
+    const int minSubstScore = static_cast<int>(substitutionMatrix.getMinScore());
+    const int maxSubstScore = static_cast<int>(substitutionMatrix.getMaxScore());
+    const int bias = qMax(0, -minSubstScore);
+    const int saturationScore = 0xFF - bias;
+    if (maxSubstScore + bias > 0xFF || saturationScore <= 0 || minScore <= 0) {
+        return false;
+    }
+    const int threshold = qMin(minScore, saturationScore);
+
+    // query profile: a vector of 32 scores for every segment and every alphabet char,
+    // the last profile is used for unknown chars and contains the max score
+    const QByteArray alphaChars = substitutionMatrix.getAlphabet()->getAlphabetChars();
+    const int queryLength = patternSeq.length();
+    const int segLength = (queryLength + nElementsInVec - 1) / nElementsInVec;
+    const int unknownCharProfile = alphaChars.size();
+    int charToProfile[256];
+    for (int c = 0; c < 256; c++) {
+        charToProfile[c] = unknownCharProfile;
+    }
+
+    __m256i *profiles = (__m256i*)_mm_malloc((unknownCharProfile + 1) * segLength * sizeof(__m256i), 32);
+    quint8 *profileData = (quint8*)profiles;
+    for (int p = 0; p <= unknownCharProfile; p++) {
+        for (int j = 0; j < segLength; j++) {
+            for (int lane = 0, k = j; lane < nElementsInVec; lane++, k += segLength) {
+                int score = 0; // positions out of the query get the lowest score
+                if (k < queryLength) {
+                    score = bias + (p == unknownCharProfile ? maxSubstScore : static_cast<int>(substitutionMatrix.getScore(alphaChars.at(p), patternSeq.at(k))));
+                }
+                *profileData++ = static_cast<quint8>(score);
+            }
+        }
+        if (p != unknownCharProfile) {
+            charToProfile[uchar(alphaChars.at(p))] = p;
+        }
+    }
+
+    __m256i *pvHLoad = (__m256i*)_mm_malloc(segLength * sizeof(__m256i), 32);
+    __m256i *pvHStore = (__m256i*)_mm_malloc(segLength * sizeof(__m256i), 32);
+    __m256i *pvE = (__m256i*)_mm_malloc(segLength * sizeof(__m256i), 32);
+    const __m256i vZero = _mm256_setzero_si256();
+    for (int j = 0; j < segLength; j++) {
+        _mm256_store_si256(pvHStore + j, vZero);
+        _mm256_store_si256(pvE + j, vZero);
+    }
+
+    const __m256i vBias = _mm256_set1_epi8(static_cast<char>(bias));
+    const __m256i vGapOpen = _mm256_set1_epi8(static_cast<char>(qMin(-gapOpen, 0xFF)));
+    const __m256i vGapExtend = _mm256_set1_epi8(static_cast<char>(qMin(-gapExtension, 0xFF)));
+    const __m256i vThreshold = _mm256_set1_epi8(static_cast<char>(threshold));
+
+    const unsigned char *dbSeq = (const unsigned char *)searchSeq.constData();
+    const int dbLength = searchSeq.length();
+    quint8 columnScores[nElementsInVec];
+    for (int i = 0; i < dbLength; i++) {
+        const __m256i *pvScore = profiles + charToProfile[dbSeq[i]] * segLength;
+
+        __m256i vF = vZero;
+        __m256i vColumnMax = vZero;
+        __m256i vH = shiftLeftByOneByte(_mm256_load_si256(pvHStore + segLength - 1));
+        qSwap(pvHLoad, pvHStore);
+
+        for (int j = 0; j < segLength; j++) {
+            vH = _mm256_subs_epu8(_mm256_adds_epu8(vH, _mm256_load_si256(pvScore + j)), vBias);
+
+            __m256i vE = _mm256_load_si256(pvE + j);
+            vH = _mm256_max_epu8(vH, vE);
+            vH = _mm256_max_epu8(vH, vF);
+            vColumnMax = _mm256_max_epu8(vColumnMax, vH);
+            _mm256_store_si256(pvHStore + j, vH);
+
+            vH = _mm256_subs_epu8(vH, vGapOpen);
+            vE = _mm256_max_epu8(_mm256_subs_epu8(vE, vGapExtend), vH);
+            _mm256_store_si256(pvE + j, vE);
+            vF = _mm256_max_epu8(_mm256_subs_epu8(vF, vGapExtend), vH);
+
+            vH = _mm256_load_si256(pvHLoad + j);
+        }
+
+        // lazy F loop: propagate vertical gaps across the segments until they can't improve H
+        int j = 0;
+        vF = shiftLeftByOneByte(vF);
+        vH = _mm256_load_si256(pvHStore);
+        while (isAnyGreater(vF, _mm256_subs_epu8(vH, vGapOpen))) {
+            vH = _mm256_max_epu8(vH, vF);
+            vColumnMax = _mm256_max_epu8(vColumnMax, vH);
+            _mm256_store_si256(pvHStore + j, vH);
+
+            vH = _mm256_subs_epu8(vH, vGapOpen);
+            _mm256_store_si256(pvE + j, _mm256_max_epu8(_mm256_load_si256(pvE + j), vH));
+            vF = _mm256_subs_epu8(vF, vGapExtend);
+
+            if (++j >= segLength) {
+                j = 0;
+                vF = shiftLeftByOneByte(vF);
+            }
+            vH = _mm256_load_si256(pvHStore + j);
+        }
+
+        if (!isAnyGreaterOrEqual(vColumnMax, vThreshold)) {
+            continue;
+        }
+
+        _mm256_storeu_si256((__m256i*)columnScores, vColumnMax);
+        int columnMax = 0;
+        for (int lane = 0; lane < nElementsInVec; lane++) {
+            columnMax = qMax(columnMax, int(columnScores[lane]));
+        }
+
+        // any alignment with a score not less than the min score ending in the column fits into matrixLength columns
+        qint64 regionStart = qMax(0, i + 1 - matrixLength);
+        qint64 regionEnd = i + 1;
+        const bool saturated = columnMax >= saturationScore;
+        if (saturated) {
+            // the scores derived from the saturated cells are underestimated: restart the pass from the next column,
+            // the columns are exact again when the restart point is farther than matrixLength
+            regionEnd = i + matrixLength;
+            for (int k = 0; k < segLength; k++) {
+                _mm256_store_si256(pvHStore + k, vZero);
+                _mm256_store_si256(pvE + k, vZero);
+            }
+        }
+        regionEnd = qMin(qint64(dbLength), qMax(regionEnd, regionStart + queryLength));
+
+        if (!regions.isEmpty() && regionStart <= regions.last().region.endPos()) {
+            CandidateRegion &last = regions.last();
+            last.region = U2Region(last.region.startPos, qMax(last.region.endPos(), regionEnd) - last.region.startPos);
+            last.saturated = last.saturated || saturated;
+            last.maxScore = qMax(last.maxScore, columnMax);
+        } else {
+            regions << CandidateRegion(U2Region(regionStart, regionEnd - regionStart), saturated, columnMax);
+        }
+    }
+
+    _mm_free(pvHLoad);
+    _mm_free(pvHStore);
+    _mm_free(pvE);
+    _mm_free(profiles);
+    return true;
+}
+
+} // namespace
+
+#endif //SW2_BUILD_WITH_AVX2
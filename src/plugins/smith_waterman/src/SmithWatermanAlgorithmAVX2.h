@@ -0,0 +1,66 @@
+/**
+ * UGENE - Integrated Bioinformatics Tools.
+ * Copyright (C) 2008-2017 UniPro <ugene@unipro.ru>
+ * http://ugene.net
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation; either version 2
+ * of the License, or (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ */
+
+#ifdef SW2_BUILD_WITH_AVX2
+
+#ifndef _SMITHWATERMANALGORITHM_AVX2_H
+#define _SMITHWATERMANALGORITHM_AVX2_H
+
+#include "SmithWatermanAlgorithmSSE2.h"
+
+#include <U2Core/U2Region.h>
+
+namespace U2 {
+
+/**
+ * Runs a 32-lane 8-bit striped (Farrar) pass over the whole search sequence first.
+ * Only the regions where a column score reaches the minimum score (or saturates 8 bits)
+ * are recomputed with the 16/32-bit SSE2 passes that collect the results.
+ * Must be used only if AppResourcePool::isAVX2Enabled() returns true.
+ */
+class SmithWatermanAlgorithmAVX2 : public SmithWatermanAlgorithmSSE2 {
+public:
+    virtual void launch(const SMatrix& substitutionMatrix, const QByteArray & _patternSeq,
+        const QByteArray & _searchSeq, int _gapOpen, int _gapExtension, int _minScore,
+        SmithWatermanSettings::SWResultView resultView);
+
+private:
+    struct CandidateRegion {
+        CandidateRegion(const U2Region &region = U2Region(), bool saturated = false, int maxScore = 0)
+            : region(region), saturated(saturated), maxScore(maxScore) {}
+
+        U2Region region;
+        // true if 8-bit scores overflowed in the region, the max score is unknown then
+        bool saturated;
+        int maxScore;
+    };
+
+    // returns false if the 8-bit pass can't be used for the current parameters
+    bool findCandidateRegions(QList<CandidateRegion> &regions);
+    void calculateRegionResults(const CandidateRegion &candidate);
+
+    static const int nElementsInVec = 32;
+};
+
+} // namespace
+
+#endif
+#endif //SW2_BUILD_WITH_AVX2
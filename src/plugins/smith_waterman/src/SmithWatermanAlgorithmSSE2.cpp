@@ -101,29 +101,33 @@ void SmithWatermanAlgorithmSSE2::launch(const SMatrix& _substitutionMatrix, cons
             searchSeq.length(), (-1)*(gapOpen + gapExtension), (-1)*(gapExtension));
 
         if (minScore <= maxScore) {
-            if (maxScore >= 0x8000 || matrixLength >= 0x10000) {
-                switch(resultView) {
-                case SmithWatermanSettings::MULTIPLE_ALIGNMENT:
-                    calculateMatrixForMultipleAlignmentResultWithInt();
-                    break;
-                case SmithWatermanSettings::ANNOTATIONS:
-                    calculateMatrixForAnnotationsResultWithInt();
-                    break;
-                default:
-                    assert(false);
-                }
-            } else {
-                switch(resultView) {
-                case SmithWatermanSettings::MULTIPLE_ALIGNMENT:
-                    calculateMatrixForMultipleAlignmentResultWithShort();
-                    break;
-                case SmithWatermanSettings::ANNOTATIONS:
-                    calculateMatrixForAnnotationsResultWithShort();
-                    break;
-                default:
-                    assert(false);
-                }
-            }
+            calculateResults(maxScore);
+        }
+    }
+}
+
+void SmithWatermanAlgorithmSSE2::calculateResults(int maxScore) {
+    if (maxScore >= 0x8000 || matrixLength >= 0x10000) {
+        switch(resultView) {
+        case SmithWatermanSettings::MULTIPLE_ALIGNMENT:
+            calculateMatrixForMultipleAlignmentResultWithInt();
+            break;
+        case SmithWatermanSettings::ANNOTATIONS:
+            calculateMatrixForAnnotationsResultWithInt();
+            break;
+        default:
+            assert(false);
+        }
+    } else {
+        switch(resultView) {
+        case SmithWatermanSettings::MULTIPLE_ALIGNMENT:
+            calculateMatrixForMultipleAlignmentResultWithShort();
+            break;
+        case SmithWatermanSettings::ANNOTATIONS:
+            calculateMatrixForAnnotationsResultWithShort();
+            break;
+        default:
+            assert(false);
         }
     }
 }
@@ -43,6 +43,12 @@ public:
         const quint32 minScore, const quint32 maxScore,
         const SmithWatermanSettings::SWResultView resultView);
 
+protected:
+    // runs the pass that collects results, the score precision is selected by @maxScore
+    void calculateResults(int maxScore);
+    int calculateMatrixSSE2(unsigned queryLength, unsigned char *dbSeq, unsigned dbLength,
+        unsigned short gapOpenOrig, unsigned short gapExtend);
+
 private:
     static const int nElementsInVec = 8;
     void printVector(__m128i &toprint, int add);
@@ -50,8 +56,6 @@ private:
     void calculateMatrixForAnnotationsResultWithShort();
     void calculateMatrixForMultipleAlignmentResultWithInt();
     void calculateMatrixForAnnotationsResultWithInt();
-    int calculateMatrixSSE2(unsigned queryLength, unsigned char *dbSeq, unsigned dbLength,
-        unsigned short gapOpenOrig, unsigned short gapExtend);
 };
 
 
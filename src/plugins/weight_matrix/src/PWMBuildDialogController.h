@@ -25,6 +25,7 @@
 #include <QDialog>
 
 #include <U2Algorithm/PWMConversionAlgorithm.h>
+#include <U2Algorithm/WeightMatrixAlgorithm.h>
 
 #include <U2Core/DNASequence.h>
 #include <U2Core/MultipleSequenceAlignment.h>
@@ -34,7 +35,6 @@
 
 #include <U2View/AlignmentLogo.h>
 
-#include "WeightMatrixAlgorithm.h"
 #include "WeightMatrixPlugin.h"
 #include "ui_PWMBuildDialog.h"
 
@@ -27,6 +27,7 @@
 #include <QPushButton>
 
 #include <U2Algorithm/PWMConversionAlgorithmRegistry.h>
+#include <U2Algorithm/WeightMatrixAlgorithm.h>
 
 #include <U2Core/AppContext.h>
 #include <U2Core/CreateAnnotationTask.h>
@@ -58,7 +59,6 @@
 #include "PWMSearchDialogController.h"
 #include "SetParametersDialogController.h"
 #include "ViewMatrixDialogController.h"
-#include "WeightMatrixAlgorithm.h"
 #include "WeightMatrixIO.h"
 #include "WeightMatrixSearchTask.h"
 
@@ -27,7 +27,7 @@
 
 #include <U2Core/SaveDocumentTask.h>
 
-#include "WeightMatrixAlgorithm.h"
+#include <U2Algorithm/WeightMatrixAlgorithm.h>
 
 Q_DECLARE_METATYPE(U2::PWMatrix)
 Q_DECLARE_METATYPE(U2::PFMatrix)
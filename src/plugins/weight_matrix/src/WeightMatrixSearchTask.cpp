@@ -20,6 +20,7 @@
  */
 
 #include <U2Core/Counter.h>
+#include <U2Core/U2SafePoints.h>
 
 #include "WeightMatrixSearchTask.h"
 
@@ -28,8 +29,11 @@ namespace U2 {
 WeightMatrixSearchTask::WeightMatrixSearchTask(const QList<QPair<PWMatrix,WeightMatrixSearchCfg> > &m, const QByteArray& seq, int ro)
 : Task(tr("Weight matrix multiple search"), TaskFlags_NR_FOSCOE), models(m), resultsOffset(ro)
 {
+    CHECK(!m.isEmpty(), );
+    // all matrices of a batch usually share the complement translation, so the sequence is encoded only once
+    QSharedPointer<WeightMatrixSequenceCodes> codes(new WeightMatrixSequenceCodes(seq, m.first().second.complTT));
     for (int i = 0, n = m.size(); i < n; i++) {
-        addSubTask(new WeightMatrixSingleSearchTask(m[i].first, seq, m[i].second, ro));
+        addSubTask(new WeightMatrixSingleSearchTask(m[i].first, seq, m[i].second, ro, codes));
     }
 }
 
@@ -52,9 +56,15 @@ QList<WeightMatrixSearchResult> WeightMatrixSearchTask::takeResults() {
 }
 
 //Weight matrix single search
-WeightMatrixSingleSearchTask::WeightMatrixSingleSearchTask(const PWMatrix& m, const QByteArray& _seq, const WeightMatrixSearchCfg& cfg, int ro)
-: Task(tr("Weight matrix search"), TaskFlags_NR_FOSCOE), model(m), cfg(cfg), resultsOffset(ro), seq(_seq)
+WeightMatrixSingleSearchTask::WeightMatrixSingleSearchTask(const PWMatrix& m, const QByteArray& _seq, const WeightMatrixSearchCfg& cfg, int ro,
+                                                           const QSharedPointer<WeightMatrixSequenceCodes>& _codes)
+: Task(tr("Weight matrix search"), TaskFlags_NR_FOSCOE), model(m), scanner(m), cfg(cfg), resultsOffset(ro), seq(_seq)
 {
+    if (!_codes.isNull() && _codes->getComplementTranslation() == cfg.complTT && _codes->getSequence().constData() == seq.constData()) {
+        codes = _codes;
+    } else {
+        codes = QSharedPointer<WeightMatrixSequenceCodes>(new WeightMatrixSequenceCodes(seq, cfg.complTT));
+    }
     GCOUNTER( cvar, tvar, "WeightMatrixSingleSearchTask" );
     SequenceWalkerConfig c;
     c.walkCircular = false;
@@ -78,14 +88,22 @@ void WeightMatrixSingleSearchTask::onRegion(SequenceWalkerSubtask* t, TaskStateI
     }
     U2Region globalRegion = t->getGlobalRegion();
     int seqLen = globalRegion.length;
-    const char* seq = t->getGlobalConfig().seq + globalRegion.startPos;
     int modelSize = model.getLength();
     ti.progress =0;
     int lenPerPercent = seqLen / 100;
     int pLeft = lenPerPercent;
-    DNATranslation* complTT = t->isDNAComplemented() ? t->getGlobalConfig().complTrans : NULL;
+    bool complement = t->isDNAComplemented();
+    codes->prepare();
+    const float minScore = cfg.minPSUM / 100.0f;
     for (int i = 0, n = seqLen - modelSize; i <= n && !ti.cancelFlag; i++, --pLeft) {
-        float psum = WeightMatrixAlgorithm::getScore(seq + i, modelSize, model, complTT);
+        float psum = 0;
+        if (!scanner.getScore(*codes, globalRegion.startPos + i, complement, minScore, psum)) {
+            if (pLeft == 0) {
+                ti.progress++;
+                pLeft = lenPerPercent;
+            }
+            continue;
+        }
         if (psum < -1e-6 || psum > 1 + 1e-6) {
             ti.setError(  tr("Internal error invalid psum: %1").arg(psum) );
             return;
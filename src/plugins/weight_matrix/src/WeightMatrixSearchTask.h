@@ -22,7 +22,7 @@
 #ifndef _U2_WEIGHT_MATRIX_SEARCH_TASK_H_
 #define _U2_WEIGHT_MATRIX_SEARCH_TASK_H_
 
-#include "WeightMatrixAlgorithm.h"
+#include <U2Algorithm/WeightMatrixAlgorithm.h>
 
 #include <U2Core/U2Region.h>
 #include <U2Core/AnnotationData.h>
@@ -30,6 +30,7 @@
 
 #include <QMutex>
 #include <QPair>
+#include <QSharedPointer>
 
 namespace U2 {
 
@@ -109,7 +110,9 @@ private:
 class WeightMatrixSingleSearchTask : public Task, public SequenceWalkerCallback {
     Q_OBJECT
 public:
-    WeightMatrixSingleSearchTask(const PWMatrix& model, const QByteArray& seq, const WeightMatrixSearchCfg& cfg, int resultsOffset);
+    // 'codes' can be shared by the tasks that scan the same sequence
+    WeightMatrixSingleSearchTask(const PWMatrix& model, const QByteArray& seq, const WeightMatrixSearchCfg& cfg, int resultsOffset,
+                                 const QSharedPointer<WeightMatrixSequenceCodes>& codes = QSharedPointer<WeightMatrixSequenceCodes>());
 
     virtual void onRegion(SequenceWalkerSubtask* t, TaskStateInfo& ti);
     QList<WeightMatrixSearchResult> takeResults();
@@ -119,6 +122,8 @@ private:
 
     QMutex                              lock;
     PWMatrix                            model;
+    WeightMatrixScanner                 scanner;
+    QSharedPointer<WeightMatrixSequenceCodes> codes;
     WeightMatrixSearchCfg               cfg;
     QList<WeightMatrixSearchResult>     results;
     int                                 resultsOffset;
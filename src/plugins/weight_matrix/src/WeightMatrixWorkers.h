@@ -24,7 +24,7 @@
 
 #include <U2Lang/LocalDomain.h>
 #include <U2Lang/WorkflowUtils.h>
-#include "WeightMatrixAlgorithm.h"
+#include <U2Algorithm/WeightMatrixAlgorithm.h>
 #include "WeightMatrixSearchTask.h"
 
 namespace U2 {
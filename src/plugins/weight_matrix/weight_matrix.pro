@@ -8,7 +8,6 @@ HEADERS += src/WeightMatrixPlugin.h \
            src/ViewMatrixDialogController.h \
            src/SetParametersDialogController.h \
 		   src/PMatrixFormat.h \
-           src/WeightMatrixAlgorithm.h \
            src/WeightMatrixSearchTask.h \
            src/WeightMatrixIO.h \
            src/WeightMatrixIOWorkers.h \
@@ -29,7 +28,6 @@ SOURCES += src/WeightMatrixPlugin.cpp \
            src/ViewMatrixDialogController.cpp \
            src/SetParametersDialogController.cpp \
 		   src/PMatrixFormat.cpp \
-           src/WeightMatrixAlgorithm.cpp \
            src/WeightMatrixSearchTask.cpp \
            src/WeightMatrixIO.cpp \
            src/WeightMatrixIOWorkers.cpp \
@@ -27,12 +27,14 @@
 #include <U2Core/IOAdapter.h>
 #include <U2Core/IOAdapterUtils.h>
 #include <U2Core/TaskSignalMapper.h>
+#include <U2Core/TextUtils.h>
 #include <U2Core/U2SafePoints.h>
 
 #include <U2Designer/DelegateEditors.h>
 
 #include <U2Formats/BAMUtils.h>
 #include <U2Formats/FastqFormat.h>
+#include <U2Formats/FastqRecordReader.h>
 
 #include <U2Lang/ActorPrototypeRegistry.h>
 #include <U2Lang/BaseActorCategories.h>
@@ -589,6 +591,28 @@ MergeFastqTask::MergeFastqTask(const BaseNGSSetting &settings)
     GCOUNTER(cvar, tvar, "NGS:FASTQMergeFastqmerTask");
 }
 
+// the read name is written without the comment
+static int getReadIdLength(const FastqRecord &record) {
+    int length = 0;
+    while (length < record.nameLength && !TextUtils::WHITES.testBit((uchar)record.name[length])) {
+        length++;
+    }
+    return length;
+}
+
+// FASTA inputs were always accepted by the merger: their reads get the highest quality
+static bool isFastaFile(const QString &url, U2OpStatus &os) {
+    QScopedPointer<IOAdapter> io(IOAdapterUtils::open(url, os));
+    CHECK_OP(os, false);
+    char c = 0;
+    while (1 == io->readBlock(&c, 1)) {
+        if (!TextUtils::WHITES.testBit((uchar)c)) {
+            return '>' == c;
+        }
+    }
+    return false;
+}
+
 void MergeFastqTask::runStep(){
     QScopedPointer<IOAdapter> io  (IOAdapterUtils::open(settings.outDir + settings.outName, stateInfo, IOAdapterMode_Append));
 
@@ -597,18 +621,36 @@ void MergeFastqTask::runStep(){
     qint64 numberOfFiles = 0;
 
     foreach (QString url, urls){
-        FASTQIterator iter(url, stateInfo);
+        const bool fasta = isFastaFile(url, stateInfo);
+        CHECK_OP(stateInfo, );
+        if (fasta) {
+            FASTQIterator iter(url, stateInfo);
+            CHECK_OP(stateInfo, );
+            while (iter.hasNext()) {
+                CHECK(!stateInfo.isCoR(), );
+                DNASequence dna = iter.next();
+                FastqFormat::writeEntry(dna.getName(), dna, io.data(), "Writing error", stateInfo, false);
+                numberOfSeqs++;
+            }
+            numberOfFiles++;
+            continue;
+        }
+
+        QScopedPointer<IOAdapter> inputIo(IOAdapterUtils::open(url, stateInfo));
         if (stateInfo.hasError()) {
             return;
         }
-        while(iter.hasNext()){
+        FastqRecordReader reader(inputIo.data());
+        FastqRecord record;
+        while(reader.readNext(record, stateInfo)){
             if(stateInfo.isCoR()){
                 return;
             }
-            DNASequence dna = iter.next();
-            FastqFormat::writeEntry(dna.getName(), dna, io.data(), "Writing error", stateInfo, false);
+            record.nameLength = getReadIdLength(record);
+            FastqFormat::writeEntry(record, io.data(), "Writing error", stateInfo);
             numberOfSeqs++;
         }
+        CHECK_OP(stateInfo, );
         numberOfFiles++;
 
     }
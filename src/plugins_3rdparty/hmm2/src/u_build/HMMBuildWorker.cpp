@@ -20,6 +20,7 @@
  */
 
 #include <U2Core/AppContext.h>
+#include <U2Core/AppResources.h>
 #include <U2Core/FailTask.h>
 #include <U2Core/Log.h>
 #include <U2Core/MultipleSequenceAlignment.h>
@@ -138,7 +139,7 @@ void HMMBuildWorkerFactory::init() {
     a << new Attribute(fid, BaseTypes::NUM_TYPE(), false, QVariant(0));
     a << new Attribute(lmd, BaseTypes::NUM_TYPE(), false, QVariant(325));
     a << new Attribute(ldd, BaseTypes::NUM_TYPE(), false, QVariant(double(200)));
-    a << new Attribute(td, BaseTypes::NUM_TYPE(), false, QVariant(1));
+    a << new Attribute(td, BaseTypes::NUM_TYPE(), false, QVariant(AppResourcePool::instance()->getIdealThreadCount()));
 
     Descriptor desc(HMMBuildWorkerFactory::ACTOR, HMMBuildWorker::tr("HMM2 Build"), HMMBuildWorker::tr("Builds a HMM profile from a multiple sequence alignment."
         "<p>The HMM profile is a statistical model which captures position-specific information"
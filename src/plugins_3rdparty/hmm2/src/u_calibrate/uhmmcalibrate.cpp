@@ -8,6 +8,7 @@
 #include <stdlib.h>
 
 #include <QMutexLocker>
+#include <U2Core/AppResources.h>
 #include <U2Core/Task.h>
 
 namespace U2 {
@@ -21,7 +22,7 @@ UHMMCalibrateSettings::UHMMCalibrateSettings() {
     lenmean      = 325.;
     lensd        = 200.;
     seed         = (int) time ((time_t *) NULL);
-	nThreads     = 1;
+	nThreads     = AppResourcePool::instance()->getIdealThreadCount();
 }
 
 void UHMMCalibrate::calibrate(plan7_s* hmm, const UHMMCalibrateSettings& s, TaskStateInfo& si) {
@@ -137,6 +138,9 @@ static void main_loop_serial(struct plan7_s *hmm, int seed, int nsample,
 
 //parallel calibrate
 
+// number of random sequences that a thread takes at once: the fewer locks, the less the threads wait for each other
+static const int CALIBRATE_BATCH_SIZE = 16;
+
 void UHMMCalibrate::calibrateParallel(WorkPool_s *wpool, TaskStateInfo& si) {
     
     HMMERTaskLocalData  *tls = getHMMERTaskLocalData();
@@ -144,46 +148,56 @@ void UHMMCalibrate::calibrateParallel(WorkPool_s *wpool, TaskStateInfo& si) {
     struct plan7_s      *hmm = wpool->hmm;
     struct dpmatrix_s   *mx = CreatePlan7Matrix(1, hmm->M, 25, 0);
     
-    int     len;
-    float   sc;
-    char    *seq;
-    unsigned char *dsq;
-
-    while(true) {
-        /* generate a sequence */
-        {   
+    QVector<char*>  seqs;
+    QVector<int>    lens;
+    QVector<float>  scores;
+
+    while (!si.cancelFlag) {
+        /* generate a batch of sequences: the random generator is shared by all threads */
+        seqs.clear();
+        lens.clear();
+        {
             QMutexLocker locker(&wpool->lockInput);
-            wpool->nseq++;
-            if (wpool->nseq > wpool->nsample) {  /* we're done; release input lock, break loop */
-                break;
-            }
-            if (wpool->fixedlen) {
-                len = wpool->fixedlen;
-            } else { 
-                do { 
-                    len = (int) Gaussrandom(wpool->lenmean, wpool->lensd); 
-                } while (len < 1);
+            while (seqs.size() < CALIBRATE_BATCH_SIZE && wpool->nseq < wpool->nsample) {
+                wpool->nseq++;
+                int len = 0;
+                if (wpool->fixedlen) {
+                    len = wpool->fixedlen;
+                } else {
+                    do {
+                        len = (int) Gaussrandom(wpool->lenmean, wpool->lensd);
+                    } while (len < 1);
+                }
+                lens << len;
+                seqs << RandomSequence(al->Alphabet, wpool->randomseq.data(), al->Alphabet_size, len);
             }
-            seq = RandomSequence(al->Alphabet, wpool->randomseq.data(), al->Alphabet_size, len);
         }
-        
-        /* compute score */
-        dsq = DigitizeSequence(seq, len);
-
-        if (P7ViterbiSpaceOK(len, hmm->M, mx)) {
-            sc = P7Viterbi(dsq, len, hmm, mx, NULL);
-        } else {
-            int pStub;
-            sc = P7SmallViterbi(dsq, len, hmm, mx, NULL, pStub);
+        if (seqs.isEmpty()) {  /* we're done */
+            break;
         }
-        free(dsq); 
-        free(seq);
 
+        /* compute scores */
+        scores.clear();
+        for (int i = 0; i < seqs.size(); i++) {
+            unsigned char *dsq = DigitizeSequence(seqs[i], lens[i]);
+            float sc = 0;
+            if (P7ViterbiSpaceOK(lens[i], hmm->M, mx)) {
+                sc = P7Viterbi(dsq, lens[i], hmm, mx, NULL);
+            } else {
+                int pStub;
+                sc = P7SmallViterbi(dsq, lens[i], hmm, mx, NULL, pStub);
+            }
+            scores << sc;
+            free(dsq);
+            free(seqs[i]);
+        }
 
         /* save output */
         QMutexLocker locker(&wpool->lockOutput);
-        AddToHistogram(wpool->hist, sc);
-        wpool->max_score = qMax(wpool->max_score, sc);
+        foreach (float sc, scores) {
+            AddToHistogram(wpool->hist, sc);
+            wpool->max_score = qMax(wpool->max_score, sc);
+        }
         si.progress = int(100*wpool->nseq/float(wpool->nsample)); //TODO: update progress for all tasks?
         if (wpool->progress!=NULL) {
             *wpool->progress = si.progress;
@@ -226,6 +226,8 @@ Task* HMMSearchWorker::tick() {
                 subtasks << new HMMSearchTask(hmm, dnaSequence, cfg);
             }
             Task* searchTask = new MultiTask(tr("Find HMM signals in %1").arg(dnaSequence.getName()), subtasks);
+            // models are searched at the same time, each of them also splits the sequence into chunks
+            searchTask->setMaxParallelSubtasks(MAX_PARALLEL_SUBTASKS_AUTO);
             connect(new TaskSignalMapper(searchTask), SIGNAL(si_taskFinished(Task*)), SLOT(sl_taskFinished(Task*)));
             return searchTask;
         }
@@ -69,6 +69,7 @@ namespace U2 {
 #define MU_ATTR "mu"
 #define LAMBDA_ATTR "lambda"
 #define SEED_ATTR "seed"
+#define COMPARE_WITH_SERIAL_ATTR "compare_serial"
 
 #define ENV_HMMSEARCH_ALGORITHM_NAME "HMMSEARCH_ALGORITHM"
 #define ENV_HMMSEARCH_ALGORITHM_SSE "sse"
@@ -492,6 +493,7 @@ void GTest_uHMMERCalibrate::init(XMLTestFormat* tf, const QDomElement& el) {
     Q_UNUSED(tf);
 
     calibrateTask = NULL;
+    serialCalibrateTask = NULL;
 
     QString hmmFile = el.attribute(HMM_FILE_ATTR);
     if (hmmFile.isEmpty()) {
@@ -554,7 +556,8 @@ void GTest_uHMMERCalibrate::init(XMLTestFormat* tf, const QDomElement& el) {
         s.seed = seed;
     }
 
-    calibrateTask = new HMMCalibrateToFileTask*[nCalibrates];
+    bool compareWithSerial = (el.attribute(COMPARE_WITH_SERIAL_ATTR) == "true");
+    calibrateTask = new HMMCalibrateToFileTask*[nCalibrates + 1];
 
     s.nThreads = nThreads;
 
@@ -562,7 +565,14 @@ void GTest_uHMMERCalibrate::init(XMLTestFormat* tf, const QDomElement& el) {
     for(int i=0;i<nCalibrates;i++){
         calibrateTask[i] = new HMMCalibrateToFileTask(env->getVar("COMMON_DATA_DIR")+"/"+hmmFile,env->getVar("TEMP_DATA_DIR")+"/temp111",s);
     }
-    addSubTask(new GTest_uHMMERCalibrateSubtask(calibrateTask, nCalibrates));
+    if (compareWithSerial) {
+        //the same seed gives the same random sequences to the serial calibration
+        UHMMCalibrateSettings serialSettings = s;
+        serialSettings.nThreads = 1;
+        serialCalibrateTask = new HMMCalibrateToFileTask(env->getVar("COMMON_DATA_DIR")+"/"+hmmFile,env->getVar("TEMP_DATA_DIR")+"/temp112",serialSettings);
+        calibrateTask[nCalibrates] = serialCalibrateTask;
+    }
+    addSubTask(new GTest_uHMMERCalibrateSubtask(calibrateTask, compareWithSerial ? nCalibrates + 1 : nCalibrates));
 }
 
 Task::ReportResult GTest_uHMMERCalibrate::report() {
@@ -581,6 +591,14 @@ Task::ReportResult GTest_uHMMERCalibrate::report() {
             stateInfo.setError(  QString("lambda value %1, expected %2").arg(new_lambda).arg(lambda) );
             break;
         }
+        if (serialCalibrateTask != NULL) {
+            const ::plan7_s* serialHmm = (const ::plan7_s*)serialCalibrateTask->getHMM();
+            if (new_mu != serialHmm->mu || new_lambda != serialHmm->lambda) {
+                stateInfo.setError(  QString("mu and lambda values %1 and %2 differ from the single thread values %3 and %4")
+                    .arg(new_mu).arg(new_lambda).arg(serialHmm->mu).arg(serialHmm->lambda) );
+                break;
+            }
+        }
     }
     return ReportResult_Finished;
 }
@@ -596,6 +614,7 @@ GTest_uHMMERCalibrate::GTest_uHMMERCalibrateSubtask::GTest_uHMMERCalibrateSubtas
 }
 void GTest_uHMMERCalibrate::cleanup(){
     QFile::remove(env->getVar("TEMP_DATA_DIR")+"/temp111");
+    QFile::remove(env->getVar("TEMP_DATA_DIR")+"/temp112");
     delete[] calibrateTask;
 }
 
@@ -81,6 +81,8 @@ private:
 	float mu;
 	float lambda;
 	int nCalibrates;
+	// the parallel calibrations must give exactly the values of this single thread calibration
+	HMMCalibrateToFileTask *serialCalibrateTask;
 };
 
 class UHMMERTests {